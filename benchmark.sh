@@ -0,0 +1,192 @@
+#!/bin/bash
+
+# (C) Copyright 2025 - 2026, SECO Mind Srl
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# --- Configuration ---
+fresh_mode=false
+transport=mqtt
+system_transport=false
+simdjson=false
+jobs=$(nproc --all)
+build_dir="benchmark/build"
+filter=""
+replay_file=""
+replay_speed=1
+conformance=false
+allocation_budget=false
+
+# --- Helper Functions ---
+display_help() {
+    cat << EOF
+Usage: $0 [OPTIONS]
+
+Build and run the benchmarks.
+
+Options:
+  --fresh               Build from scratch (removes $build_dir).
+  --transport <TR>      Specify the transport to use (mqtt, grpc or both). Default: $transport.
+  --system_transport    Use the system trasnport (gRPC or MQTT) instead of building it from scratch.
+  --simdjson            Parse interfaces and pairing responses with simdjson (mqtt or both).
+  -j, --jobs <N>        Specify the number of parallel jobs for make. Default: $jobs.
+  --filter <REGEX>      Only run the benchmarks matching the regular expression.
+  --replay <FILE>       Replay a capture file instead of running the benchmarks (grpc or both).
+  --speed <FACTOR>      Pace of the replay relative to the capture, 0 for unthrottled. Default: $replay_speed.
+  --conformance         Run the device conformance checks instead of the benchmarks.
+  --allocation_budget   Check the allocations of the device sends instead of running the benchmarks.
+  -h, --help            Display this help message.
+EOF
+}
+error_exit() {
+    echo "Error: $1" >&2
+    exit 1
+}
+
+# --- Argument Parsing ---
+while [[ "$#" -gt 0 ]]; do
+    case $1 in
+        --fresh) fresh_mode=true; shift ;;
+        --transport)
+            transport="$2"
+            if [[ ! "$transport" =~ ^('mqtt'|'grpc'|'both')$ ]]; then
+                error_exit "Invalid transport '$transport'. Use mqtt, grpc or both."
+            fi
+            shift 2
+            ;;
+        --system_transport) system_transport=true; shift ;;
+        --simdjson) simdjson=true; shift ;;
+        -j|--jobs)
+            jobs="$2"
+            if ! [[ "$jobs" =~ ^[0-9]+$ && "$jobs" -gt 0 ]]; then
+                error_exit "Invalid argument for --jobs. Please provide a positive number."
+            fi
+            shift 2
+            ;;
+        --filter) filter="$2"; shift 2 ;;
+        --replay) replay_file="$(realpath "$2")"; shift 2 ;;
+        --speed) replay_speed="$2"; shift 2 ;;
+        --conformance) conformance=true; shift ;;
+        --allocation_budget) allocation_budget=true; shift ;;
+        -h|--help) display_help; exit 0 ;;
+        *) display_help; error_exit "Unknown option: $1" ;;
+    esac
+done
+
+if [[ -n "$replay_file" && "$transport" == "mqtt" ]]; then
+    error_exit "Capture files can only be replayed with the grpc transport."
+fi
+
+# --- Build Logic ---
+
+echo "Configuration:"
+echo "  Jobs: $jobs"
+echo "  Build Directory: $build_dir"
+echo "  Fresh Mode: $fresh_mode"
+echo "  Transport: $transport"
+echo "  Use System transport: $system_transport"
+echo "  Use simdjson: $simdjson"
+echo ""
+
+# Clean build if --fresh is set
+if [ "$fresh_mode" = true ]; then
+    if [ -d "$build_dir" ]; then
+        echo "Fresh build requested. Removing $build_dir..."
+        rm -rf "$build_dir"
+    else
+        echo "Fresh build requested, but $build_dir does not exist. Skipping removal."
+    fi
+fi
+
+# Create build directory if it doesn't exist
+echo "Ensuring build directory '$build_dir' exists..."
+if ! mkdir -p "$build_dir"; then
+    error_exit "Failed to create build directory '$build_dir'."
+fi
+
+# Navigate to build directory
+echo "Changing directory to '$build_dir'..."
+if ! cd "$build_dir"; then
+    error_exit "Failed to navigate to '$build_dir'. Make sure you are running this script from the project root (parent of the 'benchmark' directory)."
+fi
+
+# Configure CMake
+echo "Running CMake..."
+cmake_options_array=()
+cmake_options_array+=("-DCMAKE_BUILD_TYPE=Release")
+cmake_options_array+=("-DCMAKE_CXX_STANDARD=20")
+cmake_options_array+=("-DCMAKE_CXX_STANDARD_REQUIRED=ON")
+cmake_options_array+=("-DCMAKE_POLICY_VERSION_MINIMUM=3.15")
+cmake_options_array+=("-DASTARTE_PUBLIC_SPDLOG_DEP=ON")
+cmake_options_array+=("-DASTARTE_PUBLIC_PROTO_DEP=ON")
+cmake_options_array+=("-DCMAKE_POSITION_INDEPENDENT_CODE=ON")
+
+# With both transports the device workloads and conformance checks run on each of them
+if [[ "$transport" == "grpc" ]]; then
+    cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=ON")
+    cmake_options_array+=("-DASTARTE_TRANSPORT_MQTT=OFF")
+elif [[ "$transport" == "both" ]]; then
+    cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=ON")
+    cmake_options_array+=("-DASTARTE_TRANSPORT_MQTT=ON")
+else
+    cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=OFF")
+fi
+
+if [ "$system_transport" = true ] && [[ "$transport" != "mqtt" ]]; then
+    cmake_options_array+=("-DASTARTE_USE_SYSTEM_GRPC=ON")
+fi
+if [ "$system_transport" = true ] && [[ "$transport" != "grpc" ]]; then
+    cmake_options_array+=("-DASTARTE_USE_SYSTEM_MQTT=ON")
+fi
+
+if [ "$simdjson" = true ]; then
+    cmake_options_array+=("-DASTARTE_USE_SIMDJSON=ON")
+fi
+
+echo "CMake options: ${cmake_options_array[*]}"
+if ! cmake "${cmake_options_array[@]}" ..; then
+    error_exit "CMake configuration failed."
+fi
+
+# Build the project
+echo "Building with make -j $jobs ..."
+if ! make -j "$jobs"; then
+    error_exit "Make build failed."
+fi
+
+# Replay the capture file
+if [[ -n "$replay_file" ]]; then
+    echo "Replaying $replay_file..."
+    if ! ./benchmark_replay "$replay_file" --speed "$replay_speed"; then
+        error_exit "Replay failed."
+    fi
+    exit 0
+fi
+
+# Run the conformance checks
+if [ "$conformance" = true ]; then
+    echo "Running the device conformance checks..."
+    if ! ./benchmark_conformance; then
+        error_exit "Conformance checks failed."
+    fi
+    exit 0
+fi
+
+# Check the allocation budgets of the device sends
+if [ "$allocation_budget" = true ]; then
+    echo "Running the device allocation budget checks..."
+    if ! ./benchmark_allocation_budget; then
+        error_exit "Allocation budget checks failed."
+    fi
+    exit 0
+fi
+
+# Run the benchmarks
+echo "Running benchmarks..."
+benchmark_args=()
+if [[ -n "$filter" ]]; then
+    benchmark_args+=("--benchmark_filter=$filter")
+fi
+if ! ./benchmark_runner "${benchmark_args[@]}"; then
+    error_exit "Benchmark execution failed."
+fi
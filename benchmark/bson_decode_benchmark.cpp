@@ -0,0 +1,152 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "mqtt/deserialize.hpp"
+#include "mqtt/serialize.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Type;
+using astarte::device::mqtt::bson::deserialize_astarte_individual;
+using astarte::device::mqtt::bson::deserialize_astarte_object;
+using astarte::device::mqtt::bson::ObjectTypeLookup;
+using astarte::device::mqtt::bson::serialize_astarte_individual;
+using astarte::device::mqtt::bson::serialize_astarte_object;
+using nlohmann::json;
+
+namespace {
+
+const auto k_timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+
+auto encode_individual(const Data& data) -> std::vector<uint8_t> {
+  json doc;
+  serialize_astarte_individual(doc, "v", data, &k_timestamp);
+  return json::to_bson(doc);
+}
+
+auto make_object(int64_t keys) -> DatastreamObject {
+  DatastreamObject object;
+  for (int64_t i = 0; i < keys; i++) {
+    object.insert("sensor" + std::to_string(i), Data(static_cast<double>(i) * 0.5));
+  }
+  return object;
+}
+
+auto object_type_of(std::string_view key) -> std::optional<Type> {
+  if (key.starts_with("sensor")) {
+    return Type::kDouble;
+  }
+  return std::nullopt;
+}
+
+// Decodes the payload into a document and converts its value, as a generic BSON library would.
+template <typename T>
+auto decode_with_document(const std::vector<uint8_t>& payload) -> Data {
+  auto doc = json::from_bson(payload);
+  return Data(doc.at("v").get<T>());
+}
+
+// Decodes a double individual, the most common payload sent by Astarte.
+void BM_BsonDecodeDoubleDocument(benchmark::State& state) {
+  const auto payload = encode_individual(Data(21.5));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decode_with_document<double>(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+void BM_BsonDecodeDoubleDirect(benchmark::State& state) {
+  const auto payload = encode_individual(Data(21.5));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(deserialize_astarte_individual(payload, Type::kDouble));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+// Decodes a long integer array individual, the argument is the length of the array.
+void BM_BsonDecodeArrayDocument(benchmark::State& state) {
+  const auto payload = encode_individual(Data(std::vector<int64_t>(state.range(0), 5000000000)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decode_with_document<std::vector<int64_t>>(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+void BM_BsonDecodeArrayDirect(benchmark::State& state) {
+  const auto payload = encode_individual(Data(std::vector<int64_t>(state.range(0), 5000000000)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(deserialize_astarte_individual(payload, Type::kLongIntegerArray));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+// Decodes an object of doubles, the argument is the number of keys of the object.
+void BM_BsonDecodeObjectDocument(benchmark::State& state) {
+  json doc;
+  serialize_astarte_object(doc, make_object(state.range(0)), &k_timestamp);
+  const auto payload = json::to_bson(doc);
+  for (auto _ : state) {
+    auto decoded = json::from_bson(payload);
+    DatastreamObject object;
+    for (const auto& [key, value] : decoded.at("v").items()) {
+      if (!object_type_of(key)) {
+        state.SkipWithError("unexpected object key");
+        return;
+      }
+      object.insert(key, Data(value.get<double>()));
+    }
+    benchmark::DoNotOptimize(object);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+void BM_BsonDecodeObjectDirect(benchmark::State& state) {
+  json doc;
+  serialize_astarte_object(doc, make_object(state.range(0)), &k_timestamp);
+  const auto payload = json::to_bson(doc);
+  const ObjectTypeLookup type_of = object_type_of;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(deserialize_astarte_object(payload, type_of));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+void BM_BsonDecodeObjectReserved(benchmark::State& state) {
+  json doc;
+  serialize_astarte_object(doc, make_object(state.range(0)), &k_timestamp);
+  const auto payload = json::to_bson(doc);
+  const ObjectTypeLookup type_of = object_type_of;
+  const auto keys = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(deserialize_astarte_object(payload, type_of, keys));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_BsonDecodeDoubleDocument);
+BENCHMARK(BM_BsonDecodeDoubleDirect);
+BENCHMARK(BM_BsonDecodeArrayDocument)->ArgName("length")->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_BsonDecodeArrayDirect)->ArgName("length")->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_BsonDecodeObjectDocument)->ArgName("keys")->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_BsonDecodeObjectDirect)->ArgName("keys")->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_BsonDecodeObjectReserved)->ArgName("keys")->RangeMultiplier(4)->Range(1, 64);
+
+#endif
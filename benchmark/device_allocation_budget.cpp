@@ -0,0 +1,248 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Budgets of the heap allocations performed by the sends of the device of each transport the SDK
+// has been built with, for each Data type. The devices send to their in-process server stand-ins,
+// so a budget covers the whole device call on the calling thread: the lookup of the interface, the
+// validation, the conversion of the data and the hand over to the transport. When an optimization
+// lowers a count, lower the budget accordingly so that regressions are caught.
+//
+// Usage: benchmark_allocation_budget
+//
+// Prints one line per budget of each transport and exits with a failure if any budget is exceeded.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(ASTARTE_TRANSPORT_GRPC)
+#include <google/protobuf/stubs/common.h>
+#endif
+
+#include "allocation_counter.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "device_harness.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Device;
+using astarte::device::Error;
+using astarte::device::benchmark::DeviceHarness;
+using astarte::device::benchmark::k_object_interface;
+using astarte::device::benchmark::k_types_interface;
+using astarte::device::unit::AllocationScope;
+
+namespace {
+
+using SendResult = astarte::device::astarte_tl::expected<void, Error>;
+
+// Number of measured sends of each budget, the median count is checked.
+constexpr size_t k_samples = 16;
+// Maximum time waited for the server stand-in to receive the sends.
+constexpr auto k_delivery_timeout = std::chrono::seconds(10);
+// Interval at which the messages received by the server stand-in are polled.
+constexpr auto k_delivery_poll_interval = std::chrono::milliseconds(10);
+
+const auto k_timestamp =
+    std::chrono::system_clock::time_point(std::chrono::milliseconds(1700000000123));
+
+// Allocations of the Paho message and of its delivery token, performed by every MQTT send.
+constexpr uint64_t k_mqtt_publish_allowance = 16;
+
+#if defined(ASTARTE_TRANSPORT_GRPC)
+// Allocations of the unary call performed by every gRPC send. The protobuf releases based on
+// abseil allocate the message internals differently, the allowance is keyed on the release the
+// SDK is built against.
+#if GOOGLE_PROTOBUF_VERSION >= 4022000
+constexpr uint64_t k_grpc_call_allowance = 96;
+#else
+constexpr uint64_t k_grpc_call_allowance = 80;
+#endif
+// Relative tolerance of the gRPC budgets, the gRPC release is not pinned when using the system one.
+constexpr double k_grpc_tolerance = 0.25;
+#endif
+
+// A value of each Data type, with the endpoint it is sent on and the budgets of its send.
+struct TypeBudget {
+  Data data;
+  // Path of the mapping of the types interface.
+  const char* path;
+  // Send of the MQTT device, on top of the publish allowance.
+  uint64_t mqtt;
+  // Send of the gRPC device, on top of the call allowance.
+  uint64_t grpc;
+};
+
+auto budgets() -> std::vector<TypeBudget> {
+  return {
+      {Data(int32_t{-42}), "/sensor_1/integer", 9, 10},
+      {Data(int64_t{5000000000}), "/sensor_1/longinteger", 9, 10},
+      {Data(3.25), "/sensor_1/double", 9, 10},
+      {Data(true), "/sensor_1/boolean", 9, 10},
+      {Data(std::string(32, 'x')), "/sensor_1/string", 13, 12},
+      {Data(std::vector<uint8_t>(32, 0xAB)), "/sensor_1/binaryblob", 13, 12},
+      {Data(k_timestamp), "/sensor_1/datetime", 9, 11},
+      {Data(std::vector<int32_t>(8, -42)), "/sensor_1/integerarray", 16, 12},
+      {Data(std::vector<int64_t>(8, 5000000000)), "/sensor_1/longintegerarray", 17, 12},
+      {Data(std::vector<double>(8, 3.25)), "/sensor_1/doublearray", 17, 12},
+      {Data(std::vector<bool>(8, true)), "/sensor_1/booleanarray", 15, 12},
+      {Data(std::vector<std::string>(4, std::string(32, 'x'))), "/sensor_1/stringarray", 24, 16},
+      {Data(std::vector<std::vector<uint8_t>>(4, std::vector<uint8_t>(32, 0xAB))),
+       "/sensor_1/binaryblobarray", 33, 16},
+      {Data(std::vector<std::chrono::system_clock::time_point>(4, k_timestamp)),
+       "/sensor_1/datetimearray", 16, 18},
+  };
+}
+
+// Budgets of the send of an object of three entries.
+constexpr uint64_t k_mqtt_object_budget = 20;
+constexpr uint64_t k_grpc_object_budget = 20;
+
+// Runs the checks, counting the failures.
+class Checker {
+ public:
+  void check(std::string_view transport, std::string_view name, std::optional<uint64_t> count,
+             uint64_t budget) {
+    const bool passed = count && count.value() <= budget;
+    std::cout << (passed ? "PASS " : "FAIL ") << transport << " " << name << ": ";
+    if (count) {
+      std::cout << count.value() << " allocations, budget " << budget << "\n";
+    } else {
+      std::cout << "send failed\n";
+    }
+    if (!passed) {
+      failures_++;
+    }
+  }
+
+  void check(std::string_view name, bool passed) {
+    std::cout << (passed ? "PASS " : "FAIL ") << name << "\n";
+    if (!passed) {
+      failures_++;
+    }
+  }
+
+  [[nodiscard]] auto failures() const -> int { return failures_; }
+
+ private:
+  int failures_{0};
+};
+
+// Gets the budget of a send on a transport, adding the allowance of the transport.
+auto transport_budget([[maybe_unused]] std::string_view transport, uint64_t mqtt,
+                      [[maybe_unused]] uint64_t grpc) -> uint64_t {
+#if defined(ASTARTE_TRANSPORT_GRPC)
+  if (transport == "grpc") {
+    return static_cast<uint64_t>(static_cast<double>(grpc + k_grpc_call_allowance) *
+                                 (1.0 + k_grpc_tolerance));
+  }
+#endif
+  return mqtt + k_mqtt_publish_allowance;
+}
+
+// Measures the median allocations of the calling thread over the sends, after a first send that
+// initializes the lazily constructed state. Returns std::nullopt if a send fails.
+template <typename Send>
+auto measure(Send&& send, uint64_t& sends) -> std::optional<uint64_t> {
+  sends++;
+  if (!send()) {
+    return std::nullopt;
+  }
+  std::vector<uint64_t> counts;
+  counts.reserve(k_samples);
+  for (size_t i = 0; i < k_samples; i++) {
+    sends++;
+    const AllocationScope scope;
+    const bool sent = static_cast<bool>(send());
+    const auto count = scope.count();
+    if (!sent) {
+      return std::nullopt;
+    }
+    counts.push_back(count);
+  }
+  std::sort(counts.begin(), counts.end());
+  return counts[counts.size() / 2];
+}
+
+// Waits until the server stand-in has received the sends.
+auto wait_delivered(const DeviceHarness& harness, uint64_t sends) -> bool {
+  const auto deadline = std::chrono::steady_clock::now() + k_delivery_timeout;
+  while (harness.delivered() < sends) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(k_delivery_poll_interval);
+  }
+  return harness.delivered() == sends;
+}
+
+// Runs the checks on the device of a transport.
+void check_transport(std::string_view transport, Checker& checker) {
+  std::cout << "Transport: " << transport << "\n";
+  std::unique_ptr<DeviceHarness> harness;
+  try {
+    harness = DeviceHarness::create(transport);
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to create the device: " << e.what() << "\n";
+    checker.check("create", false);
+    return;
+  }
+  if (!harness->connect()) {
+    checker.check("connect", false);
+    return;
+  }
+
+  Device& device = harness->device();
+  uint64_t sends = 0;
+  for (const auto& budget : budgets()) {
+    const auto count = measure(
+        [&]() -> SendResult {
+          return device.send_individual(k_types_interface, budget.path, budget.data,
+                                        &k_timestamp);
+        },
+        sends);
+    checker.check(transport, std::string("send_individual ") + budget.path, count,
+                  transport_budget(transport, budget.mqtt, budget.grpc));
+  }
+
+  const DatastreamObject object{{"temperature", Data(21.5)},
+                                {"humidity", Data(0.45)},
+                                {"status", Data(std::string(32, 'x'))}};
+  const auto count = measure(
+      [&]() -> SendResult {
+        return device.send_object(k_object_interface, "/sensor_1", object, &k_timestamp);
+      },
+      sends);
+  checker.check(transport, "send_object", count,
+                transport_budget(transport, k_mqtt_object_budget, k_grpc_object_budget));
+
+  // the counted sends must have reached the server stand-in
+  checker.check("delivered", wait_delivered(*harness, sends));
+  checker.check("disconnect", static_cast<bool>(device.disconnect()));
+}
+
+}  // namespace
+
+auto main() -> int {
+  Checker checker;
+  for (const auto transport : DeviceHarness::transports()) {
+    check_transport(transport, checker);
+  }
+
+  std::cout << checker.failures() << " checks failed\n";
+  return checker.failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,176 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Transport agnostic workloads, written against the abstract Device and registered once for each
+// transport the SDK has been built with. Building the suite with both transports reports the
+// throughput, latency and allocations per operation of the same workloads side by side.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "device_harness.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Device;
+using astarte::device::benchmark::DeviceHarness;
+using astarte::device::benchmark::k_individual_interface;
+using astarte::device::benchmark::k_object_interface;
+using astarte::device::unit::allocation_count;
+
+namespace {
+
+// Number of elements of the array samples.
+constexpr size_t k_array_size = 16;
+// Length of the string samples.
+constexpr size_t k_string_size = 32;
+
+// One per transport, shared by all its workloads, connecting a device is much slower than the
+// workloads themselves.
+std::map<std::string_view, std::unique_ptr<DeviceHarness>> harnesses;
+
+auto shared_harness(benchmark::State& state, std::string_view transport) -> DeviceHarness* {
+  auto& harness = harnesses[transport];
+  if (!harness) {
+    try {
+      harness = DeviceHarness::create(transport);
+    } catch (const std::exception& e) {
+      state.SkipWithError(e.what());
+      return nullptr;
+    }
+    if (!harness->connect()) {
+      harness.reset();
+      state.SkipWithError("failed to connect the device");
+      return nullptr;
+    }
+  }
+  return harness.get();
+}
+
+// Measures the latency of each call and the allocations of the whole run, then checks that every
+// message reached the server stand-in.
+template <typename Send>
+void run_workload(benchmark::State& state, DeviceHarness& bench, Send&& send) {
+  std::vector<double> latencies_us;
+  latencies_us.reserve(static_cast<size_t>(state.max_iterations));
+  const auto delivered_before = bench.delivered();
+  const auto allocations_before = allocation_count();
+
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    auto res = send(bench.device());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (!res) {
+      state.SkipWithError("send failed");
+      return;
+    }
+    latencies_us.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+  }
+
+  const auto allocations = allocation_count() - allocations_before;
+  const auto iterations = static_cast<uint64_t>(state.iterations());
+  if (bench.delivered() - delivered_before != iterations) {
+    state.SkipWithError("the server stand-in did not receive every message");
+    return;
+  }
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile = [&latencies_us](double pct) {
+    if (latencies_us.empty()) {
+      return 0.0;
+    }
+    auto index = static_cast<size_t>(pct * static_cast<double>(latencies_us.size() - 1));
+    return latencies_us[index];
+  };
+
+  state.SetLabel(std::string(bench.transport()));
+  state.SetItemsProcessed(state.iterations());
+  state.counters["p50_us"] = percentile(0.50);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["allocs_per_op"] =
+      static_cast<double>(allocations) / static_cast<double>(std::max<uint64_t>(iterations, 1));
+}
+
+// Sends individual datastreams, the argument selects the type of the data: a double, an array of
+// longs or a string.
+void BM_DeviceSendIndividual(benchmark::State& state, std::string_view transport) {
+  auto* bench = shared_harness(state, transport);
+  if (bench == nullptr) {
+    return;
+  }
+
+  std::string_view path;
+  Data data(0.0);
+  switch (state.range(0)) {
+    case 0:
+      path = "/sensor_1/value";
+      data = Data(21.5);
+      break;
+    case 1:
+      path = "/sensor_1/samples";
+      data = Data(std::vector<int64_t>(k_array_size, 1LL << 40));
+      break;
+    default:
+      path = "/sensor_1/name";
+      data = Data(std::string(k_string_size, 'x'));
+      break;
+  }
+  const auto timestamp = std::chrono::system_clock::now();
+
+  run_workload(state, *bench, [&](Device& device) {
+    return device.send_individual(k_individual_interface, path, data, &timestamp);
+  });
+}
+
+// Sends an object datastream of three entries.
+void BM_DeviceSendObject(benchmark::State& state, std::string_view transport) {
+  auto* bench = shared_harness(state, transport);
+  if (bench == nullptr) {
+    return;
+  }
+
+  const DatastreamObject object{{"temperature", Data(21.5)},
+                                {"humidity", Data(0.45)},
+                                {"status", Data(std::string("nominal"))}};
+  const auto timestamp = std::chrono::system_clock::now();
+
+  run_workload(state, *bench, [&](Device& device) {
+    return device.send_object(k_object_interface, "/sensor_1", object, &timestamp);
+  });
+}
+
+// Registers the workloads of each built transport, named after it.
+auto register_workloads() -> bool {
+  for (const auto transport : DeviceHarness::transports()) {
+    const std::string individual_name = "BM_DeviceSendIndividual/" + std::string(transport);
+    benchmark::RegisterBenchmark(individual_name.c_str(), BM_DeviceSendIndividual, transport)
+        ->ArgName("type")
+        ->DenseRange(0, 2)
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+    const std::string object_name = "BM_DeviceSendObject/" + std::string(transport);
+    benchmark::RegisterBenchmark(object_name.c_str(), BM_DeviceSendObject, transport)
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+  }
+  return true;
+}
+
+[[maybe_unused]] const bool workloads_registered = register_workloads();
+
+}  // namespace
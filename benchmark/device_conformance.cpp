@@ -0,0 +1,136 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks that the device of each transport the SDK has been built with behaves as specified by the
+// abstract Device, using the same interfaces and data of the device benchmarks.
+//
+// Usage: benchmark_conformance
+//
+// Prints one line per check of each transport and exits with a failure if any check fails.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "device_harness.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Device;
+using astarte::device::Error;
+using astarte::device::benchmark::DeviceHarness;
+using astarte::device::benchmark::k_individual_interface;
+using astarte::device::benchmark::k_object_interface;
+
+namespace {
+
+using SendResult = astarte::device::astarte_tl::expected<void, Error>;
+
+// Runs the checks, counting the failures.
+class Checker {
+ public:
+  void check(std::string_view name, bool passed) {
+    std::cout << (passed ? "PASS " : "FAIL ") << name << "\n";
+    if (!passed) {
+      failures_++;
+    }
+  }
+
+  [[nodiscard]] auto failures() const -> int { return failures_; }
+
+ private:
+  int failures_{0};
+};
+
+// A send that must reach the server stand-in exactly once.
+struct Delivery {
+  std::string_view name;
+  std::function<SendResult(Device&)> send;
+};
+
+auto deliveries(const std::chrono::system_clock::time_point& timestamp) -> std::vector<Delivery> {
+  return {
+      {"send_individual double",
+       [&timestamp](Device& device) {
+         return device.send_individual(k_individual_interface, "/sensor_1/value", Data(21.5),
+                                       &timestamp);
+       }},
+      {"send_individual longintegerarray",
+       [&timestamp](Device& device) {
+         return device.send_individual(k_individual_interface, "/sensor_1/samples",
+                                       Data(std::vector<int64_t>{1, 2, 3}), &timestamp);
+       }},
+      {"send_individual string",
+       [&timestamp](Device& device) {
+         return device.send_individual(k_individual_interface, "/sensor_1/name",
+                                       Data(std::string("sensor")), &timestamp);
+       }},
+      {"send_object",
+       [&timestamp](Device& device) {
+         const DatastreamObject object{{"temperature", Data(21.5)},
+                                       {"humidity", Data(0.45)},
+                                       {"status", Data(std::string("nominal"))}};
+         return device.send_object(k_object_interface, "/sensor_1", object, &timestamp);
+       }},
+  };
+}
+
+// Runs the checks on the device of a transport.
+void check_transport(std::string_view transport, Checker& checker) {
+  std::cout << "Transport: " << transport << "\n";
+  std::unique_ptr<DeviceHarness> harness;
+  try {
+    harness = DeviceHarness::create(transport);
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to create the device: " << e.what() << "\n";
+    checker.check("create", false);
+    return;
+  }
+
+  auto& device = harness->device();
+  const auto timestamp = std::chrono::system_clock::now();
+  const auto sends = deliveries(timestamp);
+
+  checker.check("not connected before connect", !device.is_connected());
+  checker.check("send refused before connect", !sends.front().send(device));
+
+  const bool connected = harness->connect();
+  checker.check("connect", connected);
+  if (!connected) {
+    return;
+  }
+
+  for (const auto& delivery : sends) {
+    const auto before = harness->delivered();
+    const bool sent = static_cast<bool>(delivery.send(device));
+    checker.check(delivery.name, sent && harness->delivered() == before + 1);
+  }
+
+  checker.check("disconnect", static_cast<bool>(device.disconnect()));
+  checker.check("not connected after disconnect", !device.is_connected());
+  checker.check("send refused after disconnect", !sends.front().send(device));
+}
+
+}  // namespace
+
+auto main() -> int {
+  Checker checker;
+  for (const auto transport : DeviceHarness::transports()) {
+    check_transport(transport, checker);
+  }
+
+  std::cout << checker.failures() << " checks failed\n";
+  return checker.failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
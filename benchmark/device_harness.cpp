@@ -0,0 +1,148 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device_harness.hpp"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+
+namespace astarte::device::benchmark {
+
+namespace {
+
+// Interval at which the connection state of the device is polled.
+constexpr auto k_connect_poll_interval = std::chrono::milliseconds(10);
+
+constexpr std::string_view k_individual_json = R"({
+  "interface_name": "org.astarte-platform.benchmark.DeviceDatastream",
+  "version_major": 0,
+  "version_minor": 1,
+  "type": "datastream",
+  "ownership": "device",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/value", "type": "double", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/samples", "type": "longintegerarray", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/name", "type": "string", "explicit_timestamp": true,
+     "reliability": "guaranteed"}
+  ]
+})";
+
+constexpr std::string_view k_object_json = R"({
+  "interface_name": "org.astarte-platform.benchmark.DeviceAggregate",
+  "version_major": 0,
+  "version_minor": 1,
+  "type": "datastream",
+  "ownership": "device",
+  "aggregation": "object",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/temperature", "type": "double", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/humidity", "type": "double", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/status", "type": "string", "explicit_timestamp": true,
+     "reliability": "guaranteed"}
+  ]
+})";
+
+constexpr std::string_view k_types_json = R"({
+  "interface_name": "org.astarte-platform.benchmark.DeviceTypes",
+  "version_major": 0,
+  "version_minor": 1,
+  "type": "datastream",
+  "ownership": "device",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/integer", "type": "integer", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/longinteger", "type": "longinteger", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/double", "type": "double", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/boolean", "type": "boolean", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/string", "type": "string", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/binaryblob", "type": "binaryblob", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/datetime", "type": "datetime", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/integerarray", "type": "integerarray",
+     "explicit_timestamp": true, "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/longintegerarray", "type": "longintegerarray",
+     "explicit_timestamp": true, "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/doublearray", "type": "doublearray", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/booleanarray", "type": "booleanarray",
+     "explicit_timestamp": true, "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/stringarray", "type": "stringarray", "explicit_timestamp": true,
+     "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/binaryblobarray", "type": "binaryblobarray",
+     "explicit_timestamp": true, "reliability": "guaranteed"},
+    {"endpoint": "/%{sensor_id}/datetimearray", "type": "datetimearray",
+     "explicit_timestamp": true, "reliability": "guaranteed"}
+  ]
+})";
+
+}  // namespace
+
+auto DeviceHarness::transports() -> std::vector<std::string_view> {
+  std::vector<std::string_view> names;
+#if defined(ASTARTE_TRANSPORT_MQTT)
+  names.emplace_back("mqtt");
+#endif
+#if defined(ASTARTE_TRANSPORT_GRPC)
+  names.emplace_back("grpc");
+#endif
+  return names;
+}
+
+auto DeviceHarness::create(std::string_view transport) -> std::unique_ptr<DeviceHarness> {
+#if defined(ASTARTE_TRANSPORT_MQTT)
+  if (transport == "mqtt") {
+    return create_mqtt_harness();
+  }
+#endif
+#if defined(ASTARTE_TRANSPORT_GRPC)
+  if (transport == "grpc") {
+    return create_grpc_harness();
+  }
+#endif
+  throw std::runtime_error(
+      astarte_fmt::format("the SDK has not been built with the {} transport", transport));
+}
+
+auto DeviceHarness::connect(std::chrono::milliseconds timeout) -> bool {
+  if (!device().connect()) {
+    return false;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!device().is_connected()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(k_connect_poll_interval);
+  }
+  baseline_ = received();
+  return true;
+}
+
+void DeviceHarness::add_interfaces(Device& device) {
+  for (const auto json : {k_individual_json, k_object_json, k_types_json}) {
+    auto res = device.add_interface_from_str(json);
+    if (!res) {
+      throw std::runtime_error(
+          astarte_fmt::format("failed to add a workload interface: {}", res.error()));
+    }
+  }
+}
+
+}  // namespace astarte::device::benchmark
@@ -0,0 +1,139 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_BENCHMARK_DEVICE_HARNESS_H
+#define ASTARTE_BENCHMARK_DEVICE_HARNESS_H
+
+/**
+ * @file benchmark/device_harness.hpp
+ * @brief Transport agnostic device attached to an in-process server stand-in.
+ *
+ * @details The harness owns a device of one of the transports the SDK has been built with,
+ * together with the stand-in of the server it talks to: the MQTT broker and pairing API for
+ * `DeviceMqtt` and the message hub for `DeviceGrpc`. Workloads written against the abstract
+ * `Device` run unchanged on both transports, making their results directly comparable.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/device.hpp"
+
+namespace astarte::device::benchmark {
+
+/// @brief Device owned datastream interface with individual aggregation used by the workloads.
+inline constexpr std::string_view k_individual_interface =
+    "org.astarte-platform.benchmark.DeviceDatastream";
+/// @brief Device owned datastream interface with object aggregation used by the workloads.
+inline constexpr std::string_view k_object_interface =
+    "org.astarte-platform.benchmark.DeviceAggregate";
+/// @brief Device owned datastream interface with a mapping of each type, named after the type.
+inline constexpr std::string_view k_types_interface = "org.astarte-platform.benchmark.DeviceTypes";
+
+/**
+ * @brief Device of a built transport attached to its server stand-in.
+ */
+class DeviceHarness {
+ public:
+  /**
+   * @brief Gets the transports the SDK has been built with.
+   * @return The names of the transports, as returned by `transport()`.
+   */
+  static auto transports() -> std::vector<std::string_view>;
+
+  /**
+   * @brief Starts the server stand-in and creates a device with the workload interfaces.
+   * @details The device is not connected.
+   * @param[in] transport The name of a built transport, either "mqtt" or "grpc".
+   * @return The harness.
+   * @throws std::runtime_error if the transport has not been built, or if the stand-in or the
+   * device could not be created.
+   */
+  static auto create(std::string_view transport) -> std::unique_ptr<DeviceHarness>;
+
+  /// @brief Disconnects the device and stops the server stand-in.
+  virtual ~DeviceHarness() = default;
+
+  /// @brief DeviceHarness is non-copyable.
+  DeviceHarness(const DeviceHarness&) = delete;
+  /// @brief DeviceHarness is non-movable.
+  DeviceHarness(DeviceHarness&&) = delete;
+  /// @brief DeviceHarness is non-copyable.
+  auto operator=(const DeviceHarness&) -> DeviceHarness& = delete;
+  /// @brief DeviceHarness is non-movable.
+  auto operator=(DeviceHarness&&) -> DeviceHarness& = delete;
+
+  /**
+   * @brief Gets the device under test.
+   * @return The device.
+   */
+  virtual auto device() -> Device& = 0;
+
+  /**
+   * @brief Gets the name of the transport of the device.
+   * @return Either "mqtt" or "grpc".
+   */
+  [[nodiscard]] virtual auto transport() const -> std::string_view = 0;
+
+  /**
+   * @brief Gets the number of messages received by the server stand-in since the last connection.
+   * @details Messages exchanged to set up the session, such as the MQTT introspection, are not
+   * counted.
+   * @return The number of received messages.
+   */
+  [[nodiscard]] auto delivered() const -> uint64_t { return received() - baseline_; }
+
+  /**
+   * @brief Connects the device and waits for the connection to be established.
+   * @param[in] timeout Maximum time to wait for the connection.
+   * @return True if the device is connected.
+   */
+  auto connect(std::chrono::milliseconds timeout = std::chrono::seconds(10)) -> bool;
+
+ protected:
+  /// @brief Constructor for the derived harnesses.
+  DeviceHarness() = default;
+
+  /**
+   * @brief Adds the workload interfaces to a device.
+   * @param[in,out] device The device to configure.
+   * @throws std::runtime_error if an interface is rejected.
+   */
+  static void add_interfaces(Device& device);
+
+ private:
+  /**
+   * @brief Gets the number of messages received by the server stand-in since it was started.
+   * @return The number of received messages.
+   */
+  [[nodiscard]] virtual auto received() const -> uint64_t = 0;
+
+  /// @brief Messages received by the stand-in when the device completed its last connection.
+  uint64_t baseline_{0};
+};
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+/**
+ * @brief Creates the harness of the MQTT transport.
+ * @return The harness.
+ * @throws std::runtime_error if the stand-ins or the device could not be created.
+ */
+auto create_mqtt_harness() -> std::unique_ptr<DeviceHarness>;
+#endif
+
+#if defined(ASTARTE_TRANSPORT_GRPC)
+/**
+ * @brief Creates the harness of the gRPC transport.
+ * @return The harness.
+ * @throws std::runtime_error if the stand-in or the device could not be created.
+ */
+auto create_grpc_harness() -> std::unique_ptr<DeviceHarness>;
+#endif
+
+}  // namespace astarte::device::benchmark
+
+#endif  // ASTARTE_BENCHMARK_DEVICE_HARNESS_H
@@ -0,0 +1,57 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(ASTARTE_TRANSPORT_GRPC)
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/grpc/device_grpc.hpp"
+#include "device_harness.hpp"
+#include "local_message_hub.hpp"
+
+namespace astarte::device::benchmark {
+
+namespace {
+
+using grpc::DeviceGrpc;
+
+// gRPC device attached to the message hub stand-in.
+class GrpcDeviceHarness final : public DeviceHarness {
+ public:
+  GrpcDeviceHarness() : device_(hub_.address(), "aa04dade-9401-4c37-8c6a-d8da15b083ae") {
+    add_interfaces(device_);
+  }
+
+  ~GrpcDeviceHarness() override {
+    if (device_.is_connected()) {
+      (void)device_.disconnect();
+    }
+  }
+
+  GrpcDeviceHarness(const GrpcDeviceHarness&) = delete;
+  GrpcDeviceHarness(GrpcDeviceHarness&&) = delete;
+  auto operator=(const GrpcDeviceHarness&) -> GrpcDeviceHarness& = delete;
+  auto operator=(GrpcDeviceHarness&&) -> GrpcDeviceHarness& = delete;
+
+  auto device() -> Device& override { return device_; }
+
+  [[nodiscard]] auto transport() const -> std::string_view override { return "grpc"; }
+
+ private:
+  [[nodiscard]] auto received() const -> uint64_t override { return hub_.received(); }
+
+  LocalMessageHub hub_;
+  DeviceGrpc device_;
+};
+
+}  // namespace
+
+auto create_grpc_harness() -> std::unique_ptr<DeviceHarness> {
+  return std::make_unique<GrpcDeviceHarness>();
+}
+
+}  // namespace astarte::device::benchmark
+#endif
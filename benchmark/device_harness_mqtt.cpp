@@ -0,0 +1,80 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/mqtt/config.hpp"
+#include "astarte_device_sdk/mqtt/device_mqtt.hpp"
+#include "device_harness.hpp"
+#include "local_broker.hpp"
+#include "local_pairing_api.hpp"
+
+namespace astarte::device::benchmark {
+
+namespace {
+
+using mqtt::Config;
+using mqtt::DeviceMqtt;
+
+// MQTT device attached to the broker stand-in, credentials are served by the pairing stand-in.
+class MqttDeviceHarness final : public DeviceHarness {
+ public:
+  MqttDeviceHarness()
+      : pairing_api_(broker_.url()),
+        store_dir_(std::filesystem::temp_directory_path() / "astarte_device_harness") {
+    std::filesystem::create_directories(store_dir_);
+    auto cfg = Config::with_credential_secret("realm", "device_id", "secret", pairing_api_.url(),
+                                              store_dir_.string());
+    auto device = DeviceMqtt::create(std::move(cfg));
+    if (!device) {
+      throw std::runtime_error(
+          astarte_fmt::format("failed to create the MQTT device: {}", device.error()));
+    }
+    device_.emplace(std::move(device.value()));
+    add_interfaces(*device_);
+  }
+
+  ~MqttDeviceHarness() override {
+    if (device_ && device_->is_connected()) {
+      (void)device_->disconnect();
+    }
+    device_.reset();
+    std::filesystem::remove_all(store_dir_);
+  }
+
+  MqttDeviceHarness(const MqttDeviceHarness&) = delete;
+  MqttDeviceHarness(MqttDeviceHarness&&) = delete;
+  auto operator=(const MqttDeviceHarness&) -> MqttDeviceHarness& = delete;
+  auto operator=(MqttDeviceHarness&&) -> MqttDeviceHarness& = delete;
+
+  auto device() -> Device& override { return *device_; }
+
+  [[nodiscard]] auto transport() const -> std::string_view override { return "mqtt"; }
+
+ private:
+  [[nodiscard]] auto received() const -> uint64_t override { return broker_.received(); }
+
+  LocalBroker broker_;
+  LocalPairingApi pairing_api_;
+  std::filesystem::path store_dir_;
+  std::optional<DeviceMqtt> device_;
+};
+
+}  // namespace
+
+auto create_mqtt_harness() -> std::unique_ptr<DeviceHarness> {
+  return std::make_unique<MqttDeviceHarness>();
+}
+
+}  // namespace astarte::device::benchmark
+#endif
@@ -0,0 +1,79 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#if defined(ASTARTE_TRANSPORT_GRPC)
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/grpc/device_grpc.hpp"
+#include "local_message_hub.hpp"
+
+using astarte::device::Data;
+using astarte::device::benchmark::LocalMessageHub;
+using astarte::device::grpc::DeviceGrpc;
+
+namespace {
+
+// Maximum time waited for the device to attach to the message hub.
+constexpr auto k_connect_timeout = std::chrono::seconds(10);
+// Interval at which the connection state of the device is polled.
+constexpr auto k_connect_poll_interval = std::chrono::milliseconds(10);
+
+// Shared between the benchmark threads, set up and torn down by the first thread.
+std::unique_ptr<LocalMessageHub> hub;
+std::unique_ptr<DeviceGrpc> device;
+
+auto wait_connected(const DeviceGrpc& dev) -> bool {
+  const auto deadline = std::chrono::steady_clock::now() + k_connect_timeout;
+  while (!dev.is_connected()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(k_connect_poll_interval);
+  }
+  return true;
+}
+
+// Sends individual datastreams from several threads through a single device, measuring how the
+// send throughput scales with the number of concurrent senders.
+void BM_GrpcSendIndividualConcurrent(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    hub = std::make_unique<LocalMessageHub>();
+    device = std::make_unique<DeviceGrpc>(hub->address(), "aa04dade-9401-4c37-8c6a-d8da15b083ae");
+    if (!device->connect() || !wait_connected(*device)) {
+      state.SkipWithError("failed to attach to the message hub");
+    }
+  }
+
+  const Data data(42.0);
+  for (auto _ : state) {
+    auto res = device->send_individual("org.astarte.Benchmark", "/sensor/value", data, nullptr);
+    if (!res) {
+      state.SkipWithError("send failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    if (device->is_connected()) {
+      (void)device->disconnect();
+    }
+    device.reset();
+    hub.reset();
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_GrpcSendIndividualConcurrent)
+    ->ThreadRange(1, 16)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+#endif
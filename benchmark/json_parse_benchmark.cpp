@@ -0,0 +1,164 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <array>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mqtt/interface.hpp"
+#include "mqtt/json_backend.hpp"
+
+using astarte::device::mqtt::Interface;
+namespace json_backend = astarte::device::mqtt::json_backend;
+using nlohmann::json;
+
+namespace {
+
+// Number of interfaces of the set, the size of the introspection of a large gateway device.
+constexpr int k_interfaces = 300;
+// Types of the mappings of each interface, one mapping for each Astarte type.
+constexpr std::array<std::string_view, 14> k_types{
+    "integer",          "longinteger", "double",       "boolean",     "string",
+    "binaryblob",       "datetime",    "integerarray", "longintegerarray",
+    "doublearray",      "booleanarray", "stringarray", "binaryblobarray",
+    "datetimearray"};
+
+// Builds an interface of the set, cycling through datastreams, aggregates and properties.
+auto make_interface(int index) -> std::string {
+  const auto kind = index % 3;
+  json mappings = json::array();
+  for (size_t i = 0; i < k_types.size(); i++) {
+    json mapping = {{"endpoint", kind == 2 ? "/%{sensor_id}/value" + std::to_string(i)
+                                           : "/%{sensor_id}/sample" + std::to_string(i)},
+                    {"type", k_types.at(i)},
+                    {"description", "Sample of the sensor, as read by the acquisition board."},
+                    {"doc", "The value is stored as received, without any calibration."}};
+    if (kind == 2) {
+      mapping["allow_unset"] = true;
+    } else {
+      mapping["explicit_timestamp"] = true;
+      mapping["reliability"] = "guaranteed";
+      mapping["retention"] = "stored";
+      mapping["expiry"] = 3600;
+      mapping["database_retention_policy"] = "use_ttl";
+      mapping["database_retention_ttl"] = 86400;
+    }
+    mappings.push_back(mapping);
+  }
+  return json{{"interface_name", "org.astarte-platform.bench.Interface" + std::to_string(index)},
+              {"version_major", 1},
+              {"version_minor", index % 10},
+              {"type", kind == 2 ? "properties" : "datastream"},
+              {"ownership", index % 2 == 0 ? "device" : "server"},
+              {"aggregation", kind == 1 ? "object" : "individual"},
+              {"description", "Interface generated for the parsing benchmarks."},
+              {"mappings", mappings}}
+      .dump(2);
+}
+
+auto make_interface_set() -> std::vector<std::string> {
+  std::vector<std::string> set;
+  set.reserve(k_interfaces);
+  for (int i = 0; i < k_interfaces; i++) {
+    set.push_back(make_interface(i));
+  }
+  return set;
+}
+
+auto set_bytes(const std::vector<std::string>& set) -> int64_t {
+  int64_t bytes = 0;
+  for (const auto& interface : set) {
+    bytes += static_cast<int64_t>(interface.size());
+  }
+  return bytes;
+}
+
+// Builds a pairing response carrying a certificate chain of the given size in kilobytes, followed
+// by unrelated fields the parser has to skip.
+auto make_pairing_response(int64_t kilobytes) -> std::string {
+  const std::string certificate = "-----BEGIN CERTIFICATE-----\n" +
+                                  std::string(static_cast<size_t>(kilobytes) * 1024, 'A') +
+                                  "\n-----END CERTIFICATE-----\n";
+  json extra = json::array();
+  for (int i = 0; i < 64; i++) {
+    extra.push_back({{"id", i}, {"name", "field" + std::to_string(i)}, {"enabled", true}});
+  }
+  return json{{"data", {{"client_crt", certificate}, {"extra", extra}}}}.dump();
+}
+
+// Parses the whole interface set with the backend selected at build time.
+void BM_ParseInterfaceSet(benchmark::State& state) {
+  const auto set = make_interface_set();
+  for (auto _ : state) {
+    for (const auto& interface : set) {
+      auto res = Interface::try_from_str(interface);
+      if (!res) {
+        state.SkipWithError("invalid interface");
+        return;
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetLabel(std::string(json_backend::name()));
+  state.SetItemsProcessed(state.iterations() * k_interfaces);
+  state.SetBytesProcessed(state.iterations() * set_bytes(set));
+}
+
+// Parses the whole interface set through an nlohmann::json DOM, as a baseline.
+void BM_ParseInterfaceSetDom(benchmark::State& state) {
+  const auto set = make_interface_set();
+  for (auto _ : state) {
+    for (const auto& interface : set) {
+      auto res = Interface::try_from_json(json::parse(interface));
+      if (!res) {
+        state.SkipWithError("invalid interface");
+        return;
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetLabel("nlohmann");
+  state.SetItemsProcessed(state.iterations() * k_interfaces);
+  state.SetBytesProcessed(state.iterations() * set_bytes(set));
+}
+
+// Extracts the certificate from a pairing response, the argument is its size in kilobytes.
+void BM_ParsePairingResponse(benchmark::State& state) {
+  const auto response = make_pairing_response(state.range(0));
+  for (auto _ : state) {
+    auto res = json_backend::value_at<std::string>(response, "/data/client_crt");
+    if (!res) {
+      state.SkipWithError("invalid response");
+      return;
+    }
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetLabel(std::string(json_backend::name()));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(response.size()));
+}
+
+void BM_ParsePairingResponseDom(benchmark::State& state) {
+  const auto response = make_pairing_response(state.range(0));
+  for (auto _ : state) {
+    auto res = json::parse(response).at("data").at("client_crt").get<std::string>();
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetLabel("nlohmann");
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(response.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_ParseInterfaceSet)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseInterfaceSetDom)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParsePairingResponse)->ArgName("kb")->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_ParsePairingResponseDom)->ArgName("kb")->RangeMultiplier(8)->Range(1, 512);
+
+#endif
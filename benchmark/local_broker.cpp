@@ -0,0 +1,452 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "local_broker.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace astarte::device::benchmark {
+
+namespace {
+
+// MQTT control packet types, as found in the upper nibble of the fixed header.
+constexpr uint8_t k_connect = 1;
+constexpr uint8_t k_publish = 3;
+constexpr uint8_t k_pubrel = 6;
+constexpr uint8_t k_subscribe = 8;
+constexpr uint8_t k_unsubscribe = 10;
+constexpr uint8_t k_pingreq = 12;
+constexpr uint8_t k_disconnect = 14;
+
+// Fixed headers of the packets sent by the broker.
+constexpr uint8_t k_connack = 0x20;
+constexpr uint8_t k_puback = 0x40;
+constexpr uint8_t k_pubrec = 0x50;
+constexpr uint8_t k_pubcomp = 0x70;
+constexpr uint8_t k_suback = 0x90;
+constexpr uint8_t k_unsuback = 0xB0;
+constexpr uint8_t k_pingresp = 0xD0;
+
+auto read_exact(int fd, uint8_t* buf, size_t len) -> bool {
+  while (len > 0) {
+    auto res = ::recv(fd, buf, len, 0);
+    if (res <= 0) {
+      return false;
+    }
+    buf += res;
+    len -= static_cast<size_t>(res);
+  }
+  return true;
+}
+
+auto write_all(int fd, const std::vector<uint8_t>& bytes) -> bool {
+  size_t sent = 0;
+  while (sent < bytes.size()) {
+    auto res = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+    if (res <= 0) {
+      return false;
+    }
+    sent += static_cast<size_t>(res);
+  }
+  return true;
+}
+
+// MQTT 5 properties used by the broker.
+constexpr uint8_t k_prop_topic_alias_maximum = 0x22;
+constexpr uint8_t k_prop_topic_alias = 0x23;
+
+constexpr uint8_t k_protocol_level_v5 = 5;
+
+// Acknowledgement carrying only the packet identifier.
+auto ack(uint8_t header, uint8_t id_msb, uint8_t id_lsb) -> std::vector<uint8_t> {
+  return {header, 2, id_msb, id_lsb};
+}
+
+auto read_u16(const std::vector<uint8_t>& body, size_t pos) -> uint16_t {
+  return static_cast<uint16_t>((body[pos] << 8U) | body[pos + 1]);
+}
+
+// Decodes a variable byte integer, advancing the position past it.
+auto read_varint(const std::vector<uint8_t>& body, size_t& pos) -> std::optional<size_t> {
+  size_t value = 0;
+  size_t multiplier = 1;
+  for (int i = 0; i < 4 && pos < body.size(); i++) {
+    auto encoded = body[pos++];
+    value += (encoded & 0x7FU) * multiplier;
+    multiplier *= 128;
+    if ((encoded & 0x80U) == 0) {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+auto varint_size(size_t value) -> size_t {
+  size_t size = 1;
+  while (value >= 128) {
+    value /= 128;
+    size++;
+  }
+  return size;
+}
+
+// Extracts the topic alias from a block of PUBLISH properties, zero if not present and
+// std::nullopt if the properties are malformed.
+auto find_topic_alias(const std::vector<uint8_t>& body, size_t pos, size_t end)
+    -> std::optional<uint16_t> {
+  uint16_t alias = 0;
+  while (pos < end) {
+    auto id = body[pos++];
+    size_t len = 0;
+    switch (id) {
+      case 0x01:  // Payload format indicator
+        len = 1;
+        break;
+      case 0x02:  // Message expiry interval
+        len = 4;
+        break;
+      case k_prop_topic_alias:
+        if (pos + 2 > end) {
+          return std::nullopt;
+        }
+        alias = read_u16(body, pos);
+        len = 2;
+        break;
+      case 0x03:  // Content type
+      case 0x08:  // Response topic
+      case 0x09:  // Correlation data
+        if (pos + 2 > end) {
+          return std::nullopt;
+        }
+        len = 2 + read_u16(body, pos);
+        break;
+      case 0x26:  // User property
+        if (pos + 2 > end) {
+          return std::nullopt;
+        }
+        len = 2 + read_u16(body, pos);
+        if (pos + len + 2 > end) {
+          return std::nullopt;
+        }
+        len += 2 + read_u16(body, pos + len);
+        break;
+      default:
+        return std::nullopt;
+    }
+    pos += len;
+  }
+  if (pos != end) {
+    return std::nullopt;
+  }
+  return alias;
+}
+
+}  // namespace
+
+LocalBroker::LocalBroker(std::chrono::microseconds ack_delay, uint16_t topic_alias_maximum)
+    : ack_delay_(ack_delay), topic_alias_maximum_(topic_alias_maximum) {
+  listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    throw std::runtime_error("failed to create the broker socket");
+  }
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* sock_addr = reinterpret_cast<sockaddr*>(&addr);
+  socklen_t addr_len = sizeof(addr);
+  if (::bind(listen_fd_, sock_addr, addr_len) != 0 || ::listen(listen_fd_, 8) != 0 ||
+      ::getsockname(listen_fd_, sock_addr, &addr_len) != 0) {
+    ::close(listen_fd_);
+    throw std::runtime_error("failed to bind the broker socket");
+  }
+  port_ = ntohs(addr.sin_port);
+
+  accept_thread_ = std::jthread([this](const std::stop_token& stoken) { accept_loop(stoken); });
+}
+
+LocalBroker::~LocalBroker() {
+  accept_thread_.request_stop();
+  ::shutdown(listen_fd_, SHUT_RDWR);
+  accept_thread_.join();
+  ::close(listen_fd_);
+
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
+  for (auto& session : sessions_) {
+    ::shutdown(session->fd, SHUT_RDWR);
+    {
+      std::lock_guard<std::mutex> session_lock(session->mutex);
+      session->closed = true;
+    }
+    session->cv.notify_all();
+  }
+  client_threads_.clear();
+  for (auto& session : sessions_) {
+    ::close(session->fd);
+  }
+}
+
+auto LocalBroker::url() const -> std::string {
+  return "tcp://127.0.0.1:" + std::to_string(port_);
+}
+
+void LocalBroker::accept_loop(const std::stop_token& stoken) {
+  while (!stoken.stop_requested()) {
+    int client_fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (client_fd < 0) {
+      return;
+    }
+    int nodelay = 1;
+    ::setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto& session = sessions_.emplace_back(std::make_unique<Session>());
+    session->fd = client_fd;
+    client_threads_.emplace_back([this, &client = *session]() { read_loop(client); });
+    client_threads_.emplace_back([&client = *session]() { write_loop(client); });
+  }
+}
+
+void LocalBroker::read_loop(Session& session) {
+  std::vector<uint8_t> body;
+  while (true) {
+    uint8_t header = 0;
+    if (!read_exact(session.fd, &header, 1)) {
+      break;
+    }
+
+    // Remaining length is a variable length integer of at most four bytes
+    size_t remaining = 0;
+    size_t multiplier = 1;
+    uint8_t encoded = 0;
+    bool valid = true;
+    for (int i = 0; i < 4; i++) {
+      if (!read_exact(session.fd, &encoded, 1)) {
+        valid = false;
+        break;
+      }
+      remaining += (encoded & 0x7FU) * multiplier;
+      multiplier *= 128;
+      if ((encoded & 0x80U) == 0) {
+        break;
+      }
+    }
+
+    body.resize(remaining);
+    if (!valid || !read_exact(session.fd, body.data(), remaining)) {
+      break;
+    }
+
+    if ((header >> 4U) == k_disconnect) {
+      break;
+    }
+    if (!handle_packet(session, header, body)) {
+      protocol_errors_.fetch_add(1);
+      ::shutdown(session.fd, SHUT_RDWR);
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    session.closed = true;
+  }
+  session.cv.notify_all();
+}
+
+void LocalBroker::write_loop(Session& session) {
+  std::unique_lock<std::mutex> lock(session.mutex);
+  while (true) {
+    session.cv.wait(lock, [&session] { return session.closed || !session.outgoing.empty(); });
+    if (session.closed) {
+      return;
+    }
+
+    auto deadline = session.outgoing.front().deadline;
+    if (std::chrono::steady_clock::now() < deadline) {
+      session.cv.wait_until(lock, deadline, [&session] { return session.closed; });
+      continue;
+    }
+
+    auto bytes = std::move(session.outgoing.front().bytes);
+    session.outgoing.pop_front();
+    lock.unlock();
+    bool sent = write_all(session.fd, bytes);
+    lock.lock();
+    if (!sent) {
+      return;
+    }
+  }
+}
+
+auto LocalBroker::handle_packet(Session& session, uint8_t header,
+                                const std::vector<uint8_t>& body) -> bool {
+  bool is_v5 = session.protocol_level == k_protocol_level_v5;
+  switch (header >> 4U) {
+    case k_connect: {
+      // The protocol level follows the protocol name "MQTT"
+      if (body.size() < 7) {
+        return false;
+      }
+      session.protocol_level = body[6];
+      if (session.protocol_level != k_protocol_level_v5) {
+        enqueue(session, {k_connack, 2, 0, 0}, false);
+        break;
+      }
+      std::vector<uint8_t> props;
+      if (topic_alias_maximum_ > 0) {
+        props = {k_prop_topic_alias_maximum, static_cast<uint8_t>(topic_alias_maximum_ >> 8U),
+                 static_cast<uint8_t>(topic_alias_maximum_ & 0xFFU)};
+      }
+      std::vector<uint8_t> connack{k_connack, static_cast<uint8_t>(3 + props.size()), 0, 0,
+                                   static_cast<uint8_t>(props.size())};
+      connack.insert(connack.end(), props.begin(), props.end());
+      enqueue(session, std::move(connack), false);
+      break;
+    }
+    case k_publish:
+      return handle_publish(session, header, body);
+    case k_pubrel:
+      if (body.size() >= 2) {
+        enqueue(session, ack(k_pubcomp, body[0], body[1]), true);
+      }
+      break;
+    case k_subscribe: {
+      if (body.size() < 2) {
+        return false;
+      }
+      size_t pos = 2;
+      if (is_v5) {
+        auto props_len = read_varint(body, pos);
+        if (!props_len) {
+          return false;
+        }
+        pos += props_len.value();
+      }
+      // Grant the requested QoS to every topic filter
+      std::vector<uint8_t> granted;
+      while (pos + 2 < body.size()) {
+        pos += 2 + read_u16(body, pos);
+        if (pos >= body.size()) {
+          return false;
+        }
+        granted.push_back(body[pos] & 0x03U);
+        pos++;
+      }
+      std::vector<uint8_t> suback{k_suback, 0, body[0], body[1]};
+      if (is_v5) {
+        suback.push_back(0);
+      }
+      suback.insert(suback.end(), granted.begin(), granted.end());
+      suback[1] = static_cast<uint8_t>(suback.size() - 2);
+      enqueue(session, std::move(suback), false);
+      break;
+    }
+    case k_unsubscribe: {
+      if (body.size() < 2) {
+        return false;
+      }
+      std::vector<uint8_t> unsuback{k_unsuback, 2, body[0], body[1]};
+      if (is_v5) {
+        size_t pos = 2;
+        auto props_len = read_varint(body, pos);
+        if (!props_len) {
+          return false;
+        }
+        pos += props_len.value();
+        // One success reason code for every topic filter
+        unsuback.push_back(0);
+        while (pos + 2 <= body.size()) {
+          pos += 2 + read_u16(body, pos);
+          unsuback.push_back(0);
+        }
+        unsuback[1] = static_cast<uint8_t>(unsuback.size() - 2);
+      }
+      enqueue(session, std::move(unsuback), false);
+      break;
+    }
+    case k_pingreq:
+      enqueue(session, {k_pingresp, 0}, false);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+auto LocalBroker::handle_publish(Session& session, uint8_t header,
+                                 const std::vector<uint8_t>& body) -> bool {
+  received_.fetch_add(1, std::memory_order_relaxed);
+  received_bytes_.fetch_add(1 + varint_size(body.size()) + body.size(), std::memory_order_relaxed);
+
+  if (body.size() < 2) {
+    return false;
+  }
+  auto qos = (header >> 1U) & 0x03U;
+  size_t topic_len = read_u16(body, 0);
+  size_t pos = 2 + topic_len;
+  if (qos > 0) {
+    pos += 2;
+  }
+  if (pos > body.size()) {
+    return false;
+  }
+
+  if (session.protocol_level == k_protocol_level_v5) {
+    auto props_len = read_varint(body, pos);
+    if (!props_len || pos + props_len.value() > body.size()) {
+      return false;
+    }
+    auto alias = find_topic_alias(body, pos, pos + props_len.value());
+    if (!alias || alias.value() > topic_alias_maximum_) {
+      return false;
+    }
+    if (alias.value() != 0 && topic_len > 0) {
+      auto topic_begin = body.begin() + 2;
+      session.topic_aliases[alias.value()] = std::string(topic_begin, topic_begin + topic_len);
+    } else if (alias.value() != 0 && !session.topic_aliases.contains(alias.value())) {
+      return false;
+    } else if (alias.value() == 0 && topic_len == 0) {
+      return false;
+    }
+  } else if (topic_len == 0) {
+    return false;
+  }
+
+  if (qos > 0) {
+    auto id_msb = body[2 + topic_len];
+    auto id_lsb = body[2 + topic_len + 1];
+    enqueue(session, ack(qos == 1 ? k_puback : k_pubrec, id_msb, id_lsb), true);
+  }
+  return true;
+}
+
+void LocalBroker::enqueue(Session& session, std::vector<uint8_t> bytes, bool delayed) const {
+  auto deadline = std::chrono::steady_clock::now();
+  if (delayed) {
+    deadline += ack_delay_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    session.outgoing.push_back({deadline, std::move(bytes)});
+  }
+  session.cv.notify_one();
+}
+
+}  // namespace astarte::device::benchmark
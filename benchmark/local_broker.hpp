@@ -0,0 +1,175 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_BENCHMARK_LOCAL_BROKER_H
+#define ASTARTE_BENCHMARK_LOCAL_BROKER_H
+
+/**
+ * @file benchmark/local_broker.hpp
+ * @brief Minimal in-process MQTT broker stand-in used by the benchmarks.
+ *
+ * @details The broker accepts plain TCP connections on the loopback interface and implements just
+ * enough of MQTT 3.1.1 and MQTT 5 to acknowledge connections, subscriptions and publishes. Messages
+ * are counted and dropped. Acknowledgements can be delayed by a fixed amount of time to emulate the
+ * round trip time of a real network link, without blocking the reception of further packets.
+ * MQTT 5 topic aliases are validated, a publish using an unknown alias closes the connection.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace astarte::device::benchmark {
+
+/**
+ * @brief MQTT broker stand-in listening on the loopback interface.
+ */
+class LocalBroker {
+ public:
+  /**
+   * @brief Starts the broker on an ephemeral port.
+   * @param[in] ack_delay Delay applied to every acknowledgement sent to the clients.
+   * @param[in] topic_alias_maximum Topic alias maximum advertised to MQTT 5 clients.
+   */
+  explicit LocalBroker(std::chrono::microseconds ack_delay = std::chrono::microseconds(0),
+                       uint16_t topic_alias_maximum = 0);
+
+  /// @brief Stops the broker and closes all the client connections.
+  ~LocalBroker();
+
+  /// @brief LocalBroker is non-copyable.
+  LocalBroker(const LocalBroker&) = delete;
+  /// @brief LocalBroker is non-movable.
+  LocalBroker(LocalBroker&&) = delete;
+  /// @brief LocalBroker is non-copyable.
+  auto operator=(const LocalBroker&) -> LocalBroker& = delete;
+  /// @brief LocalBroker is non-movable.
+  auto operator=(LocalBroker&&) -> LocalBroker& = delete;
+
+  /**
+   * @brief Gets the URL clients should use to connect to the broker.
+   * @return The broker URL in the form tcp://127.0.0.1:<port>.
+   */
+  [[nodiscard]] auto url() const -> std::string;
+
+  /**
+   * @brief Gets the number of PUBLISH packets received since the broker was started.
+   * @return The number of received messages.
+   */
+  [[nodiscard]] auto received() const -> uint64_t { return received_.load(); }
+
+  /**
+   * @brief Gets the number of bytes of the PUBLISH packets received since the broker was started.
+   * @return The number of received bytes, including the packets headers.
+   */
+  [[nodiscard]] auto received_bytes() const -> uint64_t { return received_bytes_.load(); }
+
+  /**
+   * @brief Gets the number of connections closed because of a protocol violation.
+   * @return The number of protocol errors.
+   */
+  [[nodiscard]] auto protocol_errors() const -> uint64_t { return protocol_errors_.load(); }
+
+ private:
+  /// @brief Packet queued for transmission at a given instant.
+  struct Outgoing {
+    /// @brief Instant after which the packet can be transmitted.
+    std::chrono::steady_clock::time_point deadline;
+    /// @brief Encoded packet.
+    std::vector<uint8_t> bytes;
+  };
+
+  /// @brief Per client session state.
+  struct Session {
+    /// @brief Socket connected to the client.
+    int fd;
+    /// @brief Guards the outgoing queue.
+    std::mutex mutex;
+    /// @brief Signals new outgoing packets or the session termination.
+    std::condition_variable cv;
+    /// @brief Packets waiting to be transmitted, ordered by deadline.
+    std::deque<Outgoing> outgoing;
+    /// @brief True when the session has been closed.
+    bool closed{false};
+    /// @brief Protocol level sent by the client in the CONNECT packet.
+    uint8_t protocol_level{0};
+    /// @brief Topic aliases established by the client.
+    std::unordered_map<uint16_t, std::string> topic_aliases;
+  };
+
+  /**
+   * @brief Accepts new clients until the broker is stopped.
+   * @param[in] stoken Token used to stop the loop.
+   */
+  void accept_loop(const std::stop_token& stoken);
+  /**
+   * @brief Reads and handles packets from a client.
+   * @param[in,out] session The client session.
+   */
+  void read_loop(Session& session);
+  /**
+   * @brief Transmits the queued packets to a client once their deadline expires.
+   * @param[in,out] session The client session.
+   */
+  static void write_loop(Session& session);
+  /**
+   * @brief Handles a single packet received from a client.
+   * @param[in,out] session The client session.
+   * @param[in] header The first byte of the fixed header.
+   * @param[in] body The variable header and payload of the packet.
+   * @return False if the packet violates the protocol and the connection must be closed.
+   */
+  auto handle_packet(Session& session, uint8_t header, const std::vector<uint8_t>& body) -> bool;
+  /**
+   * @brief Handles a PUBLISH packet received from a client.
+   * @param[in,out] session The client session.
+   * @param[in] header The first byte of the fixed header.
+   * @param[in] body The variable header and payload of the packet.
+   * @return False if the packet violates the protocol and the connection must be closed.
+   */
+  auto handle_publish(Session& session, uint8_t header, const std::vector<uint8_t>& body) -> bool;
+  /**
+   * @brief Queues a packet for transmission.
+   * @param[in,out] session The client session.
+   * @param[in] bytes The encoded packet.
+   * @param[in] delayed True if the packet is an acknowledgement subject to the configured delay.
+   */
+  void enqueue(Session& session, std::vector<uint8_t> bytes, bool delayed) const;
+
+  /// @brief Delay applied to acknowledgements.
+  std::chrono::microseconds ack_delay_;
+  /// @brief Topic alias maximum advertised to MQTT 5 clients.
+  uint16_t topic_alias_maximum_;
+  /// @brief Listening socket.
+  int listen_fd_{-1};
+  /// @brief Port the broker listens on.
+  uint16_t port_{0};
+  /// @brief Number of received PUBLISH packets.
+  std::atomic<uint64_t> received_{0};
+  /// @brief Number of received PUBLISH bytes.
+  std::atomic<uint64_t> received_bytes_{0};
+  /// @brief Number of protocol violations.
+  std::atomic<uint64_t> protocol_errors_{0};
+  /// @brief Guards the sessions and client threads.
+  std::mutex sessions_mutex_;
+  /// @brief Active client sessions.
+  std::vector<std::unique_ptr<Session>> sessions_;
+  /// @brief Threads serving the client sessions.
+  std::vector<std::jthread> client_threads_;
+  /// @brief Thread accepting new clients.
+  std::jthread accept_thread_;
+};
+
+}  // namespace astarte::device::benchmark
+
+#endif  // ASTARTE_BENCHMARK_LOCAL_BROKER_H
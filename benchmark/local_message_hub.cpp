@@ -0,0 +1,78 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "local_message_hub.hpp"
+
+#include <astarteplatform/msghub/message_hub_service.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace astarte::device::benchmark {
+
+namespace {
+
+// Interval at which attached streams check for client cancellation.
+constexpr auto k_attach_poll_interval = std::chrono::milliseconds(50);
+
+}  // namespace
+
+LocalMessageHub::LocalMessageHub() {
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port_);
+  builder.RegisterService(this);
+  server_ = builder.BuildAndStart();
+}
+
+LocalMessageHub::~LocalMessageHub() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  detached_.notify_all();
+  server_->Shutdown();
+  server_->Wait();
+}
+
+auto LocalMessageHub::address() const -> std::string {
+  return "127.0.0.1:" + std::to_string(port_);
+}
+
+auto LocalMessageHub::Attach(grpc::ServerContext* context,
+                             const astarteplatform::msghub::Node* /*request*/,
+                             grpc::ServerWriter<astarteplatform::msghub::MessageHubEvent>* writer)
+    -> grpc::Status {
+  // The device refuses the attach when the server sends no initial metadata
+  context->AddInitialMetadata("node-id", "benchmark");
+  writer->SendInitialMetadata();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  const uint64_t generation = generation_;
+  while (running_ && generation == generation_ && !context->IsCancelled()) {
+    detached_.wait_for(lock, k_attach_poll_interval);
+  }
+  return grpc::Status::OK;
+}
+
+auto LocalMessageHub::Send(grpc::ServerContext* /*context*/,
+                           const astarteplatform::msghub::AstarteMessage* /*request*/,
+                           google::protobuf::Empty* /*response*/) -> grpc::Status {
+  received_++;
+  return grpc::Status::OK;
+}
+
+auto LocalMessageHub::Detach(grpc::ServerContext* /*context*/,
+                             const google::protobuf::Empty* /*request*/,
+                             google::protobuf::Empty* /*response*/) -> grpc::Status {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+  }
+  detached_.notify_all();
+  return grpc::Status::OK;
+}
+
+}  // namespace astarte::device::benchmark
@@ -0,0 +1,113 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_BENCHMARK_LOCAL_MESSAGE_HUB_H
+#define ASTARTE_BENCHMARK_LOCAL_MESSAGE_HUB_H
+
+/**
+ * @file benchmark/local_message_hub.hpp
+ * @brief Minimal in-process Astarte message hub stand-in used by the benchmarks.
+ *
+ * @details The message hub listens on the loopback interface and implements the Attach, Send and
+ * Detach RPCs. Attached nodes are kept attached until they detach or the hub is stopped, sent
+ * messages are counted and dropped.
+ */
+
+#include <astarteplatform/msghub/message_hub_service.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace astarte::device::benchmark {
+
+/**
+ * @brief Astarte message hub stand-in listening on the loopback interface.
+ */
+class LocalMessageHub final : public astarteplatform::msghub::MessageHub::Service {
+ public:
+  /**
+   * @brief Starts the message hub on an ephemeral port.
+   */
+  LocalMessageHub();
+
+  /// @brief Stops the message hub and releases all the attached nodes.
+  ~LocalMessageHub() override;
+
+  /// @brief LocalMessageHub is non-copyable.
+  LocalMessageHub(const LocalMessageHub&) = delete;
+  /// @brief LocalMessageHub is non-movable.
+  LocalMessageHub(LocalMessageHub&&) = delete;
+  /// @brief LocalMessageHub is non-copyable.
+  auto operator=(const LocalMessageHub&) -> LocalMessageHub& = delete;
+  /// @brief LocalMessageHub is non-movable.
+  auto operator=(LocalMessageHub&&) -> LocalMessageHub& = delete;
+
+  /**
+   * @brief Gets the address clients should use to connect to the message hub.
+   * @return The message hub address in the form 127.0.0.1:<port>.
+   */
+  [[nodiscard]] auto address() const -> std::string;
+
+  /**
+   * @brief Gets the number of messages received since the message hub was started.
+   * @return The number of received messages.
+   */
+  [[nodiscard]] auto received() const -> uint64_t { return received_.load(); }
+
+  /**
+   * @brief Attaches a node, keeping the events stream open until the node detaches.
+   * @param[in] context The server context of the call.
+   * @param[in] request The node to attach.
+   * @param[in,out] writer The events stream, no event is ever written.
+   * @return The status of the call.
+   */
+  auto Attach(::grpc::ServerContext* context, const astarteplatform::msghub::Node* request,
+              ::grpc::ServerWriter<astarteplatform::msghub::MessageHubEvent>* writer)
+      -> ::grpc::Status override;
+
+  /**
+   * @brief Receives a message from an attached node.
+   * @param[in] context The server context of the call.
+   * @param[in] request The received message.
+   * @param[out] response Empty response.
+   * @return The status of the call.
+   */
+  auto Send(::grpc::ServerContext* context, const astarteplatform::msghub::AstarteMessage* request,
+            google::protobuf::Empty* response) -> ::grpc::Status override;
+
+  /**
+   * @brief Detaches a node, closing its events stream.
+   * @param[in] context The server context of the call.
+   * @param[in] request Empty request.
+   * @param[out] response Empty response.
+   * @return The status of the call.
+   */
+  auto Detach(::grpc::ServerContext* context, const google::protobuf::Empty* request,
+              google::protobuf::Empty* response) -> ::grpc::Status override;
+
+ private:
+  /// @brief Port the server is bound to.
+  int port_{0};
+  /// @brief The gRPC server.
+  std::unique_ptr<::grpc::Server> server_;
+  /// @brief Number of received messages.
+  std::atomic<uint64_t> received_{0};
+  /// @brief Guards the attached state.
+  std::mutex mutex_;
+  /// @brief Signaled when a node detaches or the hub stops.
+  std::condition_variable detached_;
+  /// @brief Incremented on every detach, wakes the attached streams.
+  uint64_t generation_{0};
+  /// @brief True while the hub is running.
+  bool running_{true};
+};
+
+}  // namespace astarte::device::benchmark
+
+#endif  // ASTARTE_BENCHMARK_LOCAL_MESSAGE_HUB_H
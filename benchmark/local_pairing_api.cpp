@@ -0,0 +1,163 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "local_pairing_api.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace astarte::device::benchmark {
+
+namespace {
+
+// Upper bound to the size of the request headers.
+constexpr size_t k_max_header_size = 16 * 1024;
+
+constexpr std::string_view k_header_end = "\r\n\r\n";
+constexpr std::string_view k_content_length = "content-length:";
+
+auto write_all(int fd, std::string_view bytes) -> bool {
+  while (!bytes.empty()) {
+    auto res = ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+    if (res <= 0) {
+      return false;
+    }
+    bytes.remove_prefix(static_cast<size_t>(res));
+  }
+  return true;
+}
+
+// Reads a request, returning its header lines. The body is read and discarded.
+auto read_request(int fd) -> std::string {
+  std::string request;
+  char buf[4096];
+  size_t header_size = std::string::npos;
+  while (header_size == std::string::npos) {
+    if (request.size() > k_max_header_size) {
+      return {};
+    }
+    auto res = ::recv(fd, buf, sizeof(buf), 0);
+    if (res <= 0) {
+      return {};
+    }
+    request.append(buf, static_cast<size_t>(res));
+    header_size = request.find(k_header_end);
+  }
+
+  std::string lower(request.substr(0, header_size));
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char chr) { return static_cast<char>(std::tolower(chr)); });
+  size_t body_size = 0;
+  if (auto pos = lower.find(k_content_length); pos != std::string::npos) {
+    body_size = std::stoul(lower.substr(pos + k_content_length.size()));
+  }
+
+  size_t received = request.size() - header_size - k_header_end.size();
+  while (received < body_size) {
+    auto res = ::recv(fd, buf, std::min(sizeof(buf), body_size - received), 0);
+    if (res <= 0) {
+      return {};
+    }
+    received += static_cast<size_t>(res);
+  }
+  request.resize(header_size);
+  return request;
+}
+
+auto http_response(std::string_view status, std::string_view body) -> std::string {
+  std::string response = "HTTP/1.1 ";
+  response.append(status)
+      .append("\r\nContent-Type: application/json\r\nContent-Length: ")
+      .append(std::to_string(body.size()))
+      .append("\r\nConnection: close\r\n\r\n")
+      .append(body);
+  return response;
+}
+
+}  // namespace
+
+LocalPairingApi::LocalPairingApi(std::string broker_url) : broker_url_(std::move(broker_url)) {
+  listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    throw std::runtime_error("failed to create the pairing API socket");
+  }
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* sock_addr = reinterpret_cast<sockaddr*>(&addr);
+  socklen_t addr_len = sizeof(addr);
+  if (::bind(listen_fd_, sock_addr, addr_len) != 0 || ::listen(listen_fd_, 8) != 0 ||
+      ::getsockname(listen_fd_, sock_addr, &addr_len) != 0) {
+    ::close(listen_fd_);
+    throw std::runtime_error("failed to bind the pairing API socket");
+  }
+  port_ = ntohs(addr.sin_port);
+
+  serve_thread_ = std::jthread([this](const std::stop_token& stoken) { serve_loop(stoken); });
+}
+
+LocalPairingApi::~LocalPairingApi() {
+  serve_thread_.request_stop();
+  ::shutdown(listen_fd_, SHUT_RDWR);
+  serve_thread_.join();
+  ::close(listen_fd_);
+}
+
+auto LocalPairingApi::url() const -> std::string {
+  return "http://127.0.0.1:" + std::to_string(port_);
+}
+
+void LocalPairingApi::serve_loop(const std::stop_token& stoken) {
+  while (!stoken.stop_requested()) {
+    int client_fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (client_fd < 0) {
+      return;
+    }
+
+    // The request line is "<method> <target> HTTP/1.1"
+    const auto request = read_request(client_fd);
+    const std::string_view request_line(request.data(), request.find("\r\n"));
+    const auto method_end = request_line.find(' ');
+    const auto target_end = request_line.find(' ', method_end + 1);
+    if (method_end != std::string_view::npos && target_end != std::string_view::npos) {
+      requests_.fetch_add(1);
+      write_all(client_fd, respond(request_line.substr(0, method_end),
+                                   request_line.substr(method_end + 1,
+                                                       target_end - method_end - 1)));
+    }
+    ::close(client_fd);
+  }
+}
+
+auto LocalPairingApi::respond(std::string_view method, std::string_view target) const
+    -> std::string {
+  if (method == "POST" && target.ends_with("/protocols/astarte_mqtt_v1/credentials/verify")) {
+    return http_response("200 OK", R"({"data":{"valid":true}})");
+  }
+  if (method == "POST" && target.ends_with("/protocols/astarte_mqtt_v1/credentials")) {
+    // The broker stand-in does not use TLS, the certificate is never parsed
+    return http_response("201 Created", R"({"data":{"client_crt":"placeholder"}})");
+  }
+  if (method == "GET" && target.find("/devices/") != std::string_view::npos) {
+    return http_response(
+        "200 OK", R"({"data":{"protocols":{"astarte_mqtt_v1":{"broker_url":")" + broker_url_ +
+                      R"("}},"version":"1.2.0","status":"connected"}})");
+  }
+  return http_response("404 Not Found", R"({"errors":{"detail":"Not Found"}})");
+}
+
+}  // namespace astarte::device::benchmark
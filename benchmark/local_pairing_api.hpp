@@ -0,0 +1,91 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_BENCHMARK_LOCAL_PAIRING_API_H
+#define ASTARTE_BENCHMARK_LOCAL_PAIRING_API_H
+
+/**
+ * @file benchmark/local_pairing_api.hpp
+ * @brief Minimal in-process Astarte pairing API stand-in used by the benchmarks.
+ *
+ * @details The pairing API listens for plain HTTP/1.1 requests on the loopback interface and
+ * answers the requests performed by the MQTT device when connecting: the broker URL, the device
+ * certificate and the certificate verification. Every request is accepted, the returned certificate
+ * is a placeholder since the broker stand-in does not use TLS.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace astarte::device::benchmark {
+
+/**
+ * @brief Astarte pairing API stand-in listening on the loopback interface.
+ */
+class LocalPairingApi {
+ public:
+  /**
+   * @brief Starts the pairing API on an ephemeral port.
+   * @param[in] broker_url The broker URL returned to the devices.
+   */
+  explicit LocalPairingApi(std::string broker_url);
+
+  /// @brief Stops the pairing API.
+  ~LocalPairingApi();
+
+  /// @brief LocalPairingApi is non-copyable.
+  LocalPairingApi(const LocalPairingApi&) = delete;
+  /// @brief LocalPairingApi is non-movable.
+  LocalPairingApi(LocalPairingApi&&) = delete;
+  /// @brief LocalPairingApi is non-copyable.
+  auto operator=(const LocalPairingApi&) -> LocalPairingApi& = delete;
+  /// @brief LocalPairingApi is non-movable.
+  auto operator=(LocalPairingApi&&) -> LocalPairingApi& = delete;
+
+  /**
+   * @brief Gets the base URL devices should be configured with.
+   * @return The base URL in the form http://127.0.0.1:<port>.
+   */
+  [[nodiscard]] auto url() const -> std::string;
+
+  /**
+   * @brief Gets the number of requests served since the pairing API was started.
+   * @return The number of requests, including the rejected ones.
+   */
+  [[nodiscard]] auto requests() const -> uint64_t { return requests_.load(); }
+
+ private:
+  /**
+   * @brief Serves the clients one request at a time until the pairing API is stopped.
+   * @param[in] stoken Token used to stop the loop.
+   */
+  void serve_loop(const std::stop_token& stoken);
+  /**
+   * @brief Builds the response to a request.
+   * @param[in] method The HTTP method of the request.
+   * @param[in] target The request target.
+   * @return The complete HTTP response.
+   */
+  [[nodiscard]] auto respond(std::string_view method, std::string_view target) const
+      -> std::string;
+
+  /// @brief Broker URL returned to the devices.
+  std::string broker_url_;
+  /// @brief Listening socket.
+  int listen_fd_{-1};
+  /// @brief Port the pairing API listens on.
+  uint16_t port_{0};
+  /// @brief Number of served requests.
+  std::atomic<uint64_t> requests_{0};
+  /// @brief Thread serving the requests.
+  std::jthread serve_thread_;
+};
+
+}  // namespace astarte::device::benchmark
+
+#endif  // ASTARTE_BENCHMARK_LOCAL_PAIRING_API_H
@@ -0,0 +1,190 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <mqtt/async_client.h>
+#include <mqtt/message.h>
+#include <mqtt/properties.h>
+#include <mqtt/token.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "astarte_device_sdk/mqtt/config.hpp"
+#include "local_broker.hpp"
+#include "mqtt/connection/options.hpp"
+#include "mqtt/connection/topic_alias.hpp"
+
+using astarte::device::benchmark::LocalBroker;
+using astarte::device::mqtt::Config;
+using astarte::device::mqtt::connection::build_connect_options;
+using astarte::device::mqtt::connection::build_create_options;
+using astarte::device::mqtt::connection::TopicAliasCache;
+
+namespace paho_mqtt = ::mqtt;
+
+namespace {
+
+// Messages published in each benchmark iteration before waiting for their acknowledgement.
+constexpr int64_t k_batch = 2000;
+// Size of the payload of each message, similar to a BSON serialized individual.
+constexpr size_t k_payload_size = 64;
+// Size of the payload of a small scalar sample, such as a BSON serialized double.
+constexpr size_t k_small_payload_size = 24;
+// Topic alias maximum advertised by the broker stand-in.
+constexpr uint16_t k_broker_topic_alias_maximum = 64;
+
+auto make_config(int64_t max_inflight) -> Config {
+  auto cfg = Config::with_credential_secret("realm", "device_id", "secret",
+                                            "http://localhost:4003", "/tmp");
+  cfg.max_inflight(static_cast<uint32_t>(max_inflight));
+  return cfg;
+}
+
+// Publishes QoS 1 messages as fast as the client allows, arguments are the in-flight window and the
+// emulated broker round trip time in microseconds.
+void BM_MqttPublishQos1(benchmark::State& state) {
+  LocalBroker broker(std::chrono::microseconds(state.range(1)));
+  auto cfg = make_config(state.range(0));
+  auto conn_opts = build_connect_options(cfg);
+  if (!conn_opts) {
+    state.SkipWithError("invalid connection options");
+    return;
+  }
+
+  paho_mqtt::async_client client(broker.url(), "realm/device_id", build_create_options(cfg));
+  client.connect(conn_opts.value())->wait();
+
+  const std::string topic = "realm/device_id/org.astarte.Benchmark/sensor/value";
+  const std::vector<uint8_t> payload(k_payload_size, 0xAB);
+  std::vector<paho_mqtt::delivery_token_ptr> tokens;
+  tokens.reserve(k_batch);
+
+  for (auto _ : state) {
+    tokens.clear();
+    for (int64_t i = 0; i < k_batch; i++) {
+      tokens.push_back(client.publish(topic, payload.data(), payload.size(), 1, false));
+    }
+    for (auto& token : tokens) {
+      token->wait();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * k_batch);
+  client.disconnect()->wait();
+}
+
+// Publishes a single QoS 1 message at a time waiting for its acknowledgement, as done by the
+// device send methods. The in-flight window has no effect on this access pattern.
+void BM_MqttPublishQos1Blocking(benchmark::State& state) {
+  LocalBroker broker(std::chrono::microseconds(state.range(1)));
+  auto cfg = make_config(state.range(0));
+  auto conn_opts = build_connect_options(cfg);
+  if (!conn_opts) {
+    state.SkipWithError("invalid connection options");
+    return;
+  }
+
+  paho_mqtt::async_client client(broker.url(), "realm/device_id", build_create_options(cfg));
+  client.connect(conn_opts.value())->wait();
+
+  const std::string topic = "realm/device_id/org.astarte.Benchmark/sensor/value";
+  const std::vector<uint8_t> payload(k_payload_size, 0xAB);
+
+  for (auto _ : state) {
+    client.publish(topic, payload.data(), payload.size(), 1, false)->wait();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  client.disconnect()->wait();
+}
+
+// Publishes small QoS 0 messages round robin over a set of topics, arguments are whether MQTT 5
+// topic aliases are enabled and the number of distinct topics. Reports the bytes per message
+// received by the broker.
+void BM_MqttPublishTopicAlias(benchmark::State& state) {
+  bool aliases_enabled = state.range(0) != 0;
+  auto topics_count = state.range(1);
+
+  LocalBroker broker(std::chrono::microseconds(0), k_broker_topic_alias_maximum);
+  auto cfg = make_config(100);
+  cfg.mqtt_v5(true).topic_alias_maximum(aliases_enabled ? k_broker_topic_alias_maximum : 0);
+  auto conn_opts = build_connect_options(cfg);
+  if (!conn_opts) {
+    state.SkipWithError("invalid connection options");
+    return;
+  }
+
+  paho_mqtt::async_client client(broker.url(), "realm/device_id", build_create_options(cfg));
+  client.connect(conn_opts.value())->wait();
+
+  // Same aliasing scheme used by the MQTT connection of the device
+  TopicAliasCache aliases;
+  aliases.reset(std::min(k_broker_topic_alias_maximum, cfg.topic_alias_maximum()));
+
+  std::vector<std::string> topics;
+  for (int64_t i = 0; i < topics_count; i++) {
+    topics.push_back("realm/device_id/org.astarte.Benchmark/sensor" + std::to_string(i) + "/value");
+  }
+  const std::vector<uint8_t> payload(k_small_payload_size, 0xAB);
+  std::vector<paho_mqtt::delivery_token_ptr> tokens;
+  tokens.reserve(k_batch);
+
+  for (auto _ : state) {
+    tokens.clear();
+    for (int64_t i = 0; i < k_batch; i++) {
+      const auto& topic = topics[static_cast<size_t>(i % topics_count)];
+      auto alias = aliases.lookup(topic, 0);
+      if (!alias) {
+        tokens.push_back(client.publish(topic, payload.data(), payload.size(), 0, false));
+        continue;
+      }
+      paho_mqtt::properties props{
+          paho_mqtt::property(paho_mqtt::property::TOPIC_ALIAS, static_cast<int>(alias->value))};
+      tokens.push_back(client.publish(paho_mqtt::message::create(
+          alias->established ? std::string() : topic, payload.data(), payload.size(), 0, false,
+          props)));
+    }
+    for (auto& token : tokens) {
+      token->wait();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * k_batch);
+  client.disconnect()->wait();
+
+  if (broker.protocol_errors() > 0) {
+    state.SkipWithError("the broker detected a protocol violation");
+    return;
+  }
+  state.counters["bytes_per_msg"] = static_cast<double>(broker.received_bytes()) /
+                                    static_cast<double>(std::max<uint64_t>(broker.received(), 1));
+}
+
+}  // namespace
+
+BENCHMARK(BM_MqttPublishQos1)
+    ->ArgNames({"max_inflight", "rtt_us"})
+    ->ArgsProduct({{1, 10, 100, 1000}, {0, 500}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_MqttPublishQos1Blocking)
+    ->ArgNames({"max_inflight", "rtt_us"})
+    ->ArgsProduct({{1, 100}, {0, 500}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_MqttPublishTopicAlias)
+    ->ArgNames({"aliases", "topics"})
+    ->ArgsProduct({{0, 1}, {8, 256}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+#endif
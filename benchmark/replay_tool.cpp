@@ -0,0 +1,94 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Replays a capture file against a gRPC device attached to an in-process message hub, printing
+// the throughput and latency of the replay.
+//
+// Usage: benchmark_replay <capture file> [--speed <factor>] [--keep-timestamps]
+//
+// A speed of 1 replays the capture at its original pace, 0 replays it as fast as possible.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "astarte_device_sdk/capture.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/grpc/device_grpc.hpp"
+#include "local_message_hub.hpp"
+
+using astarte::device::benchmark::LocalMessageHub;
+using astarte::device::grpc::DeviceGrpc;
+namespace capture = astarte::device::capture;
+
+namespace {
+
+// Maximum time waited for the device to attach to the message hub.
+constexpr auto k_connect_timeout = std::chrono::seconds(10);
+// Interval at which the connection state of the device is polled.
+constexpr auto k_connect_poll_interval = std::chrono::milliseconds(10);
+
+auto wait_connected(const DeviceGrpc& dev) -> bool {
+  const auto deadline = std::chrono::steady_clock::now() + k_connect_timeout;
+  while (!dev.is_connected()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(k_connect_poll_interval);
+  }
+  return true;
+}
+
+void usage(std::string_view program) {
+  std::cerr << "Usage: " << program << " <capture file> [--speed <factor>] [--keep-timestamps]\n";
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 2) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  capture::ReplayOptions options;
+  for (int i = 2; i < argc; i++) {
+    const std::string_view arg(argv[i]);
+    if (arg == "--speed" && i + 1 < argc) {
+      options.speed = std::stod(argv[++i]);
+    } else if (arg == "--keep-timestamps") {
+      options.shift_timestamps = false;
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto recorded = capture::read_file(argv[1]);
+  if (!recorded) {
+    std::cerr << "Failed to read the capture: " << astarte_fmt::format("{}", recorded.error())
+              << "\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "Replaying " << recorded->sends.size() << " sends at speed " << options.speed
+            << "\n";
+
+  LocalMessageHub hub;
+  DeviceGrpc device(hub.address(), "aa04dade-9401-4c37-8c6a-d8da15b083ae");
+  if (!device.connect() || !wait_connected(device)) {
+    std::cerr << "Failed to attach to the message hub\n";
+    return EXIT_FAILURE;
+  }
+
+  auto report = capture::replay(device, recorded.value(), options);
+  (void)device.disconnect();
+
+  capture::write_report(std::cout, report);
+  std::cout << "hub received: " << hub.received() << "\n";
+  return EXIT_SUCCESS;
+}
@@ -9,13 +9,18 @@ include_guard(GLOBAL)
 # Defines MQTT-specific CMake options and displays them.
 function(astarte_sdk_add_mqtt_options)
     option(ASTARTE_USE_SYSTEM_MQTT "Use the system installed MQTT library" OFF)
+    option(ASTARTE_USE_SIMDJSON "Parse interfaces and pairing responses with simdjson" OFF)
 
     message(STATUS "  MQTT Options:")
     message(STATUS "    ASTARTE_USE_SYSTEM_MQTT: ${ASTARTE_USE_SYSTEM_MQTT}")
+    message(STATUS "    ASTARTE_USE_SIMDJSON: ${ASTARTE_USE_SIMDJSON}")
 endfunction()
 
 # Finds and/or downloads the dependencies required for MQTT transport.
 function(astarte_sdk_configure_mqtt_dependencies)
+    # Compression library, used by the list of the set server properties
+    find_package(ZLIB REQUIRED)
+
     # Fetch and configure the Paho C++ library
     if(ASTARTE_USE_SYSTEM_MQTT)
         find_package(PahoMqttCpp REQUIRED)
@@ -27,6 +32,10 @@ function(astarte_sdk_configure_mqtt_dependencies)
         if(NOT TARGET ada::ada)
             find_package(ada REQUIRED)
         endif()
+
+        if(ASTARTE_USE_SIMDJSON)
+            find_package(simdjson REQUIRED)
+        endif()
     else()
         FetchContent_Declare(
             paho-mqtt-cpp
@@ -51,6 +60,18 @@ function(astarte_sdk_configure_mqtt_dependencies)
         FetchContent_Declare(json URL ${JSON_GIT_URL})
         FetchContent_MakeAvailable(json)
 
+        # Optional faster json parser
+        if(ASTARTE_USE_SIMDJSON)
+            set(SIMDJSON_GIT_REPOSITORY https://github.com/simdjson/simdjson.git)
+            set(SIMDJSON_GIT_TAG v3.10.1)
+            FetchContent_Declare(
+                simdjson
+                GIT_REPOSITORY ${SIMDJSON_GIT_REPOSITORY}
+                GIT_TAG ${SIMDJSON_GIT_TAG}
+            )
+            FetchContent_MakeAvailable(simdjson)
+        endif()
+
         # Library to manage url
         set(URL_GIT_REPOSITORY https://github.com/ada-url/ada.git)
         set(URL_GIT_TAG v3.2.4)
@@ -105,35 +126,53 @@ function(
         ${ASTARTE_MQTT_SOURCES}
         "src/mqtt/connection/callbacks.cpp"
         "src/mqtt/connection/connection.cpp"
+        "src/mqtt/connection/duplicate_filter.cpp"
         "src/mqtt/connection/listener.cpp"
+        "src/mqtt/connection/options.cpp"
+        "src/mqtt/connection/topic_alias.cpp"
+        "src/mqtt/connection/topic_router.cpp"
         "src/mqtt/config.cpp"
         "src/mqtt/credentials.cpp"
         "src/mqtt/crypto.cpp"
+        "src/mqtt/deserialize.cpp"
         "src/mqtt/device_mqtt_impl.cpp"
         "src/mqtt/device_mqtt.cpp"
         "src/mqtt/errors.cpp"
         "src/mqtt/interface.cpp"
         "src/mqtt/introspection.cpp"
+        "src/mqtt/json_backend.cpp"
         "src/mqtt/mapping.cpp"
         "src/mqtt/persistence.cpp"
+        "src/mqtt/property_cache.cpp"
         "src/mqtt/pairing.cpp"
+        "src/mqtt/send_pipeline.cpp"
         "src/mqtt/serialize.cpp"
+        "src/mqtt/server_properties.cpp"
     )
     list(
         APPEND
         ${ASTARTE_MQTT_PRIVATE_HEADERS}
         "private/mqtt/connection/callbacks.hpp"
         "private/mqtt/connection/connection.hpp"
+        "private/mqtt/connection/duplicate_filter.hpp"
         "private/mqtt/connection/listener.hpp"
+        "private/mqtt/connection/options.hpp"
+        "private/mqtt/connection/topic_alias.hpp"
+        "private/mqtt/connection/topic_router.hpp"
         "private/mqtt/credentials.hpp"
         "private/mqtt/crypto.hpp"
+        "private/mqtt/deserialize.hpp"
         "private/mqtt/device_mqtt_impl.hpp"
         "private/mqtt/helpers.hpp"
         "private/mqtt/interface.hpp"
         "private/mqtt/introspection.hpp"
+        "private/mqtt/json_backend.hpp"
         "private/mqtt/mapping.hpp"
         "private/mqtt/persistence.hpp"
+        "private/mqtt/property_cache.hpp"
+        "private/mqtt/send_pipeline.hpp"
         "private/mqtt/serialize.hpp"
+        "private/mqtt/server_properties.hpp"
     )
     set(${ASTARTE_MQTT_PUBLIC_HEADERS} ${${ASTARTE_MQTT_PUBLIC_HEADERS}} PARENT_SCOPE)
     set(${ASTARTE_MQTT_SOURCES} ${${ASTARTE_MQTT_SOURCES}} PARENT_SCOPE)
@@ -156,16 +195,28 @@ function(astarte_sdk_add_mqtt_transport)
         astarte_device_sdk
         PRIVATE cpr::cpr
         PRIVATE nlohmann_json::nlohmann_json
+        PRIVATE ZLIB::ZLIB
         PUBLIC MbedTLS::mbedtls
         PUBLIC MbedTLS::mbedx509
         PUBLIC ada::ada
     )
+
+    # Link with the optional json parser
+    if(ASTARTE_USE_SIMDJSON)
+        target_link_libraries(astarte_device_sdk PRIVATE simdjson::simdjson)
+        target_compile_definitions(astarte_device_sdk PRIVATE ASTARTE_USE_SIMDJSON)
+    endif()
+
+    target_compile_definitions(astarte_device_sdk PUBLIC ASTARTE_TRANSPORT_MQTT)
 endfunction()
 
 # Adds mqtt-specific targets to the installation list.
 function(astarte_sdk_add_mqtt_install_targets TARGET_LIST_VAR)
     if(NOT ASTARTE_USE_SYSTEM_MQTT)
         list(APPEND ${TARGET_LIST_VAR} ada nlohmann_json cpr paho-mqtt3as)
+        if(ASTARTE_USE_SIMDJSON)
+            list(APPEND ${TARGET_LIST_VAR} simdjson)
+        endif()
     endif()
 
     set(${TARGET_LIST_VAR} ${${TARGET_LIST_VAR}} PARENT_SCOPE)
@@ -38,6 +38,7 @@ using astarte::device::Error;
 using astarte::device::Message;
 using astarte::device::Ownership;
 using astarte::device::PropertyIndividual;
+using astarte::device::SharedMessage;
 using astarte::device::StoredProperty;
 
 // -----------------------------------------------------------------------------
@@ -53,7 +54,7 @@ struct TestHttpConfig {
 struct TestCaseContext {
   std::string device_id;
   std::shared_ptr<Device> device;
-  std::shared_ptr<SharedQueue<Message>> rx_queue;
+  std::shared_ptr<SharedQueue<SharedMessage>> rx_queue;
   TestHttpConfig http;
 };
 
@@ -312,8 +313,8 @@ inline Action ReadReceivedDeviceData(Message expected_message) {
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
-    Message received = ctx.rx_queue->pop().value();
-    if (received != expected) {
+    const SharedMessage received = ctx.rx_queue->pop().value();
+    if (received.get() != expected) {
       spdlog::error("Received message differs from expected.");
       spdlog::error("Received: {}", received);
       spdlog::error("Expected: {}", expected);
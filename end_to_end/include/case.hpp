@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "action.hpp"
@@ -55,7 +56,7 @@ class TestCase {
     }
 
     // 2. Create the RX Queue for this specific run
-    auto rx_queue = std::make_shared<SharedQueue<Message>>();
+    auto rx_queue = std::make_shared<SharedQueue<SharedMessage>>();
 
     // 3. Start the background reception thread (if device is present)
     std::unique_ptr<std::jthread> rx_thread;
@@ -63,11 +64,10 @@ class TestCase {
     if (device) {
       rx_thread = std::make_unique<std::jthread>([&, dev = device](std::stop_token token) {
         while (!token.stop_requested()) {
-          auto incoming = dev->poll_incoming(std::chrono::milliseconds(100));
+          auto incoming = dev->poll_incoming_shared(std::chrono::milliseconds(100));
           if (incoming.has_value()) {
-            Message msg(incoming.value());
-            spdlog::debug("Handler received message: {}", msg.get_path());
-            rx_queue->push(msg);
+            spdlog::debug("Handler received message: {}", incoming.value()->get_path());
+            rx_queue->push(std::move(incoming.value()));
           }
         }
       });
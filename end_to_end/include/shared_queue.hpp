@@ -8,6 +8,7 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <utility>
 
 template <typename T>
 class SharedQueue {
@@ -16,7 +17,7 @@ class SharedQueue {
     std::unique_lock<std::mutex> mlock(mutex_);
     std::optional<T> res = std::nullopt;
     if (!queue_.empty()) {
-      res = queue_.front();
+      res = std::move(queue_.front());
       queue_.pop();
     }
     return res;
@@ -25,6 +26,10 @@ class SharedQueue {
     std::unique_lock<std::mutex> mlock(mutex_);
     queue_.push(item);
   }
+  void push(T&& item) {
+    std::unique_lock<std::mutex> mlock(mutex_);
+    queue_.push(std::move(item));
+  }
   auto size() -> std::size_t {
     std::unique_lock<std::mutex> mlock(mutex_);
     const std::size_t size = queue_.size();
@@ -135,6 +135,8 @@ file_patterns=(
     "samples/"*/*/*.cpp
     "samples/"*/*/*.hpp
     "unit/"*.cpp
+    "benchmark/"*.cpp
+    "benchmark/"*.hpp
     "end_to_end/src/"*.cpp
     "end_to_end/include/"*.hpp
     "end_to_end/include/constants/"*.hpp
@@ -171,6 +173,7 @@ cmake_files=(
     "cmake/AstarteGrpcTransport.cmake"
     "cmake/AstarteMqttTransport.cmake"
     "unit/CMakeLists.txt"
+    "benchmark/CMakeLists.txt"
     "end_to_end/CMakeLists.txt"
     "samples/grpc/qt/CMakeLists.txt"
     "samples/grpc/native/CMakeLists.txt"
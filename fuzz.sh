@@ -0,0 +1,127 @@
+#!/bin/bash
+
+# (C) Copyright 2025 - 2026, SECO Mind Srl
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# --- Configuration ---
+fresh_mode=false
+system_transport=false
+jobs=$(nproc --all)
+build_dir="fuzz/build"
+corpus_dir="fuzz/corpus"
+max_time=60
+
+# --- Helper Functions ---
+display_help() {
+    cat << EOF
+Usage: $0 [OPTIONS]
+
+Build the fuzz targets with clang and libFuzzer and run them.
+
+Options:
+  --fresh               Build from scratch (removes $build_dir).
+  --system_transport    Use the system MQTT library instead of building it from scratch.
+  -j, --jobs <N>        Specify the number of parallel jobs for make. Default: $jobs.
+  --max_time <S>        Seconds each fuzz target runs for, 0 for no limit. Default: $max_time.
+  -h, --help            Display this help message.
+EOF
+}
+error_exit() {
+    echo "Error: $1" >&2
+    exit 1
+}
+
+# --- Argument Parsing ---
+while [[ "$#" -gt 0 ]]; do
+    case $1 in
+        --fresh) fresh_mode=true; shift ;;
+        --system_transport) system_transport=true; shift ;;
+        -j|--jobs)
+            jobs="$2"
+            if ! [[ "$jobs" =~ ^[0-9]+$ && "$jobs" -gt 0 ]]; then
+                error_exit "Invalid argument for --jobs. Please provide a positive number."
+            fi
+            shift 2
+            ;;
+        --max_time)
+            max_time="$2"
+            if ! [[ "$max_time" =~ ^[0-9]+$ ]]; then
+                error_exit "Invalid argument for --max_time. Please provide a number of seconds."
+            fi
+            shift 2
+            ;;
+        -h|--help) display_help; exit 0 ;;
+        *) display_help; error_exit "Unknown option: $1" ;;
+    esac
+done
+
+# --- Build Logic ---
+
+echo "Configuration:"
+echo "  Jobs: $jobs"
+echo "  Build Directory: $build_dir"
+echo "  Fresh Mode: $fresh_mode"
+echo "  Use System transport: $system_transport"
+echo "  Max time: $max_time"
+echo ""
+
+# Clean build if --fresh is set
+if [ "$fresh_mode" = true ]; then
+    if [ -d "$build_dir" ]; then
+        echo "Fresh build requested. Removing $build_dir..."
+        rm -rf "$build_dir"
+    else
+        echo "Fresh build requested, but $build_dir does not exist. Skipping removal."
+    fi
+fi
+
+# Create build and corpus directories if they don't exist
+echo "Ensuring directories '$build_dir' and '$corpus_dir' exist..."
+if ! mkdir -p "$build_dir" "$corpus_dir"; then
+    error_exit "Failed to create directories '$build_dir' and '$corpus_dir'."
+fi
+corpus_dir="$(realpath "$corpus_dir")"
+
+# Navigate to build directory
+echo "Changing directory to '$build_dir'..."
+if ! cd "$build_dir"; then
+    error_exit "Failed to navigate to '$build_dir'. Make sure you are running this script from the project root (parent of the 'fuzz' directory)."
+fi
+
+# Configure CMake
+echo "Running CMake..."
+cmake_options_array=()
+cmake_options_array+=("-DCMAKE_BUILD_TYPE=RelWithDebInfo")
+cmake_options_array+=("-DCMAKE_C_COMPILER=clang")
+cmake_options_array+=("-DCMAKE_CXX_COMPILER=clang++")
+cmake_options_array+=("-DCMAKE_CXX_STANDARD=20")
+cmake_options_array+=("-DCMAKE_CXX_STANDARD_REQUIRED=ON")
+cmake_options_array+=("-DCMAKE_POLICY_VERSION_MINIMUM=3.15")
+cmake_options_array+=("-DASTARTE_PUBLIC_SPDLOG_DEP=ON")
+cmake_options_array+=("-DCMAKE_POSITION_INDEPENDENT_CODE=ON")
+cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=OFF")
+
+if [ "$system_transport" = true ]; then
+    cmake_options_array+=("-DASTARTE_USE_SYSTEM_MQTT=ON")
+fi
+
+echo "CMake options: ${cmake_options_array[*]}"
+if ! cmake "${cmake_options_array[@]}" ..; then
+    error_exit "CMake configuration failed."
+fi
+
+# Build the project
+echo "Building with make -j $jobs ..."
+if ! make -j "$jobs"; then
+    error_exit "Make build failed."
+fi
+
+# Run the fuzz targets
+for target in bson_deserialize_fuzzer; do
+    echo "Running $target..."
+    mkdir -p "$corpus_dir/$target"
+    if ! "./$target" -max_total_time="$max_time" "$corpus_dir/$target"; then
+        error_exit "Fuzz target $target found a failure."
+    fi
+done
@@ -0,0 +1,83 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// libFuzzer target for the BSON decoder of the payloads received from Astarte.
+//
+// The first byte of the input selects the type expected by the mapping, the rest is the payload.
+// Every payload the decoder accepts must survive a serialization round trip.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "mqtt/deserialize.hpp"
+#include "mqtt/serialize.hpp"
+
+using astarte::device::Type;
+using astarte::device::mqtt::bson::deserialize_astarte_individual;
+using astarte::device::mqtt::bson::deserialize_astarte_object;
+using astarte::device::mqtt::bson::serialize_astarte_individual;
+using astarte::device::mqtt::bson::serialize_astarte_object;
+using nlohmann::json;
+
+namespace {
+
+// Number of values of the Type enum
+constexpr uint8_t k_types = static_cast<uint8_t>(Type::kStringArray) + 1;
+
+// Object keys get a type from their first character, so that any key is valid
+auto object_type_of(std::string_view key) -> std::optional<Type> {
+  if (key.empty()) {
+    return std::nullopt;
+  }
+  return static_cast<Type>(static_cast<uint8_t>(key.front()) % k_types);
+}
+
+void fuzz_individual(Type type, std::span<const uint8_t> payload) {
+  auto decoded = deserialize_astarte_individual(payload, type);
+  if (!decoded) {
+    return;
+  }
+  json doc;
+  serialize_astarte_individual(doc, "v", decoded->data,
+                               decoded->timestamp ? &decoded->timestamp.value() : nullptr);
+  if (!deserialize_astarte_individual(json::to_bson(doc), type)) {
+    std::abort();
+  }
+}
+
+void fuzz_object(std::span<const uint8_t> payload) {
+  auto decoded = deserialize_astarte_object(payload, object_type_of);
+  if (!decoded || decoded->object.size() == 0) {
+    return;
+  }
+  json doc;
+  serialize_astarte_object(doc, decoded->object,
+                           decoded->timestamp ? &decoded->timestamp.value() : nullptr);
+  if (!deserialize_astarte_object(json::to_bson(doc), object_type_of)) {
+    std::abort();
+  }
+}
+
+}  // namespace
+
+extern "C" auto LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) -> int {
+  if (size == 0) {
+    return 0;
+  }
+  const std::span<const uint8_t> payload(data + 1, size - 1);
+  if (data[0] < k_types) {
+    fuzz_individual(static_cast<Type>(data[0]), payload);
+  } else {
+    fuzz_object(payload);
+  }
+  return 0;
+}
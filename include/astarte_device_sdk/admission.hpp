@@ -0,0 +1,92 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DEVICE_SDK_ADMISSION_H
+#define ASTARTE_DEVICE_SDK_ADMISSION_H
+
+/**
+ * @file astarte_device_sdk/admission.hpp
+ * @brief Admission control of the sends of a device while its outbound path is saturated.
+ *
+ * @details This file defines the options of the admission control, selecting for each interface
+ * the policy applied to its sends once too many sends or bytes are waiting to be delivered, and
+ * the counters reporting the decisions taken.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace astarte::device {
+
+/// @brief Policy applied to the sends of an interface while the outbound path is saturated.
+enum class OverloadPolicy : uint8_t {
+  /// @brief Sends exceeding the limits are refused with an `OverloadError`.
+  kReject = 0,
+  /// @brief Sends are dropped as the load grows, starting from the lowest priority interfaces.
+  kDropLowestPriority = 1,
+  /// @brief Once the load exceeds `AdmissionOptions::sampling_load`, only one send every
+  /// `InterfaceAdmission::sample_every` is admitted, the others are dropped.
+  kSample = 2,
+};
+
+/// @brief Admission settings of an interface.
+struct InterfaceAdmission {
+  /// @brief The policy applied to the sends of the interface.
+  OverloadPolicy policy{OverloadPolicy::kReject};
+  /// @brief Priority of the interface for `OverloadPolicy::kDropLowestPriority`, higher values
+  /// are dropped later.
+  uint32_t priority{0};
+  /// @brief Ratio of the sends admitted by `OverloadPolicy::kSample`, one every `sample_every`.
+  uint32_t sample_every{1};
+};
+
+/**
+ * @brief Options of the admission control of a device.
+ *
+ * @details The load of the outbound path is the largest of the ratios between the sends waiting
+ * for their delivery and `max_pending_sends`, and between their bytes and `max_pending_bytes`.
+ * A send raising the load above one is never admitted: it is refused or dropped depending on the
+ * policy of its interface. Below that, the policies shed sends progressively:
+ * - `OverloadPolicy::kReject` admits all the sends.
+ * - `OverloadPolicy::kDropLowestPriority` drops the sends of priority `p` once the load exceeds
+ *   `(p + 1) / (P + 1)`, where `P` is the highest priority configured, so that the sends of the
+ *   highest priority interfaces are the last ones dropped.
+ * - `OverloadPolicy::kSample` admits one send every `sample_every` once the load exceeds
+ *   `sampling_load`.
+ *
+ * A send is always admitted while no other send is pending, even if its bytes exceed
+ * `max_pending_bytes`. Dropped sends are reported as successful to the caller and are only
+ * accounted in the counters.
+ */
+struct AdmissionOptions {
+  /// @brief Maximum number of sends waiting for their delivery, zero for no limit.
+  size_t max_pending_sends{0};
+  /// @brief Maximum number of payload bytes waiting for their delivery, zero for no limit.
+  size_t max_pending_bytes{0};
+  /// @brief Load above which the interfaces using `OverloadPolicy::kSample` are sampled.
+  double sampling_load{0.5};
+  /// @brief Settings of the interfaces not listed in `interfaces`.
+  InterfaceAdmission default_interface{};
+  /// @brief Settings of specific interfaces, by interface name.
+  std::map<std::string, InterfaceAdmission, std::less<>> interfaces{};
+};
+
+/// @brief Counters of the admission decisions.
+struct AdmissionCounters {
+  /// @brief Number of admitted sends.
+  uint64_t admitted{0};
+  /// @brief Number of sends refused with an `OverloadError`.
+  uint64_t rejected{0};
+  /// @brief Number of sends dropped by `OverloadPolicy::kDropLowestPriority`.
+  uint64_t dropped{0};
+  /// @brief Number of sends dropped by `OverloadPolicy::kSample`.
+  uint64_t sampled_out{0};
+};
+
+}  // namespace astarte::device
+
+#endif  // ASTARTE_DEVICE_SDK_ADMISSION_H
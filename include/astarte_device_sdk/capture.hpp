@@ -0,0 +1,165 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DEVICE_SDK_CAPTURE_H
+#define ASTARTE_DEVICE_SDK_CAPTURE_H
+
+/**
+ * @file astarte_device_sdk/capture.hpp
+ * @brief Capture and replay of the data sent by the devices.
+ *
+ * @details While a capture is running, every send call of the devices, with its interface, path,
+ * data, timestamp, timing and outcome, is appended to a compact binary capture file. A capture file
+ * can be replayed against any `Device` at the original pace or accelerated, producing a throughput
+ * and latency report, so that benchmarks can run on a production-shaped workload.
+ *
+ * When no capture is running a send call pays a single relaxed atomic load.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/object.hpp"
+
+namespace astarte::device::capture {
+
+/// @brief Device methods recorded in a capture.
+enum class SendKind : uint8_t {
+  /// @brief A call to `Device::send_individual`.
+  kIndividual = 1,
+  /// @brief A call to `Device::send_object`.
+  kObject = 2,
+  /// @brief A call to `Device::set_property`.
+  kSetProperty = 3,
+  /// @brief A call to `Device::unset_property`.
+  kUnsetProperty = 4,
+};
+
+/// @brief A send call recorded in a capture.
+struct CapturedSend {
+  /// @brief The called method.
+  SendKind kind;
+  /// @brief The name of the interface.
+  std::string interface_name;
+  /// @brief The path of the data.
+  std::string path;
+  /// @brief The sent data, set for individuals and properties.
+  std::optional<Data> data;
+  /// @brief The sent object, set for objects.
+  std::optional<DatastreamObject> object;
+  /// @brief The explicit timestamp of the data, if any.
+  std::optional<std::chrono::system_clock::time_point> timestamp;
+  /// @brief Time elapsed between the start of the capture and the call.
+  std::chrono::nanoseconds offset;
+  /// @brief Time spent in the call.
+  std::chrono::nanoseconds duration;
+  /// @brief True if the call succeeded.
+  bool succeeded;
+};
+
+/// @brief Content of a capture file.
+struct Capture {
+  /// @brief Time at which the capture has been started.
+  std::chrono::system_clock::time_point started;
+  /// @brief The recorded send calls, in call order.
+  std::vector<CapturedSend> sends;
+};
+
+/**
+ * @brief Starts capturing the send calls of all the devices to a file.
+ *
+ * @param[in] file The capture file, overwritten if it exists.
+ * @return An error if a capture is already running or the file can not be created.
+ */
+auto start(const std::filesystem::path& file) -> astarte_tl::expected<void, Error>;
+
+/**
+ * @brief Stops the running capture and closes its file.
+ *
+ * @return An error if no capture is running or the file could not be written completely.
+ */
+auto stop() -> astarte_tl::expected<void, Error>;
+
+/**
+ * @brief Checks if a capture is running.
+ * @return True if the send calls are being captured, false otherwise.
+ */
+[[nodiscard]] auto is_active() -> bool;
+
+/**
+ * @brief Reads a capture file.
+ *
+ * @param[in] file The capture file.
+ * @return The content of the capture, an error if the file can not be read or is malformed.
+ */
+[[nodiscard]] auto read_file(const std::filesystem::path& file)
+    -> astarte_tl::expected<Capture, Error>;
+
+/// @brief Options of a replay.
+struct ReplayOptions {
+  /// @brief Pace of the replay relative to the capture, zero replays as fast as possible.
+  double speed{1.0};
+  /// @brief Shift the explicit timestamps so that they are relative to the start of the replay.
+  bool shift_timestamps{true};
+};
+
+/// @brief Throughput and latency of a replay.
+struct ReplayReport {
+  /// @brief Number of replayed send calls.
+  size_t sends{0};
+  /// @brief Number of replayed send calls that failed.
+  size_t failures{0};
+  /// @brief Duration of the whole replay.
+  std::chrono::nanoseconds elapsed{0};
+  /// @brief Median latency of the send calls.
+  std::chrono::nanoseconds latency_p50{0};
+  /// @brief 90th percentile latency of the send calls.
+  std::chrono::nanoseconds latency_p90{0};
+  /// @brief 99th percentile latency of the send calls.
+  std::chrono::nanoseconds latency_p99{0};
+  /// @brief Maximum latency of the send calls.
+  std::chrono::nanoseconds latency_max{0};
+
+  /**
+   * @brief Gets the replay throughput.
+   * @return The number of send calls per second.
+   */
+  [[nodiscard]] auto throughput() const -> double;
+};
+
+/**
+ * @brief Replays a capture against a device.
+ *
+ * @details The send calls are performed from the calling thread in capture order. At a non-zero
+ * speed each call is delayed until its capture offset, scaled by the speed, has elapsed since the
+ * start of the replay. Calls that take longer than in the capture delay all the following ones.
+ *
+ * @param[in,out] device The connected device the capture is replayed on.
+ * @param[in] capture The capture to replay.
+ * @param[in] options The replay options.
+ * @return The throughput and latency of the replay.
+ */
+auto replay(Device& device, const Capture& capture, const ReplayOptions& options = {})
+    -> ReplayReport;
+
+/**
+ * @brief Writes a human readable replay report.
+ *
+ * @param[in,out] out The stream the report is written to.
+ * @param[in] report The replay report.
+ */
+void write_report(std::ostream& out, const ReplayReport& report);
+
+}  // namespace astarte::device::capture
+
+#endif  // ASTARTE_DEVICE_SDK_CAPTURE_H
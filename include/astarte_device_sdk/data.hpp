@@ -47,6 +47,46 @@ concept DataAllowedType = requires {
                std::is_same_v<T, std::vector<std::chrono::system_clock::time_point>>;
 };
 
+/**
+ * @brief Astarte type of the values of a C++ type, resolved at compile time.
+ *
+ * @details `std::string_view` values are strings, stored as `std::string` in a `Data`.
+ *
+ * @tparam T The C++ type, must satisfy `DataAllowedType`.
+ */
+template <DataAllowedType T>
+inline constexpr Type k_astarte_type = []() {
+  if constexpr (std::is_same_v<T, int32_t>) {
+    return Type::kInteger;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return Type::kLongInteger;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return Type::kDouble;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return Type::kBoolean;
+  } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+    return Type::kString;
+  } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+    return Type::kBinaryBlob;
+  } else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
+    return Type::kDatetime;
+  } else if constexpr (std::is_same_v<T, std::vector<int32_t>>) {
+    return Type::kIntegerArray;
+  } else if constexpr (std::is_same_v<T, std::vector<int64_t>>) {
+    return Type::kLongIntegerArray;
+  } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+    return Type::kDoubleArray;
+  } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+    return Type::kBooleanArray;
+  } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+    return Type::kStringArray;
+  } else if constexpr (std::is_same_v<T, std::vector<std::vector<uint8_t>>>) {
+    return Type::kBinaryBlobArray;
+  } else {
+    return Type::kDatetimeArray;
+  }
+}();
+
 /**
  * @brief Represents a single Astarte data value.
  *
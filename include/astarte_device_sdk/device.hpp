@@ -14,11 +14,16 @@
  * data transmission capabilities.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
+#include <iterator>
+#include <list>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/errors.hpp"
@@ -177,6 +182,27 @@ class Device {
   virtual auto poll_incoming(const std::chrono::milliseconds& timeout)
       -> std::optional<Message> = 0;
 
+  /**
+   * @brief Polls for incoming messages from Astarte, as shared immutable messages.
+   *
+   * @details Behaves as poll_incoming(). The returned handle can be copied to several consumers
+   * without copying the message. Devices queueing the received messages as shared messages
+   * override this method to hand them out without any copy, the default implementation wraps the
+   * result of poll_incoming().
+   *
+   * @param[in] timeout The maximum duration to block waiting for a message.
+   * @return std::optional containing the SharedMessage if received, or std::nullopt if the
+   * timeout was reached.
+   */
+  virtual auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage> {
+    auto message = poll_incoming(timeout);
+    if (!message) {
+      return std::nullopt;
+    }
+    return SharedMessage(std::move(message.value()));
+  }
+
   /**
    * @brief Retrieves all stored properties matching an ownership filter.
    *
@@ -195,6 +221,88 @@ class Device {
   virtual auto get_properties(std::string_view interface_name)
       -> astarte_tl::expected<std::list<StoredProperty>, Error> = 0;
 
+  /**
+   * @brief Retrieves all stored properties matching an ownership filter into a vector.
+   *
+   * @details Properties of the same interface share a single interface name string. Devices
+   * override this method to build the vector directly, the default implementation moves the
+   * result of get_all_properties() into a vector.
+   *
+   * @param[in] ownership Optional filter, if std::nullopt, returns all properties.
+   * @return An expected containing the vector of properties on success or Error on failure.
+   */
+  virtual auto get_all_properties_vector(const std::optional<Ownership>& ownership)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+    auto properties = get_all_properties(ownership);
+    if (!properties) {
+      return astarte_tl::unexpected(properties.error());
+    }
+    return to_vector(std::move(properties.value()));
+  }
+
+  /**
+   * @brief Retrieves all stored properties belonging to a specific interface into a vector.
+   *
+   * @details Properties share a single interface name string. Devices override this method to
+   * build the vector directly, the default implementation moves the result of get_properties()
+   * into a vector.
+   *
+   * @param[in] interface_name The name of the interface to query.
+   * @return An expected containing the vector of properties on success or Error on failure.
+   */
+  virtual auto get_properties_vector(std::string_view interface_name)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+    auto properties = get_properties(interface_name);
+    if (!properties) {
+      return astarte_tl::unexpected(properties.error());
+    }
+    return to_vector(std::move(properties.value()));
+  }
+
+  /**
+   * @brief Visits all stored properties matching an ownership filter.
+   *
+   * @details The properties are handed to the visitor one at a time without being copied into a
+   * container, which keeps the memory usage bounded for large property sets. Devices override
+   * this method to do so, the default implementation visits the result of get_all_properties().
+   *
+   * @param[in] ownership Optional filter, if std::nullopt, visits all properties.
+   * @param[in] visitor The callable invoked for each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  virtual auto visit_all_properties(const std::optional<Ownership>& ownership,
+                                    const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error> {
+    auto properties = get_all_properties(ownership);
+    if (!properties) {
+      return astarte_tl::unexpected(properties.error());
+    }
+    visit_each(properties.value(), visitor);
+    return {};
+  }
+
+  /**
+   * @brief Visits all stored properties belonging to a specific interface.
+   *
+   * @details The properties are handed to the visitor one at a time without being copied into a
+   * container, which keeps the memory usage bounded for large property sets. Devices override
+   * this method to do so, the default implementation visits the result of get_properties().
+   *
+   * @param[in] interface_name The name of the interface to query.
+   * @param[in] visitor The callable invoked for each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  virtual auto visit_properties(std::string_view interface_name,
+                                const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error> {
+    auto properties = get_properties(interface_name);
+    if (!properties) {
+      return astarte_tl::unexpected(properties.error());
+    }
+    visit_each(properties.value(), visitor);
+    return {};
+  }
+
   /**
    * @brief Retrieves a specific property value.
    *
@@ -207,6 +315,34 @@ class Device {
 
  protected:
   Device() = default;
+
+ private:
+  /**
+   * @brief Moves a list of properties into a vector.
+   * @param[in,out] properties The list of properties, left empty.
+   * @return The vector of properties.
+   */
+  static auto to_vector(std::list<StoredProperty>&& properties) -> std::vector<StoredProperty> {
+    std::vector<StoredProperty> vector;
+    vector.reserve(properties.size());
+    std::move(properties.begin(), properties.end(), std::back_inserter(vector));
+    properties.clear();
+    return vector;
+  }
+
+  /**
+   * @brief Hands each property of a list to a visitor.
+   * @param[in] properties The list of properties.
+   * @param[in] visitor The callable invoked for each property.
+   */
+  static void visit_each(const std::list<StoredProperty>& properties,
+                         const StoredPropertyVisitor& visitor) {
+    for (const auto& property : properties) {
+      visitor(StoredPropertyView(property.get_interface_name(), property.get_path(),
+                                 property.get_version_major(), property.get_ownership(),
+                                 property.get_value()));
+    }
+  }
 };
 
 }  // namespace device
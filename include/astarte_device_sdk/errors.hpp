@@ -14,6 +14,9 @@
  * without relying on C++ exceptions.
  */
 
+// the contents of the Error variant depend on the transports the library has been built with
+#include "astarte_device_sdk/build_config.hpp"
+
 #if defined(ASTARTE_USE_TL_EXPECTED)
 #include <tl/expected.hpp>
 #else
@@ -44,6 +47,7 @@ class InternalError;
 class OperationRefusedError;
 class GrpcLibError;
 class MsgHubError;
+class OverloadError;
 class InterfaceValidationError;
 class InvalidInterfaceVersionError;
 class InvalidInterfaceTypeError;
@@ -53,7 +57,7 @@ class InvalidReliabilityError;
 class InvalidAstarteTypeError;
 class InvalidRetentionError;
 class InvalidDatabaseRetentionPolicyError;
-#if !defined(ASTARTE_TRANSPORT_GRPC)
+#if defined(ASTARTE_TRANSPORT_MQTT)
 namespace mqtt {
 class JsonParsingError;
 class DeviceRegistrationError;
@@ -83,14 +87,14 @@ using Error =
                  InvalidInterfaceOwnershipeError, InvalidInterfaceAggregationError,
                  InvalidAstarteTypeError, InvalidReliabilityError, InvalidRetentionError,
                  InvalidDatabaseRetentionPolicyError,
-#if !defined(ASTARTE_TRANSPORT_GRPC)
-                 OperationRefusedError, GrpcLibError, MsgHubError, mqtt::JsonParsingError,
-                 mqtt::DeviceRegistrationError, mqtt::PairingApiError, mqtt::MqttError,
-                 mqtt::InvalidUrlError, mqtt::RetrieveBrokerUrlError, mqtt::ReadCredentialError,
-                 mqtt::WriteCredentialError, mqtt::PairingConfigError, mqtt::CryptoError,
-                 mqtt::UuidError, mqtt::HttpError, mqtt::MqttConnectionError>;
+#if defined(ASTARTE_TRANSPORT_MQTT)
+                 OperationRefusedError, GrpcLibError, MsgHubError, OverloadError,
+                 mqtt::JsonParsingError, mqtt::DeviceRegistrationError, mqtt::PairingApiError,
+                 mqtt::MqttError, mqtt::InvalidUrlError, mqtt::RetrieveBrokerUrlError,
+                 mqtt::ReadCredentialError, mqtt::WriteCredentialError, mqtt::PairingConfigError,
+                 mqtt::CryptoError, mqtt::UuidError, mqtt::HttpError, mqtt::MqttConnectionError>;
 #else
-                 OperationRefusedError, GrpcLibError, MsgHubError>;
+                 OperationRefusedError, GrpcLibError, MsgHubError, OverloadError>;
 #endif
 
 /**
@@ -317,6 +321,26 @@ class MsgHubError : public ErrorBase {
   static constexpr std::string_view k_type_ = "MsgHubError";
 };
 
+/// @brief A send was rejected because the outbound path of the device is saturated.
+class OverloadError : public ErrorBase {
+ public:
+  /**
+   * @brief Standard error constructor.
+   * @param[in] message The human-readable error message.
+   */
+  explicit OverloadError(std::string_view message);
+
+  /**
+   * @brief Nested error constructor.
+   * @param[in] message The human-readable error message.
+   * @param[in] other The error to nest.
+   */
+  explicit OverloadError(std::string_view message, const Error& other);
+
+ private:
+  static constexpr std::string_view k_type_ = "OverloadError";
+};
+
 // -----------------------------------------------------------------------------
 // Interface validation errors
 // -----------------------------------------------------------------------------
@@ -503,7 +527,7 @@ class InvalidDatabaseRetentionPolicyError : public ErrorBase {
 
 }  // namespace astarte::device
 
-#if !defined(ASTARTE_TRANSPORT_GRPC)
+#if defined(ASTARTE_TRANSPORT_MQTT)
 // We accept this circular inclusion as it's required for the forward declarations above to work
 // even when an user includes only this header.
 // NOLINTNEXTLINE(misc-header-include-cycle)
@@ -0,0 +1,321 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DEVICE_SDK_FAILOVER_DEVICE_H
+#define ASTARTE_DEVICE_SDK_FAILOVER_DEVICE_H
+
+/**
+ * @file astarte_device_sdk/failover_device.hpp
+ * @brief Astarte device routing its sends over a primary device and failing over to a fallback
+ * one.
+ *
+ * @details The typical pairing is a `grpc::DeviceGrpc` attached to the local message hub as the
+ * primary device and a `mqtt::DeviceMqtt` connecting directly to Astarte as the fallback device,
+ * which requires an SDK built with both transports. Any pair of devices can be used, since the
+ * failover device only relies on the abstract `Device`.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+
+namespace astarte::device {
+
+/// @brief Route taken by the sends of a FailoverDevice.
+enum class FailoverRoute : uint8_t {
+  /// @brief Sends go through the primary device.
+  kPrimary = 0,
+  /// @brief Sends go through the fallback device.
+  kFallback = 1,
+  /// @brief Neither device is connected, sends are buffered.
+  kBuffering = 2,
+};
+
+/// @brief Options of a FailoverDevice.
+struct FailoverOptions {
+  /// @brief Time the primary device may stay disconnected before the fallback one is connected.
+  std::chrono::milliseconds failover_delay{std::chrono::seconds(2)};
+  /// @brief Time the fallback device is used before the primary one is tried again.
+  std::chrono::milliseconds failback_delay{std::chrono::seconds(5)};
+  /// @brief Interval at which the connection of the devices is checked.
+  std::chrono::milliseconds check_interval{std::chrono::milliseconds(100)};
+  /// @brief Maximum number of sends buffered while neither device is connected.
+  size_t buffer_capacity{4096};
+  /// @brief Hook invoked on the thread monitoring the devices each time it is started.
+  ThreadHook thread_hook;
+};
+
+/**
+ * @brief Device sending over a primary device, failing over to a fallback device during its
+ * outages.
+ *
+ * @details Sends go through the primary device while it is connected. Once the primary device has
+ * been disconnected for `FailoverOptions::failover_delay` it is stopped, and the fallback device
+ * is connected and used. After `FailoverOptions::failback_delay` the fallback device is
+ * disconnected and the primary device is connected again, falling over again if it does not
+ * connect within `FailoverOptions::failover_delay`. The two devices are never connected at the
+ * same time, so that both can share the same Astarte device identity without the broker letting
+ * each connection take over the other one.
+ *
+ * Sends performed while neither device is connected, such as during a switchover, are buffered
+ * and flushed in order as soon as a device is connected. Sends from the same thread are always
+ * delivered in call order. Sends of buffered data that the connected device refuses are logged
+ * and dropped.
+ *
+ * Interfaces are installed on both devices. Received messages and properties are read from the
+ * device in use.
+ */
+class FailoverDevice : public Device {
+ public:
+  /**
+   * @brief Constructor for the failover device.
+   *
+   * @param[in] primary The device used whenever it is connected.
+   * @param[in] fallback The device used during the outages of the primary one.
+   * @param[in] options The failover options.
+   */
+  FailoverDevice(std::shared_ptr<Device> primary, std::shared_ptr<Device> fallback,
+                 FailoverOptions options = {});
+
+  /// @brief Virtual destructor, stopping the monitor of the devices.
+  ~FailoverDevice() override;
+
+  /// @brief Device is non-copyable.
+  FailoverDevice(FailoverDevice& other) = delete;
+
+  /// @brief Device is non-moveable.
+  FailoverDevice(FailoverDevice&& other) = delete;
+
+  /// @brief Device is non-copyable.
+  auto operator=(FailoverDevice& other) -> FailoverDevice& = delete;
+
+  /// @brief Device is non-moveable.
+  auto operator=(FailoverDevice&& other) -> FailoverDevice& = delete;
+
+  /**
+   * @brief Adds an interface definition to both devices from a JSON file.
+   *
+   * @param[in] json_file The filesystem path to the .json interface definition.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto add_interface_from_file(const std::filesystem::path& json_file)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Adds an interface definition to both devices from a JSON string.
+   *
+   * @param[in] json The interface definition as a JSON string view.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto add_interface_from_str(std::string_view json) -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Removes an installed interface from both devices.
+   *
+   * @param[in] interface_name The name of the interface to remove.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto remove_interface(const std::string& interface_name)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Connects the primary device and starts monitoring the devices.
+   *
+   * @details A failure to connect the primary device is logged and handled as an outage.
+   *
+   * @return An expected containing void on success or Error if the device is already connected.
+   */
+  auto connect() -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Checks connectivity status.
+   * @return True if the device in use is connected, false otherwise.
+   */
+  [[nodiscard]] auto is_connected() const -> bool override;
+
+  /**
+   * @brief Stops monitoring the devices and disconnects them.
+   *
+   * @details Buffered sends are flushed to the device in use, if it is still connected. The ones
+   * that cannot be delivered are dropped, logging and recording their number in the flight
+   * recorder. Until the buffer is empty, sends are refused rather than overtaking it.
+   *
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto disconnect() -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Sends an individual data point through the device in use, or buffers it.
+   *
+   * @param[in] interface_name The name of the target interface.
+   * @param[in] path The specific mapping path within the interface (e.g., "/sensors/temp").
+   * @param[in] data The value payload to transmit.
+   * @param[in] timestamp Optional timestamp. Should match the interface timestamp configuration.
+   * @return An expected containing void on success or Error on failure or if the buffer is full.
+   */
+  auto send_individual(std::string_view interface_name, std::string_view path, const Data& data,
+                       const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Sends an aggregate object through the device in use, or buffers it.
+   *
+   * @param[in] interface_name The name of the target interface.
+   * @param[in] path The common base path for the object.
+   * @param[in] object The map of keys and values representing the object.
+   * @param[in] timestamp Optional timestamp. Should match the interface timestamp configuration.
+   * @return An expected containing void on success or Error on failure or if the buffer is full.
+   */
+  auto send_object(std::string_view interface_name, std::string_view path,
+                   const DatastreamObject& object,
+                   const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Sets a device property through the device in use, or buffers it.
+   *
+   * @param[in] interface_name The name of the property interface.
+   * @param[in] path The path to the property.
+   * @param[in] data The value to set.
+   * @return An expected containing void on success or Error on failure or if the buffer is full.
+   */
+  auto set_property(std::string_view interface_name, std::string_view path, const Data& data)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Unsets a device property through the device in use, or buffers it.
+   *
+   * @param[in] interface_name The name of the property interface.
+   * @param[in] path The path to the property to unset.
+   * @return An expected containing void on success or Error on failure or if the buffer is full.
+   */
+  auto unset_property(std::string_view interface_name, std::string_view path)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Polls for incoming messages on both devices.
+   *
+   * @details The device that is not in use is checked without waiting, so that the messages it
+   * received before a switchover are not lost.
+   *
+   * @param[in] timeout The maximum duration to wait for a message of the device in use.
+   * @return An optional containing the message if one was received, or std::nullopt on timeout.
+   */
+  auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message> override;
+
+  /**
+   * @brief Polls for incoming messages on both devices, as shared immutable messages.
+   *
+   * @details Behaves as poll_incoming(), relying on the devices to share their messages.
+   *
+   * @param[in] timeout The maximum duration to wait for a message of the device in use.
+   * @return An optional containing the message if one was received, or std::nullopt on timeout.
+   */
+  auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage> override;
+
+  /**
+   * @brief Retrieves all properties from the device in use.
+   *
+   * @param[in] ownership Optional filter for property ownership.
+   * @return An expected containing a list of properties on success or Error on failure.
+   */
+  auto get_all_properties(const std::optional<Ownership>& ownership)
+      -> astarte_tl::expected<std::list<StoredProperty>, Error> override;
+
+  /**
+   * @brief Retrieves the properties of an interface from the device in use.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @return An expected containing a list of properties on success or Error on failure.
+   */
+  auto get_properties(std::string_view interface_name)
+      -> astarte_tl::expected<std::list<StoredProperty>, Error> override;
+
+  /**
+   * @brief Retrieves all properties from the device in use.
+   *
+   * @param[in] ownership Optional filter for property ownership.
+   * @return An expected containing a vector of properties on success or Error on failure.
+   */
+  auto get_all_properties_vector(const std::optional<Ownership>& ownership)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error> override;
+
+  /**
+   * @brief Retrieves the properties of an interface from the device in use.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @return An expected containing a vector of properties on success or Error on failure.
+   */
+  auto get_properties_vector(std::string_view interface_name)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error> override;
+
+  /**
+   * @brief Visits all properties of the device in use.
+   *
+   * @param[in] ownership Optional filter for property ownership.
+   * @param[in] visitor The callable invoked on each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit_all_properties(const std::optional<Ownership>& ownership,
+                            const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Visits the properties of an interface of the device in use.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @param[in] visitor The callable invoked on each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit_properties(std::string_view interface_name, const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Retrieves a single property from the device in use.
+   *
+   * @param[in] interface_name The interface name.
+   * @param[in] path The exact path to the property.
+   * @return An expected containing the property on success or Error on failure.
+   */
+  auto get_property(std::string_view interface_name, std::string_view path)
+      -> astarte_tl::expected<PropertyIndividual, Error> override;
+
+  /**
+   * @brief Gets the route currently taken by the sends.
+   * @return The current route.
+   */
+  [[nodiscard]] auto route() const -> FailoverRoute;
+
+  /**
+   * @brief Gets the number of sends waiting in the buffer.
+   * @return The number of buffered sends.
+   */
+  [[nodiscard]] auto buffered() const -> size_t;
+
+ private:
+  struct FailoverDeviceImpl;
+  std::shared_ptr<FailoverDeviceImpl> astarte_device_impl_;
+};
+
+}  // namespace astarte::device
+
+#endif  // ASTARTE_DEVICE_SDK_FAILOVER_DEVICE_H
@@ -0,0 +1,154 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DEVICE_SDK_FLIGHT_RECORDER_H
+#define ASTARTE_DEVICE_SDK_FLIGHT_RECORDER_H
+
+/**
+ * @file astarte_device_sdk/flight_recorder.hpp
+ * @brief Flight recorder of the recent transport events.
+ *
+ * @details The SDK always records its transport events, such as connection attempts, backoff
+ * delays, publish outcomes and queue depths, in a fixed-size in-memory ring overwriting the oldest
+ * events. Recording an event costs a few relaxed atomic operations and never allocates, so the
+ * recorder stays enabled in production where logs are usually turned off.
+ *
+ * The recorded events can be dumped on demand, as text or in a compact binary format, and the
+ * binary dump can be written from a signal handler to capture the events preceding a crash.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+
+namespace astarte::device::flight_recorder {
+
+/// @brief Number of events kept by the recorder, older events are overwritten.
+constexpr size_t k_capacity = 1024;
+
+/// @brief Kinds of the recorded events, the meaning of the event value depends on the kind.
+enum class EventKind : uint32_t {
+  /// @brief A connection to the broker or message hub is being attempted. Value is unused.
+  kConnectAttempt = 1,
+  /// @brief The connection has been established. Value is unused.
+  kConnected = 2,
+  /// @brief The connection attempt failed. Value is the transport error code, if any.
+  kConnectFailed = 3,
+  /// @brief An established connection has been lost. Value is the number of messages waiting
+  /// for delivery, if known.
+  kConnectionLost = 4,
+  /// @brief The Astarte session setup failed after connecting. Value is unused.
+  kSessionSetupFailed = 5,
+  /// @brief The device has been disconnected on request. Value is unused.
+  kDisconnected = 6,
+  /// @brief A reconnection has been scheduled. Value is the backoff delay in milliseconds.
+  kBackoffDelay = 7,
+  /// @brief A message has been delivered. Value is the quality of service of the message.
+  kPublishSucceeded = 8,
+  /// @brief A message could not be delivered. Value is the transport error code, if any.
+  kPublishFailed = 9,
+  /// @brief The message hub stream has been closed with an error. Value is the gRPC status code.
+  kStreamError = 10,
+  /// @brief A message has been added to the receive queue. Value is the queue length.
+  kReceiveQueueDepth = 11,
+  /// @brief A redelivered message has been discarded. Value is the quality of service of the
+  /// message.
+  kDuplicateDiscarded = 12,
+  /// @brief A failover device changed the route of its sends. Value is the new route, as in
+  /// `FailoverRoute`.
+  kFailoverRoute = 13,
+  /// @brief A send has been refused or dropped by the admission control. Value is the policy of
+  /// its interface, as in `OverloadPolicy`.
+  kSendShed = 14,
+  /// @brief A failover device has been disconnected with sends that no device could deliver.
+  /// Value is the number of dropped sends.
+  kFailoverBufferDropped = 15,
+};
+
+/**
+ * @brief Gets the name of an event kind.
+ *
+ * @param[in] kind The event kind.
+ * @return The snake case name of the kind, "unknown" for values outside the enumeration.
+ */
+[[nodiscard]] auto event_kind_name(EventKind kind) -> std::string_view;
+
+/// @brief A recorded transport event.
+struct Event {
+  /// @brief Time of the event, in nanoseconds since the Unix epoch.
+  int64_t timestamp_ns;
+  /// @brief The kind of the event.
+  EventKind kind;
+  /// @brief The value of the event, as described by its kind.
+  int64_t value;
+};
+
+/**
+ * @brief Gets the recorded events.
+ *
+ * @details Events can be read while they are being recorded, events overwritten during the read
+ * are skipped.
+ *
+ * @return The recorded events, oldest first.
+ */
+[[nodiscard]] auto snapshot() -> std::vector<Event>;
+
+/**
+ * @brief Discards all the recorded events.
+ */
+void clear();
+
+/**
+ * @brief Writes the recorded events as text, one event per line.
+ *
+ * @param[in,out] out The stream the events are written to.
+ */
+void write_text(std::ostream& out);
+
+/**
+ * @brief Writes the recorded events in the binary dump format.
+ *
+ * @details The dump starts with the 8 bytes magic "ASTFLREC", followed by the format version and
+ * the number of events as 32 bits unsigned integers. Each event is then written as a 64 bits
+ * timestamp, a 64 bits value and a 32 bits kind followed by 4 padding bytes. All the integers use
+ * the native byte order of the device. Events overwritten while dumping are written as records of
+ * kind zero, which are skipped when decoding.
+ *
+ * The function does not allocate nor lock and only calls `write`, so it can be called from a
+ * signal handler.
+ *
+ * @param[in] fd The file descriptor the dump is written to.
+ * @return True if the whole dump has been written, false otherwise.
+ */
+auto write_binary(int fd) -> bool;
+
+/**
+ * @brief Decodes a binary dump produced by `write_binary`.
+ *
+ * @param[in] dump The content of the dump.
+ * @return The events contained in the dump, an error if the dump is malformed.
+ */
+[[nodiscard]] auto parse_binary(std::span<const uint8_t> dump)
+    -> astarte_tl::expected<std::vector<Event>, Error>;
+
+/**
+ * @brief Writes the binary dump when the process crashes.
+ *
+ * @details Installs handlers for SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT writing the binary
+ * dump to the file descriptor, after which the default action of the signal is performed. The file
+ * descriptor must stay open for the lifetime of the process. Only supported on POSIX platforms.
+ *
+ * @param[in] fd The file descriptor the dump is written to.
+ * @return An error if the handlers could not be installed.
+ */
+auto install_crash_handler(int fd) -> astarte_tl::expected<void, Error>;
+
+}  // namespace astarte::device::flight_recorder
+
+#endif  // ASTARTE_DEVICE_SDK_FLIGHT_RECORDER_H
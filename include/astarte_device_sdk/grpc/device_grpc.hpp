@@ -17,6 +17,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/device.hpp"
@@ -24,6 +25,7 @@
 #include "astarte_device_sdk/msg.hpp"
 #include "astarte_device_sdk/object.hpp"
 #include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
 
 /// @brief Namespace for Astarte device functionality using the gRPC transport layer.
 namespace astarte::device::grpc {
@@ -84,6 +86,17 @@ class DeviceGrpc : public Device {
   auto remove_interface(const std::string& interface_name)
       -> astarte_tl::expected<void, Error> override;
 
+  /**
+   * @brief Sets the hook invoked on the thread maintaining the connection with the message hub.
+   *
+   * @details The hook is invoked each time the thread is started by `connect()`. Threads created
+   * internally by the gRPC library are not affected.
+   *
+   * @param[in] hook The hook to invoke, for example to apply a `ThreadConfig`.
+   * @return An expected containing void on success or Error if the device is already connecting.
+   */
+  auto set_thread_hook(ThreadHook hook) -> astarte_tl::expected<void, Error>;
+
   /**
    * @brief Connects the device to the Astarte platform.
    *
@@ -166,6 +179,19 @@ class DeviceGrpc : public Device {
    */
   auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message> override;
 
+  /**
+   * @brief Polls for incoming messages from Astarte, as shared immutable messages.
+   *
+   * @details The received messages are queued as shared messages, which are handed out without
+   * being copied.
+   *
+   * @param[in] timeout The maximum duration to block waiting for a message.
+   * @return std::optional containing the SharedMessage if received, or std::nullopt if the
+   * timeout was reached.
+   */
+  auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage> override;
+
   /**
    * @brief Retrieves all stored properties matching an ownership filter.
    *
@@ -184,6 +210,45 @@ class DeviceGrpc : public Device {
   auto get_properties(std::string_view interface_name)
       -> astarte_tl::expected<std::list<StoredProperty>, Error> override;
 
+  /**
+   * @brief Retrieves all stored properties matching an ownership filter into a vector.
+   *
+   * @param[in] ownership Optional filter, if std::nullopt, returns all properties.
+   * @return An expected containing the vector of properties on success or Error on failure.
+   */
+  auto get_all_properties_vector(const std::optional<Ownership>& ownership)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error> override;
+
+  /**
+   * @brief Retrieves all stored properties belonging to a specific interface into a vector.
+   *
+   * @param[in] interface_name The name of the interface to query.
+   * @return An expected containing the vector of properties on success or Error on failure.
+   */
+  auto get_properties_vector(std::string_view interface_name)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error> override;
+
+  /**
+   * @brief Visits all stored properties matching an ownership filter.
+   *
+   * @param[in] ownership Optional filter, if std::nullopt, visits all properties.
+   * @param[in] visitor The callable invoked for each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit_all_properties(const std::optional<Ownership>& ownership,
+                            const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error> override;
+
+  /**
+   * @brief Visits all stored properties belonging to a specific interface.
+   *
+   * @param[in] interface_name The name of the interface to query.
+   * @param[in] visitor The callable invoked for each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit_properties(std::string_view interface_name, const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error> override;
+
   /**
    * @brief Retrieves a specific property value.
    *
@@ -24,9 +24,12 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
+#include "astarte_device_sdk/admission.hpp"
 #include "astarte_device_sdk/mqtt/errors.hpp"
 #include "astarte_device_sdk/mqtt/pairing.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
 
 namespace astarte::device::mqtt {
 
@@ -46,6 +49,24 @@ constexpr uint32_t DEFAULT_CONNECTION_TIMEOUT = 5;
 /// @brief Default disconnection timeout in seconds for the MQTT connection.
 constexpr auto DEFAULT_DISCONNECTION_TIMEOUT = 1s;
 
+/// @brief Default maximum number of QoS 1 and 2 messages that can be in-flight simultaneously.
+constexpr uint32_t DEFAULT_MAX_INFLIGHT = 100;
+
+/// @brief Default maximum number of messages buffered by the client while disconnected.
+constexpr uint32_t DEFAULT_MAX_BUFFERED_MESSAGES = 1000;
+
+/// @brief Default maximum number of topic aliases used when MQTT 5 is enabled.
+constexpr uint16_t DEFAULT_TOPIC_ALIAS_MAXIMUM = 64;
+
+/// @brief Default maximum number of received messages remembered to discard redeliveries.
+constexpr uint32_t DEFAULT_DEDUPLICATION_CAPACITY = 1024;
+
+/// @brief Default maximum number of sends waiting for the send workers.
+constexpr uint32_t DEFAULT_SEND_QUEUE_CAPACITY = 1024;
+
+/// @brief Default number of serialized bytes closing a batch of the send workers.
+constexpr uint32_t DEFAULT_SEND_BATCH_BYTES = 16384;
+
 /**
  * @brief Configuration for the Astarte MQTT connection.
  *
@@ -162,6 +183,10 @@ class Config {
   /**
    * @brief Sets the MQTT disconnection timeout.
    *
+   * @details With the send workers enabled, the disconnection also waits up to this timeout for
+   * the delivery of the queued sends. Past it, the sends still undelivered are left to the client
+   * and may be delivered on the next connection.
+   *
    * @param[in] duration The timeout duration in milliseconds.
    * @return A reference to the Config object for chaining.
    */
@@ -170,6 +195,229 @@ class Config {
     return *this;
   }
 
+  /**
+   * @brief Sets the maximum number of in-flight messages.
+   *
+   * @details QoS 1 and 2 messages count as in-flight from the moment they are published until
+   * they are acknowledged by the broker. Further publishes are queued by the client until a slot
+   * frees up, so a small window bounds the achievable throughput to one window per round trip.
+   *
+   * @param[in] max_inflight The maximum number of unacknowledged messages.
+   * @return A reference to the Config object for chaining.
+   */
+  auto max_inflight(uint32_t max_inflight) -> Config& {
+    this->max_inflight_ = max_inflight;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the maximum number of messages buffered while the client is disconnected.
+   *
+   * @param[in] max_buffered The maximum number of buffered messages.
+   * @return A reference to the Config object for chaining.
+   */
+  auto max_buffered_messages(uint32_t max_buffered) -> Config& {
+    this->max_buffered_ = max_buffered;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the policy applied when the offline buffer is full.
+   *
+   * @param[in] delete_oldest If true the oldest buffered message is discarded to make room for a
+   * new one, otherwise the new message is refused.
+   * @return A reference to the Config object for chaining.
+   */
+  auto delete_oldest_messages(bool delete_oldest) -> Config& {
+    this->delete_oldest_ = delete_oldest;
+    return *this;
+  }
+
+  /**
+   * @brief Sets whether messages published while disconnected are buffered.
+   *
+   * @details Buffering only applies after the first successful connection, i.e. while the client
+   * is automatically reconnecting to the broker. Disabled by default, the sends performed while
+   * disconnected fail.
+   *
+   * @param[in] send_while_disconnected True to buffer messages while disconnected.
+   * @return A reference to the Config object for chaining.
+   */
+  auto send_while_disconnected(bool send_while_disconnected) -> Config& {
+    this->send_while_disconnected_ = send_while_disconnected;
+    return *this;
+  }
+
+  /**
+   * @brief Sets whether the connection uses MQTT 5 instead of MQTT 3.1.1.
+   *
+   * @details MQTT 5 enables topic aliases, which replace the full publish topic of the QoS 0
+   * messages with a two bytes identifier for the most recently used topics.
+   *
+   * @param[in] enabled True to use MQTT 5.
+   * @return A reference to the Config object for chaining.
+   */
+  auto mqtt_v5(bool enabled) -> Config& {
+    this->mqtt_v5_ = enabled;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the maximum number of topic aliases used by the device.
+   *
+   * @details The effective number of aliases is also bounded by the maximum advertised by the
+   * broker on each connection. Topic aliases are only used when MQTT 5 is enabled, and only for the
+   * QoS 0 messages, as the other ones may be retransmitted on a later connection.
+   *
+   * @param[in] maximum The maximum number of topic aliases, zero disables topic aliases.
+   * @return A reference to the Config object for chaining.
+   */
+  auto topic_alias_maximum(uint16_t maximum) -> Config& {
+    this->topic_alias_max_ = maximum;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the time window in which redelivered messages are discarded.
+   *
+   * @details The broker may deliver a QoS 1 message more than once, for example after a
+   * reconnection. When the window is not zero each received server-owned datastream is
+   * remembered, by a hash of its topic and payload, and identical datastreams received within the
+   * window are discarded. Datastreams the server intentionally sends twice within the window are
+   * discarded as well. Properties and control messages are never discarded, since a repeated
+   * message may restore a state changed in the meantime.
+   *
+   * @param[in] window The deduplication window, zero disables the deduplication.
+   * @return A reference to the Config object for chaining.
+   */
+  auto deduplication_window(std::chrono::milliseconds window) -> Config& {
+    this->dedup_window_ = window;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the maximum number of received messages remembered for the deduplication.
+   *
+   * @details When the limit is reached the oldest message is forgotten, even if its window has
+   * not elapsed yet. The memory is allocated once when the device connects.
+   *
+   * @param[in] capacity The maximum number of remembered messages.
+   * @return A reference to the Config object for chaining.
+   */
+  auto deduplication_capacity(uint32_t capacity) -> Config& {
+    this->dedup_capacity_ = capacity;
+    return *this;
+  }
+
+  /**
+   * @brief Sets whether the received server-owned properties are persisted.
+   *
+   * @details The properties are stored in the store directory and the broker session is kept
+   * across connections. When the broker resumes the session and the stored properties are
+   * consistent with Astarte, the device skips the session setup, including the `emptyCache`
+   * request that makes Astarte resend all the server-owned properties. The stored values are
+   * returned by the property getters of the device, also across restarts.
+   *
+   * @param[in] enabled True to persist the server-owned properties.
+   * @return A reference to the Config object for chaining.
+   */
+  auto persist_server_properties(bool enabled) -> Config& {
+    this->persist_server_properties_ = enabled;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the number of worker threads serializing and publishing the datastreams.
+   *
+   * @details With zero workers, the default, datastreams are serialized and published on the
+   * calling thread, which returns once the publication completes. Otherwise the calling thread
+   * only validates the data and queues it, the BSON serialization and the publication run on the
+   * workers and their failures are logged. The sends of the same interface are always published
+   * in call order, the sends of different interfaces may be published concurrently.
+   *
+   * @param[in] workers The number of worker threads, zero to send on the calling thread.
+   * @return A reference to the Config object for chaining.
+   */
+  auto send_workers(uint32_t workers) -> Config& {
+    this->send_workers_ = workers;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the maximum number of sends waiting for the send workers.
+   *
+   * @details Sends exceeding the capacity are refused with an `OperationRefusedError`.
+   *
+   * @param[in] capacity The maximum number of queued sends.
+   * @return A reference to the Config object for chaining.
+   */
+  auto send_queue_capacity(uint32_t capacity) -> Config& {
+    this->send_queue_capacity_ = capacity;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the maximum time the send workers linger to batch further sends.
+   *
+   * @details Each send worker publishes the queued sends in batches, handing all the messages of
+   * a batch to the client before waiting for their delivery. A batch is closed once its messages
+   * reach `send_batch_bytes()` or once the linger time has elapsed. The linger time adapts to the
+   * load: it grows up to the maximum while the batches collect several sends and falls back to
+   * zero while the sends arrive one at a time, so that sparse sends are published immediately.
+   * Only used with send workers, see `send_workers()`.
+   *
+   * @param[in] linger The maximum linger time, zero to only batch the already queued sends.
+   * @return A reference to the Config object for chaining.
+   */
+  auto send_linger(std::chrono::microseconds linger) -> Config& {
+    this->send_linger_ = linger;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the number of serialized bytes closing a batch of the send workers.
+   *
+   * @param[in] batch_bytes The size of the payloads closing a batch.
+   * @return A reference to the Config object for chaining.
+   */
+  auto send_batch_bytes(uint32_t batch_bytes) -> Config& {
+    this->send_batch_bytes_ = batch_bytes;
+    return *this;
+  }
+
+  /**
+   * @brief Enables the admission control of the datastreams.
+   *
+   * @details Each datastream is admitted once validated, and accounted in the load of the
+   * outbound path until its publication completes, either on the calling thread or on the send
+   * workers. While the outbound path is saturated, for example because the broker slows down,
+   * the sends are refused with an `OverloadError` or dropped according to the policy of their
+   * interface, instead of blocking the calling threads. See `AdmissionOptions` for the policies.
+   *
+   * @param[in] options The admission options.
+   * @return A reference to the Config object for chaining.
+   */
+  auto admission(AdmissionOptions options) -> Config& {
+    this->admission_ = std::move(options);
+    return *this;
+  }
+
+  /**
+   * @brief Sets the hook invoked on the threads delivering the MQTT events and on the send
+   * workers.
+   *
+   * @details The event threads are owned by the Paho MQTT library, the hook is invoked once per
+   * thread before the first event is handled on it. The hook is invoked on each send worker when
+   * the device is created.
+   *
+   * @param[in] hook The hook to invoke, for example to apply a `ThreadConfig`.
+   * @return A reference to the Config object for chaining.
+   */
+  auto thread_hook(ThreadHook hook) -> Config& {
+    this->thread_hook_ = std::move(hook);
+    return *this;
+  }
+
   /**
    * @brief Gets the MQTT keep-alive interval.
    * @return The connection keepalive value.
@@ -190,6 +438,103 @@ class Config {
     return disconn_timeout_;
   }
 
+  /**
+   * @brief Gets the maximum number of in-flight messages.
+   * @return The in-flight window size.
+   */
+  [[nodiscard]] auto max_inflight() const -> uint32_t { return max_inflight_; }
+
+  /**
+   * @brief Gets the maximum number of messages buffered while disconnected.
+   * @return The offline buffer size.
+   */
+  [[nodiscard]] auto max_buffered_messages() const -> uint32_t { return max_buffered_; }
+
+  /**
+   * @brief Gets the policy applied when the offline buffer is full.
+   * @return True if the oldest buffered message is discarded, false if new messages are refused.
+   */
+  [[nodiscard]] auto delete_oldest_messages() const -> bool { return delete_oldest_; }
+
+  /**
+   * @brief Gets whether messages published while disconnected are buffered.
+   * @return True if messages are buffered while disconnected, false otherwise.
+   */
+  [[nodiscard]] auto send_while_disconnected() const -> bool { return send_while_disconnected_; }
+
+  /**
+   * @brief Gets whether the connection uses MQTT 5.
+   * @return True if MQTT 5 is used, false if MQTT 3.1.1 is used.
+   */
+  [[nodiscard]] auto mqtt_v5() const -> bool { return mqtt_v5_; }
+
+  /**
+   * @brief Gets the maximum number of topic aliases used by the device.
+   * @return The maximum number of topic aliases.
+   */
+  [[nodiscard]] auto topic_alias_maximum() const -> uint16_t { return topic_alias_max_; }
+
+  /**
+   * @brief Gets the time window in which redelivered messages are discarded.
+   * @return The deduplication window, zero if the deduplication is disabled.
+   */
+  [[nodiscard]] auto deduplication_window() const -> std::chrono::milliseconds {
+    return dedup_window_;
+  }
+
+  /**
+   * @brief Gets the maximum number of received messages remembered for the deduplication.
+   * @return The number of remembered messages.
+   */
+  [[nodiscard]] auto deduplication_capacity() const -> uint32_t { return dedup_capacity_; }
+
+  /**
+   * @brief Gets whether the received server-owned properties are persisted.
+   * @return True if the server-owned properties are persisted, false otherwise.
+   */
+  [[nodiscard]] auto persist_server_properties() const -> bool {
+    return persist_server_properties_;
+  }
+
+  /**
+   * @brief Gets the number of worker threads serializing and publishing the datastreams.
+   * @return The number of send workers, zero if the datastreams are sent on the calling thread.
+   */
+  [[nodiscard]] auto send_workers() const -> uint32_t { return send_workers_; }
+
+  /**
+   * @brief Gets the maximum number of sends waiting for the send workers.
+   * @return The capacity of the send queue.
+   */
+  [[nodiscard]] auto send_queue_capacity() const -> uint32_t { return send_queue_capacity_; }
+
+  /**
+   * @brief Gets the maximum time the send workers linger to batch further sends.
+   * @return The maximum linger time, zero if only the already queued sends are batched.
+   */
+  [[nodiscard]] auto send_linger() const -> std::chrono::microseconds { return send_linger_; }
+
+  /**
+   * @brief Gets the number of serialized bytes closing a batch of the send workers.
+   * @return The size of the payloads closing a batch.
+   */
+  [[nodiscard]] auto send_batch_bytes() const -> uint32_t { return send_batch_bytes_; }
+
+  /**
+   * @brief Gets the options of the admission control of the datastreams.
+   * @return The admission options, nullopt if every datastream is admitted.
+   */
+  [[nodiscard]] auto admission() const -> const std::optional<AdmissionOptions>& {
+    return admission_;
+  }
+
+  /**
+   * @brief Gets the hook invoked on the threads delivering the MQTT events and on the send
+   * workers.
+   * @return The thread hook, empty if not set.
+   */
+  [[nodiscard]] auto thread_hook() const -> const ThreadHook& { return thread_hook_; }
+
  private:
   /**
    * @brief Private constructor.
@@ -215,6 +560,21 @@ class Config {
   uint32_t keepalive_;
   uint32_t conn_timeout_;
   std::chrono::milliseconds disconn_timeout_;
+  uint32_t max_inflight_;
+  uint32_t max_buffered_;
+  bool delete_oldest_{false};
+  bool send_while_disconnected_{false};
+  bool mqtt_v5_{false};
+  uint16_t topic_alias_max_;
+  std::chrono::milliseconds dedup_window_{0};
+  uint32_t dedup_capacity_;
+  bool persist_server_properties_{false};
+  uint32_t send_workers_{0};
+  uint32_t send_queue_capacity_;
+  std::chrono::microseconds send_linger_{0};
+  uint32_t send_batch_bytes_;
+  std::optional<AdmissionOptions> admission_;
+  ThreadHook thread_hook_;
 };
 
 }  // namespace astarte::device::mqtt
@@ -21,6 +21,7 @@
 #include <string>
 #include <string_view>
 
+#include "astarte_device_sdk/admission.hpp"
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/device.hpp"
 #include "astarte_device_sdk/mqtt/config.hpp"
@@ -135,6 +136,42 @@ class DeviceMqtt : public Device {
                        const std::chrono::system_clock::time_point* timestamp)
       -> astarte_tl::expected<void, Error> override;
 
+  /**
+   * @brief Sends an individual data point to an Astarte Interface, taking ownership of the data.
+   *
+   * @details When send workers are configured, see `Config::send_workers`, the data is moved to
+   * the worker instead of being copied.
+   *
+   * @param[in] interface_name The name of the target interface.
+   * @param[in] path The specific mapping path within the interface (e.g., "/sensors/temp").
+   * @param[in] data The value payload to transmit.
+   * @param[in] timestamp Optional timestamp. Should match the interface timestamp configuration.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto send_individual(std::string_view interface_name, std::string_view path, Data&& data,
+                       const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Sends a typed individual data point to an Astarte Interface.
+   *
+   * @details The Astarte type of the value is resolved at compile time, see `k_astarte_type`, so
+   * the value is validated and serialized without being wrapped in a `Data`. Values sent through
+   * the send workers, see `Config::send_workers`, or while a capture is running are wrapped in a
+   * `Data` and follow the same path as the other overloads.
+   *
+   * @tparam T The C++ type of the value, must satisfy `DataAllowedType`.
+   * @param[in] interface_name The name of the target interface.
+   * @param[in] path The specific mapping path within the interface (e.g., "/sensors/temp").
+   * @param[in] value The value to transmit.
+   * @param[in] timestamp Optional timestamp. Should match the interface timestamp configuration.
+   * @return An expected containing void on success or Error on failure.
+   */
+  template <DataAllowedType T>
+  auto send_individual(std::string_view interface_name, std::string_view path, const T& value,
+                       const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error>;
+
   /**
    * @brief Sends an aggregated object to an Astarte Interface.
    *
@@ -149,6 +186,42 @@ class DeviceMqtt : public Device {
                    const std::chrono::system_clock::time_point* timestamp)
       -> astarte_tl::expected<void, Error> override;
 
+  /**
+   * @brief Sends an aggregated object to an Astarte Interface, taking ownership of the object.
+   *
+   * @details When send workers are configured, see `Config::send_workers`, the object is moved to
+   * the worker instead of being copied.
+   *
+   * @param[in] interface_name The name of the target interface.
+   * @param[in] path The common base path for the object aggregation.
+   * @param[in] object The map of keys and values constituting the object.
+   * @param[in] timestamp Optional timestamp. Should match the interface timestamp configuration.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto send_object(std::string_view interface_name, std::string_view path,
+                   DatastreamObject&& object,
+                   const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Gets the counters of the admission control of the datastreams.
+   *
+   * @details All the counters are zero unless the admission control is enabled, see
+   * `Config::admission`.
+   *
+   * @return The counters of all the interfaces.
+   */
+  [[nodiscard]] auto admission_counters() const -> AdmissionCounters;
+
+  /**
+   * @brief Gets the counters of the admission control of the datastreams of an interface.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @return The counters of the interface.
+   */
+  [[nodiscard]] auto admission_counters(std::string_view interface_name) const
+      -> AdmissionCounters;
+
   /**
    * @brief Updates a local device property and synchronize it with Astarte.
    *
@@ -182,6 +255,19 @@ class DeviceMqtt : public Device {
    */
   auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message> override;
 
+  /**
+   * @brief Polls for incoming messages from Astarte, as shared immutable messages.
+   *
+   * @details The received messages are queued as shared messages, which are handed out without
+   * being copied.
+   *
+   * @param[in] timeout The maximum duration to block waiting for a message.
+   * @return std::optional containing the SharedMessage if received, or std::nullopt if the
+   * timeout was reached.
+   */
+  auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage> override;
+
   /**
    * @brief Retrieves all stored properties matching an ownership filter.
    *
@@ -13,6 +13,7 @@
  * exchanged with the Astarte platform, encapsulating interface names, paths, and payloads.
  */
 
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -132,6 +133,106 @@ class Message {
   std::variant<DatastreamIndividual, DatastreamObject, PropertyIndividual> data_;
 };
 
+/**
+ * @brief Reference counted handle to an immutable Message.
+ *
+ * @details Copying the handle shares the message instead of copying its payload, so that a
+ * received message can be handed to several queues and threads at the cost of a reference count
+ * increment. The shared message can not be modified through any of its handles.
+ *
+ * A handle that has been moved from, or converted with into_message(), is empty. An empty handle
+ * can be assigned, compared and formatted, while accessing its message is a precondition
+ * violation checked by assertions.
+ */
+class SharedMessage {
+ public:
+  /**
+   * @brief Constructor for the SharedMessage class, taking ownership of the message.
+   *
+   * @param[in] message The message to share.
+   */
+  explicit SharedMessage(Message message);
+
+  /**
+   * @brief Checks whether the handle shares a message.
+   *
+   * @return False for a handle that has been moved from, true otherwise.
+   */
+  [[nodiscard]] auto has_value() const -> bool;
+
+  /**
+   * @brief Checks whether the handle shares a message.
+   *
+   * @return False for a handle that has been moved from, true otherwise.
+   */
+  [[nodiscard]] explicit operator bool() const;
+
+  /**
+   * @brief Gets the shared message.
+   *
+   * @details The handle must not be empty.
+   *
+   * @return A constant reference to the message.
+   */
+  [[nodiscard]] auto get() const -> const Message&;
+
+  /**
+   * @brief Gets the shared message.
+   *
+   * @details The handle must not be empty.
+   *
+   * @return A constant reference to the message.
+   */
+  [[nodiscard]] auto operator*() const -> const Message&;
+
+  /**
+   * @brief Accesses the members of the shared message.
+   *
+   * @details The handle must not be empty.
+   *
+   * @return A pointer to the message.
+   */
+  [[nodiscard]] auto operator->() const -> const Message*;
+
+  /**
+   * @brief Gets the number of handles sharing the message.
+   *
+   * @return The number of handles, zero for a handle that has been moved from.
+   */
+  [[nodiscard]] auto use_count() const -> long;
+
+  /**
+   * @brief Converts the handle into a message.
+   *
+   * @details The message is moved out when this is its only handle, and copied otherwise. The
+   * handle must not be empty, and is left empty.
+   *
+   * @return The message.
+   */
+  [[nodiscard]] auto into_message() && -> Message;
+
+  /**
+   * @brief Overloader for the comparison operator ==.
+   *
+   * @param[in] other The object to compare to.
+   * @return True when the shared messages are equal or both handles are empty, false otherwise.
+   */
+  [[nodiscard]] auto operator==(const SharedMessage& other) const -> bool;
+
+  /**
+   * @brief Overloader for the comparison operator !=.
+   *
+   * @param[in] other The object to compare to.
+   * @return True when the shared messages are different, false otherwise.
+   */
+  [[nodiscard]] auto operator!=(const SharedMessage& other) const -> bool;
+
+ private:
+  // Only constant access is given to the message, it is moved out by into_message() when no
+  // other handle can observe it.
+  std::shared_ptr<Message> message_;
+};
+
 }  // namespace astarte::device
 
 /// @brief astarte_fmt::formatter specialization for astarte::device::Message.
@@ -179,6 +280,26 @@ struct astarte_fmt::formatter<astarte::device::Message> {
   }
 };
 
+/// @brief astarte_fmt::formatter specialization for astarte::device::SharedMessage.
+template <>
+struct astarte_fmt::formatter<astarte::device::SharedMessage>
+    : astarte_fmt::formatter<astarte::device::Message> {
+  /**
+   * @brief Formats the shared message.
+   *
+   * @param[in] msg The SharedMessage instance to format.
+   * @param[in,out] ctx The format context.
+   * @return An iterator to the end of the output.
+   */
+  template <typename FormatContext>
+  auto format(const astarte::device::SharedMessage& msg, FormatContext& ctx) const {
+    if (!msg) {
+      return astarte_fmt::format_to(ctx.out(), "{{empty}}");
+    }
+    return astarte_fmt::formatter<astarte::device::Message>::format(msg.get(), ctx);
+  }
+};
+
 /**
  * @brief Stream insertion operator for Message.
  *
@@ -191,4 +312,17 @@ inline auto operator<<(std::ostream& out, const astarte::device::Message& msg) -
   return out;
 }
 
+/**
+ * @brief Stream insertion operator for SharedMessage.
+ *
+ * @param[in,out] out The output stream.
+ * @param[in] msg The SharedMessage object to output.
+ * @return A reference to the output stream.
+ */
+inline auto operator<<(std::ostream& out, const astarte::device::SharedMessage& msg)
+    -> std::ostream& {
+  out << astarte_fmt::format("{}", msg);
+  return out;
+}
+
 #endif  // ASTARTE_DEVICE_SDK_MSG_H
@@ -13,10 +13,14 @@
  * allowing multiple Astarte data fields to be grouped and sent as a single coherent unit.
  */
 
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/formatter.hpp"
@@ -32,8 +36,21 @@ namespace astarte::device {
  */
 class DatastreamObject {
  public:
+  /// @brief Transparent hash of the keys, letting the map be searched without building a string.
+  struct KeyHash {
+    /// @brief Enables the lookups with any type convertible to std::string_view.
+    using is_transparent = void;
+    /**
+     * @brief Hashes a key.
+     * @param[in] key The key to hash.
+     * @return The hash of the key, equal for a std::string and a std::string_view of the same text.
+     */
+    auto operator()(std::string_view key) const noexcept -> std::size_t {
+      return std::hash<std::string_view>{}(key);
+    }
+  };
   /// @brief Helper type for the map of paths and Astarte datas.
-  using MapType = std::unordered_map<std::string, Data>;
+  using MapType = std::unordered_map<std::string, Data, KeyHash, std::equal_to<>>;
   /// @brief Helper type for the iterator over the map of paths and Astarte datas.
   using iterator = MapType::iterator;
   /// @brief Helper type for the const iterator over the map of paths and Astarte datas.
@@ -53,25 +70,39 @@ class DatastreamObject {
    */
   DatastreamObject(std::initializer_list<value_type> init);
 
+  /**
+   * @brief Constructs an empty DatastreamObject with room for a number of elements.
+   *
+   * @details Building an object of known size, such as one holding a value for each mapping of
+   * an interface, does not rehash the map while it is filled.
+   *
+   * @param[in] capacity The number of elements the object can hold without rehashing.
+   */
+  explicit DatastreamObject(size_type capacity);
+
   /**
    * @brief Accesses the specified element with bounds checking.
    *
-   * @details Soft wrapper for the equivalent method in the std::unordered_map.
+   * @details Soft wrapper for the equivalent method in the std::unordered_map. The key is
+   * searched without being copied into a string.
    *
    * @param[in] key The key to search for.
    * @return A reference to the value corresponding to the key.
+   * @throws std::out_of_range If the object does not contain the key.
    */
-  auto at(const std::string& key) -> Data&;
+  auto at(std::string_view key) -> Data&;
 
   /**
    * @brief Accesses the specified element with bounds checking.
    *
-   * @details Soft wrapper for the equivalent method in the std::unordered_map.
+   * @details Soft wrapper for the equivalent method in the std::unordered_map. The key is
+   * searched without being copied into a string.
    *
    * @param[in] key The key to search for.
    * @return A constant reference to the value corresponding to the key.
+   * @throws std::out_of_range If the object does not contain the key.
    */
-  auto at(const std::string& key) const -> const Data&;
+  auto at(std::string_view key) const -> const Data&;
 
   /**
    * @brief Returns an iterator to the beginning of the map.
@@ -128,14 +159,44 @@ class DatastreamObject {
   auto empty() const -> bool;
 
   /**
-   * @brief Inserts elements into the map.
+   * @brief Reserves room for a number of elements.
    *
    * @details Soft wrapper for the equivalent method in the std::unordered_map.
    *
+   * @param[in] count The number of elements the object can hold without rehashing.
+   */
+  void reserve(size_type count);
+
+  /**
+   * @brief Inserts elements into the map.
+   *
+   * @details Soft wrapper for the equivalent method in the std::unordered_map. Nothing is
+   * inserted if the key is already present. Temporaries are moved into the map.
+   *
    * @param[in] key The key to insert.
    * @param[in] data The value to insert.
    */
-  void insert(const std::string& key, const Data& data);
+  void insert(std::string key, Data data);
+
+  /**
+   * @brief Constructs an element in place if the key is not present.
+   *
+   * @details Unlike the equivalent method in the std::unordered_map, the key is only copied into
+   * a string when the element is inserted.
+   *
+   * @tparam Args The types of the arguments of the Data constructor.
+   * @param[in] key The key of the element.
+   * @param[in] args The arguments forwarded to the Data constructor.
+   * @return An iterator to the element with the key, and true if the element has been inserted.
+   */
+  template <typename... Args>
+  auto try_emplace(std::string_view key, Args&&... args) -> std::pair<iterator, bool> {
+    auto found = data_.find(key);
+    if (found != data_.end()) {
+      return {found, false};
+    }
+    return data_.try_emplace(std::string(key), std::forward<Args>(args)...);
+  }
 
   /**
    * @brief Erases elements from the map.
@@ -145,7 +206,7 @@ class DatastreamObject {
    * @param[in] key The key of the element to erase.
    * @return The number of elements removed (0 or 1).
    */
-  auto erase(const std::string& key) -> size_type;
+  auto erase(std::string_view key) -> size_type;
 
   /**
    * @brief Clears the contents of the map.
@@ -162,7 +223,7 @@ class DatastreamObject {
    * @param[in] key The key to find.
    * @return An iterator to the requested element.
    */
-  auto find(const std::string& key) -> iterator;
+  auto find(std::string_view key) -> iterator;
 
   /**
    * @brief Finds an element with a specific key.
@@ -172,7 +233,17 @@ class DatastreamObject {
    * @param[in] key The key to find.
    * @return A constant iterator to the requested element.
    */
-  auto find(const std::string& key) const -> const_iterator;
+  auto find(std::string_view key) const -> const_iterator;
+
+  /**
+   * @brief Checks if the map contains an element with a specific key.
+   *
+   * @details Soft wrapper for the equivalent method in the std::unordered_map.
+   *
+   * @param[in] key The key to find.
+   * @return True if the key is present, false otherwise.
+   */
+  auto contains(std::string_view key) const -> bool;
 
   /**
    * @brief Returns the raw data contained in this class instance.
@@ -11,9 +11,13 @@
  *
  * @details This file defines the StoredProperty class, which acts as a container for
  * a property's value and its associated metadata (interface name, path, version, ownership).
+ * It also defines StoredPropertyView, a non-owning counterpart used to stream large property sets
+ * without materializing them.
  */
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <string_view>
@@ -43,8 +47,23 @@ class StoredProperty {
    */
   explicit StoredProperty(std::string_view interface_name, std::string_view path,
                           int32_t version_major, Ownership ownership, Data data);
+  /**
+   * @brief Constructs a new Stored Property instance sharing its interface name.
+   *
+   * @details Properties of the same interface can share a single interface name string, avoiding
+   * a copy of the name for each property of large property sets.
+   *
+   * @param[in] interface_name The shared name of the interface the property belongs to.
+   * @param[in] path The specific path of the property.
+   * @param[in] version_major The major version of the interface.
+   * @param[in] ownership The ownership of the interface.
+   * @param[in] data The value payload of the property.
+   */
+  explicit StoredProperty(std::shared_ptr<const std::string> interface_name, std::string_view path,
+                          int32_t version_major, Ownership ownership, Data data);
   /**
    * @brief Retrieves the interface name.
+   * @details The name of a moved-from property is empty, as its path.
    * @return A constant reference to the interface name string.
    */
   [[nodiscard]] auto get_interface_name() const -> const std::string&;
@@ -82,13 +101,81 @@ class StoredProperty {
   [[nodiscard]] auto operator!=(const StoredProperty& other) const -> bool;
 
  private:
+  // The name is owned by the property unless shared with the other properties of its interface
   std::string interface_name_;
+  std::shared_ptr<const std::string> shared_interface_name_;
   std::string path_;
   int32_t version_major_;
   Ownership ownership_;
   Data data_;
 };
 
+/**
+ * @brief Non-owning view of a property stored on the device.
+ *
+ * @details Views are handed to the property visitors and reference memory owned by the caller of
+ * the visitor. They are valid only for the duration of the visitor call, use
+ * `to_stored_property()` to retain a property.
+ */
+class StoredPropertyView {
+ public:
+  /**
+   * @brief Constructs a new Stored Property View instance.
+   *
+   * @param[in] interface_name The name of the interface the property belongs to.
+   * @param[in] path The specific path of the property.
+   * @param[in] version_major The major version of the interface.
+   * @param[in] ownership The ownership of the interface.
+   * @param[in] data The value payload of the property.
+   */
+  explicit StoredPropertyView(std::string_view interface_name, std::string_view path,
+                              int32_t version_major, Ownership ownership, const Data& data);
+  /**
+   * @brief Retrieves the interface name.
+   * @return A view of the interface name string.
+   */
+  [[nodiscard]] auto get_interface_name() const -> std::string_view;
+  /**
+   * @brief Retrieves the property path.
+   * @return A view of the path string.
+   */
+  [[nodiscard]] auto get_path() const -> std::string_view;
+  /**
+   * @brief Retrieves the major version of the interface.
+   * @return The major version integer.
+   */
+  [[nodiscard]] auto get_version_major() const -> int32_t;
+  /**
+   * @brief Retrieves the ownership of the interface.
+   * @return The ownership enumeration.
+   */
+  [[nodiscard]] auto get_ownership() const -> Ownership;
+  /**
+   * @brief Retrieves the value of the property.
+   * @return A constant reference to the Data object containing the value.
+   */
+  [[nodiscard]] auto get_value() const -> const Data&;
+  /**
+   * @brief Copies the viewed property into an owning StoredProperty.
+   * @return The stored property.
+   */
+  [[nodiscard]] auto to_stored_property() const -> StoredProperty;
+
+ private:
+  std::string_view interface_name_;
+  std::string_view path_;
+  int32_t version_major_;
+  Ownership ownership_;
+  const Data* data_;
+};
+
+/**
+ * @brief Callable invoked once for each property of a property set.
+ *
+ * @details The view passed to the visitor is valid only for the duration of the call.
+ */
+using StoredPropertyVisitor = std::function<void(const StoredPropertyView&)>;
+
 }  // namespace astarte::device
 
 /// @brief astarte_fmt::formatter specialization for astarte::device::StoredProperty.
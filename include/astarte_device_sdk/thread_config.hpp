@@ -0,0 +1,183 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DEVICE_SDK_THREAD_CONFIG_H
+#define ASTARTE_DEVICE_SDK_THREAD_CONFIG_H
+
+/**
+ * @file astarte_device_sdk/thread_config.hpp
+ * @brief Configuration of the threads run by the Astarte device.
+ *
+ * @details This file defines the `ThreadConfig` class, describing the name, CPU affinity and
+ * scheduling of a thread, and the `ThreadHook` callable that the devices invoke on each of their
+ * threads before it starts doing any work.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+
+namespace astarte::device {
+
+/// @brief Threads run by the Astarte devices.
+enum class ThreadRole : uint8_t {
+  /// @brief gRPC thread attaching to the message hub and receiving its events.
+  kGrpcConnection,
+  /// @brief Paho MQTT thread delivering the connection and message events.
+  kMqttCallback,
+  /// @brief Thread of a FailoverDevice monitoring the connection of its devices.
+  kFailoverMonitor,
+  /// @brief MQTT worker thread serializing and publishing the sends of the application.
+  kMqttSendWorker,
+};
+
+/**
+ * @brief Gets the default name given to the threads of a role.
+ *
+ * @param[in] role The thread role.
+ * @return The default thread name.
+ */
+[[nodiscard]] auto thread_role_name(ThreadRole role) -> std::string_view;
+
+/// @brief Scheduling policies that can be applied to a thread.
+enum class SchedulingPolicy : uint8_t {
+  /// @brief Default time-sharing policy.
+  kOther,
+  /// @brief Time-sharing policy for CPU intensive, non-interactive threads.
+  kBatch,
+  /// @brief Policy for very low priority background threads.
+  kIdle,
+  /// @brief Real-time first-in first-out policy.
+  kFifo,
+  /// @brief Real-time round-robin policy.
+  kRoundRobin,
+};
+
+/**
+ * @brief Name, CPU affinity and scheduling of a thread.
+ *
+ * @details Each setting is optional, unset settings leave the thread untouched. The configuration
+ * is applied to the calling thread with `apply()`, usually from a `ThreadHook`. Affinity and
+ * scheduling are only supported on Linux.
+ */
+class ThreadConfig {
+ public:
+  /**
+   * @brief Sets the thread name, as shown by tools such as top and perf.
+   *
+   * @details Linux limits thread names to 15 characters, longer names are truncated.
+   *
+   * @param[in] name The thread name.
+   * @return A reference to the ThreadConfig object for chaining.
+   */
+  auto name(std::string name) -> ThreadConfig& {
+    this->name_ = std::move(name);
+    return *this;
+  }
+
+  /**
+   * @brief Sets the CPUs the thread is allowed to run on.
+   *
+   * @param[in] cpus The indexes of the allowed CPUs.
+   * @return A reference to the ThreadConfig object for chaining.
+   */
+  auto cpu_affinity(std::vector<uint32_t> cpus) -> ThreadConfig& {
+    this->cpus_ = std::move(cpus);
+    return *this;
+  }
+
+  /**
+   * @brief Sets the scheduling policy and static priority of the thread.
+   *
+   * @details The priority must be zero for the time-sharing policies and between 1 and 99 for the
+   * real-time ones. Real-time policies usually require additional privileges.
+   *
+   * @param[in] policy The scheduling policy.
+   * @param[in] priority The static priority.
+   * @return A reference to the ThreadConfig object for chaining.
+   */
+  auto scheduling(SchedulingPolicy policy, int32_t priority = 0) -> ThreadConfig& {
+    this->policy_ = policy;
+    this->priority_ = priority;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the nice value of the thread, used by the time-sharing policies.
+   *
+   * @param[in] nice The nice value, between -20 (highest priority) and 19 (lowest priority).
+   * @return A reference to the ThreadConfig object for chaining.
+   */
+  auto nice(int32_t nice) -> ThreadConfig& {
+    this->nice_ = nice;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the thread name.
+   * @return The thread name if set, std::nullopt otherwise.
+   */
+  [[nodiscard]] auto name() const -> const std::optional<std::string>& { return name_; }
+
+  /**
+   * @brief Gets the CPUs the thread is allowed to run on.
+   * @return The indexes of the allowed CPUs, empty to leave the affinity untouched.
+   */
+  [[nodiscard]] auto cpu_affinity() const -> const std::vector<uint32_t>& { return cpus_; }
+
+  /**
+   * @brief Gets the scheduling policy.
+   * @return The scheduling policy if set, std::nullopt otherwise.
+   */
+  [[nodiscard]] auto scheduling_policy() const -> std::optional<SchedulingPolicy> {
+    return policy_;
+  }
+
+  /**
+   * @brief Gets the static priority used with the scheduling policy.
+   * @return The static priority.
+   */
+  [[nodiscard]] auto scheduling_priority() const -> int32_t { return priority_; }
+
+  /**
+   * @brief Gets the nice value.
+   * @return The nice value if set, std::nullopt otherwise.
+   */
+  [[nodiscard]] auto nice() const -> std::optional<int32_t> { return nice_; }
+
+  /**
+   * @brief Applies the configuration to the calling thread.
+   *
+   * @details All the settings are attempted, the first failure is returned.
+   *
+   * @return An expected containing void on success or Error on failure.
+   */
+  [[nodiscard]] auto apply() const -> astarte_tl::expected<void, Error>;
+
+ private:
+  std::optional<std::string> name_;
+  std::vector<uint32_t> cpus_;
+  std::optional<SchedulingPolicy> policy_;
+  int32_t priority_{0};
+  std::optional<int32_t> nice_;
+};
+
+/**
+ * @brief Callable invoked on each thread run by a device, before the thread starts working.
+ *
+ * @details The hook runs on the configured thread, after the SDK gave it its default name, and
+ * typically applies a `ThreadConfig` chosen by role. Threads created internally by third party
+ * libraries and never running SDK code cannot be configured.
+ */
+using ThreadHook = std::function<void(ThreadRole role)>;
+
+}  // namespace astarte::device
+
+#endif  // ASTARTE_DEVICE_SDK_THREAD_CONFIG_H
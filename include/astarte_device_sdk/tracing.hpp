@@ -0,0 +1,65 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DEVICE_SDK_TRACING_H
+#define ASTARTE_DEVICE_SDK_TRACING_H
+
+/**
+ * @file astarte_device_sdk/tracing.hpp
+ * @brief Tracing of the SDK send and receive pipelines.
+ *
+ * @details The SDK records a span for each stage of its send and receive pipelines, such as the
+ * interface lookup, the data validation, the serialization and the transmission. Spans are kept
+ * in a fixed-size ring per thread, overwriting the oldest ones, and can be exported in the Chrome
+ * trace event format, which can be opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is disabled by default, a disabled span costs a single relaxed atomic load. Spans can
+ * also be compiled out entirely with the `ASTARTE_ENABLE_TRACING` CMake option.
+ */
+
+#include <ostream>
+#include <string>
+
+namespace astarte::device::tracing {
+
+/**
+ * @brief Starts recording spans.
+ */
+void enable();
+
+/**
+ * @brief Stops recording spans, already recorded spans are kept.
+ */
+void disable();
+
+/**
+ * @brief Checks if spans are being recorded.
+ * @return True if tracing is enabled, false otherwise.
+ */
+[[nodiscard]] auto is_enabled() -> bool;
+
+/**
+ * @brief Discards all the recorded spans.
+ */
+void clear();
+
+/**
+ * @brief Writes the recorded spans in the Chrome trace event JSON format.
+ *
+ * @details Spans can be exported while they are being recorded, spans overwritten during the
+ * export are skipped.
+ *
+ * @param[in,out] out The stream the trace is written to.
+ */
+void write_chrome_trace(std::ostream& out);
+
+/**
+ * @brief Gets the recorded spans in the Chrome trace event JSON format.
+ * @return The JSON trace.
+ */
+[[nodiscard]] auto chrome_trace() -> std::string;
+
+}  // namespace astarte::device::tracing
+
+#endif  // ASTARTE_DEVICE_SDK_TRACING_H
@@ -0,0 +1,146 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_ADMISSION_CONTROLLER_H
+#define ASTARTE_ADMISSION_CONTROLLER_H
+
+/**
+ * @file private/admission_controller.hpp
+ * @brief Admission control of the sends of a device.
+ *
+ * @details This file defines the `AdmissionController` class, which tracks the sends waiting for
+ * their delivery and decides whether a new send is admitted, refused or dropped according to the
+ * policy of its interface.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "astarte_device_sdk/admission.hpp"
+#include "astarte_device_sdk/errors.hpp"
+
+namespace astarte::device {
+
+/**
+ * @brief Tracks the outbound load of a device and admits its sends accordingly.
+ *
+ * @details Each admitted send holds a ticket, accounting the send and its bytes in the load until
+ * the ticket is destroyed, once the send has been delivered or has failed. The policies are
+ * described in `AdmissionOptions`.
+ */
+class AdmissionController {
+ public:
+  /// @brief An admitted send, released from the load when destroyed.
+  class Ticket {
+   public:
+    /// @brief Destructor, releasing the send from the load.
+    ~Ticket();
+
+    /// @brief Ticket is non-copyable.
+    Ticket(const Ticket& other) = delete;
+
+    /**
+     * @brief Move constructor, the moved-from ticket no longer releases the send.
+     * @param[in,out] other The ticket to move.
+     */
+    Ticket(Ticket&& other) noexcept;
+
+    /// @brief Ticket is non-copyable.
+    auto operator=(const Ticket& other) -> Ticket& = delete;
+
+    /// @brief Ticket is non-move-assignable.
+    auto operator=(Ticket&& other) -> Ticket& = delete;
+
+   private:
+    friend class AdmissionController;
+
+    Ticket(AdmissionController* controller, size_t bytes);
+
+    AdmissionController* controller_;
+    size_t bytes_;
+  };
+
+  /**
+   * @brief Constructs the controller.
+   * @param[in] options The admission options.
+   */
+  explicit AdmissionController(AdmissionOptions options);
+
+  /**
+   * @brief Decides whether a send is admitted.
+   *
+   * @param[in] interface_name The interface of the send.
+   * @param[in] bytes The size of the payload of the send.
+   * @return The ticket of the admitted send, nullopt if the send must be dropped, or an
+   * OverloadError if the send is refused.
+   */
+  auto admit(std::string_view interface_name, size_t bytes)
+      -> astarte_tl::expected<std::optional<Ticket>, Error>;
+
+  /**
+   * @brief Gets the counters of the decisions taken for all the interfaces.
+   * @return The total counters.
+   */
+  [[nodiscard]] auto counters() const -> AdmissionCounters;
+
+  /**
+   * @brief Gets the counters of the decisions taken for an interface.
+   * @param[in] interface_name The name of the interface.
+   * @return The counters of the interface, all zero if it never sent.
+   */
+  [[nodiscard]] auto counters(std::string_view interface_name) const -> AdmissionCounters;
+
+  /**
+   * @brief Gets the number of admitted sends not yet released.
+   * @return The number of pending sends.
+   */
+  [[nodiscard]] auto pending_sends() const -> size_t;
+
+  /**
+   * @brief Gets the payload bytes of the admitted sends not yet released.
+   * @return The number of pending bytes.
+   */
+  [[nodiscard]] auto pending_bytes() const -> size_t;
+
+ private:
+  /// @brief Settings and counters of an interface.
+  struct InterfaceState {
+    InterfaceAdmission settings{};
+    AdmissionCounters counters{};
+    // Number of sends considered while sampling, used to admit one every `sample_every`.
+    uint64_t sampled{0};
+  };
+
+  /**
+   * @brief Computes the load of the outbound path once a send is admitted.
+   * @details Must be called with the mutex held.
+   * @param[in] bytes The size of the payload of the send.
+   * @return The load, above one if the send exceeds the limits.
+   */
+  [[nodiscard]] auto load_with(size_t bytes) const -> double;
+
+  /**
+   * @brief Releases an admitted send from the load.
+   * @param[in] bytes The size of the payload of the send.
+   */
+  void release(size_t bytes);
+
+  AdmissionOptions options_;
+  // Highest priority configured, scaling the drop thresholds of the priorities.
+  uint32_t max_priority_;
+  mutable std::mutex mutex_;
+  size_t pending_sends_{0};
+  size_t pending_bytes_{0};
+  AdmissionCounters totals_;
+  std::map<std::string, InterfaceState, std::less<>> interfaces_;
+};
+
+}  // namespace astarte::device
+
+#endif  // ASTARTE_ADMISSION_CONTROLLER_H
@@ -0,0 +1,77 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_CAPTURE_SEND_H
+#define ASTARTE_CAPTURE_SEND_H
+
+/**
+ * @file private/capture_send.hpp
+ * @brief Recording of the device send calls in the running capture.
+ *
+ * @details Wrap the send calls with `captured` to append them to the running capture, if any.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <utility>
+
+#include "astarte_device_sdk/capture.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/object.hpp"
+
+namespace astarte::device::capture {
+
+/// @brief True while a capture is running.
+inline std::atomic<bool> active_flag{false};
+
+/// @brief Arguments of a send call, referencing the caller data.
+struct SendCall {
+  /// @brief The called method.
+  SendKind kind;
+  /// @brief The name of the interface.
+  std::string_view interface_name;
+  /// @brief The path of the data.
+  std::string_view path;
+  /// @brief The sent data, for individuals and properties.
+  const Data* data;
+  /// @brief The sent object, for objects.
+  const DatastreamObject* object;
+  /// @brief The explicit timestamp of the data, if any.
+  const std::chrono::system_clock::time_point* timestamp;
+};
+
+/**
+ * @brief Appends a send call to the running capture, does nothing if no capture is running.
+ *
+ * @param[in] call The arguments of the call.
+ * @param[in] start The time at which the call started.
+ * @param[in] duration The time spent in the call.
+ * @param[in] succeeded True if the call succeeded.
+ */
+void record(const SendCall& call, std::chrono::steady_clock::time_point start,
+            std::chrono::nanoseconds duration, bool succeeded);
+
+/**
+ * @brief Performs a send call, recording it in the running capture.
+ *
+ * @param[in] call The arguments of the call.
+ * @param[in] send Callable performing the call.
+ * @return The result of the call.
+ */
+template <typename Send>
+auto captured(const SendCall& call, Send&& send) -> astarte_tl::expected<void, Error> {
+  if (!active_flag.load(std::memory_order_relaxed)) {
+    return std::forward<Send>(send)();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  auto res = std::forward<Send>(send)();
+  record(call, start, std::chrono::steady_clock::now() - start, res.has_value());
+  return res;
+}
+
+}  // namespace astarte::device::capture
+
+#endif  // ASTARTE_CAPTURE_SEND_H
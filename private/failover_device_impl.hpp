@@ -0,0 +1,241 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_FAILOVER_DEVICE_IMPL_H
+#define ASTARTE_FAILOVER_DEVICE_IMPL_H
+
+/**
+ * @file private/failover_device_impl.hpp
+ * @brief Private implementation of the FailoverDevice class.
+ *
+ * @details The implementation monitors the connection of the two devices from a dedicated thread,
+ * switching the route of the sends, and keeps the sends performed while neither device is
+ * connected in a bounded buffer.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "astarte_device_sdk/capture.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/failover_device.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "capture_send.hpp"
+
+namespace astarte::device {
+
+/**
+ * @brief Implementation class for the failover device.
+ *
+ * @details Implements the logic declared in FailoverDevice using the PIMPL idiom.
+ */
+struct FailoverDevice::FailoverDeviceImpl {
+ public:
+  /**
+   * @brief Constructs a FailoverDeviceImpl instance.
+   * @param[in] primary The device used whenever it is connected.
+   * @param[in] fallback The device used during the outages of the primary one.
+   * @param[in] options The failover options.
+   */
+  FailoverDeviceImpl(std::shared_ptr<Device> primary, std::shared_ptr<Device> fallback,
+                     FailoverOptions options);
+
+  /// @brief Destructor, stopping the monitor of the devices.
+  ~FailoverDeviceImpl();
+
+  /// @brief FailoverDeviceImpl is non-copyable.
+  FailoverDeviceImpl(FailoverDeviceImpl& other) = delete;
+
+  /// @brief FailoverDeviceImpl is non-moveable.
+  FailoverDeviceImpl(FailoverDeviceImpl&& other) = delete;
+
+  /// @brief FailoverDeviceImpl is non-copyable.
+  auto operator=(FailoverDeviceImpl& other) -> FailoverDeviceImpl& = delete;
+
+  /// @brief FailoverDeviceImpl is non-moveable.
+  auto operator=(FailoverDeviceImpl&& other) -> FailoverDeviceImpl& = delete;
+
+  /**
+   * @brief Adds an interface definition to both devices from a JSON file.
+   * @param[in] json_file The filesystem path to the .json interface definition.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto add_interface_from_file(const std::filesystem::path& json_file)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Adds an interface definition to both devices from a JSON string.
+   * @param[in] json The interface definition as a JSON string view.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto add_interface_from_str(std::string_view json) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Removes an installed interface from both devices.
+   * @param[in] interface_name The name of the interface to remove.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto remove_interface(const std::string& interface_name) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Connects the primary device and starts the monitor thread.
+   * @return An expected containing void on success or Error if the device is already connected.
+   */
+  auto connect() -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Checks connectivity status.
+   * @return True if the device in use is connected, false otherwise.
+   */
+  [[nodiscard]] auto is_connected() const -> bool;
+
+  /**
+   * @brief Stops the monitor thread, flushes or drops the buffer and disconnects both devices.
+   * @return An expected containing void on success or the first Error of the devices.
+   */
+  auto disconnect() -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Performs a send call on the device in use, buffering it if neither device is connected.
+   * @param[in] call The arguments of the call.
+   * @return An expected containing void on success or Error on failure or if the buffer is full.
+   */
+  auto send(const capture::SendCall& call) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Polls for incoming messages on both devices.
+   * @param[in] timeout The maximum duration to wait for a message of the device in use.
+   * @return An optional containing the message if one was received, or std::nullopt on timeout.
+   */
+  auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message>;
+
+  /**
+   * @brief Polls for incoming shared messages on both devices.
+   * @param[in] timeout The maximum duration to wait for a message of the device in use.
+   * @return An optional containing the message if one was received, or std::nullopt on timeout.
+   */
+  auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage>;
+
+  /**
+   * @brief Gets the device the properties and the messages are read from.
+   * @return The fallback device while it is in use, the primary device otherwise.
+   */
+  [[nodiscard]] auto device_in_use() const -> Device&;
+
+  /**
+   * @brief Gets the route currently taken by the sends.
+   * @return The current route.
+   */
+  [[nodiscard]] auto route() const -> FailoverRoute;
+
+  /**
+   * @brief Gets the number of sends waiting in the buffer.
+   * @return The number of buffered sends.
+   */
+  [[nodiscard]] auto buffered() const -> size_t;
+
+ private:
+  /// @brief A send call waiting in the buffer, owning its data.
+  struct BufferedSend {
+    /// @brief The called method.
+    capture::SendKind kind;
+    /// @brief The name of the interface.
+    std::string interface_name;
+    /// @brief The path of the data.
+    std::string path;
+    /// @brief The sent data, set for individuals and properties.
+    std::optional<Data> data;
+    /// @brief The sent object, set for objects.
+    std::optional<DatastreamObject> object;
+    /// @brief The explicit timestamp of the data, if any.
+    std::optional<std::chrono::system_clock::time_point> timestamp;
+  };
+
+  /**
+   * @brief Gets the connected device the sends are routed to.
+   * @return A pointer to the device, nullptr if neither device can be used.
+   */
+  [[nodiscard]] auto connected_device() const -> Device*;
+
+  /**
+   * @brief Sends on the connected device, if any.
+   * @param[in] call The arguments of the call.
+   * @return The result of the call, nullopt if the call must be buffered.
+   */
+  auto try_send(const capture::SendCall& call) -> std::optional<astarte_tl::expected<void, Error>>;
+
+  /**
+   * @brief Sends the buffered calls in order, as long as a device is connected.
+   * @details The buffer is taken out of the mutex while its calls are sent, the sends performed
+   * meanwhile are buffered behind it. Only one thread drains the buffer at a time.
+   */
+  void drain();
+
+  /**
+   * @brief Body of the monitor thread.
+   * @param[in] token The token stopping the thread.
+   */
+  void monitor(const std::stop_token& token);
+
+  /**
+   * @brief Checks the connection of the devices, switching the route when needed.
+   */
+  void check_devices();
+
+  /**
+   * @brief Stops the primary device and connects the fallback one.
+   * @param[in] now The time of the check.
+   */
+  void fail_over(std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief Disconnects the fallback device and connects the primary one again.
+   * @param[in] now The time of the check.
+   */
+  void fail_back(std::chrono::steady_clock::time_point now);
+
+  std::shared_ptr<Device> primary_;
+  std::shared_ptr<Device> fallback_;
+  FailoverOptions options_;
+  // True between connect() and disconnect(), sends are forwarded to the primary device otherwise,
+  // once the buffer has been emptied.
+  std::atomic_bool running_{false};
+  std::atomic_bool fallback_active_{false};
+  // State of the monitor thread.
+  std::optional<std::chrono::steady_clock::time_point> primary_down_since_;
+  std::optional<std::chrono::steady_clock::time_point> fallback_since_;
+  FailoverRoute last_route_{FailoverRoute::kPrimary};
+  std::mutex monitor_mutex_;
+  std::condition_variable monitor_cv_;
+  // Serializes connect() and disconnect(), guarding the monitor thread.
+  std::mutex lifecycle_mutex_;
+  std::optional<std::jthread> monitor_thread_;
+  // Sends performed while neither device is connected. The count, including the sends being
+  // drained, is mirrored in an atomic to let the sends skip the mutex while nothing is buffered.
+  mutable std::mutex buffer_mutex_;
+  std::deque<BufferedSend> buffer_;
+  bool draining_{false};
+  // Notified when a drain of the buffer ends.
+  std::condition_variable drained_cv_;
+  std::atomic<size_t> buffered_{0};
+};
+
+}  // namespace astarte::device
+
+#endif  // ASTARTE_FAILOVER_DEVICE_IMPL_H
@@ -0,0 +1,31 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_FLIGHT_RECORDER_EVENT_H
+#define ASTARTE_FLIGHT_RECORDER_EVENT_H
+
+/**
+ * @file private/flight_recorder_event.hpp
+ * @brief Recording of transport events in the flight recorder.
+ */
+
+#include <cstdint>
+
+#include "astarte_device_sdk/flight_recorder.hpp"
+
+namespace astarte::device::flight_recorder {
+
+/**
+ * @brief Records a transport event, overwriting the oldest one when the recorder is full.
+ *
+ * @details Safe to call concurrently from any thread, never allocates nor blocks.
+ *
+ * @param[in] kind The kind of the event.
+ * @param[in] value The value of the event, as described by its kind.
+ */
+void record(EventKind kind, int64_t value = 0);
+
+}  // namespace astarte::device::flight_recorder
+
+#endif  // ASTARTE_FLIGHT_RECORDER_EVENT_H
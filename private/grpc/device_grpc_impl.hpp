@@ -24,6 +24,7 @@
 #include <filesystem>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stop_token>
 #include <string>
@@ -39,6 +40,7 @@
 #include "astarte_device_sdk/ownership.hpp"
 #include "astarte_device_sdk/property.hpp"
 #include "astarte_device_sdk/stored_property.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
 #include "shared_queue.hpp"
 
 namespace astarte::device::grpc {
@@ -48,6 +50,7 @@ using ::grpc::ClientReader;
 
 using gRPCMessageHub = astarteplatform::msghub::MessageHub;
 using gRPCMessageHubEvent = astarteplatform::msghub::MessageHubEvent;
+using gRPCStoredProperties = astarteplatform::msghub::StoredProperties;
 
 /**
  * @brief Implementation class for the gRPC-based Astarte device.
@@ -107,6 +110,17 @@ struct DeviceGrpc::DeviceGrpcImpl {
    */
   auto remove_interface(const std::string& interface_name) -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Sets the hook invoked on the thread maintaining the connection with the message hub.
+   *
+   * @details The hook is invoked each time the thread is started by `connect()`. Threads created
+   * internally by the gRPC library are not affected.
+   *
+   * @param[in] hook The hook to invoke, for example to apply a `ThreadConfig`.
+   * @return An expected containing void on success or Error if the device is already connecting.
+   */
+  auto set_thread_hook(ThreadHook hook) -> astarte_tl::expected<void, Error>;
+
   /**
    * @brief Connects the device to Astarte.
    * @details Initializes the gRPC channel and starts a dedicated management thread that
@@ -190,6 +204,16 @@ struct DeviceGrpc::DeviceGrpcImpl {
    */
   auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message>;
 
+  /**
+   * @brief Polls for a new message received from the message hub, without copying it.
+   *
+   * @param[in] timeout The maximum duration to block waiting for a message.
+   * @return An std::optional containing a SharedMessage if one was available, otherwise
+   * std::nullopt.
+   */
+  auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage>;
+
   /**
    * @brief Gets all stored properties matching the input filter.
    *
@@ -208,6 +232,45 @@ struct DeviceGrpc::DeviceGrpcImpl {
   auto get_properties(std::string_view interface_name)
       -> astarte_tl::expected<std::list<StoredProperty>, Error>;
 
+  /**
+   * @brief Retrieves all stored properties matching an ownership filter into a vector.
+   *
+   * @param[in] ownership Optional filter, if std::nullopt, returns all properties.
+   * @return An expected containing the vector of properties on success or Error on failure.
+   */
+  auto get_all_properties_vector(const std::optional<Ownership>& ownership)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error>;
+
+  /**
+   * @brief Retrieves all stored properties belonging to a specific interface into a vector.
+   *
+   * @param[in] interface_name The name of the interface to query.
+   * @return An expected containing the vector of properties on success or Error on failure.
+   */
+  auto get_properties_vector(std::string_view interface_name)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error>;
+
+  /**
+   * @brief Visits all stored properties matching an ownership filter.
+   *
+   * @param[in] ownership Optional filter, if std::nullopt, visits all properties.
+   * @param[in] visitor The callable invoked for each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit_all_properties(const std::optional<Ownership>& ownership,
+                            const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Visits all stored properties belonging to a specific interface.
+   *
+   * @param[in] interface_name The name of the interface to query.
+   * @param[in] visitor The callable invoked for each property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit_properties(std::string_view interface_name, const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error>;
+
   /**
    * @brief Gets a single stored property matching the interface name and path.
    *
@@ -224,6 +287,11 @@ struct DeviceGrpc::DeviceGrpcImpl {
     std::unique_ptr<ClientReader<gRPCMessageHubEvent>> reader;
   };
   void setup_grpc_channel();
+  [[nodiscard]] auto stub() const -> std::shared_ptr<gRPCMessageHub::Stub>;
+  auto fetch_all_properties(const std::optional<Ownership>& ownership)
+      -> astarte_tl::expected<gRPCStoredProperties, Error>;
+  auto fetch_properties(std::string_view interface_name)
+      -> astarte_tl::expected<gRPCStoredProperties, Error>;
   auto perform_attach() -> astarte_tl::expected<AttachResult, Error>;
   auto connection_attempt(const std::stop_token& token) -> astarte_tl::expected<void, Error>;
   auto handle_events(const std::stop_token& token, std::unique_ptr<ClientContext> context,
@@ -235,13 +303,22 @@ struct DeviceGrpc::DeviceGrpcImpl {
 
   std::string server_addr_;
   std::string node_uuid_;
-  std::unique_ptr<gRPCMessageHub::Stub> stub_;
+  // The stub is replaced on every connection attempt while other threads may still be sending
+  // through the previous one. Senders take a snapshot, keeping the old channel alive until done.
+  mutable std::mutex stub_mutex_;
+  std::shared_ptr<gRPCMessageHub::Stub> stub_;
+  // Guards the interfaces registry, held across the related RPCs to keep the message hub in sync.
+  std::mutex interfaces_mutex_;
   std::vector<std::string> interfaces_bins_;
+  // Serializes connect(), disconnect() and set_thread_hook(), guarding the connection thread, its
+  // stop source and the hook it is set up with.
+  std::mutex lifecycle_mutex_;
+  ThreadHook thread_hook_;
   std::optional<std::jthread> connection_thread_;
   std::atomic_bool connected_{false};
   std::stop_source ssource_;
   std::atomic_bool grpc_stream_error_{false};
-  SharedQueue<Message> rcv_queue_;
+  SharedQueue<SharedMessage> rcv_queue_;
 };
 
 }  // namespace astarte::device::grpc
@@ -160,6 +160,25 @@ class GrpcConverterFrom {
    */
   auto operator()(const gRPCStoredProperties& value)
       -> astarte_tl::expected<std::list<StoredProperty>, Error>;
+
+  /**
+   * @brief Converts a StoredProperties Protobuf message to a vector of StoredProperty objects.
+   * @details Properties of the same interface share a single interface name string.
+   * @param[in] value The Protobuf message containing the list.
+   * @return An expected containing the vector of StoredProperty on success or Error on failure.
+   */
+  auto to_vector(const gRPCStoredProperties& value)
+      -> astarte_tl::expected<std::vector<StoredProperty>, Error>;
+
+  /**
+   * @brief Converts the properties of a StoredProperties Protobuf message one at a time.
+   * @details The views passed to the visitor reference the strings of the Protobuf message.
+   * @param[in] value The Protobuf message containing the list.
+   * @param[in] visitor The callable invoked for each converted property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto visit(const gRPCStoredProperties& value, const StoredPropertyVisitor& visitor)
+      -> astarte_tl::expected<void, Error>;
 };
 
 }  // namespace astarte::device::grpc
@@ -19,15 +19,23 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "astarte_device_sdk/formatter.hpp"
 #include "astarte_device_sdk/mqtt/errors.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+#include "mqtt/connection/duplicate_filter.hpp"
 #include "mqtt/connection/listener.hpp"
+#include "mqtt/connection/topic_router.hpp"
 #include "mqtt/iaction_listener.h"
 #include "mqtt/iasync_client.h"
 #include "mqtt/introspection.hpp"
+#include "mqtt/server_properties.hpp"
 #include "mqtt/thread_queue.h"
+#include "shared_queue.hpp"
 
 namespace astarte::device::mqtt::connection {
 
@@ -54,12 +62,23 @@ class Callback : public virtual paho_mqtt::callback {
    * status.
    * @param[in] session_setup_tokens Queue for storing tokens related to session setup actions
    * (subscriptions, publications) to ensure they complete before declaring the device ready.
+   * @param[in] session_present A flag stating if the broker resumed a previous session.
+   * @param[in] received Queue of the messages received from Astarte, polled by the device.
+   * @param[in] server_properties Persistent store of the server-owned properties, nullptr if the
+   * properties are not persisted.
+   * @param[in] thread_hook Hook invoked on the Paho threads delivering the events.
+   * @param[in] duplicate_filter Filter discarding the redelivered messages, std::nullopt to
+   * deliver all the messages.
    */
   Callback(
       paho_mqtt::iasync_client* client, std::string realm, std::string device_id,
       std::shared_ptr<Introspection> introspection,
       const std::shared_ptr<std::atomic<bool>>& connected,
-      const std::shared_ptr<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>& session_setup_tokens);
+      const std::shared_ptr<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>& session_setup_tokens,
+      std::shared_ptr<std::atomic<bool>> session_present,
+      std::shared_ptr<SharedQueue<SharedMessage>> received,
+      std::shared_ptr<ServerProperties> server_properties, ThreadHook thread_hook,
+      std::optional<DuplicateFilter> duplicate_filter = std::nullopt);
 
   /**
    * @brief Performs the Astarte session setup sequence.
@@ -69,6 +88,9 @@ class Callback : public virtual paho_mqtt::callback {
    * 2. Publishes the device introspection.
    * 3. Publishes the `emptyCache` message if required.
    *
+   * The whole sequence is skipped when the broker resumed the session and the persisted
+   * server-owned properties are consistent with Astarte for the current introspection.
+   *
    * @param[in] session_present Indicates if the broker resumed a previous persistent session.
    * @return An expected containing void on success or Error on failure.
    */
@@ -85,14 +107,21 @@ class Callback : public virtual paho_mqtt::callback {
    */
   auto setup_subscriptions() -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Builds the Astarte string form of the device's introspection.
+   * @return The interfaces with their versions, separated by semicolons.
+   */
+  [[nodiscard]] auto introspection_string() const -> std::string;
+
   /**
    * @brief Publishes the device's introspection to Astarte.
    *
    * @details Sends the list of supported interfaces and versions to the introspection topic.
    *
+   * @param[in] introspection The introspection in its Astarte string form.
    * @return An expected containing void on success or Error on failure.
    */
-  auto send_introspection() -> astarte_tl::expected<void, Error>;
+  auto send_introspection(const std::string& introspection) -> astarte_tl::expected<void, Error>;
 
   /**
    * @brief Sends an "emptyCache" message to Astarte.
@@ -103,6 +132,33 @@ class Callback : public virtual paho_mqtt::callback {
    */
   auto send_emptycache() -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Decodes the payload of a message received on an interface mapping.
+   *
+   * @details Properties are decoded as property individuals, an empty payload unsetting the
+   * property. Datastreams are decoded as individuals or objects depending on the aggregation of
+   * the interface.
+   *
+   * @param[in] route The destination of the message, of the `kInterface` kind.
+   * @param[in] payload The BSON payload of the message.
+   * @return The decoded message, an error if the payload does not match the mapping.
+   */
+  static auto decode_message(const Route& route, std::string_view payload)
+      -> astarte_tl::expected<Message, Error>;
+
+  /**
+   * @brief Updates the persistent cache with a received message, if it carries a server property.
+   *
+   * @param[in] route The destination of the message.
+   * @param[in] payload The payload of the message.
+   */
+  void cache_server_property(const Route& route, std::string_view payload);
+
+  /**
+   * @brief Sets up the calling Paho thread the first time it delivers an event.
+   */
+  void setup_callback_thread() const;
+
   /**
    * @brief Called by the client when the connection is established.
    * @details This override handles automatic reconnections by the Paho library.
@@ -121,7 +177,8 @@ class Callback : public virtual paho_mqtt::callback {
 
   /**
    * @brief Called when a message arrives from the broker.
-   * @details Processes incoming messages, routing them to the appropriate handler within the SDK.
+   * @details Routes the message to its interface mapping, discards the redelivered ones, and
+   * queues the decoded message for the device to poll.
    *
    * @param[in] msg The received message.
    */
@@ -143,14 +200,26 @@ class Callback : public virtual paho_mqtt::callback {
   std::string device_id_;
   /// @brief Reference to the device's introspection.
   std::shared_ptr<Introspection> introspection_;
+  /// @brief Router of the topics of the received messages.
+  TopicRouter router_;
   /// @brief The flag stating if the device is successfully connected to Astarte.
   std::shared_ptr<std::atomic<bool>> connected_;
+  /// @brief The flag stating if the broker resumed a previous session.
+  std::shared_ptr<std::atomic<bool>> session_present_;
   /// @brief Paho MQTT tokens for the messages of an Astarte session setup.
   std::shared_ptr<paho_mqtt::thread_queue<paho_mqtt::token_ptr>> session_setup_tokens_;
   /// @brief Paho MQTT listener for the messages of an Astarte session setup.
   std::shared_ptr<SessionSetupListener> session_setup_listener_;
   /// @brief Paho MQTT listener for the disconnection.
   std::shared_ptr<DisconnectionListener> disconnection_listener_;
+  /// @brief Queue of the received messages.
+  std::shared_ptr<SharedQueue<SharedMessage>> received_;
+  /// @brief Persistent store of the server-owned properties, nullptr if disabled.
+  std::shared_ptr<ServerProperties> server_properties_;
+  /// @brief Hook invoked on the Paho threads delivering the events.
+  ThreadHook thread_hook_;
+  /// @brief Filter discarding the redelivered messages, kept across automatic reconnections.
+  std::optional<DuplicateFilter> duplicate_filter_;
 };
 
 }  // namespace astarte::device::mqtt::connection
@@ -17,9 +17,11 @@
 #include <spdlog/spdlog.h>
 
 #include <atomic>
+#include <chrono>
 #include <format>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -27,17 +29,58 @@
 #include "astarte_device_sdk/mqtt/config.hpp"
 #include "astarte_device_sdk/mqtt/errors.hpp"
 #include "astarte_device_sdk/mqtt/pairing.hpp"
+#include "astarte_device_sdk/msg.hpp"
 #include "astarte_device_sdk/ownership.hpp"
 #include "mqtt/async_client.h"
 #include "mqtt/connection/callbacks.hpp"
 #include "mqtt/connection/listener.hpp"
+#include "mqtt/connection/topic_alias.hpp"
 #include "mqtt/iasync_client.h"
+#include "mqtt/interface.hpp"
 #include "mqtt/introspection.hpp"
+#include "mqtt/server_properties.hpp"
+#include "shared_queue.hpp"
 
 namespace astarte::device::mqtt::connection {
 
 namespace paho_mqtt = ::mqtt;
 
+/**
+ * @brief A message handed to the Paho client, whose delivery has not been awaited yet.
+ *
+ * @details Obtained from `Connection::start_send`, lets a sender hand several messages to the
+ * client before waiting for the first delivery.
+ */
+class PendingSend {
+ public:
+  /**
+   * @brief Constructs a pending send.
+   * @param[in] token The delivery token of the message.
+   * @param[in] qos The MQTT QoS level of the message.
+   */
+  PendingSend(paho_mqtt::delivery_token_ptr token, uint8_t qos);
+
+  /**
+   * @brief Waits until the message is delivered, according to its QoS.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto wait() -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Waits until the message is delivered or the wait is abandoned.
+   * @details The flag is polled while waiting, the message stays with the client once the wait is
+   * abandoned and may still be delivered later.
+   *
+   * @param[in] abandon The flag abandoning the wait once set.
+   * @return An expected containing void on success or Error on failure or abandon.
+   */
+  auto wait(const std::atomic<bool>& abandon) -> astarte_tl::expected<void, Error>;
+
+ private:
+  paho_mqtt::delivery_token_ptr token_;
+  uint8_t qos_;
+};
+
 /**
  * @brief Manages the MQTT connection to an Astarte instance.
  *
@@ -94,17 +137,50 @@ class Connection {
    */
   [[nodiscard]] auto is_connected() const -> bool;
 
+  /**
+   * @brief Gets the persistent store of the server-owned properties.
+   * @return The store, nullptr if the server-owned properties are not persisted.
+   */
+  [[nodiscard]] auto server_properties() const -> const std::shared_ptr<ServerProperties>&;
+
+  /**
+   * @brief Pops a message received from Astarte.
+   *
+   * @details Blocks until a message is received or the timeout expires.
+   *
+   * @param[in] timeout The maximum duration to block waiting for a message.
+   * @return The received message, std::nullopt if the timeout was reached.
+   */
+  auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<SharedMessage>;
+
   /**
    * @brief Sends individual or object data to Astarte.
    *
    * @param[in] interface_name The interface on which data will be sent.
    * @param[in] path The mapping path of the Astarte interface on which data will be sent.
-   * @param[in] qos The quality of service value (0, 1, or 2).
+   * @param[in] descriptor The metadata resolved while validating the data, such as the QoS.
    * @param[in] data A span of bytes containing the BSON serialized data to send.
    * @return An expected containing void on success or Error on failure.
    */
-  auto send(std::string_view interface_name, std::string_view path, uint8_t qos,
-            std::span<uint8_t> data) -> astarte_tl::expected<void, Error>;
+  auto send(std::string_view interface_name, std::string_view path,
+            const SendDescriptor& descriptor, std::span<uint8_t> data)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Hands individual or object data to the client without waiting for its delivery.
+   *
+   * @details Messages started from the same thread are transmitted in the order they were
+   * started. The payload is copied by the client and can be released on return.
+   *
+   * @param[in] interface_name The interface on which data will be sent.
+   * @param[in] path The mapping path of the Astarte interface on which data will be sent.
+   * @param[in] descriptor The metadata resolved while validating the data, such as the QoS.
+   * @param[in] data A span of bytes containing the BSON serialized data to send.
+   * @return An expected containing the pending send on success or Error on failure.
+   */
+  auto start_send(std::string_view interface_name, std::string_view path,
+                  const SendDescriptor& descriptor, std::span<uint8_t> data)
+      -> astarte_tl::expected<PendingSend, Error>;
 
   /**
    * @brief Disconnects the client from the Astarte MQTT broker.
@@ -124,6 +200,19 @@ class Connection {
   Connection(Config cfg, paho_mqtt::connect_options options,
              std::unique_ptr<paho_mqtt::async_client> client, PairingApi pairing_api);
 
+  /**
+   * @brief Hands a message to the Paho client, replacing the topic with an alias when possible.
+   *
+   * @details With MQTT 5 the expiry of the mapping is forwarded as the message expiry interval.
+   *
+   * @param[in] topic The full topic of the message.
+   * @param[in] descriptor The metadata of the message, such as the QoS.
+   * @param[in] data A span of bytes containing the message payload.
+   * @return The delivery token of the message.
+   */
+  auto publish(const std::string& topic, const SendDescriptor& descriptor,
+               std::span<uint8_t> data) -> paho_mqtt::delivery_token_ptr;
+
   /// @brief Pairing API object.
   PairingApi pairing_api_;
   /// @brief The MQTT configuration object.
@@ -138,6 +227,17 @@ class Connection {
   std::shared_ptr<std::atomic<bool>> connected_;
   /// @brief Queue containing the tokens used during session setup.
   std::shared_ptr<paho_mqtt::thread_queue<paho_mqtt::token_ptr>> session_setup_tokens_;
+  /// @brief Flag stating if the broker resumed a previous session on the last connection.
+  std::shared_ptr<std::atomic<bool>> session_present_;
+  /// @brief Messages received from Astarte, queued by the callback.
+  std::shared_ptr<SharedQueue<SharedMessage>> received_;
+  /// @brief Topic aliases assigned to the published topics, only used with MQTT 5.
+  std::shared_ptr<TopicAliasCache> topic_aliases_;
+  /// @brief Persistent store of the server-owned properties, nullptr if disabled.
+  std::shared_ptr<ServerProperties> server_properties_;
+  /// @brief Paho MQTT listener for the connections, updating the session present flag and the
+  /// topic aliases.
+  std::shared_ptr<ConnectionListener> connection_listener_;
 };
 
 }  // namespace astarte::device::mqtt::connection
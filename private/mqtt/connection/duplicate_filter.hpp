@@ -0,0 +1,133 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_CONNECTION_DUPLICATE_FILTER_H
+#define ASTARTE_MQTT_CONNECTION_DUPLICATE_FILTER_H
+
+/**
+ * @file private/mqtt/connection/duplicate_filter.hpp
+ * @brief Detection of redelivered MQTT messages.
+ *
+ * @details This file defines the `DuplicateFilter` class, which remembers the messages received in
+ * a bounded window so that QoS 1 redeliveries from the broker can be discarded before reaching the
+ * application.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace astarte::device::mqtt::connection {
+
+/**
+ * @brief Bounded set of the fingerprints of the recently received messages.
+ *
+ * @details A message is identified by a 64 bits hash of its topic and payload. The filter
+ * remembers at most `capacity` messages, and forgets each message once `window` has elapsed since
+ * its first reception. Identical messages received within the window are reported as duplicates,
+ * including the ones the server intentionally sent twice.
+ *
+ * All the memory is allocated on construction: the fingerprints live in a ring buffer in arrival
+ * order, indexed by an open addressing hash table with linear probing.
+ *
+ * The class is not internally synchronized, it is meant to be used from the single thread
+ * delivering the MQTT messages.
+ */
+class DuplicateFilter {
+ public:
+  /// @brief Clock used to expire the remembered messages.
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructs an empty filter.
+   *
+   * @param[in] capacity The maximum number of remembered messages, at least one.
+   * @param[in] window The time after which a remembered message is forgotten.
+   */
+  DuplicateFilter(size_t capacity, std::chrono::milliseconds window);
+
+  /**
+   * @brief Checks whether a message has already been received, remembering it otherwise.
+   *
+   * @param[in] topic The topic of the message.
+   * @param[in] payload The payload of the message.
+   * @param[in] now The reception time of the message.
+   * @return True if the message has been received within the window, false otherwise.
+   */
+  auto check(std::string_view topic, std::string_view payload, Clock::time_point now = Clock::now())
+      -> bool;
+
+  /**
+   * @brief Forgets all the remembered messages.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of remembered messages.
+   * @return The number of messages.
+   */
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+
+  /**
+   * @brief Gets the maximum number of remembered messages.
+   * @return The capacity of the filter.
+   */
+  [[nodiscard]] auto capacity() const -> size_t { return entries_.size(); }
+
+  /**
+   * @brief Computes the fingerprint identifying a message.
+   *
+   * @param[in] topic The topic of the message.
+   * @param[in] payload The payload of the message.
+   * @return The 64 bits fingerprint.
+   */
+  [[nodiscard]] static auto fingerprint(std::string_view topic, std::string_view payload)
+      -> uint64_t;
+
+ private:
+  /// @brief A remembered message.
+  struct Entry {
+    /// @brief The fingerprint of the message.
+    uint64_t fingerprint;
+    /// @brief The time of the first reception of the message.
+    Clock::time_point received;
+  };
+
+  /// @brief Marker of the unused slots of the hash table.
+  static constexpr uint32_t k_empty = UINT32_MAX;
+
+  /**
+   * @brief Gets the preferred slot of a fingerprint.
+   * @param[in] fingerprint The fingerprint.
+   * @return The index of the slot.
+   */
+  [[nodiscard]] auto home(uint64_t fingerprint) const -> size_t;
+  /**
+   * @brief Finds the slot holding a fingerprint, or the empty slot where it would be inserted.
+   * @param[in] fingerprint The fingerprint.
+   * @return The index of the slot.
+   */
+  [[nodiscard]] auto find(uint64_t fingerprint) const -> size_t;
+  /**
+   * @brief Forgets the oldest remembered message.
+   */
+  void evict_oldest();
+
+  /// @brief Remembered messages in arrival order, starting from `head_`.
+  std::vector<Entry> entries_;
+  /// @brief Hash table of indexes into `entries_`, its size is a power of two.
+  std::vector<uint32_t> slots_;
+  /// @brief Time after which a remembered message is forgotten.
+  std::chrono::milliseconds window_;
+  /// @brief Index of the oldest remembered message.
+  size_t head_{0};
+  /// @brief Number of remembered messages.
+  size_t size_{0};
+};
+
+}  // namespace astarte::device::mqtt::connection
+
+#endif  // ASTARTE_MQTT_CONNECTION_DUPLICATE_FILTER_H
@@ -17,8 +17,10 @@
 #include <spdlog/spdlog.h>
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 
+#include "mqtt/connection/topic_alias.hpp"
 #include "mqtt/iaction_listener.h"
 #include "mqtt/thread_queue.h"
 #include "mqtt/token.h"
@@ -66,6 +68,48 @@ class SessionSetupListener : public virtual paho_mqtt::iaction_listener {
   std::shared_ptr<std::atomic<bool>> connected_;
 };
 
+/**
+ * @brief Listener for the MQTT connection action.
+ *
+ * @details This class implements `paho_mqtt::iaction_listener` to record whether the broker
+ * resumed a previous session and how many topic aliases it accepts. The client invokes it on the
+ * first connection and on every automatic reconnection, before notifying the connection to the
+ * client callback.
+ */
+class ConnectionListener : public virtual paho_mqtt::iaction_listener {
+ public:
+  /**
+   * @brief Constructs a new Connection Listener object.
+   *
+   * @param[in] session_present A flag stating if the broker resumed a previous session.
+   * @param[in] topic_aliases Topic aliases of the connection, reset on every new connection.
+   * @param[in] topic_alias_maximum The maximum number of topic aliases used by the device, zero
+   * to never use topic aliases.
+   */
+  ConnectionListener(std::shared_ptr<std::atomic<bool>> session_present,
+                     std::shared_ptr<TopicAliasCache> topic_aliases, uint16_t topic_alias_maximum);
+
+ private:
+  /**
+   * @brief Called when the connection action fails.
+   * @param[in] tok The token associated with the failed action.
+   */
+  void on_failure(const paho_mqtt::token& tok) override;
+
+  /**
+   * @brief Called when the connection action completes successfully.
+   * @param[in] tok The token associated with the successful action.
+   */
+  void on_success(const paho_mqtt::token& tok) override;
+
+  /// @brief The flag stating if the broker resumed a previous session.
+  std::shared_ptr<std::atomic<bool>> session_present_;
+  /// @brief Topic aliases used by the publishes of the connection.
+  std::shared_ptr<TopicAliasCache> topic_aliases_;
+  /// @brief The maximum number of topic aliases used by the device.
+  uint16_t topic_alias_maximum_;
+};
+
 /**
  * @brief Listener for the MQTT disconnection action.
  *
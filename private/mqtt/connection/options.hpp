@@ -0,0 +1,48 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_CONNECTION_OPTIONS_H
+#define ASTARTE_MQTT_CONNECTION_OPTIONS_H
+
+/**
+ * @file private/mqtt/connection/options.hpp
+ * @brief Conversion of the MQTT configuration into Paho client options.
+ *
+ * @details This file declares the helpers translating an Astarte `Config` into the Paho
+ * creation and connection options. TLS settings are not part of these options since they depend
+ * on the device credentials, which are only available after pairing.
+ */
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/mqtt/config.hpp"
+#include "mqtt/connect_options.h"
+#include "mqtt/create_options.h"
+
+namespace astarte::device::mqtt::connection {
+
+namespace paho_mqtt = ::mqtt;
+
+/**
+ * @brief Builds the Paho client creation options.
+ *
+ * @details Creation options control the client-side buffering of messages published while the
+ * client is disconnected from the broker.
+ *
+ * @param[in] cfg The MQTT configuration object.
+ * @return The Paho creation options.
+ */
+auto build_create_options(const Config& cfg) -> paho_mqtt::create_options;
+
+/**
+ * @brief Builds the Paho connection options, excluding the TLS settings.
+ *
+ * @param[in] cfg The MQTT configuration object.
+ * @return An expected containing the connection options on success or Error on failure.
+ */
+auto build_connect_options(const Config& cfg)
+    -> astarte_tl::expected<paho_mqtt::connect_options, Error>;
+
+}  // namespace astarte::device::mqtt::connection
+
+#endif  // ASTARTE_MQTT_CONNECTION_OPTIONS_H
@@ -0,0 +1,115 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_CONNECTION_TOPIC_ALIAS_H
+#define ASTARTE_MQTT_CONNECTION_TOPIC_ALIAS_H
+
+/**
+ * @file private/mqtt/connection/topic_alias.hpp
+ * @brief MQTT 5 topic alias assignment.
+ *
+ * @details This file defines the `TopicAliasCache` class, which assigns MQTT 5 topic aliases to
+ * the most recently used publish topics, so that subsequent publishes on the same topic can omit
+ * the full topic string.
+ */
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace astarte::device::mqtt::connection {
+
+/**
+ * @brief Least recently used cache of MQTT 5 topic aliases.
+ *
+ * @details Aliases are valid for a single network connection and must be forgotten on reconnection.
+ * A topic is bound to an alias the first time it is published, the publish carrying both the topic
+ * and the alias establishes the mapping on the broker. When all the aliases are in use the least
+ * recently used one is re-bound to the new topic.
+ *
+ * Only QoS 0 messages are aliased. Paho keeps the QoS 1 and 2 messages until they are
+ * acknowledged and retransmits them on the following connections, where the alias may be unknown
+ * or beyond the maximum advertised by the broker on reconnection, so they always carry the full
+ * topic.
+ *
+ * The class is not internally synchronized, callers must hold the lock returned by `lock()` from
+ * the lookup until the message is handed to the client, to preserve the publish order.
+ */
+class TopicAliasCache {
+ public:
+  /// @brief Alias to attach to a publish.
+  struct Alias {
+    /// @brief The alias value, always greater than zero.
+    uint16_t value;
+    /// @brief True if the broker already knows the alias and the topic can be omitted.
+    bool established;
+  };
+
+  /**
+   * @brief Constructs a cache with aliasing disabled.
+   */
+  TopicAliasCache() = default;
+
+  /**
+   * @brief Acquires the lock guarding the cache.
+   * @return The acquired lock.
+   */
+  [[nodiscard]] auto lock() -> std::unique_lock<std::mutex> {
+    return std::unique_lock<std::mutex>(mutex_);
+  }
+
+  /**
+   * @brief Forgets all the aliases and sets the number of usable aliases.
+   *
+   * @param[in] maximum The maximum number of aliases accepted by the broker, zero disables
+   * aliasing.
+   */
+  void reset(uint16_t maximum);
+
+  /**
+   * @brief Forgets all the aliases, keeping the current maximum.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of usable aliases.
+   * @return The maximum number of aliases.
+   */
+  [[nodiscard]] auto maximum() const -> uint16_t { return maximum_; }
+
+  /**
+   * @brief Looks up or assigns the alias of a topic.
+   *
+   * @param[in] topic The topic of the publish.
+   * @param[in] qos The quality of service of the publish.
+   * @return The alias to use, or std::nullopt if aliasing is disabled or the QoS is not 0.
+   */
+  auto lookup(std::string_view topic, uint8_t qos) -> std::optional<Alias>;
+
+ private:
+  /// @brief Topic bound to an alias.
+  struct Entry {
+    /// @brief The topic.
+    std::string topic;
+    /// @brief The bound alias.
+    uint16_t alias;
+  };
+
+  /// @brief Guards the cache.
+  std::mutex mutex_;
+  /// @brief Maximum number of aliases.
+  uint16_t maximum_{0};
+  /// @brief Bound topics, most recently used first.
+  std::list<Entry> lru_;
+  /// @brief Index of the bound topics, keys reference the strings stored in the LRU list.
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace astarte::device::mqtt::connection
+
+#endif  // ASTARTE_MQTT_CONNECTION_TOPIC_ALIAS_H
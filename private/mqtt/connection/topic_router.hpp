@@ -0,0 +1,103 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_CONNECTION_TOPIC_ROUTER_H
+#define ASTARTE_MQTT_CONNECTION_TOPIC_ROUTER_H
+
+/**
+ * @file private/mqtt/connection/topic_router.hpp
+ * @brief Routing of the topics of the incoming MQTT messages.
+ *
+ * @details This file defines the `TopicRouter` class, which splits the topic of a received message
+ * into its components and resolves the interface and mapping it addresses, without allocating.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "mqtt/interface.hpp"
+#include "mqtt/introspection.hpp"
+#include "mqtt/mapping.hpp"
+
+namespace astarte::device::mqtt::connection {
+
+/**
+ * @brief Destination of an incoming message.
+ *
+ * @details The string views reference the topic passed to the router, they are only valid as long
+ * as the message is alive.
+ */
+struct Route {
+  /// @brief Kind of destination.
+  enum class Kind : uint8_t {
+    /// @brief The topic does not belong to the device or is malformed.
+    kInvalid,
+    /// @brief A control message, `path` holds the part of the topic following `control`.
+    kControl,
+    /// @brief The interface is not in the introspection.
+    kUnknownInterface,
+    /// @brief The interface exists but no mapping matches the path.
+    kUnknownMapping,
+    /// @brief A message for an interface mapping.
+    kInterface,
+  };
+
+  /// @brief The kind of destination.
+  Kind kind{Kind::kInvalid};
+  /// @brief The name of the interface, empty for control messages.
+  std::string_view interface_name;
+  /// @brief The path of the message, starting with a slash.
+  std::string_view path;
+  /// @brief The interface, set for the `kUnknownMapping` and `kInterface` kinds.
+  std::shared_ptr<const Interface> interface;
+  /// @brief The mapping, set for the `kInterface` kind. For objects it is the first mapping of the
+  /// object.
+  const Mapping* mapping{nullptr};
+};
+
+/**
+ * @brief Router of the topics in the form `<realm>/<device id>/<interface name>/<path>` and
+ * `<realm>/<device id>/control/<path>`.
+ *
+ * @details The prefix of the device is computed once on construction and verified with a single
+ * comparison, the remaining components are views into the topic.
+ */
+class TopicRouter {
+ public:
+  /**
+   * @brief Constructs the router of a device.
+   *
+   * @param[in] realm The Astarte realm of the device.
+   * @param[in] device_id The Astarte device ID.
+   */
+  TopicRouter(std::string_view realm, std::string_view device_id);
+
+  /**
+   * @brief Splits a topic into interface name and path, without resolving them.
+   *
+   * @param[in] topic The topic of the message.
+   * @return The route with the `kControl` or `kInterface` kind on success, `kInvalid` otherwise.
+   */
+  [[nodiscard]] auto split(std::string_view topic) const -> Route;
+
+  /**
+   * @brief Resolves the destination of a topic.
+   *
+   * @param[in] topic The topic of the message.
+   * @param[in] introspection The introspection of the device.
+   * @return The route of the message.
+   */
+  [[nodiscard]] auto route(std::string_view topic, const Introspection& introspection) const
+      -> Route;
+
+ private:
+  /// @brief The `<realm>/<device id>/` prefix of all the topics of the device.
+  std::string prefix_;
+};
+
+}  // namespace astarte::device::mqtt::connection
+
+#endif  // ASTARTE_MQTT_CONNECTION_TOPIC_ROUTER_H
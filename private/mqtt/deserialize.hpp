@@ -0,0 +1,89 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_DATA_DESERIALIZATION_H
+#define ASTARTE_DATA_DESERIALIZATION_H
+
+/**
+ * @file private/mqtt/deserialize.hpp
+ * @brief BSON deserialization utilities for Astarte data.
+ *
+ * @details This file provides functions to decode the BSON payloads received over MQTT directly
+ * into Astarte data, without building an intermediate document. The decoder validates the whole
+ * payload against the BSON specification and the types expected by the interface mappings, and
+ * reports malformed payloads as errors without throwing.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/type.hpp"
+
+namespace astarte::device::mqtt::bson {
+
+/// @brief An Astarte individual decoded from a BSON payload.
+struct DeserializedIndividual {
+  /// @brief The value of the individual.
+  Data data;
+  /// @brief The explicit timestamp of the individual, if any.
+  std::optional<std::chrono::system_clock::time_point> timestamp;
+};
+
+/// @brief An Astarte object decoded from a BSON payload.
+struct DeserializedObject {
+  /// @brief The values of the object.
+  DatastreamObject object;
+  /// @brief The explicit timestamp of the object, if any.
+  std::optional<std::chrono::system_clock::time_point> timestamp;
+};
+
+/**
+ * @brief Gets the Astarte type expected for a key of an object.
+ *
+ * @details Returns std::nullopt for keys not defined by the interface.
+ */
+using ObjectTypeLookup = std::function<std::optional<Type>(std::string_view key)>;
+
+/**
+ * @brief Deserializes an Astarte individual from BSON.
+ *
+ * @details The payload must be a BSON document with the value in the "v" element and an optional
+ * "t" element holding the timestamp, as sent by Astarte. Integral values are accepted for double
+ * mappings and for date-times, 32 bits integers are accepted for long integer mappings.
+ *
+ * @param[in] payload The BSON payload.
+ * @param[in] type The type of the mapping the payload has been received on.
+ * @return The decoded individual, an error if the payload is malformed or of the wrong type.
+ */
+auto deserialize_astarte_individual(std::span<const uint8_t> payload, Type type)
+    -> astarte_tl::expected<DeserializedIndividual, Error>;
+
+/**
+ * @brief Deserializes an Astarte object from BSON.
+ *
+ * @details The payload must be a BSON document with the object in the "v" embedded document and
+ * an optional "t" element holding the timestamp. Each key of the object is decoded with the type
+ * returned by the lookup.
+ *
+ * @param[in] payload The BSON payload.
+ * @param[in] type_of The lookup of the types of the object keys.
+ * @param[in] expected_keys The number of keys the object is expected to hold, such as the number
+ * of mappings of its interface, reserved before decoding.
+ * @return The decoded object, an error if the payload is malformed or of the wrong type.
+ */
+auto deserialize_astarte_object(std::span<const uint8_t> payload, const ObjectTypeLookup& type_of,
+                                size_t expected_keys = 0)
+    -> astarte_tl::expected<DeserializedObject, Error>;
+
+}  // namespace astarte::device::mqtt::bson
+
+#endif  // ASTARTE_DATA_DESERIALIZATION_H
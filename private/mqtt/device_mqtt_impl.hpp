@@ -16,13 +16,18 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "admission_controller.hpp"
+#include "astarte_device_sdk/admission.hpp"
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/mqtt/config.hpp"
 #include "astarte_device_sdk/mqtt/device_mqtt.hpp"
@@ -33,7 +38,10 @@
 #include "astarte_device_sdk/property.hpp"
 #include "astarte_device_sdk/stored_property.hpp"
 #include "mqtt/connection/connection.hpp"
+#include "mqtt/interface.hpp"
 #include "mqtt/introspection.hpp"
+#include "mqtt/send_pipeline.hpp"
+#include "mqtt/server_properties.hpp"
 
 namespace astarte::device::mqtt {
 
@@ -135,6 +143,38 @@ struct DeviceMqtt::DeviceMqttImpl {
                        const std::chrono::system_clock::time_point* timestamp)
       -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Sends an individual datastream value to an interface, taking ownership of the data.
+   * @details With the send workers enabled the data is moved into the queued send instead of
+   * being copied.
+   *
+   * @param[in] interface_name The name of the interface to send data to.
+   * @param[in] path The path within the interface (e.g., "/endpoint/value").
+   * @param[in] data The data point to send.
+   * @param[in] timestamp An optional timestamp for the data point.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto send_individual(std::string_view interface_name, std::string_view path, Data&& data,
+                       const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Sends a typed individual datastream value to an interface.
+   * @details The value is validated against its mapping and serialized without being wrapped in a
+   * Data. With the send workers enabled the value is wrapped in a Data and queued.
+   *
+   * @tparam T The C++ type of the value, must satisfy `DataAllowedType`.
+   * @param[in] interface_name The name of the interface to send data to.
+   * @param[in] path The path within the interface (e.g., "/endpoint/value").
+   * @param[in] value The value to send.
+   * @param[in] timestamp An optional timestamp for the data point.
+   * @return An expected containing void on success or Error on failure.
+   */
+  template <DataAllowedType T>
+  auto send_individual(std::string_view interface_name, std::string_view path, const T& value,
+                       const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error>;
+
   /**
    * @brief Sends a datastream object to an interface.
    *
@@ -149,6 +189,36 @@ struct DeviceMqtt::DeviceMqttImpl {
                    const std::chrono::system_clock::time_point* timestamp)
       -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Sends a datastream object to an interface, taking ownership of the object.
+   * @details With the send workers enabled the object is moved into the queued send instead of
+   * being copied.
+   *
+   * @param[in] interface_name The name of the interface to send data to.
+   * @param[in] path The base path for the object within the interface.
+   * @param[in] object The key-value map representing the object to send.
+   * @param[in] timestamp An optional timestamp for the data.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto send_object(std::string_view interface_name, std::string_view path,
+                   DatastreamObject&& object,
+                   const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Gets the counters of the admission control of the datastreams.
+   * @return The counters of all the interfaces, all zero without admission control.
+   */
+  [[nodiscard]] auto admission_counters() const -> AdmissionCounters;
+
+  /**
+   * @brief Gets the counters of the admission control of the datastreams of an interface.
+   * @param[in] interface_name The name of the interface.
+   * @return The counters of the interface, all zero without admission control.
+   */
+  [[nodiscard]] auto admission_counters(std::string_view interface_name) const
+      -> AdmissionCounters;
+
   /**
    * @brief Sets a device property on an interface.
    *
@@ -182,9 +252,22 @@ struct DeviceMqtt::DeviceMqttImpl {
    */
   auto poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message>;
 
+  /**
+   * @brief Polls for a new message received from Astarte, without copying it.
+   *
+   * @param[in] timeout The maximum duration to block waiting for a message.
+   * @return An std::optional containing a SharedMessage if one was available, otherwise
+   * std::nullopt.
+   */
+  auto poll_incoming_shared(const std::chrono::milliseconds& timeout)
+      -> std::optional<SharedMessage>;
+
   /**
    * @brief Gets all stored properties matching the input filter.
    *
+   * @details The server-owned properties are read from their persistent store, the device-owned
+   * ones are not stored.
+   *
    * @param[in] ownership Optional ownership filter.
    * @return An expected containing the list of properties on success or Error on failure.
    */
@@ -211,6 +294,22 @@ struct DeviceMqtt::DeviceMqttImpl {
       -> astarte_tl::expected<PropertyIndividual, Error>;
 
  private:
+  /// @brief A validated send, keeping alive the interface its descriptor refers to.
+  struct ResolvedSend {
+    /// @brief The interface of the data.
+    std::shared_ptr<const Interface> interface;
+    /// @brief The metadata of the send, pointing into the interface.
+    SendDescriptor descriptor;
+  };
+
+  /// @brief Outcome of the admission of a datastream.
+  struct Admission {
+    /// @brief False if the datastream must be dropped.
+    bool admitted{true};
+    /// @brief Accounts the datastream in the load until released, null without admission control.
+    std::shared_ptr<AdmissionController::Ticket> ticket;
+  };
+
   /**
    * @brief Private constructor for a DeviceMqttImpl instance.
    * @param[in] cfg Set of MQTT configuration options used to connect a device to Astarte.
@@ -218,9 +317,90 @@ struct DeviceMqtt::DeviceMqttImpl {
    */
   DeviceMqttImpl(Config cfg, connection::Connection connection);
 
+  /**
+   * @brief Gets the persistent store of the server-owned properties.
+   * @return An expected containing the store or Error if the properties are not persisted.
+   */
+  [[nodiscard]] auto stored_server_properties() const
+      -> astarte_tl::expected<std::shared_ptr<ServerProperties>, Error>;
+
+  /**
+   * @brief Gets an interface of the introspection to send data on it.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @return An expected containing the interface or Error if the device is not connected or the
+   * interface is not installed.
+   */
+  [[nodiscard]] auto lookup_interface(std::string_view interface_name) const
+      -> astarte_tl::expected<std::shared_ptr<const Interface>, Error>;
+
+  /**
+   * @brief Validates an individual datastream value.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @param[in] path The path within the interface.
+   * @param[in] data The data point to validate.
+   * @param[in] timestamp An optional timestamp for the data point.
+   * @return An expected containing the resolved send on success or Error on failure.
+   */
+  [[nodiscard]] auto resolve_individual(std::string_view interface_name, std::string_view path,
+                                        const Data& data,
+                                        const std::chrono::system_clock::time_point* timestamp)
+      const -> astarte_tl::expected<ResolvedSend, Error>;
+
+  /**
+   * @brief Validates a datastream object.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @param[in] path The base path for the object within the interface.
+   * @param[in] object The object to validate.
+   * @param[in] timestamp An optional timestamp for the data.
+   * @return An expected containing the resolved send on success or Error on failure.
+   */
+  [[nodiscard]] auto resolve_object(std::string_view interface_name, std::string_view path,
+                                    const DatastreamObject& object,
+                                    const std::chrono::system_clock::time_point* timestamp) const
+      -> astarte_tl::expected<ResolvedSend, Error>;
+
+  /**
+   * @brief Admits a validated datastream in the load of the outbound path.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @param[in] bytes The estimated size of the payload.
+   * @return An expected containing the outcome of the admission or Error if the datastream is
+   * refused.
+   */
+  auto admit(std::string_view interface_name, size_t bytes)
+      -> astarte_tl::expected<Admission, Error>;
+
+  /**
+   * @brief Hands serialized data to the connection, without waiting for its delivery.
+   * @details Run by the send workers, failures are logged.
+   *
+   * @param[in] interface_name The name of the interface.
+   * @param[in] path The path within the interface.
+   * @param[in] descriptor The metadata resolved by the validation.
+   * @param[in] bson_bytes The BSON serialized data.
+   * @param[in] ticket The admission ticket, released once the publication completes.
+   * @return The publication started, to be awaited by the worker.
+   */
+  auto start_publish(std::string_view interface_name, std::string_view path,
+                     const SendDescriptor& descriptor, std::vector<uint8_t>& bson_bytes,
+                     std::shared_ptr<AdmissionController::Ticket> ticket)
+      -> SendPipeline::InFlight;
+
   Config cfg_;
   connection::Connection connection_;
   std::shared_ptr<Introspection> introspection_ = std::make_shared<Introspection>();
+  // Admission control of the datastreams, null when every datastream is admitted. Outlives the
+  // pipeline, whose queued sends hold its tickets.
+  std::unique_ptr<AdmissionController> admission_;
+  // Set to stop the send workers from waiting on the deliveries in flight, so that a disconnection
+  // or the destruction of the device does not hang while the broker is unreachable.
+  std::atomic<bool> abandon_deliveries_{false};
+  // Workers publishing the datastreams, null when they are sent on the calling thread. Declared
+  // last so that the queued sends are published before the connection is destroyed.
+  std::unique_ptr<SendPipeline> pipeline_;
 };
 
 }  // namespace astarte::device::mqtt
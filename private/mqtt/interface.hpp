@@ -17,6 +17,7 @@
 #include <spdlog/spdlog.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -157,6 +158,25 @@ class InterfaceAggregation {
   Value value_;
 };
 
+/**
+ * @brief Metadata of a validated send, resolved from the mapping of the data.
+ *
+ * @details Returned by the validation of the data sent on an interface, so that serialization and
+ * the transport do not need to resolve the mapping again.
+ */
+struct SendDescriptor {
+  /// @brief The mapping of the data, for objects the first mapping of the object.
+  const Mapping* mapping;
+  /// @brief The MQTT QoS level of the publication.
+  uint8_t qos;
+  /// @brief What to do with the data when it cannot be delivered.
+  Retention retention;
+  /// @brief Seconds after which undelivered data expires, zero if it never expires.
+  int64_t expiry;
+  /// @brief True if the data is sent with an explicit timestamp.
+  bool explicit_timestamp;
+};
+
 /**
  * @brief Represents a parsed Astarte interface.
  *
@@ -172,6 +192,17 @@ class Interface {
    */
   static auto try_from_json(const json& interface) -> astarte_tl::expected<Interface, Error>;
 
+  /**
+   * @brief Tries to parse a JSON string into an Interface object.
+   *
+   * @details The string is parsed with the JSON backend selected at build time, see
+   * mqtt/json_backend.hpp. Both backends apply the same validation as try_from_json.
+   *
+   * @param[in] interface The JSON string of the Astarte interface.
+   * @return An expected containing the Interface on success or Error on failure.
+   */
+  static auto try_from_str(std::string_view interface) -> astarte_tl::expected<Interface, Error>;
+
   /**
    * @brief Move constructor.
    * @param[in,out] other The Interface object to move from.
@@ -234,6 +265,17 @@ class Interface {
   [[nodiscard]] auto get_mapping(std::string_view path) const
       -> astarte_tl::expected<const Mapping*, Error>;
 
+  /**
+   * @brief Finds the mapping of a path without allocating.
+   *
+   * @details For object aggregated interfaces the path is the common path of the object and the
+   * first mapping of the object is returned.
+   *
+   * @param[in] path The Astarte interface path.
+   * @return A pointer to the mapping, nullptr if no mapping matches the path.
+   */
+  [[nodiscard]] auto find_mapping(std::string_view path) const -> const Mapping*;
+
   /**
    * @brief Validates an Astarte individual data point against this interface.
    *
@@ -258,6 +300,63 @@ class Interface {
                        const std::chrono::system_clock::time_point* timestamp) const
       -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Validates an Astarte individual data point and resolves the metadata of its send.
+   *
+   * @param[in] path The Astarte interface path.
+   * @param[in] data The value to validate.
+   * @param[in] timestamp A pointer to the timestamp, if provided.
+   * @return An expected containing the send descriptor on success or Error on failure.
+   */
+  auto resolve_individual(std::string_view path, const Data& data,
+                          const std::chrono::system_clock::time_point* timestamp) const
+      -> astarte_tl::expected<SendDescriptor, Error>;
+
+  /**
+   * @brief Validates a typed Astarte individual value and resolves the metadata of its send.
+   *
+   * @details The Astarte type of the value is known at compile time, so it is checked against the
+   * mapping without wrapping the value in a Data.
+   *
+   * @tparam T The C++ type of the value.
+   * @param[in] path The Astarte interface path.
+   * @param[in] value The value to validate.
+   * @param[in] timestamp A pointer to the timestamp, if provided.
+   * @return An expected containing the send descriptor on success or Error on failure.
+   */
+  template <DataAllowedType T>
+  auto resolve_individual(std::string_view path, const T& value,
+                          const std::chrono::system_clock::time_point* timestamp) const
+      -> astarte_tl::expected<SendDescriptor, Error> {
+    auto mapping_res = get_mapping(path);
+    if (!mapping_res) {
+      return astarte_tl::unexpected(mapping_res.error());
+    }
+    const Mapping* mapping = mapping_res.value();
+
+    auto res = mapping->check_value(value);
+    if (!res) {
+      return astarte_tl::unexpected(res.error());
+    }
+
+    return describe_individual(*mapping, path, timestamp);
+  }
+
+  /**
+   * @brief Validates an Astarte object and resolves the metadata of its send.
+   *
+   * @details The common path is matched once and the mapping of each entry is resolved by the last
+   * segment of its endpoint, without formatting the path of each entry.
+   *
+   * @param[in] common_path The common base path of the Astarte interface endpoints.
+   * @param[in] object The Astarte object data to validate.
+   * @param[in] timestamp A pointer to the timestamp, if provided.
+   * @return An expected containing the send descriptor on success or Error on failure.
+   */
+  auto resolve_object(std::string_view common_path, const DatastreamObject& object,
+                      const std::chrono::system_clock::time_point* timestamp) const
+      -> astarte_tl::expected<SendDescriptor, Error>;
+
   /**
    * @brief Gets the MQTT QoS level from a certain mapping endpoint.
    *
@@ -279,7 +378,66 @@ class Interface {
         aggregation_(aggregation),
         description_(std::move(description)),
         doc_(std::move(doc)),
-        mappings_(std::move(mappings)) {}
+        mappings_(std::move(mappings)) {
+    index_object_fields();
+  }
+
+  /**
+   * @brief Builds the send descriptor of a validated mapping.
+   *
+   * @param[in] mapping The mapping of the data.
+   * @param[in] timestamp A pointer to the timestamp, if provided.
+   * @return An expected containing the send descriptor on success or Error on failure.
+   */
+  static auto describe_send(const Mapping& mapping,
+                            const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<SendDescriptor, Error>;
+
+  /**
+   * @brief Checks the timestamp of an individual data point and builds the descriptor of its send.
+   *
+   * @param[in] mapping The mapping of the data, already type checked.
+   * @param[in] path The Astarte interface path.
+   * @param[in] timestamp A pointer to the timestamp, if provided.
+   * @return An expected containing the send descriptor on success or Error on failure.
+   */
+  auto describe_individual(const Mapping& mapping, std::string_view path,
+                           const std::chrono::system_clock::time_point* timestamp) const
+      -> astarte_tl::expected<SendDescriptor, Error>;
+
+  /// @brief Mapping of an object entry, indexed by the last segment of the mapping endpoint.
+  struct ObjectField {
+    /// @brief Index of the mapping in the interface mappings.
+    size_t mapping;
+    /// @brief Offset of the last segment in the mapping endpoint.
+    size_t name_offset;
+  };
+
+  /**
+   * @brief Gets the name of an object field, the last segment of the endpoint of its mapping.
+   *
+   * @details Offsets are stored instead of views, so the index never refers to another interface.
+   *
+   * @param[in] field The indexed field.
+   * @return A view of the name, valid as long as the interface.
+   */
+  [[nodiscard]] auto object_field_name(const ObjectField& field) const -> std::string_view;
+
+  /**
+   * @brief Builds the object fields index, sorted by name.
+   *
+   * @details The index is left empty for individual interfaces and for objects whose endpoints do
+   * not share the same common path, which are then validated one path at a time.
+   */
+  void index_object_fields();
+
+  /**
+   * @brief Finds the mapping of an object entry in the object fields index.
+   *
+   * @param[in] name The key of the object entry.
+   * @return A pointer to the mapping, nullptr if no mapping has the name as last segment.
+   */
+  [[nodiscard]] auto find_object_field(std::string_view name) const -> const Mapping*;
 
   std::string interface_name_;
   uint32_t version_major_;
@@ -290,6 +448,7 @@ class Interface {
   std::optional<std::string> description_;
   std::optional<std::string> doc_;
   std::vector<Mapping> mappings_;
+  std::vector<ObjectField> object_fields_;
 };
 
 }  // namespace astarte::device::mqtt
@@ -76,6 +76,15 @@ class Introspection {
   [[nodiscard]] auto get(std::string_view interface_name) const
       -> astarte_tl::expected<std::shared_ptr<const Interface>, Error>;
 
+  /**
+   * @brief Finds an interface without allocating.
+   *
+   * @param[in] interface_name The name of the interface to retrieve.
+   * @return The pointer to the Interface, nullptr if the interface is not in the introspection.
+   */
+  [[nodiscard]] auto find(std::string_view interface_name) const
+      -> std::shared_ptr<const Interface>;
+
  private:
   mutable std::shared_mutex lock_;
   std::map<std::string, std::shared_ptr<const Interface>, std::less<>> interfaces_;
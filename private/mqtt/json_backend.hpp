@@ -0,0 +1,46 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_JSON_BACKEND_H
+#define ASTARTE_MQTT_JSON_BACKEND_H
+
+/**
+ * @file private/mqtt/json_backend.hpp
+ * @brief Parsing of JSON documents with the backend selected at build time.
+ *
+ * @details By default JSON documents are parsed into an nlohmann::json DOM. When the SDK is built
+ * with the `ASTARTE_USE_SIMDJSON` option the simdjson on-demand parser is used instead, reading
+ * only the values that are needed without building a DOM.
+ */
+
+#include <string>
+#include <string_view>
+
+#include "astarte_device_sdk/errors.hpp"
+
+namespace astarte::device::mqtt::json_backend {
+
+/**
+ * @brief Gets the name of the JSON backend the SDK has been built with.
+ * @return "simdjson" or "nlohmann".
+ */
+auto name() -> std::string_view;
+
+/**
+ * @brief Extracts a single value from a JSON document.
+ *
+ * @details Only std::string and bool values are supported.
+ *
+ * @tparam T The type of the value to extract.
+ * @param[in] text The JSON document.
+ * @param[in] pointer The JSON pointer to the value, as defined by RFC 6901.
+ * @return The value, an error if the document is not valid JSON or the value is missing or of
+ * a different type.
+ */
+template <typename T>
+auto value_at(std::string_view text, std::string_view pointer) -> astarte_tl::expected<T, Error>;
+
+}  // namespace astarte::device::mqtt::json_backend
+
+#endif  // ASTARTE_MQTT_JSON_BACKEND_H
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <format>
 #include <functional>
+#include <limits>
 #include <map>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -30,6 +31,7 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/errors.hpp"
@@ -59,13 +61,13 @@ class Reliability {
   };
 
   /// @brief Constructs a Reliability object with default value (unreliable).
-  Reliability() : value_(kUnreliable) {}
+  constexpr Reliability() : value_(kUnreliable) {}
 
   /**
    * @brief Constructs a Reliability from a specific Value.
    * @param[in] val The reliability value.
    */
-  explicit Reliability(Value val) : value_(val) {}
+  constexpr explicit Reliability(Value val) : value_(val) {}
 
   /// @brief Default equality operator for comparing two Reliability objects.
   constexpr auto operator==(const Reliability& other) const -> bool = default;
@@ -111,7 +113,7 @@ class Reliability {
    * @brief Gets the Quality of Service (QoS) level associated with the reliability.
    * @return The QoS value as an 8-bit integer (0, 1, or 2).
    */
-  [[nodiscard]] auto get_qos() const -> int8_t { return static_cast<int8_t>(value_); }
+  [[nodiscard]] constexpr auto get_qos() const -> int8_t { return static_cast<int8_t>(value_); }
 
   /**
    * @brief Deserializes Reliability from a JSON object.
@@ -150,13 +152,19 @@ class Retention {
   };
 
   /// @brief Constructs a Retention object with default value (discard).
-  Retention() : value_(kDiscard) {}
+  constexpr Retention() : value_(kDiscard) {}
 
   /**
    * @brief Constructs a Retention from a specific Value.
    * @param[in] val The retention value.
    */
-  explicit Retention(Value val) : value_(val) {}
+  constexpr explicit Retention(Value val) : value_(val) {}
+
+  /**
+   * @brief Gets the underlying value of the retention.
+   * @return The retention value.
+   */
+  [[nodiscard]] constexpr auto value() const -> Value { return value_; }
 
   /// @brief Default equality operator for comparing two Retention objects.
   constexpr auto operator==(const Retention& other) const -> bool = default;
@@ -297,6 +305,128 @@ class DatabaseRetentionPolicy {
   Value value_;
 };
 
+/**
+ * @brief Metadata of a mapping read on every send, packed in a single word.
+ *
+ * @details The word is derived once when the mapping is constructed, so that validating and
+ * publishing data reads a single word next to the endpoint of the mapping instead of several
+ * optional fields. From the least significant bit, the word contains:
+ * - bits 0-3: the Astarte type;
+ * - bits 4-5: the QoS of the reliability;
+ * - bits 6-7: the retention;
+ * - bits 8-9: the explicit timestamp requirement;
+ * - bit 10: set if the property can be unset;
+ * - bits 32-63: the expiry in seconds, clamped to 32 bits.
+ */
+class MappingMetadata {
+ public:
+  /// @brief Requirement on the timestamp of the data sent on a mapping.
+  enum class Timestamp : uint8_t {
+    /// @brief The mapping does not define explicit_timestamp, any data is accepted.
+    kAny = 0,
+    /// @brief The data must have an explicit timestamp.
+    kRequired = 1,
+    /// @brief The data must not have an explicit timestamp.
+    kForbidden = 2,
+  };
+
+  /// @brief Constructs the metadata of an unreliable mapping of binary blobs.
+  constexpr MappingMetadata() = default;
+
+  /**
+   * @brief Packs the metadata of a mapping.
+   *
+   * @param[in] type The data type accepted by the mapping.
+   * @param[in] explicit_timestamp Whether the data must have an explicit timestamp.
+   * @param[in] reliability The QoS level of the data, unreliable if not set.
+   * @param[in] retention The policy for retaining unsent data, discard if not set.
+   * @param[in] expiry The expiration time of retained data in seconds, never if not set.
+   * @param[in] allow_unset Whether the property can be unset, false if not set.
+   */
+  constexpr MappingMetadata(Type type, std::optional<bool> explicit_timestamp,
+                            std::optional<Reliability> reliability,
+                            std::optional<Retention> retention, std::optional<int64_t> expiry,
+                            std::optional<bool> allow_unset) {
+    Timestamp timestamp = Timestamp::kAny;
+    if (explicit_timestamp.has_value()) {
+      timestamp = explicit_timestamp.value() ? Timestamp::kRequired : Timestamp::kForbidden;
+    }
+    const int64_t seconds = std::clamp<int64_t>(expiry.value_or(0), 0, k_max_expiry);
+    word_ = static_cast<uint64_t>(type) & k_type_mask;
+    word_ |= static_cast<uint64_t>(reliability.value_or(Reliability()).get_qos()) << k_qos_shift;
+    word_ |= static_cast<uint64_t>(retention.value_or(Retention()).value()) << k_retention_shift;
+    word_ |= static_cast<uint64_t>(timestamp) << k_timestamp_shift;
+    word_ |= static_cast<uint64_t>(allow_unset.value_or(false)) << k_allow_unset_shift;
+    word_ |= static_cast<uint64_t>(seconds) << k_expiry_shift;
+  }
+
+  /**
+   * @brief Gets the data type accepted by the mapping.
+   * @return The Astarte type.
+   */
+  [[nodiscard]] constexpr auto type() const -> Type {
+    return static_cast<Type>(word_ & k_type_mask);
+  }
+
+  /**
+   * @brief Gets the QoS level of the data.
+   * @return The QoS level, 0, 1 or 2.
+   */
+  [[nodiscard]] constexpr auto qos() const -> uint8_t {
+    return static_cast<uint8_t>((word_ >> k_qos_shift) & k_two_bits_mask);
+  }
+
+  /**
+   * @brief Gets the policy for retaining unsent data.
+   * @return The retention.
+   */
+  [[nodiscard]] constexpr auto retention() const -> Retention {
+    return Retention(static_cast<Retention::Value>((word_ >> k_retention_shift) & k_two_bits_mask));
+  }
+
+  /**
+   * @brief Gets the requirement on the timestamp of the data.
+   * @return The timestamp requirement.
+   */
+  [[nodiscard]] constexpr auto timestamp() const -> Timestamp {
+    return static_cast<Timestamp>((word_ >> k_timestamp_shift) & k_two_bits_mask);
+  }
+
+  /**
+   * @brief Checks if the property can be unset.
+   * @return True if the property can be unset.
+   */
+  [[nodiscard]] constexpr auto allow_unset() const -> bool {
+    return ((word_ >> k_allow_unset_shift) & 1U) != 0;
+  }
+
+  /**
+   * @brief Gets the expiration time of retained data.
+   * @return The expiry in seconds, zero if retained data never expires.
+   */
+  [[nodiscard]] constexpr auto expiry() const -> int64_t {
+    return static_cast<int64_t>(word_ >> k_expiry_shift);
+  }
+
+  /// @brief Default equality operator for comparing two packed metadata.
+  constexpr auto operator==(const MappingMetadata& other) const -> bool = default;
+
+ private:
+  static constexpr uint64_t k_type_mask = 0xF;
+  static constexpr uint64_t k_two_bits_mask = 0x3;
+  static constexpr int k_qos_shift = 4;
+  static constexpr int k_retention_shift = 6;
+  static constexpr int k_timestamp_shift = 8;
+  static constexpr int k_allow_unset_shift = 10;
+  static constexpr int k_expiry_shift = 32;
+  static constexpr int64_t k_max_expiry = std::numeric_limits<uint32_t>::max();
+
+  uint64_t word_{0};
+};
+
+static_assert(sizeof(MappingMetadata) == sizeof(uint64_t));
+static_assert(Type::kStringArray <= 0xF, "the Astarte type must fit in four bits");
+
 /**
  * @brief Represents a single Astarte mapping within an interface.
  *
@@ -327,7 +457,7 @@ class Mapping {
           std::optional<int64_t> database_retention_ttl, std::optional<bool> allow_unset,
           std::optional<std::string> description, std::optional<std::string> doc)
       : endpoint_(std::move(endpoint)),
-        type_(type),
+        metadata_(type, explicit_timestamp, reliability, retention, expiry, allow_unset),
         explicit_timestamp_(explicit_timestamp),
         reliability_(reliability),
         retention_(retention),
@@ -346,6 +476,15 @@ class Mapping {
    */
   [[nodiscard]] auto match_path(std::string_view path) const -> bool;
 
+  /**
+   * @brief Checks that the mapping endpoint, without its last segment, matches the common path of
+   * an object.
+   *
+   * @param[in] path The common path of the object to check.
+   * @return True if the mapping belongs to objects sent on the path, false otherwise.
+   */
+  [[nodiscard]] auto match_object_path(std::string_view path) const -> bool;
+
   /**
    * @brief Checks that the Astarte data matches the mapping type.
    *
@@ -354,6 +493,41 @@ class Mapping {
    */
   [[nodiscard]] auto check_data_type(const Data& data) const -> astarte_tl::expected<void, Error>;
 
+  /**
+   * @brief Checks that a value matches the mapping type.
+   *
+   * @details The type of the value is known at compile time and compared against the packed
+   * metadata of the mapping, doubles are also checked to be finite.
+   *
+   * @tparam T The C++ type of the value.
+   * @param[in] value The value to check.
+   * @return An expected containing void on success or Error on failure.
+   */
+  template <DataAllowedType T>
+  [[nodiscard]] auto check_value(const T& value) const -> astarte_tl::expected<void, Error> {
+    if (metadata_.type() != k_astarte_type<T>) {
+      spdlog::error("Astarte data type and mapping type do not match");
+      return astarte_tl::unexpected(
+          InterfaceValidationError("Astarte data type and mapping type do not match"));
+    }
+
+    if constexpr (std::is_same_v<T, double>) {
+      if (!std::isfinite(value)) {
+        spdlog::error("Astarte data double is not a number");
+        return astarte_tl::unexpected(
+            InterfaceValidationError("Astarte data double is not a number"));
+      }
+    } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+      if (!std::ranges::all_of(value, [](double elem) { return std::isfinite(elem); })) {
+        spdlog::error("Astarte data double is not a number");
+        return astarte_tl::unexpected(
+            InterfaceValidationError("Astarte data double is not a number"));
+      }
+    }
+
+    return {};
+  }
+
   /**
    * @brief Gets the path of the mapping.
    * @details It can be parametrized (e.g. `/foo/%{path}/baz`).
@@ -366,7 +540,13 @@ class Mapping {
    * @details This represents the data type that will be published on the mapping.
    * @return The Astarte Type.
    */
-  [[nodiscard]] auto type() const -> Type { return type_; }
+  [[nodiscard]] auto type() const -> Type { return metadata_.type(); }
+
+  /**
+   * @brief Gets the metadata of the mapping read on every send.
+   * @return The packed metadata.
+   */
+  [[nodiscard]] auto metadata() const -> MappingMetadata { return metadata_; }
 
   /**
    * @brief Checks if an explicit timestamp is allowed.
@@ -447,7 +627,8 @@ class Mapping {
 
  private:
   std::string endpoint_;
-  Type type_;
+  // Packed copy of the fields read on every send, next to the endpoint matched before reading it.
+  MappingMetadata metadata_;
   std::optional<bool> explicit_timestamp_;
   std::optional<Reliability> reliability_;
   std::optional<Retention> retention_;
@@ -0,0 +1,205 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_PROPERTY_CACHE_H
+#define ASTARTE_MQTT_PROPERTY_CACHE_H
+
+/**
+ * @file private/mqtt/property_cache.hpp
+ * @brief Persistent cache of the server-owned properties.
+ *
+ * @details This file defines the `PropertyCache` class, which stores the server-owned properties
+ * received from Astarte on disk and tracks whether they are consistent with the values held by
+ * the server, so that the device can avoid requesting all of them on every reconnection.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "astarte_device_sdk/errors.hpp"
+
+namespace astarte::device::mqtt {
+
+/**
+ * @brief Persistent cache of the server-owned properties received from Astarte.
+ *
+ * @details Properties are stored as the raw BSON payloads received from the broker, keyed by the
+ * interface name followed by the property path.
+ *
+ * The cache is consistent with the server once a full synchronization has completed: after the
+ * device sends `emptyCache`, Astarte publishes the list of all the set server-owned properties on
+ * `control/consumer/properties` and then the value of each of them. The synchronization completes
+ * when a value has been received for every listed property. From then on every received property
+ * is persisted immediately, while during a synchronization the cache is only persisted once it
+ * completes. A synchronization is tied to the introspection it was performed with.
+ *
+ * The cache is persisted as a snapshot of all the properties and a journal of the updates received
+ * since the snapshot was written. Each update appends a single record to the journal, and the
+ * snapshot is rewritten once the journal holds more records than there are properties, so that the
+ * cost of persisting an update does not grow with the number of properties. Both files are synced
+ * to the disk before an update is considered persisted. The journal carries the generation of the
+ * snapshot it extends, so that a journal left behind by an interrupted rewrite is never applied.
+ *
+ * The class is not internally synchronized, it is meant to be used from the single thread
+ * delivering the MQTT messages.
+ */
+class PropertyCache {
+ public:
+  /**
+   * @brief Loads the cache from a file.
+   *
+   * @details A missing or unreadable file results in an empty, inconsistent, cache.
+   *
+   * @param[in] file_path The path of the file backing the cache.
+   * @return The loaded cache.
+   */
+  static auto load(std::filesystem::path file_path) -> PropertyCache;
+
+  /**
+   * @brief Checks whether the cache is consistent with the server.
+   *
+   * @param[in] introspection The current introspection of the device, in its Astarte string form.
+   * @return True if a synchronization completed with the same introspection, false otherwise.
+   */
+  [[nodiscard]] auto is_consistent(std::string_view introspection) const -> bool;
+
+  /**
+   * @brief Starts a synchronization, to be called right before sending `emptyCache`.
+   *
+   * @param[in] introspection The current introspection of the device, in its Astarte string form.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto begin_sync(std::string_view introspection) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Stores a received property.
+   *
+   * @param[in] interface_name The name of the server-owned property interface.
+   * @param[in] path The path of the property.
+   * @param[in] payload The BSON payload of the property, an empty payload unsets the property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto store(std::string_view interface_name, std::string_view path, std::string_view payload)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Applies the list of the properties set on the server, removing all the others.
+   *
+   * @param[in] payload The payload received on `control/consumer/properties`, a four bytes big
+   * endian length followed by the zlib compressed list of the set properties.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto purge(std::string_view payload) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Gets the payload of a property.
+   *
+   * @param[in] interface_name The name of the server-owned property interface.
+   * @param[in] path The path of the property.
+   * @return The BSON payload of the property, std::nullopt if the property is not set.
+   */
+  [[nodiscard]] auto get(std::string_view interface_name, std::string_view path) const
+      -> std::optional<std::string>;
+
+  /**
+   * @brief Visits the stored properties of an interface, ordered by path.
+   *
+   * @param[in] interface_name The name of the interface, std::nullopt to visit all the properties.
+   * @param[in] visitor Callable invoked with the interface name, the path and the payload of each
+   * property.
+   */
+  void for_each(
+      std::optional<std::string_view> interface_name,
+      const std::function<void(std::string_view, std::string_view, std::string_view)>& visitor)
+      const;
+
+  /**
+   * @brief Gets the number of stored properties.
+   * @return The number of properties.
+   */
+  [[nodiscard]] auto size() const -> size_t { return properties_.size(); }
+
+ private:
+  /**
+   * @brief Constructs an empty cache.
+   * @param[in] file_path The path of the file backing the cache.
+   */
+  explicit PropertyCache(std::filesystem::path file_path);
+
+  /**
+   * @brief Marks the synchronization as completed if no listed property is missing.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto complete_sync() -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Writes the cache to its file, removing the files and the consistency on failure.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto persist() -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Persists the update of a property, appending it to the journal.
+   *
+   * @details The snapshot is rewritten instead once the journal outgrows the properties. Failures
+   * remove the files and the consistency.
+   *
+   * @param[in] key The key of the property.
+   * @param[in] payload The payload of the property, empty if the property has been unset.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto persist_update(std::string_view key, std::string_view payload)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Writes the cache to its file, replacing the previous content atomically, and clears the
+   * journal.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto save() -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Applies the journal of the updates to the loaded snapshot.
+   * @details A truncated or invalid record ends the journal.
+   */
+  void replay_journal();
+
+  /**
+   * @brief Gets the path of the journal of the updates.
+   * @return The path of the journal.
+   */
+  [[nodiscard]] auto journal_path() const -> std::filesystem::path;
+
+  /// @brief The path of the file backing the cache.
+  std::filesystem::path file_path_;
+  /// @brief Introspection the last synchronization has been performed with.
+  std::string introspection_;
+  /// @brief Generation of the snapshot, the journal only applies to the snapshot of its generation.
+  int64_t generation_{0};
+  /// @brief Number of update records in the journal.
+  size_t journal_records_{0};
+  /// @brief True if the last synchronization has completed.
+  bool consistent_{false};
+  /// @brief True while a synchronization is in progress.
+  bool syncing_{false};
+  /// @brief True while the synchronization awaits the list of the set properties.
+  bool awaiting_list_{false};
+  /// @brief Properties received during the synchronization, before the list of set properties.
+  std::set<std::string, std::less<>> received_;
+  /// @brief Listed properties whose value has not been received yet.
+  std::set<std::string, std::less<>> pending_;
+  /// @brief Payloads of the properties, keyed by interface name followed by path.
+  std::map<std::string, std::string, std::less<>> properties_;
+};
+
+}  // namespace astarte::device::mqtt
+
+#endif  // ASTARTE_MQTT_PROPERTY_CACHE_H
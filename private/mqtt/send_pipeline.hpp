@@ -0,0 +1,184 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_SEND_PIPELINE_H
+#define ASTARTE_MQTT_SEND_PIPELINE_H
+
+/**
+ * @file private/mqtt/send_pipeline.hpp
+ * @brief Pool of worker threads serializing and publishing the sends of a device.
+ *
+ * @details This file defines the `SendPipeline` class, which runs the serialization and the
+ * publication of the validated sends off the threads of the application, starting the
+ * publications of a batch of sends before waiting for their delivery.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+
+namespace astarte::device::mqtt {
+
+/**
+ * @brief Fixed pool of workers running the jobs submitted under a key in submission order.
+ *
+ * @details Each key is assigned to a single worker by its hash, so the jobs of the same key run
+ * one after the other in the order they were submitted, while jobs of different keys may run
+ * concurrently on different workers. The device uses the interface name as key, preserving the
+ * order of the sends of each interface.
+ *
+ * A job only starts its work, such as handing a message to the transport, and returns the bytes
+ * it started along with the wait for its completion. Each worker collects its jobs in batches,
+ * starting every job of a batch before waiting for the completion of the first one. A batch
+ * takes the jobs already queued and, while the worker lingers, the ones submitted afterwards, up
+ * to a number of started bytes. The linger time adapts to the load: it grows while batches
+ * collect several jobs and shrinks back to zero while jobs arrive one at a time, so that an idle
+ * pipeline adds no latency.
+ *
+ * The number of jobs waiting to run is bounded, further submissions are refused. The workers run
+ * the remaining jobs before stopping, when the pipeline is destroyed.
+ */
+class SendPipeline {
+ public:
+  /// @brief The work started by a job.
+  struct InFlight {
+    /// @brief The number of bytes started by the job, counted against the batch size.
+    size_t bytes{0};
+    /// @brief Waits for the completion of the work, empty if the work is already completed.
+    std::function<void()> wait;
+  };
+
+  /// @brief A unit of work, owning everything it needs to run.
+  using Job = std::function<InFlight()>;
+
+  /**
+   * @brief Starts the workers.
+   *
+   * @param[in] workers The number of worker threads, at least one.
+   * @param[in] capacity The maximum number of jobs waiting to run, at least one.
+   * @param[in] hook The hook invoked on each worker thread when it starts, may be empty.
+   * @param[in] max_linger The maximum time a batch waits for further jobs, zero to never wait.
+   * @param[in] batch_bytes The number of started bytes closing a batch, at least one.
+   */
+  SendPipeline(uint32_t workers, size_t capacity, ThreadHook hook,
+               std::chrono::microseconds max_linger = std::chrono::microseconds(0),
+               size_t batch_bytes = 1);
+
+  /// @brief Destructor, running the jobs still waiting and joining the workers.
+  ~SendPipeline();
+
+  /// @brief SendPipeline is non-copyable.
+  SendPipeline(const SendPipeline& other) = delete;
+
+  /// @brief SendPipeline is non-moveable.
+  SendPipeline(SendPipeline&& other) = delete;
+
+  /// @brief SendPipeline is non-copyable.
+  auto operator=(const SendPipeline& other) -> SendPipeline& = delete;
+
+  /// @brief SendPipeline is non-moveable.
+  auto operator=(SendPipeline&& other) -> SendPipeline& = delete;
+
+  /**
+   * @brief Queues a job on the worker of its key.
+   *
+   * @param[in] key The key ordering the job, such as an interface name.
+   * @param[in] job The job to run.
+   * @return An expected containing void on success or Error if too many jobs are waiting.
+   */
+  auto submit(std::string_view key, Job job) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Waits until all the jobs submitted so far have run.
+   */
+  void flush();
+
+  /**
+   * @brief Waits until all the jobs submitted so far have run, or until a timeout.
+   *
+   * @param[in] timeout The maximum time to wait.
+   * @return True if all the jobs have run, false if the timeout elapsed first.
+   */
+  auto flush_for(std::chrono::milliseconds timeout) -> bool;
+
+  /**
+   * @brief Gets the number of jobs submitted and not yet completed.
+   * @return The number of pending jobs.
+   */
+  [[nodiscard]] auto pending() const -> size_t;
+
+  /**
+   * @brief Gets the number of worker threads.
+   * @return The number of workers.
+   */
+  [[nodiscard]] auto workers() const -> size_t { return workers_.size(); }
+
+  /**
+   * @brief Gets the current linger time of the workers.
+   * @return The longest linger time among the workers.
+   */
+  [[nodiscard]] auto linger() const -> std::chrono::microseconds;
+
+ private:
+  /// @brief A worker thread and the jobs assigned to it.
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Job> jobs;
+    // True while a batch taken from the queue is running.
+    bool busy{false};
+    // Current linger time in microseconds, written by the worker only.
+    std::atomic<int64_t> linger{0};
+    std::jthread thread;
+  };
+
+  /**
+   * @brief Body of a worker thread.
+   * @param[in] worker The worker run by the thread.
+   * @param[in] token The token stopping the thread.
+   */
+  void run(Worker& worker, const std::stop_token& token);
+
+  /**
+   * @brief Collects and runs a batch of jobs, waiting for their completion.
+   * @details Called by the worker thread with its mutex held, and at least one job queued.
+   * @param[in] worker The worker running the batch.
+   * @param[in] lock The lock on the mutex of the worker.
+   * @param[in] token The token stopping the worker, ending the linger early.
+   * @return The number of jobs in the batch.
+   */
+  auto run_batch(Worker& worker, std::unique_lock<std::mutex>& lock, const std::stop_token& token)
+      -> size_t;
+
+  /**
+   * @brief Adapts the linger time of a worker to the size of its last batch.
+   * @param[in] worker The worker.
+   * @param[in] jobs The number of jobs in the last batch.
+   */
+  void adapt_linger(Worker& worker, size_t jobs) const;
+
+  size_t capacity_;
+  ThreadHook hook_;
+  std::chrono::microseconds max_linger_;
+  size_t batch_bytes_;
+  std::atomic<size_t> pending_{0};
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace astarte::device::mqtt
+
+#endif  // ASTARTE_MQTT_SEND_PIPELINE_H
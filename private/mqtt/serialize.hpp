@@ -13,17 +13,106 @@
  * and objects) into BSON format for transmission over MQTT.
  */
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <iterator>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/errors.hpp"
 #include "astarte_device_sdk/object.hpp"
+#include "tracing_span.hpp"
 
 namespace astarte::device::mqtt::bson {
 
 using json = nlohmann::json;
 
+/// @brief BSON binary subtype of the Astarte binary blobs.
+constexpr uint8_t BSON_TYPE_EOO = 0x00;
+
+/**
+ * @brief Serializes a typed Astarte value to BSON.
+ *
+ * @details The conversion of the value is selected at compile time.
+ *
+ * @tparam T The C++ type of the value, must satisfy `DataAllowedType`.
+ * @param[in,out] bson A reference to the JSON/BSON object to populate.
+ * @param[in] key The BSON key associated with the Astarte data value.
+ * @param[in] value The value to serialize.
+ */
+template <DataAllowedType T>
+void serialize_astarte_value(json& bson, const std::string& key, const T& value) {
+  // handle Binary Blob
+  if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+    bson.emplace(key, json::binary(value, BSON_TYPE_EOO));
+  }
+  // handle DateTime (std::chrono::system_clock::time_point)
+  else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
+    // Convert to milliseconds
+    auto millis =
+        std::chrono::duration_cast<std::chrono::milliseconds>(value.time_since_epoch()).count();
+
+    bson.emplace(key, millis);
+  }
+  // handle Array of Binaries
+  else if constexpr (std::is_same_v<T, std::vector<std::vector<uint8_t>>>) {
+    std::vector<json> binary_array;
+    binary_array.reserve(value.size());
+    std::transform(value.begin(), value.end(), std::back_inserter(binary_array),
+                   [](const auto& bin) { return json::binary(bin, BSON_TYPE_EOO); });
+
+    bson.emplace(key, binary_array);
+  }
+  // handle Array of DateTimes
+  else if constexpr (std::is_same_v<T, std::vector<std::chrono::system_clock::time_point>>) {
+    std::vector<int64_t> dates;
+    dates.reserve(value.size());
+    std::transform(value.begin(), value.end(), std::back_inserter(dates), [](const auto& time) {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch())
+          .count();
+    });
+
+    bson.emplace(key, dates);
+  }
+  // handle string views, stored as strings
+  else if constexpr (std::is_same_v<T, std::string_view>) {
+    bson.emplace(key, std::string(value));
+  }
+  // default handler (int, double, string, bool, and the respective vectors)
+  else {
+    bson.emplace(key, value);
+  }
+}
+
+/**
+ * @brief Serializes a timestamp to BSON, if set.
+ *
+ * @param[in,out] bson A reference to the JSON/BSON object to populate.
+ * @param[in] timestamp Optional timestamp to include in the serialization.
+ */
+void serialize_timestamp(json& bson, const std::chrono::system_clock::time_point* timestamp);
+
+/**
+ * @brief Serializes a typed Astarte individual to BSON, without wrapping it in a Data.
+ *
+ * @tparam T The C++ type of the value, must satisfy `DataAllowedType`.
+ * @param[in,out] bson A reference to the JSON/BSON object to populate.
+ * @param[in] key The BSON key associated with the Astarte data value.
+ * @param[in] value The value to serialize.
+ * @param[in] timestamp Optional timestamp to include in the serialization.
+ */
+template <DataAllowedType T>
+void serialize_astarte_individual(json& bson, const std::string& key, const T& value,
+                                  const std::chrono::system_clock::time_point* timestamp) {
+  serialize_astarte_value(bson, key, value);
+  serialize_timestamp(bson, timestamp);
+}
+
 /**
  * @brief Serializes an Astarte Data individual to BSON.
  *
@@ -45,6 +134,59 @@ void serialize_astarte_individual(json& bson, const std::string& key, const Data
 void serialize_astarte_object(json& bson, const DatastreamObject& object,
                               const std::chrono::system_clock::time_point* timestamp);
 
+/**
+ * @brief Logs a serialized payload at the trace level.
+ *
+ * @details The payload is only dumped when the trace level is enabled, as the dump allocates.
+ *
+ * @param[in] kind The kind of the payload, either "individual" or "object".
+ * @param[in] bson The payload to log.
+ */
+void trace_payload(std::string_view kind, const json& bson);
+
+/**
+ * @brief Serializes an individual to the BSON payload of its publication.
+ *
+ * @details The payload is `{"v": <value>}`, with `"t": <timestamp>` when the timestamp is set.
+ *
+ * @tparam Value Either a Data or a type satisfying `DataAllowedType`.
+ * @param[in] value The value to serialize.
+ * @param[in] timestamp Optional timestamp to include in the serialization.
+ * @return The BSON bytes, an error if the value could not be serialized.
+ */
+template <typename Value>
+auto individual_to_bytes(const Value& value, const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<std::vector<uint8_t>, Error> {
+  tracing::ScopedSpan serialize_span("mqtt", "serialize_bson");
+  json bson;
+  serialize_astarte_individual(bson, "v", value, timestamp);
+  serialize_span.end();
+
+  // check that the generated bson is not 0 size
+  if (bson.empty()) {
+    return astarte_tl::unexpected(
+        DataSerializationError("Failed to serialize individual data to BSON"));
+  }
+  trace_payload("individual", bson);
+
+  ASTARTE_TRACE_SPAN("mqtt", "to_bson");
+  return json::to_bson(bson);
+}
+
+/**
+ * @brief Serializes an object to the BSON payload of its publication.
+ *
+ * @details The payload is `{"v": {<path>: <value>, ...}}`, with `"t": <timestamp>` when the
+ * timestamp is set.
+ *
+ * @param[in] object The object to serialize.
+ * @param[in] timestamp Optional timestamp to include in the serialization.
+ * @return The BSON bytes, an error if the object could not be serialized.
+ */
+auto object_to_bytes(const DatastreamObject& object,
+                     const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<std::vector<uint8_t>, Error>;
+
 }  // namespace astarte::device::mqtt::bson
 
 #endif  // ASTARTE_DATA_SERIALIZATION_H
@@ -0,0 +1,116 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_MQTT_SERVER_PROPERTIES_H
+#define ASTARTE_MQTT_SERVER_PROPERTIES_H
+
+/**
+ * @file private/mqtt/server_properties.hpp
+ * @brief Thread-safe store of the server-owned properties.
+ *
+ * @details This file defines the `ServerProperties` class, which shares the persistent cache of
+ * the server-owned properties between the thread delivering the MQTT messages and the users of the
+ * device reading the properties.
+ */
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+#include "mqtt/introspection.hpp"
+#include "mqtt/property_cache.hpp"
+
+namespace astarte::device::mqtt {
+
+/**
+ * @brief Server-owned properties received from Astarte, backed by the persistent cache.
+ *
+ * @details When the session setup is skipped Astarte does not resend the server-owned properties,
+ * their last values are only available from the cache. The properties are stored as received and
+ * decoded on read, using the mappings of the current introspection. Properties of interfaces or
+ * mappings missing from the introspection are not returned.
+ *
+ * All the methods are thread-safe.
+ */
+class ServerProperties {
+ public:
+  /**
+   * @brief Constructs the store from a loaded cache.
+   * @param[in] cache The cache backing the store.
+   */
+  explicit ServerProperties(PropertyCache cache);
+
+  /**
+   * @brief Checks whether the stored properties are consistent with the server.
+   *
+   * @param[in] introspection The current introspection of the device, in its Astarte string form.
+   * @return True if a synchronization completed with the same introspection, false otherwise.
+   */
+  [[nodiscard]] auto is_consistent(std::string_view introspection) const -> bool;
+
+  /**
+   * @brief Starts a synchronization, to be called right before sending `emptyCache`.
+   *
+   * @param[in] introspection The current introspection of the device, in its Astarte string form.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto begin_sync(std::string_view introspection) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Stores a received property.
+   *
+   * @param[in] interface_name The name of the server-owned property interface.
+   * @param[in] path The path of the property.
+   * @param[in] payload The BSON payload of the property, an empty payload unsets the property.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto store(std::string_view interface_name, std::string_view path, std::string_view payload)
+      -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Applies the list of the properties set on the server, removing all the others.
+   *
+   * @param[in] payload The payload received on `control/consumer/properties`.
+   * @return An expected containing void on success or Error on failure.
+   */
+  auto purge(std::string_view payload) -> astarte_tl::expected<void, Error>;
+
+  /**
+   * @brief Gets the value of a property.
+   *
+   * @param[in] introspection The introspection holding the interface of the property.
+   * @param[in] interface_name The name of the server-owned property interface.
+   * @param[in] path The path of the property.
+   * @return An expected containing the property, without a value if it is not set, on success or
+   * Error on failure.
+   */
+  [[nodiscard]] auto get(const Introspection& introspection, std::string_view interface_name,
+                         std::string_view path) const
+      -> astarte_tl::expected<PropertyIndividual, Error>;
+
+  /**
+   * @brief Gets the stored properties.
+   *
+   * @param[in] introspection The introspection holding the interfaces of the properties.
+   * @param[in] interface_name The name of the interface, std::nullopt to get all the properties.
+   * @return The properties, ordered by interface name and path.
+   */
+  [[nodiscard]] auto list(const Introspection& introspection,
+                          std::optional<std::string_view> interface_name) const
+      -> std::list<StoredProperty>;
+
+ private:
+  /// @brief Guards the cache.
+  mutable std::mutex mutex_;
+  /// @brief The persistent cache holding the properties.
+  PropertyCache cache_;
+};
+
+}  // namespace astarte::device::mqtt
+
+#endif  // ASTARTE_MQTT_SERVER_PROPERTIES_H
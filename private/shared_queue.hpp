@@ -19,6 +19,7 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <utility>
 
 namespace astarte::device {
 
@@ -47,7 +48,7 @@ class SharedQueue {
   auto pop(const std::chrono::milliseconds& timeout) -> std::optional<T> {
     std::unique_lock<std::mutex> mlock(mutex_);
     if (condition_.wait_for(mlock, timeout, [this] { return !queue_.empty(); })) {
-      T res = queue_.front();
+      T res = std::move(queue_.front());
       queue_.pop();
       return res;
     }
@@ -67,6 +68,17 @@ class SharedQueue {
     condition_.notify_one();
   }
 
+  /**
+   * @brief Pushes a new element into the queue, moving it.
+   *
+   * @param[in,out] item The item to be moved into the queue.
+   */
+  void push(T&& item) {
+    const std::unique_lock<std::mutex> mlock(mutex_);
+    queue_.push(std::move(item));
+    condition_.notify_one();
+  }
+
   /**
    * @brief Returns the number of elements in the queue.
    *
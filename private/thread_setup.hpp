@@ -0,0 +1,29 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_THREAD_SETUP_H
+#define ASTARTE_THREAD_SETUP_H
+
+/**
+ * @file private/thread_setup.hpp
+ * @brief Setup of the threads run by the devices.
+ */
+
+#include "astarte_device_sdk/thread_config.hpp"
+
+namespace astarte::device {
+
+/**
+ * @brief Prepares the calling thread to run SDK code.
+ *
+ * @details Names the thread after its role and invokes the user hook, if any.
+ *
+ * @param[in] role The role of the calling thread.
+ * @param[in] hook The user hook, may be empty.
+ */
+void setup_thread(ThreadRole role, const ThreadHook& hook);
+
+}  // namespace astarte::device
+
+#endif  // ASTARTE_THREAD_SETUP_H
@@ -0,0 +1,122 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_TRACING_SPAN_H
+#define ASTARTE_TRACING_SPAN_H
+
+/**
+ * @file private/tracing_span.hpp
+ * @brief Scoped tracing spans used to instrument the SDK pipelines.
+ *
+ * @details Use the `ASTARTE_TRACE_SPAN` macro to trace the remainder of the enclosing scope, or a
+ * named `ScopedSpan` with `end()` to trace a part of it. Span names and categories must be string
+ * literals, only their address is recorded. Spans do nothing when the library is compiled with
+ * `ASTARTE_DISABLE_TRACING`.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace astarte::device::tracing {
+
+/// @brief Number of spans kept for each thread, older spans are overwritten.
+constexpr size_t k_ring_capacity = 4096;
+
+/// @brief True while spans are being recorded.
+inline std::atomic<bool> enabled_flag{false};
+
+/**
+ * @brief Gets the current time of the trace clock.
+ * @return The nanoseconds elapsed on the steady clock.
+ */
+inline auto now_ns() -> int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief Records a completed span in the ring of the calling thread.
+ *
+ * @param[in] category The span category.
+ * @param[in] name The span name.
+ * @param[in] start_ns The start of the span on the trace clock.
+ * @param[in] duration_ns The duration of the span in nanoseconds.
+ */
+void record(const char* category, const char* name, int64_t start_ns, int64_t duration_ns);
+
+/**
+ * @brief Traces the time between its construction and its end or destruction.
+ */
+class ScopedSpan {
+ public:
+  /**
+   * @brief Starts the span, if tracing is enabled.
+   * @param[in] category The span category, a string literal.
+   * @param[in] name The span name, a string literal.
+   */
+  ScopedSpan(const char* category, const char* name)
+      : category_(category), name_(name), start_ns_(start()) {}
+
+  /// @brief Ends the span if not ended yet.
+  ~ScopedSpan() { end(); }
+
+  /// @brief ScopedSpan is non-copyable.
+  ScopedSpan(const ScopedSpan&) = delete;
+  /// @brief ScopedSpan is non-movable.
+  ScopedSpan(ScopedSpan&&) = delete;
+  /// @brief ScopedSpan is non-copyable.
+  auto operator=(const ScopedSpan&) -> ScopedSpan& = delete;
+  /// @brief ScopedSpan is non-movable.
+  auto operator=(ScopedSpan&&) -> ScopedSpan& = delete;
+
+  /**
+   * @brief Ends the span before the end of the scope, further calls have no effect.
+   */
+  void end() {
+    if (start_ns_ != k_inactive) {
+      record(category_, name_, start_ns_, now_ns() - start_ns_);
+      start_ns_ = k_inactive;
+    }
+  }
+
+ private:
+  /// @brief Start time of spans not being recorded.
+  static constexpr int64_t k_inactive = -1;
+
+  /**
+   * @brief Gets the start time of a new span.
+   * @return The current time if tracing is enabled, k_inactive otherwise.
+   */
+  static auto start() -> int64_t {
+#if defined(ASTARTE_DISABLE_TRACING)
+    return k_inactive;
+#else
+    return enabled_flag.load(std::memory_order_relaxed) ? now_ns() : k_inactive;
+#endif
+  }
+
+  /// @brief The span category.
+  const char* category_;
+  /// @brief The span name.
+  const char* name_;
+  /// @brief The start of the span on the trace clock.
+  int64_t start_ns_;
+};
+
+}  // namespace astarte::device::tracing
+
+/// @cond DO_NOT_DOCUMENT
+#define ASTARTE_TRACE_CONCAT_INNER(a, b) a##b
+#define ASTARTE_TRACE_CONCAT(a, b) ASTARTE_TRACE_CONCAT_INNER(a, b)
+/// @endcond
+
+/// @brief Traces the remainder of the enclosing scope.
+#define ASTARTE_TRACE_SPAN(category, name)                                        \
+  const ::astarte::device::tracing::ScopedSpan ASTARTE_TRACE_CONCAT(astarte_span_, \
+                                                                    __LINE__)(category, name)
+
+#endif  // ASTARTE_TRACING_SPAN_H
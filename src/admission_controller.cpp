@@ -0,0 +1,144 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "admission_controller.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "astarte_device_sdk/admission.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/flight_recorder.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "flight_recorder_event.hpp"
+
+namespace astarte::device {
+
+AdmissionController::Ticket::Ticket(AdmissionController* controller, size_t bytes)
+    : controller_(controller), bytes_(bytes) {}
+
+AdmissionController::Ticket::Ticket(Ticket&& other) noexcept
+    : controller_(std::exchange(other.controller_, nullptr)), bytes_(other.bytes_) {}
+
+AdmissionController::Ticket::~Ticket() {
+  if (controller_ != nullptr) {
+    controller_->release(bytes_);
+  }
+}
+
+AdmissionController::AdmissionController(AdmissionOptions options)
+    : options_(std::move(options)), max_priority_(options_.default_interface.priority) {
+  for (const auto& [name, settings] : options_.interfaces) {
+    max_priority_ = std::max(max_priority_, settings.priority);
+    interfaces_.emplace(name, InterfaceState{.settings = settings});
+  }
+}
+
+auto AdmissionController::admit(std::string_view interface_name, size_t bytes)
+    -> astarte_tl::expected<std::optional<Ticket>, Error> {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto iface = interfaces_.find(interface_name);
+  if (iface == interfaces_.end()) {
+    iface = interfaces_
+                .emplace(std::string(interface_name),
+                         InterfaceState{.settings = options_.default_interface})
+                .first;
+  }
+  InterfaceState& state = iface->second;
+  // a send larger than the byte limit is still admitted while nothing else is pending
+  const double load = pending_sends_ == 0 ? 0.0 : load_with(bytes);
+
+  bool admitted = true;
+  switch (state.settings.policy) {
+    case OverloadPolicy::kReject:
+      admitted = load <= 1.0;
+      break;
+    case OverloadPolicy::kDropLowestPriority:
+      // each priority is dropped at a higher load, the highest one only beyond the limits
+      admitted = load <= static_cast<double>(state.settings.priority + 1) /
+                             static_cast<double>(max_priority_ + 1);
+      break;
+    case OverloadPolicy::kSample:
+      admitted = load <= 1.0 &&
+                 (load <= options_.sampling_load ||
+                  state.sampled++ % std::max<uint32_t>(state.settings.sample_every, 1) == 0);
+      break;
+  }
+
+  if (admitted) {
+    pending_sends_++;
+    pending_bytes_ += bytes;
+    state.counters.admitted++;
+    totals_.admitted++;
+    return std::optional<Ticket>(Ticket(this, bytes));
+  }
+
+  flight_recorder::record(flight_recorder::EventKind::kSendShed,
+                          static_cast<int64_t>(state.settings.policy));
+  switch (state.settings.policy) {
+    case OverloadPolicy::kReject:
+      state.counters.rejected++;
+      totals_.rejected++;
+      return astarte_tl::unexpected(OverloadError(astarte_fmt::format(
+          "the outbound path is saturated, {} sends of {} bytes are waiting for their delivery",
+          pending_sends_, pending_bytes_)));
+    case OverloadPolicy::kDropLowestPriority:
+      state.counters.dropped++;
+      totals_.dropped++;
+      break;
+    case OverloadPolicy::kSample:
+      state.counters.sampled_out++;
+      totals_.sampled_out++;
+      break;
+  }
+  return std::optional<Ticket>();
+}
+
+auto AdmissionController::counters() const -> AdmissionCounters {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return totals_;
+}
+
+auto AdmissionController::counters(std::string_view interface_name) const -> AdmissionCounters {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto iface = interfaces_.find(interface_name);
+  return iface != interfaces_.end() ? iface->second.counters : AdmissionCounters{};
+}
+
+auto AdmissionController::pending_sends() const -> size_t {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return pending_sends_;
+}
+
+auto AdmissionController::pending_bytes() const -> size_t {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return pending_bytes_;
+}
+
+auto AdmissionController::load_with(size_t bytes) const -> double {
+  double load = 0.0;
+  if (options_.max_pending_sends > 0) {
+    load =
+        static_cast<double>(pending_sends_ + 1) / static_cast<double>(options_.max_pending_sends);
+  }
+  if (options_.max_pending_bytes > 0) {
+    load = std::max(load, static_cast<double>(pending_bytes_ + bytes) /
+                              static_cast<double>(options_.max_pending_bytes));
+  }
+  return load;
+}
+
+void AdmissionController::release(size_t bytes) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  pending_sends_--;
+  pending_bytes_ -= bytes;
+}
+
+}  // namespace astarte::device
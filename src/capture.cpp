@@ -0,0 +1,550 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/capture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "capture_send.hpp"
+
+namespace astarte::device::capture {
+
+namespace {
+
+// Capture files start with the magic, the format version and the capture start time. Each send
+// is then stored as a record prefixed by its length. Integers are stored in little endian order,
+// lengths, counts and durations as LEB128 varints.
+constexpr std::array<char, 8> k_magic = {'A', 'S', 'T', 'C', 'A', 'P', 'T', '\0'};
+constexpr uint32_t k_format_version = 1;
+
+constexpr uint8_t k_flag_timestamp = 0x01;
+constexpr uint8_t k_flag_succeeded = 0x02;
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+auto to_unix_ns(TimePoint time) -> int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+auto from_unix_ns(int64_t nanos) -> TimePoint {
+  return TimePoint(
+      std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+class Encoder {
+ public:
+  void u8(uint8_t value) { buf_.push_back(static_cast<char>(value)); }
+
+  void u32(uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      u8(static_cast<uint8_t>(value >> shift));
+    }
+  }
+
+  void u64(uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+      u8(static_cast<uint8_t>(value >> shift));
+    }
+  }
+
+  void i64(int64_t value) { u64(static_cast<uint64_t>(value)); }
+
+  void varint(uint64_t value) {
+    constexpr uint64_t k_low_bits = 0x7F;
+    constexpr uint8_t k_continuation = 0x80;
+    while (value > k_low_bits) {
+      u8(static_cast<uint8_t>(value & k_low_bits) | k_continuation);
+      value >>= 7;
+    }
+    u8(static_cast<uint8_t>(value));
+  }
+
+  void bytes(std::string_view value) {
+    varint(value.size());
+    buf_.append(value);
+  }
+
+  void bytes(const std::vector<uint8_t>& value) {
+    varint(value.size());
+    buf_.append(value.begin(), value.end());
+  }
+
+  void data(const Data& value) {
+    u8(static_cast<uint8_t>(value.get_type()));
+    std::visit([this](const auto& content) { this->content(content); }, value.get_raw_data());
+  }
+
+  void object(const DatastreamObject& value) {
+    varint(value.size());
+    for (const auto& [key, data] : value) {
+      bytes(key);
+      this->data(data);
+    }
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return buf_.size(); }
+  [[nodiscard]] auto buffer() const -> const std::string& { return buf_; }
+
+ private:
+  void content(int32_t value) { u32(static_cast<uint32_t>(value)); }
+  void content(int64_t value) { i64(value); }
+  void content(double value) { u64(std::bit_cast<uint64_t>(value)); }
+  void content(bool value) { u8(value ? 1 : 0); }
+  void content(const std::string& value) { bytes(value); }
+  void content(const std::vector<uint8_t>& value) { bytes(value); }
+  void content(const TimePoint& value) { i64(to_unix_ns(value)); }
+
+  template <typename T>
+  void content(const std::vector<T>& values) {
+    varint(values.size());
+    for (const auto& value : values) {
+      content(static_cast<const T&>(value));
+    }
+  }
+
+  std::string buf_;
+};
+
+class Decoder {
+ public:
+  explicit Decoder(std::span<const uint8_t> buf) : buf_(buf) {}
+
+  [[nodiscard]] auto failed() const -> bool { return failed_; }
+  [[nodiscard]] auto remaining() const -> size_t { return buf_.size() - pos_; }
+
+  auto u8() -> uint8_t {
+    if (remaining() < 1) {
+      failed_ = true;
+      return 0;
+    }
+    return buf_[pos_++];
+  }
+
+  auto u32() -> uint32_t {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+      value |= static_cast<uint32_t>(u8()) << shift;
+    }
+    return value;
+  }
+
+  auto u64() -> uint64_t {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 8) {
+      value |= static_cast<uint64_t>(u8()) << shift;
+    }
+    return value;
+  }
+
+  auto i64() -> int64_t { return static_cast<int64_t>(u64()); }
+
+  auto varint() -> uint64_t {
+    constexpr uint64_t k_low_bits = 0x7F;
+    constexpr uint8_t k_continuation = 0x80;
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64 && !failed_; shift += 7) {
+      const uint8_t byte = u8();
+      value |= (byte & k_low_bits) << shift;
+      if ((byte & k_continuation) == 0) {
+        return value;
+      }
+    }
+    failed_ = true;
+    return 0;
+  }
+
+  // Reads a count of elements each taking at least one byte
+  auto count() -> size_t {
+    const uint64_t value = varint();
+    if (value > remaining()) {
+      failed_ = true;
+      return 0;
+    }
+    return static_cast<size_t>(value);
+  }
+
+  // Splits the next bytes into a decoder of their own
+  auto split(size_t len) -> Decoder {
+    if (len > remaining()) {
+      failed_ = true;
+      return Decoder({});
+    }
+    Decoder sub(buf_.subspan(pos_, len));
+    pos_ += len;
+    return sub;
+  }
+
+  auto string() -> std::string {
+    const size_t len = count();
+    std::string value(reinterpret_cast<const char*>(buf_.data() + pos_), len);
+    pos_ += len;
+    return value;
+  }
+
+  auto blob() -> std::vector<uint8_t> {
+    const size_t len = count();
+    std::vector<uint8_t> value(buf_.begin() + static_cast<std::ptrdiff_t>(pos_),
+                               buf_.begin() + static_cast<std::ptrdiff_t>(pos_ + len));
+    pos_ += len;
+    return value;
+  }
+
+  auto data() -> std::optional<Data> {
+    switch (static_cast<Type>(u8())) {
+      case kInteger:
+        return Data(static_cast<int32_t>(u32()));
+      case kLongInteger:
+        return Data(i64());
+      case kDouble:
+        return Data(std::bit_cast<double>(u64()));
+      case kBoolean:
+        return Data(u8() != 0);
+      case kString:
+        return Data(string());
+      case kBinaryBlob:
+        return Data(blob());
+      case kDatetime:
+        return Data(from_unix_ns(i64()));
+      case kIntegerArray:
+        return Data(array([this] { return static_cast<int32_t>(u32()); }));
+      case kLongIntegerArray:
+        return Data(array([this] { return i64(); }));
+      case kDoubleArray:
+        return Data(array([this] { return std::bit_cast<double>(u64()); }));
+      case kBooleanArray:
+        return Data(array([this] { return u8() != 0; }));
+      case kStringArray:
+        return Data(array([this] { return string(); }));
+      case kBinaryBlobArray:
+        return Data(array([this] { return blob(); }));
+      case kDatetimeArray:
+        return Data(array([this] { return from_unix_ns(i64()); }));
+    }
+    failed_ = true;
+    return std::nullopt;
+  }
+
+  auto object() -> std::optional<DatastreamObject> {
+    const size_t len = count();
+    DatastreamObject value(len);
+    for (size_t i = 0; i < len && !failed_; i++) {
+      auto key = string();
+      auto data = this->data();
+      if (!data) {
+        return std::nullopt;
+      }
+      value.insert(std::move(key), std::move(data.value()));
+    }
+    return value;
+  }
+
+ private:
+  template <typename Element>
+  auto array(Element element) -> std::vector<decltype(element())> {
+    std::vector<decltype(element())> values;
+    const size_t len = count();
+    values.reserve(len);
+    for (size_t i = 0; i < len && !failed_; i++) {
+      values.push_back(element());
+    }
+    return values;
+  }
+
+  std::span<const uint8_t> buf_;
+  size_t pos_{0};
+  bool failed_{false};
+};
+
+// The running capture
+struct Recorder {
+  std::mutex mutex;
+  std::ofstream file;
+  std::chrono::steady_clock::time_point started;
+};
+
+auto recorder() -> Recorder& {
+  static Recorder instance;
+  return instance;
+}
+
+auto decode_send(Decoder& dec) -> std::optional<CapturedSend> {
+  const auto kind = static_cast<SendKind>(dec.u8());
+  const uint8_t flags = dec.u8();
+  CapturedSend send{.kind = kind,
+                    .interface_name = {},
+                    .path = {},
+                    .data = std::nullopt,
+                    .object = std::nullopt,
+                    .timestamp = std::nullopt,
+                    .offset = std::chrono::nanoseconds(dec.varint()),
+                    .duration = std::chrono::nanoseconds(dec.varint()),
+                    .succeeded = (flags & k_flag_succeeded) != 0};
+  if ((flags & k_flag_timestamp) != 0) {
+    send.timestamp = from_unix_ns(dec.i64());
+  }
+  send.interface_name = dec.string();
+  send.path = dec.string();
+
+  switch (kind) {
+    case SendKind::kIndividual:
+    case SendKind::kSetProperty:
+      send.data = dec.data();
+      if (!send.data) {
+        return std::nullopt;
+      }
+      break;
+    case SendKind::kObject:
+      send.object = dec.object();
+      if (!send.object) {
+        return std::nullopt;
+      }
+      break;
+    case SendKind::kUnsetProperty:
+      break;
+    default:
+      return std::nullopt;
+  }
+
+  if (dec.failed()) {
+    return std::nullopt;
+  }
+  return send;
+}
+
+auto replay_send(Device& device, const CapturedSend& send, const TimePoint* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  switch (send.kind) {
+    case SendKind::kIndividual:
+      return device.send_individual(send.interface_name, send.path, send.data.value(), timestamp);
+    case SendKind::kObject:
+      return device.send_object(send.interface_name, send.path, send.object.value(), timestamp);
+    case SendKind::kSetProperty:
+      return device.set_property(send.interface_name, send.path, send.data.value());
+    case SendKind::kUnsetProperty:
+      return device.unset_property(send.interface_name, send.path);
+  }
+  return astarte_tl::unexpected(InvalidInputError("unknown captured send kind"));
+}
+
+// Gets the latency below which the given fraction of the sorted latencies falls
+auto percentile(const std::vector<std::chrono::nanoseconds>& sorted, double fraction)
+    -> std::chrono::nanoseconds {
+  if (sorted.empty()) {
+    return std::chrono::nanoseconds(0);
+  }
+  auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+  return sorted.at(std::clamp<size_t>(rank, 1, sorted.size()) - 1);
+}
+
+}  // namespace
+
+void record(const SendCall& call, std::chrono::steady_clock::time_point start,
+            std::chrono::nanoseconds duration, bool succeeded) {
+  Encoder body;
+  body.u8(static_cast<uint8_t>(call.kind));
+  body.u8((call.timestamp != nullptr ? k_flag_timestamp : 0) |
+          (succeeded ? k_flag_succeeded : 0));
+
+  auto& rec = recorder();
+  const std::lock_guard<std::mutex> lock(rec.mutex);
+  // The capture could have been stopped after the call started
+  if (!rec.file.is_open() || start < rec.started) {
+    return;
+  }
+
+  body.varint(static_cast<uint64_t>((start - rec.started).count()));
+  body.varint(static_cast<uint64_t>(duration.count()));
+  if (call.timestamp != nullptr) {
+    body.i64(to_unix_ns(*call.timestamp));
+  }
+  body.bytes(call.interface_name);
+  body.bytes(call.path);
+  if (call.data != nullptr) {
+    body.data(*call.data);
+  }
+  if (call.object != nullptr) {
+    body.object(*call.object);
+  }
+
+  Encoder length;
+  length.u32(static_cast<uint32_t>(body.size()));
+  rec.file << length.buffer() << body.buffer();
+}
+
+auto start(const std::filesystem::path& file) -> astarte_tl::expected<void, Error> {
+  auto& rec = recorder();
+  const std::lock_guard<std::mutex> lock(rec.mutex);
+  if (rec.file.is_open()) {
+    return astarte_tl::unexpected(OperationRefusedError("a capture is already running"));
+  }
+
+  rec.file.open(file, std::ios::binary | std::ios::trunc);
+  if (!rec.file) {
+    rec.file = std::ofstream();
+    return astarte_tl::unexpected(InternalError(
+        astarte_fmt::format("could not create the capture file {}", file.string())));
+  }
+
+  Encoder header;
+  for (const char chr : k_magic) {
+    header.u8(static_cast<uint8_t>(chr));
+  }
+  header.u32(k_format_version);
+  header.i64(to_unix_ns(std::chrono::system_clock::now()));
+  rec.file << header.buffer();
+  rec.started = std::chrono::steady_clock::now();
+  active_flag.store(true, std::memory_order_relaxed);
+  return {};
+}
+
+auto stop() -> astarte_tl::expected<void, Error> {
+  auto& rec = recorder();
+  const std::lock_guard<std::mutex> lock(rec.mutex);
+  if (!rec.file.is_open()) {
+    return astarte_tl::unexpected(OperationRefusedError("no capture is running"));
+  }
+  active_flag.store(false, std::memory_order_relaxed);
+  rec.file.close();
+  const bool written = !rec.file.fail();
+  rec.file = std::ofstream();
+  if (!written) {
+    return astarte_tl::unexpected(InternalError("the capture file could not be written"));
+  }
+  return {};
+}
+
+auto is_active() -> bool { return active_flag.load(std::memory_order_relaxed); }
+
+auto read_file(const std::filesystem::path& file) -> astarte_tl::expected<Capture, Error> {
+  std::ifstream input(file, std::ios::binary);
+  if (!input) {
+    return astarte_tl::unexpected(InvalidInputError(
+        astarte_fmt::format("could not open the capture file {}", file.string())));
+  }
+  const std::vector<uint8_t> content((std::istreambuf_iterator<char>(input)),
+                                     std::istreambuf_iterator<char>());
+
+  Decoder dec(content);
+  for (const char chr : k_magic) {
+    if (dec.u8() != static_cast<uint8_t>(chr)) {
+      return astarte_tl::unexpected(
+          InvalidInputError(astarte_fmt::format("{} is not a capture file", file.string())));
+    }
+  }
+  const uint32_t version = dec.u32();
+  if (version != k_format_version) {
+    return astarte_tl::unexpected(
+        InvalidInputError(astarte_fmt::format("unsupported capture format version {}", version)));
+  }
+
+  Capture capture{.started = from_unix_ns(dec.i64()), .sends = {}};
+  while (!dec.failed() && dec.remaining() > 0) {
+    Decoder record_dec = dec.split(dec.u32());
+    if (dec.failed()) {
+      break;
+    }
+    auto send = decode_send(record_dec);
+    if (!send || record_dec.remaining() != 0) {
+      return astarte_tl::unexpected(InvalidInputError(astarte_fmt::format(
+          "malformed record {} in capture file {}", capture.sends.size(), file.string())));
+    }
+    capture.sends.push_back(std::move(send.value()));
+  }
+  if (dec.failed()) {
+    return astarte_tl::unexpected(InvalidInputError(
+        astarte_fmt::format("truncated capture file {}", file.string())));
+  }
+  return capture;
+}
+
+auto ReplayReport::throughput() const -> double {
+  if (elapsed.count() <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(sends) / std::chrono::duration<double>(elapsed).count();
+}
+
+auto replay(Device& device, const Capture& capture, const ReplayOptions& options)
+    -> ReplayReport {
+  ReplayReport report;
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(capture.sends.size());
+
+  const auto replay_start = std::chrono::steady_clock::now();
+  const auto timestamp_shift = std::chrono::system_clock::now() - capture.started;
+  for (const auto& send : capture.sends) {
+    if (options.speed > 0) {
+      const auto due = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double, std::nano>(static_cast<double>(send.offset.count()) /
+                                                   options.speed));
+      std::this_thread::sleep_until(replay_start + due);
+    }
+
+    std::optional<TimePoint> timestamp;
+    if (send.timestamp) {
+      timestamp = options.shift_timestamps
+                      ? send.timestamp.value() +
+                            std::chrono::duration_cast<TimePoint::duration>(timestamp_shift)
+                      : send.timestamp.value();
+    }
+
+    const auto call_start = std::chrono::steady_clock::now();
+    auto res = replay_send(device, send, timestamp ? &timestamp.value() : nullptr);
+    latencies.push_back(std::chrono::steady_clock::now() - call_start);
+    report.sends++;
+    if (!res) {
+      report.failures++;
+    }
+  }
+  report.elapsed = std::chrono::steady_clock::now() - replay_start;
+
+  std::ranges::sort(latencies);
+  report.latency_p50 = percentile(latencies, 0.50);
+  report.latency_p90 = percentile(latencies, 0.90);
+  report.latency_p99 = percentile(latencies, 0.99);
+  report.latency_max = latencies.empty() ? std::chrono::nanoseconds(0) : latencies.back();
+  return report;
+}
+
+void write_report(std::ostream& out, const ReplayReport& report) {
+  auto micros = [](std::chrono::nanoseconds value) {
+    return std::chrono::duration<double, std::micro>(value).count();
+  };
+  out << astarte_fmt::format("sends:       {} ({} failed)\n", report.sends, report.failures);
+  out << astarte_fmt::format("elapsed:     {:.3f} s\n",
+                             std::chrono::duration<double>(report.elapsed).count());
+  out << astarte_fmt::format("throughput:  {:.1f} sends/s\n", report.throughput());
+  out << astarte_fmt::format("latency p50: {:.1f} us\n", micros(report.latency_p50));
+  out << astarte_fmt::format("latency p90: {:.1f} us\n", micros(report.latency_p90));
+  out << astarte_fmt::format("latency p99: {:.1f} us\n", micros(report.latency_p99));
+  out << astarte_fmt::format("latency max: {:.1f} us\n", micros(report.latency_max));
+}
+
+}  // namespace astarte::device::capture
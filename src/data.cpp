@@ -4,10 +4,14 @@
 
 #include "astarte_device_sdk/data.hpp"
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <ctime>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -15,30 +19,23 @@
 
 namespace astarte::device {
 
+namespace {
+
+// Builds the Astarte types of the alternatives of a variant, in order
+template <typename Variant, size_t... Index>
+constexpr auto astarte_types(std::index_sequence<Index...> /*unused*/)
+    -> std::array<Type, sizeof...(Index)> {
+  return {k_astarte_type<std::variant_alternative_t<Index, Variant>>...};
+}
+
+}  // namespace
+
 auto Data::get_type() const -> Type {
-  struct Visitor {
-    auto operator()(const int32_t& /*unused*/) -> Type { return kInteger; }
-    auto operator()(const int64_t& /*unused*/) -> Type { return kLongInteger; }
-    auto operator()(const double& /*unused*/) -> Type { return kDouble; }
-    auto operator()(const bool& /*unused*/) -> Type { return kBoolean; }
-    auto operator()(const std::string& /*unused*/) -> Type { return kString; }
-    auto operator()(const std::vector<uint8_t>& /*unused*/) -> Type { return kBinaryBlob; }
-    auto operator()(const std::chrono::system_clock::time_point& /*unused*/) -> Type {
-      return kDatetime;
-    }
-    auto operator()(const std::vector<int32_t>& /*unused*/) -> Type { return kIntegerArray; }
-    auto operator()(const std::vector<int64_t>& /*unused*/) -> Type { return kLongIntegerArray; }
-    auto operator()(const std::vector<double>& /*unused*/) -> Type { return kDoubleArray; }
-    auto operator()(const std::vector<bool>& /*unused*/) -> Type { return kBooleanArray; }
-    auto operator()(const std::vector<std::string>& /*unused*/) -> Type { return kStringArray; }
-    auto operator()(const std::vector<std::vector<uint8_t>>& /*unused*/) -> Type {
-      return kBinaryBlobArray;
-    }
-    auto operator()(const std::vector<std::chrono::system_clock::time_point>& /*unused*/) -> Type {
-      return kDatetimeArray;
-    }
-  };
-  return std::visit(Visitor{}, data_);
+  // the index of the held alternative selects its type, without visiting the variant
+  using Variant = std::decay_t<decltype(data_)>;
+  static constexpr auto k_types =
+      astarte_types<Variant>(std::make_index_sequence<std::variant_size_v<Variant>>());
+  return k_types.at(data_.index());
 }
 
 auto Data::get_raw_data() const
@@ -63,6 +63,11 @@ MsgHubError::MsgHubError(std::string_view message, const Error& other)
     : ErrorBase(k_type_, message,
                 std::visit([](const auto& err) -> const ErrorBase& { return err; }, other)) {}
 
+OverloadError::OverloadError(std::string_view message) : ErrorBase(k_type_, message) {}
+OverloadError::OverloadError(std::string_view message, const Error& other)
+    : ErrorBase(k_type_, message,
+                std::visit([](const auto& err) -> const ErrorBase& { return err; }, other)) {}
+
 InvalidInterfaceTypeError::InvalidInterfaceTypeError(std::string_view message)
     : ErrorBase(k_type_, message) {}
 InvalidInterfaceTypeError::InvalidInterfaceTypeError(std::string_view message, const Error& other)
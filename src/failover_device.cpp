@@ -0,0 +1,166 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/failover_device.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(ASTARTE_USE_TL_EXPECTED)
+#include "tl/expected.hpp"
+#else
+#include <expected>
+#endif
+
+#include "astarte_device_sdk/capture.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+#include "capture_send.hpp"
+#include "failover_device_impl.hpp"
+
+namespace astarte::device {
+
+FailoverDevice::FailoverDevice(std::shared_ptr<Device> primary, std::shared_ptr<Device> fallback,
+                               FailoverOptions options)
+    : astarte_device_impl_{std::make_shared<FailoverDeviceImpl>(
+          std::move(primary), std::move(fallback), std::move(options))} {}
+
+FailoverDevice::~FailoverDevice() = default;
+
+auto FailoverDevice::add_interface_from_file(const std::filesystem::path& json_file)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->add_interface_from_file(json_file);
+}
+
+auto FailoverDevice::add_interface_from_str(std::string_view json)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->add_interface_from_str(json);
+}
+
+auto FailoverDevice::remove_interface(const std::string& interface_name)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->remove_interface(interface_name);
+}
+
+auto FailoverDevice::connect() -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->connect();
+}
+
+auto FailoverDevice::is_connected() const -> bool { return astarte_device_impl_->is_connected(); }
+
+auto FailoverDevice::disconnect() -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->disconnect();
+}
+
+// The sends are not captured here, the wrapped devices record the ones they perform
+auto FailoverDevice::send_individual(std::string_view interface_name, std::string_view path,
+                                     const Data& data,
+                                     const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->send(capture::SendCall{.kind = capture::SendKind::kIndividual,
+                                                      .interface_name = interface_name,
+                                                      .path = path,
+                                                      .data = &data,
+                                                      .object = nullptr,
+                                                      .timestamp = timestamp});
+}
+
+auto FailoverDevice::send_object(std::string_view interface_name, std::string_view path,
+                                 const DatastreamObject& object,
+                                 const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->send(capture::SendCall{.kind = capture::SendKind::kObject,
+                                                      .interface_name = interface_name,
+                                                      .path = path,
+                                                      .data = nullptr,
+                                                      .object = &object,
+                                                      .timestamp = timestamp});
+}
+
+auto FailoverDevice::set_property(std::string_view interface_name, std::string_view path,
+                                  const Data& data) -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->send(capture::SendCall{.kind = capture::SendKind::kSetProperty,
+                                                      .interface_name = interface_name,
+                                                      .path = path,
+                                                      .data = &data,
+                                                      .object = nullptr,
+                                                      .timestamp = nullptr});
+}
+
+auto FailoverDevice::unset_property(std::string_view interface_name, std::string_view path)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->send(capture::SendCall{.kind = capture::SendKind::kUnsetProperty,
+                                                      .interface_name = interface_name,
+                                                      .path = path,
+                                                      .data = nullptr,
+                                                      .object = nullptr,
+                                                      .timestamp = nullptr});
+}
+
+auto FailoverDevice::poll_incoming(const std::chrono::milliseconds& timeout)
+    -> std::optional<Message> {
+  return astarte_device_impl_->poll_incoming(timeout);
+}
+
+auto FailoverDevice::poll_incoming_shared(const std::chrono::milliseconds& timeout)
+    -> std::optional<SharedMessage> {
+  return astarte_device_impl_->poll_incoming_shared(timeout);
+}
+
+auto FailoverDevice::get_all_properties(const std::optional<Ownership>& ownership)
+    -> astarte_tl::expected<std::list<StoredProperty>, Error> {
+  return astarte_device_impl_->device_in_use().get_all_properties(ownership);
+}
+
+auto FailoverDevice::get_properties(std::string_view interface_name)
+    -> astarte_tl::expected<std::list<StoredProperty>, Error> {
+  return astarte_device_impl_->device_in_use().get_properties(interface_name);
+}
+
+auto FailoverDevice::get_all_properties_vector(const std::optional<Ownership>& ownership)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  return astarte_device_impl_->device_in_use().get_all_properties_vector(ownership);
+}
+
+auto FailoverDevice::get_properties_vector(std::string_view interface_name)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  return astarte_device_impl_->device_in_use().get_properties_vector(interface_name);
+}
+
+auto FailoverDevice::visit_all_properties(const std::optional<Ownership>& ownership,
+                                          const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->device_in_use().visit_all_properties(ownership, visitor);
+}
+
+auto FailoverDevice::visit_properties(std::string_view interface_name,
+                                      const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->device_in_use().visit_properties(interface_name, visitor);
+}
+
+auto FailoverDevice::get_property(std::string_view interface_name, std::string_view path)
+    -> astarte_tl::expected<PropertyIndividual, Error> {
+  return astarte_device_impl_->device_in_use().get_property(interface_name, path);
+}
+
+auto FailoverDevice::route() const -> FailoverRoute { return astarte_device_impl_->route(); }
+
+auto FailoverDevice::buffered() const -> size_t { return astarte_device_impl_->buffered(); }
+
+}  // namespace astarte::device
@@ -0,0 +1,394 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "failover_device_impl.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(ASTARTE_USE_TL_EXPECTED)
+#include "tl/expected.hpp"
+#else
+#include <expected>
+#endif
+
+#include "astarte_device_sdk/capture.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/failover_device.hpp"
+#include "astarte_device_sdk/flight_recorder.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+#include "capture_send.hpp"
+#include "flight_recorder_event.hpp"
+#include "thread_setup.hpp"
+
+namespace astarte::device {
+
+namespace {
+
+// Performs a send call on a device
+auto dispatch(Device& device, const capture::SendCall& call) -> astarte_tl::expected<void, Error> {
+  switch (call.kind) {
+    case capture::SendKind::kIndividual:
+      return device.send_individual(call.interface_name, call.path, *call.data, call.timestamp);
+    case capture::SendKind::kObject:
+      return device.send_object(call.interface_name, call.path, *call.object, call.timestamp);
+    case capture::SendKind::kSetProperty:
+      return device.set_property(call.interface_name, call.path, *call.data);
+    case capture::SendKind::kUnsetProperty:
+      return device.unset_property(call.interface_name, call.path);
+  }
+  return astarte_tl::unexpected(InvalidInputError("unknown send kind"));
+}
+
+// Returns the first error of the two results, if any
+auto first_error(astarte_tl::expected<void, Error> first, astarte_tl::expected<void, Error> second)
+    -> astarte_tl::expected<void, Error> {
+  return first ? second : first;
+}
+
+}  // namespace
+
+FailoverDevice::FailoverDeviceImpl::FailoverDeviceImpl(std::shared_ptr<Device> primary,
+                                                       std::shared_ptr<Device> fallback,
+                                                       FailoverOptions options)
+    : primary_(std::move(primary)), fallback_(std::move(fallback)), options_(std::move(options)) {}
+
+FailoverDevice::FailoverDeviceImpl::~FailoverDeviceImpl() {
+  const std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  monitor_thread_.reset();
+}
+
+auto FailoverDevice::FailoverDeviceImpl::add_interface_from_file(
+    const std::filesystem::path& json_file) -> astarte_tl::expected<void, Error> {
+  auto res = primary_->add_interface_from_file(json_file);
+  return first_error(std::move(res), fallback_->add_interface_from_file(json_file));
+}
+
+auto FailoverDevice::FailoverDeviceImpl::add_interface_from_str(std::string_view json)
+    -> astarte_tl::expected<void, Error> {
+  auto res = primary_->add_interface_from_str(json);
+  return first_error(std::move(res), fallback_->add_interface_from_str(json));
+}
+
+auto FailoverDevice::FailoverDeviceImpl::remove_interface(const std::string& interface_name)
+    -> astarte_tl::expected<void, Error> {
+  auto res = primary_->remove_interface(interface_name);
+  return first_error(std::move(res), fallback_->remove_interface(interface_name));
+}
+
+auto FailoverDevice::FailoverDeviceImpl::connect() -> astarte_tl::expected<void, Error> {
+  const std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  if (monitor_thread_) {
+    spdlog::warn("Connection process is already running.");
+    return astarte_tl::unexpected(
+        OperationRefusedError{"Connection process is already in progress"});
+  }
+
+  auto res = primary_->connect();
+  if (!res) {
+    spdlog::warn("The primary device failed to connect: {}", res.error());
+  }
+
+  primary_down_since_.reset();
+  fallback_since_.reset();
+  last_route_ = FailoverRoute::kPrimary;
+  running_.store(true);
+  monitor_thread_.emplace([this](const std::stop_token& token) { monitor(token); });
+  return {};
+}
+
+auto FailoverDevice::FailoverDeviceImpl::is_connected() const -> bool {
+  return running_.load() && connected_device() != nullptr;
+}
+
+auto FailoverDevice::FailoverDeviceImpl::disconnect() -> astarte_tl::expected<void, Error> {
+  const std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  // the jthread requests the stop of the monitor and joins it
+  monitor_thread_.reset();
+  running_.store(false);
+
+  // flush the buffer while a device is still connected, the sends it could not deliver are dropped
+  drain();
+  size_t dropped = 0;
+  {
+    std::unique_lock<std::mutex> buffer_lock(buffer_mutex_);
+    drained_cv_.wait(buffer_lock, [this]() { return !draining_; });
+    dropped = buffer_.size();
+    buffer_.clear();
+    buffered_.fetch_sub(dropped, std::memory_order_release);
+  }
+  if (dropped != 0) {
+    spdlog::warn("Dropping {} buffered sends, no device is connected to deliver them.", dropped);
+    flight_recorder::record(flight_recorder::EventKind::kFailoverBufferDropped,
+                            static_cast<int64_t>(dropped));
+  }
+
+  auto res = primary_->disconnect();
+  if (fallback_active_.exchange(false)) {
+    res = first_error(std::move(res), fallback_->disconnect());
+  }
+  return res;
+}
+
+auto FailoverDevice::FailoverDeviceImpl::send(const capture::SendCall& call)
+    -> astarte_tl::expected<void, Error> {
+  if (!running_.load()) {
+    // the buffer is being flushed by a disconnection, the send must not overtake it
+    if (buffered_.load(std::memory_order_acquire) != 0) {
+      return astarte_tl::unexpected(OperationRefusedError(
+          "the failover device is disconnecting, its buffer is being flushed"));
+    }
+    return dispatch(*primary_, call);
+  }
+
+  // the buffered sends must be delivered before the new one
+  if (buffered_.load(std::memory_order_acquire) != 0) {
+    drain();
+  }
+  // while nothing is buffered the sends skip the buffer mutex
+  if (buffered_.load(std::memory_order_acquire) == 0) {
+    if (auto res = try_send(call)) {
+      return std::move(res.value());
+    }
+  }
+
+  const std::lock_guard<std::mutex> lock(buffer_mutex_);
+  // a disconnection has emptied the buffer for good, nothing would flush this send
+  if (!running_.load()) {
+    return astarte_tl::unexpected(
+        OperationRefusedError("the failover device has been disconnected"));
+  }
+  if (buffered_.load(std::memory_order_relaxed) >= options_.buffer_capacity) {
+    return astarte_tl::unexpected(OperationRefusedError(astarte_fmt::format(
+        "the failover buffer is full, {} sends are waiting for a connection",
+        buffered_.load(std::memory_order_relaxed))));
+  }
+  buffer_.push_back(BufferedSend{
+      .kind = call.kind,
+      .interface_name = std::string(call.interface_name),
+      .path = std::string(call.path),
+      .data = call.data != nullptr ? std::optional<Data>(*call.data) : std::nullopt,
+      .object =
+          call.object != nullptr ? std::optional<DatastreamObject>(*call.object) : std::nullopt,
+      .timestamp = call.timestamp != nullptr ? std::optional(*call.timestamp) : std::nullopt,
+  });
+  buffered_.fetch_add(1, std::memory_order_release);
+  return {};
+}
+
+auto FailoverDevice::FailoverDeviceImpl::poll_incoming(const std::chrono::milliseconds& timeout)
+    -> std::optional<Message> {
+  Device& in_use = device_in_use();
+  Device& idle = &in_use == primary_.get() ? *fallback_ : *primary_;
+  if (auto msg = idle.poll_incoming(std::chrono::milliseconds(0))) {
+    return msg;
+  }
+  return in_use.poll_incoming(timeout);
+}
+
+auto FailoverDevice::FailoverDeviceImpl::poll_incoming_shared(
+    const std::chrono::milliseconds& timeout) -> std::optional<SharedMessage> {
+  Device& in_use = device_in_use();
+  Device& idle = &in_use == primary_.get() ? *fallback_ : *primary_;
+  if (auto msg = idle.poll_incoming_shared(std::chrono::milliseconds(0))) {
+    return msg;
+  }
+  return in_use.poll_incoming_shared(timeout);
+}
+
+auto FailoverDevice::FailoverDeviceImpl::device_in_use() const -> Device& {
+  return route() == FailoverRoute::kFallback ? *fallback_ : *primary_;
+}
+
+auto FailoverDevice::FailoverDeviceImpl::route() const -> FailoverRoute {
+  if (!running_.load()) {
+    return FailoverRoute::kPrimary;
+  }
+  Device* device = connected_device();
+  if (device == nullptr) {
+    return FailoverRoute::kBuffering;
+  }
+  return device == primary_.get() ? FailoverRoute::kPrimary : FailoverRoute::kFallback;
+}
+
+auto FailoverDevice::FailoverDeviceImpl::buffered() const -> size_t {
+  return buffered_.load(std::memory_order_acquire);
+}
+
+auto FailoverDevice::FailoverDeviceImpl::connected_device() const -> Device* {
+  // the route only goes back to the primary device once the fallback one has been disconnected
+  if (fallback_active_.load()) {
+    return fallback_->is_connected() ? fallback_.get() : nullptr;
+  }
+  return primary_->is_connected() ? primary_.get() : nullptr;
+}
+
+auto FailoverDevice::FailoverDeviceImpl::try_send(const capture::SendCall& call)
+    -> std::optional<astarte_tl::expected<void, Error>> {
+  Device* device = connected_device();
+  if (device == nullptr) {
+    return std::nullopt;
+  }
+  auto res = dispatch(*device, call);
+  // a device disconnected during the send did not refuse the data, which can be buffered
+  if (!res && !device->is_connected()) {
+    return std::nullopt;
+  }
+  return res;
+}
+
+void FailoverDevice::FailoverDeviceImpl::drain() {
+  std::deque<BufferedSend> pending;
+  {
+    const std::lock_guard<std::mutex> lock(buffer_mutex_);
+    if (draining_ || buffer_.empty()) {
+      return;
+    }
+    draining_ = true;
+    pending.swap(buffer_);
+  }
+
+  // the calls are sent without holding the mutex, as a device may block on each of them
+  while (!pending.empty()) {
+    Device* device = connected_device();
+    if (device == nullptr) {
+      break;
+    }
+    const BufferedSend& next = pending.front();
+    const capture::SendCall call{.kind = next.kind,
+                                 .interface_name = next.interface_name,
+                                 .path = next.path,
+                                 .data = next.data ? &next.data.value() : nullptr,
+                                 .object = next.object ? &next.object.value() : nullptr,
+                                 .timestamp = next.timestamp ? &next.timestamp.value() : nullptr};
+    auto res = dispatch(*device, call);
+    if (!res) {
+      if (!device->is_connected()) {
+        break;
+      }
+      spdlog::error("Dropping a buffered send on {}{}: {}", next.interface_name, next.path,
+                    res.error());
+    }
+    pending.pop_front();
+    buffered_.fetch_sub(1, std::memory_order_release);
+  }
+
+  const std::lock_guard<std::mutex> lock(buffer_mutex_);
+  // the undelivered calls precede the ones buffered while draining
+  buffer_.insert(buffer_.begin(), std::make_move_iterator(pending.begin()),
+                 std::make_move_iterator(pending.end()));
+  draining_ = false;
+  drained_cv_.notify_all();
+}
+
+void FailoverDevice::FailoverDeviceImpl::monitor(const std::stop_token& token) {
+  setup_thread(ThreadRole::kFailoverMonitor, options_.thread_hook);
+  // wake up the monitor as soon as a stop is requested
+  const std::stop_callback wake_up(token, [this]() {
+    const std::lock_guard<std::mutex> lock(monitor_mutex_);
+    monitor_cv_.notify_all();
+  });
+  std::unique_lock<std::mutex> lock(monitor_mutex_);
+  while (!token.stop_requested()) {
+    lock.unlock();
+    check_devices();
+    lock.lock();
+    monitor_cv_.wait_for(lock, options_.check_interval,
+                         [&token]() { return token.stop_requested(); });
+  }
+}
+
+void FailoverDevice::FailoverDeviceImpl::check_devices() {
+  const auto now = std::chrono::steady_clock::now();
+  if (fallback_active_.load()) {
+    // the primary device is stopped while the fallback one is in use, it can only be tried again
+    if (now - fallback_since_.value() >= options_.failback_delay) {
+      fail_back(now);
+    }
+  } else if (primary_->is_connected()) {
+    primary_down_since_.reset();
+  } else {
+    if (!primary_down_since_) {
+      primary_down_since_ = now;
+    }
+    if (now - primary_down_since_.value() >= options_.failover_delay) {
+      fail_over(now);
+    }
+  }
+
+  drain();
+
+  const FailoverRoute current = route();
+  if (current != last_route_) {
+    spdlog::info("Failover route changed to {}.", current == FailoverRoute::kPrimary    ? "primary"
+                                                  : current == FailoverRoute::kFallback ? "fallback"
+                                                                                        : "buffer");
+    flight_recorder::record(flight_recorder::EventKind::kFailoverRoute,
+                            static_cast<int64_t>(current));
+    last_route_ = current;
+  }
+}
+
+void FailoverDevice::FailoverDeviceImpl::fail_over(std::chrono::steady_clock::time_point now) {
+  spdlog::warn("The primary device is disconnected, connecting the fallback device.");
+  // Both devices may use the same Astarte identity, the broker would let each connection take
+  // over the other one. The primary device must not reconnect while the fallback one is in use.
+  auto res = primary_->disconnect();
+  if (!res) {
+    spdlog::warn("The primary device failed to disconnect: {}", res.error());
+  }
+  res = fallback_->connect();
+  if (res) {
+    fallback_since_ = now;
+    fallback_active_.store(true);
+    return;
+  }
+  spdlog::error("The fallback device failed to connect: {}", res.error());
+  // stop the fallback device retrying on its own, then keep trying the primary device and retry
+  // the fallback one after another failover delay
+  res = fallback_->disconnect();
+  if (!res) {
+    spdlog::warn("The fallback device failed to disconnect: {}", res.error());
+  }
+  primary_down_since_ = now;
+  res = primary_->connect();
+  if (!res) {
+    spdlog::warn("The primary device failed to connect: {}", res.error());
+  }
+}
+
+void FailoverDevice::FailoverDeviceImpl::fail_back(std::chrono::steady_clock::time_point now) {
+  spdlog::info("Disconnecting the fallback device to try the primary device again.");
+  // the sends are buffered until the primary device connects
+  fallback_active_.store(false);
+  auto res = fallback_->disconnect();
+  if (!res) {
+    spdlog::warn("The fallback device failed to disconnect: {}", res.error());
+  }
+  // the primary device has a failover delay to connect before the fallback one is used again
+  primary_down_since_ = now;
+  res = primary_->connect();
+  if (!res) {
+    spdlog::warn("The primary device failed to connect: {}", res.error());
+  }
+}
+
+}  // namespace astarte::device
@@ -0,0 +1,304 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/flight_recorder.hpp"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+
+#include <csignal>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "flight_recorder_event.hpp"
+
+namespace astarte::device::flight_recorder {
+
+namespace {
+
+constexpr std::array<char, 8> k_magic = {'A', 'S', 'T', 'F', 'L', 'R', 'E', 'C'};
+constexpr uint32_t k_format_version = 1;
+
+// Layout of the binary dump, the structs contain no implicit padding
+struct DumpHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t count;
+};
+struct DumpRecord {
+  int64_t timestamp_ns;
+  int64_t value;
+  uint32_t kind;
+  uint32_t reserved;
+};
+static_assert(sizeof(DumpHeader) == 16);
+static_assert(sizeof(DumpRecord) == 24);
+
+// Records written to the file descriptor with a single call while dumping
+constexpr size_t k_dump_batch = 32;
+
+// Events shared by all the threads. Writers reserve a slot by incrementing the head, each slot is
+// guarded by a sequence number so that readers can detect slots being overwritten.
+struct Recorder {
+  struct Slot {
+    // Odd while the slot is being written, 2 * (index + 1) once the event at index is complete
+    std::atomic<uint64_t> seq{0};
+    std::atomic<int64_t> timestamp_ns{0};
+    std::atomic<int64_t> value{0};
+    std::atomic<uint32_t> kind{0};
+  };
+
+  // Number of events ever recorded
+  std::atomic<uint64_t> head{0};
+  // Events before this index are discarded
+  std::atomic<uint64_t> tail{0};
+  std::array<Slot, k_capacity> slots;
+};
+
+// Constant initialized, so events can be recorded during static initialization and destruction
+constinit Recorder recorder;
+
+// File descriptor the crash handler writes the dump to
+std::atomic<int> crash_fd{-1};
+
+// Reads the event at index, returns false if the slot does not hold it anymore
+auto read_slot(uint64_t index, DumpRecord& out) -> bool {
+  const auto& slot = recorder.slots.at(index % k_capacity);
+  const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+  out.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+  out.value = slot.value.load(std::memory_order_relaxed);
+  out.kind = slot.kind.load(std::memory_order_relaxed);
+  out.reserved = 0;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return seq == 2 * (index + 1) && slot.seq.load(std::memory_order_relaxed) == seq;
+}
+
+// Range of the indexes of the readable events
+auto readable_range() -> std::pair<uint64_t, uint64_t> {
+  const uint64_t head = recorder.head.load(std::memory_order_acquire);
+  const uint64_t oldest = head > k_capacity ? head - k_capacity : 0;
+  return {std::max(oldest, recorder.tail.load(std::memory_order_acquire)), head};
+}
+
+auto write_all(int fd, const void* data, size_t size) -> bool {
+  const auto* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+#if defined(_WIN32)
+    const auto written = _write(fd, bytes, static_cast<unsigned int>(size));
+#else
+    const auto written = ::write(fd, bytes, size);
+#endif
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+#if !defined(_WIN32)
+constexpr std::array<int, 5> k_crash_signals = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+void crash_handler(int signal) {
+  const int saved_errno = errno;
+  const int fd = crash_fd.load(std::memory_order_relaxed);
+  if (fd >= 0) {
+    (void)write_binary(fd);
+  }
+  errno = saved_errno;
+  // The handler has been reset to the default one, which runs once this handler returns
+  (void)raise(signal);
+}
+#endif
+
+}  // namespace
+
+auto event_kind_name(EventKind kind) -> std::string_view {
+  switch (kind) {
+    case EventKind::kConnectAttempt:
+      return "connect_attempt";
+    case EventKind::kConnected:
+      return "connected";
+    case EventKind::kConnectFailed:
+      return "connect_failed";
+    case EventKind::kConnectionLost:
+      return "connection_lost";
+    case EventKind::kSessionSetupFailed:
+      return "session_setup_failed";
+    case EventKind::kDisconnected:
+      return "disconnected";
+    case EventKind::kBackoffDelay:
+      return "backoff_delay";
+    case EventKind::kPublishSucceeded:
+      return "publish_succeeded";
+    case EventKind::kPublishFailed:
+      return "publish_failed";
+    case EventKind::kStreamError:
+      return "stream_error";
+    case EventKind::kReceiveQueueDepth:
+      return "receive_queue_depth";
+    case EventKind::kDuplicateDiscarded:
+      return "duplicate_discarded";
+    case EventKind::kFailoverRoute:
+      return "failover_route";
+    case EventKind::kSendShed:
+      return "send_shed";
+    case EventKind::kFailoverBufferDropped:
+      return "failover_buffer_dropped";
+  }
+  return "unknown";
+}
+
+void record(EventKind kind, int64_t value) {
+  const int64_t timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count();
+  const uint64_t index = recorder.head.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = recorder.slots.at(index % k_capacity);
+  slot.seq.store((2 * index) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.timestamp_ns.store(timestamp_ns, std::memory_order_relaxed);
+  slot.value.store(value, std::memory_order_relaxed);
+  slot.kind.store(static_cast<uint32_t>(kind), std::memory_order_relaxed);
+  slot.seq.store(2 * (index + 1), std::memory_order_release);
+}
+
+auto snapshot() -> std::vector<Event> {
+  const auto [first, head] = readable_range();
+  std::vector<Event> events;
+  events.reserve(head - first);
+  for (uint64_t index = first; index < head; index++) {
+    DumpRecord rec{};
+    if (read_slot(index, rec)) {
+      events.push_back(Event{.timestamp_ns = rec.timestamp_ns,
+                             .kind = static_cast<EventKind>(rec.kind),
+                             .value = rec.value});
+    }
+  }
+  return events;
+}
+
+void clear() {
+  recorder.tail.store(recorder.head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+void write_text(std::ostream& out) {
+  constexpr int64_t k_ns_per_s = 1000000000;
+  for (const auto& event : snapshot()) {
+    out << astarte_fmt::format("{}.{:09} {} {}\n", event.timestamp_ns / k_ns_per_s,
+                               event.timestamp_ns % k_ns_per_s, event_kind_name(event.kind),
+                               event.value);
+  }
+}
+
+auto write_binary(int fd) -> bool {
+  const auto [first, head] = readable_range();
+  const DumpHeader header{
+      .magic = k_magic, .version = k_format_version, .count = static_cast<uint32_t>(head - first)};
+  if (!write_all(fd, &header, sizeof(header))) {
+    return false;
+  }
+
+  // The number of records is fixed by the header, events overwritten while dumping are written as
+  // records of kind zero
+  std::array<DumpRecord, k_dump_batch> batch{};
+  size_t batched = 0;
+  for (uint64_t index = first; index < head; index++) {
+    auto& rec = batch.at(batched);
+    if (!read_slot(index, rec)) {
+      rec = DumpRecord{};
+    }
+    batched++;
+    if (batched == batch.size() || index + 1 == head) {
+      if (!write_all(fd, batch.data(), batched * sizeof(DumpRecord))) {
+        return false;
+      }
+      batched = 0;
+    }
+  }
+  return true;
+}
+
+auto parse_binary(std::span<const uint8_t> dump)
+    -> astarte_tl::expected<std::vector<Event>, Error> {
+  DumpHeader header{};
+  if (dump.size() < sizeof(header)) {
+    return astarte_tl::unexpected(InvalidInputError("flight recorder dump is truncated"));
+  }
+  std::memcpy(&header, dump.data(), sizeof(header));
+  if (header.magic != k_magic) {
+    return astarte_tl::unexpected(InvalidInputError("not a flight recorder dump"));
+  }
+  if (header.version != k_format_version) {
+    return astarte_tl::unexpected(InvalidInputError(
+        astarte_fmt::format("unsupported flight recorder dump version {}", header.version)));
+  }
+  if (dump.size() != sizeof(header) + (static_cast<size_t>(header.count) * sizeof(DumpRecord))) {
+    return astarte_tl::unexpected(InvalidInputError(astarte_fmt::format(
+        "flight recorder dump of {} bytes does not contain {} events", dump.size(), header.count)));
+  }
+
+  std::vector<Event> events;
+  events.reserve(header.count);
+  for (size_t offset = sizeof(header); offset < dump.size(); offset += sizeof(DumpRecord)) {
+    DumpRecord rec{};
+    std::memcpy(&rec, dump.subspan(offset).data(), sizeof(rec));
+    if (rec.kind == 0) {
+      continue;
+    }
+    events.push_back(Event{.timestamp_ns = rec.timestamp_ns,
+                           .kind = static_cast<EventKind>(rec.kind),
+                           .value = rec.value});
+  }
+  return events;
+}
+
+auto install_crash_handler(int fd) -> astarte_tl::expected<void, Error> {
+#if defined(_WIN32)
+  (void)fd;
+  return astarte_tl::unexpected(
+      OperationRefusedError("the flight recorder crash handler requires POSIX signals"));
+#else
+  if (fd < 0) {
+    return astarte_tl::unexpected(
+        InvalidInputError(astarte_fmt::format("invalid file descriptor {}", fd)));
+  }
+  crash_fd.store(fd, std::memory_order_relaxed);
+
+  struct sigaction action{};
+  action.sa_handler = crash_handler;
+  action.sa_flags = SA_RESETHAND;
+  sigemptyset(&action.sa_mask);
+  for (const int signal : k_crash_signals) {
+    if (sigaction(signal, &action, nullptr) != 0) {
+      return astarte_tl::unexpected(InternalError(astarte_fmt::format(
+          "failed to install the handler of signal {}: {}", signal, std::strerror(errno))));
+    }
+  }
+  return {};
+#endif
+}
+
+}  // namespace astarte::device::flight_recorder
@@ -11,6 +11,8 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #if defined(ASTARTE_USE_TL_EXPECTED)
 #include "tl/expected.hpp"
@@ -18,6 +20,7 @@
 #include <expected>
 #endif
 
+#include "astarte_device_sdk/capture.hpp"
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/errors.hpp"
 #include "astarte_device_sdk/msg.hpp"
@@ -25,6 +28,8 @@
 #include "astarte_device_sdk/ownership.hpp"
 #include "astarte_device_sdk/property.hpp"
 #include "astarte_device_sdk/stored_property.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+#include "capture_send.hpp"
 #include "grpc/device_grpc_impl.hpp"
 
 namespace astarte::device::grpc {
@@ -49,6 +54,10 @@ auto DeviceGrpc::remove_interface(const std::string& interface_name)
   return astarte_device_impl_->remove_interface(interface_name);
 }
 
+auto DeviceGrpc::set_thread_hook(ThreadHook hook) -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->set_thread_hook(std::move(hook));
+}
+
 auto DeviceGrpc::connect() -> astarte_tl::expected<void, Error> {
   return astarte_device_impl_->connect();
 }
@@ -63,30 +72,65 @@ auto DeviceGrpc::send_individual(std::string_view interface_name, std::string_vi
                                  const Data& data,
                                  const std::chrono::system_clock::time_point* timestamp)
     -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->send_individual(interface_name, path, data, timestamp);
+  const capture::SendCall call{.kind = capture::SendKind::kIndividual,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = &data,
+                               .object = nullptr,
+                               .timestamp = timestamp};
+  return capture::captured(call, [&]() {
+    return astarte_device_impl_->send_individual(interface_name, path, data, timestamp);
+  });
 }
 
 auto DeviceGrpc::send_object(std::string_view interface_name, std::string_view path,
                              const DatastreamObject& object,
                              const std::chrono::system_clock::time_point* timestamp)
     -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->send_object(interface_name, path, object, timestamp);
+  const capture::SendCall call{.kind = capture::SendKind::kObject,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = nullptr,
+                               .object = &object,
+                               .timestamp = timestamp};
+  return capture::captured(call, [&]() {
+    return astarte_device_impl_->send_object(interface_name, path, object, timestamp);
+  });
 }
 
 auto DeviceGrpc::set_property(std::string_view interface_name, std::string_view path,
                               const Data& data) -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->set_property(interface_name, path, data);
+  const capture::SendCall call{.kind = capture::SendKind::kSetProperty,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = &data,
+                               .object = nullptr,
+                               .timestamp = nullptr};
+  return capture::captured(
+      call, [&]() { return astarte_device_impl_->set_property(interface_name, path, data); });
 }
 
 auto DeviceGrpc::unset_property(std::string_view interface_name, std::string_view path)
     -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->unset_property(interface_name, path);
+  const capture::SendCall call{.kind = capture::SendKind::kUnsetProperty,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = nullptr,
+                               .object = nullptr,
+                               .timestamp = nullptr};
+  return capture::captured(
+      call, [&]() { return astarte_device_impl_->unset_property(interface_name, path); });
 }
 
 auto DeviceGrpc::poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message> {
   return astarte_device_impl_->poll_incoming(timeout);
 }
 
+auto DeviceGrpc::poll_incoming_shared(const std::chrono::milliseconds& timeout)
+    -> std::optional<SharedMessage> {
+  return astarte_device_impl_->poll_incoming_shared(timeout);
+}
+
 auto DeviceGrpc::get_all_properties(const std::optional<Ownership>& ownership)
     -> astarte_tl::expected<std::list<StoredProperty>, Error> {
   return astarte_device_impl_->get_all_properties(ownership);
@@ -97,6 +141,28 @@ auto DeviceGrpc::get_properties(std::string_view interface_name)
   return astarte_device_impl_->get_properties(interface_name);
 }
 
+auto DeviceGrpc::get_all_properties_vector(const std::optional<Ownership>& ownership)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  return astarte_device_impl_->get_all_properties_vector(ownership);
+}
+
+auto DeviceGrpc::get_properties_vector(std::string_view interface_name)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  return astarte_device_impl_->get_properties_vector(interface_name);
+}
+
+auto DeviceGrpc::visit_all_properties(const std::optional<Ownership>& ownership,
+                                      const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->visit_all_properties(ownership, visitor);
+}
+
+auto DeviceGrpc::visit_properties(std::string_view interface_name,
+                                  const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  return astarte_device_impl_->visit_properties(interface_name, visitor);
+}
+
 auto DeviceGrpc::get_property(std::string_view interface_name, std::string_view path)
     -> astarte_tl::expected<PropertyIndividual, Error> {
   return astarte_device_impl_->get_property(interface_name, path);
@@ -29,6 +29,7 @@
 #include <iterator>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <regex>
 #include <stop_token>
@@ -46,6 +47,7 @@
 
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/flight_recorder.hpp"
 #include "astarte_device_sdk/formatter.hpp"
 #include "astarte_device_sdk/grpc/device_grpc.hpp"
 #include "astarte_device_sdk/msg.hpp"
@@ -53,10 +55,14 @@
 #include "astarte_device_sdk/ownership.hpp"
 #include "astarte_device_sdk/property.hpp"
 #include "astarte_device_sdk/stored_property.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
 #include "exponential_backoff.hpp"
+#include "flight_recorder_event.hpp"
 #include "grpc/grpc_converter.hpp"
 #include "grpc/grpc_interceptors.hpp"
 #include "shared_queue.hpp"
+#include "thread_setup.hpp"
+#include "tracing_span.hpp"
 
 namespace astarte::device::grpc {
 
@@ -85,6 +91,20 @@ using gRPCPropertyIdentifier = astarteplatform::msghub::PropertyIdentifier;
 using gRPCInterfacesJson = astarteplatform::msghub::InterfacesJson;
 using gRPCInterfacesName = astarteplatform::msghub::InterfacesName;
 
+namespace {
+
+// Records the outcome of a Send RPC in the flight recorder
+void record_send_outcome(const Status& status) {
+  if (status.ok()) {
+    flight_recorder::record(flight_recorder::EventKind::kPublishSucceeded);
+  } else {
+    flight_recorder::record(flight_recorder::EventKind::kPublishFailed,
+                            static_cast<int64_t>(status.error_code()));
+  }
+}
+
+}  // namespace
+
 DeviceGrpc::DeviceGrpcImpl::DeviceGrpcImpl(std::string server_addr, std::string node_uuid)
     : server_addr_(std::move(server_addr)),
       node_uuid_(std::move(node_uuid)),
@@ -118,6 +138,7 @@ auto DeviceGrpc::DeviceGrpcImpl::add_interface_from_file(const std::filesystem::
 auto DeviceGrpc::DeviceGrpcImpl::add_interface_from_str(std::string_view json)
     -> astarte_tl::expected<void, Error> {
   spdlog::debug("Adding interface from string");
+  const std::lock_guard<std::mutex> lock(interfaces_mutex_);
 
   // If the device is connected, notify the message hub
   if (is_connected()) {
@@ -125,7 +146,7 @@ auto DeviceGrpc::DeviceGrpcImpl::add_interface_from_str(std::string_view json)
     grpc_interfaces_json.add_interfaces_json(json);
     ClientContext context;
     google::protobuf::Empty response;
-    const Status status = stub_->AddInterfaces(&context, grpc_interfaces_json, &response);
+    const Status status = stub()->AddInterfaces(&context, grpc_interfaces_json, &response);
     if (!status.ok()) {
       spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
       return astarte_tl::unexpected(
@@ -147,6 +168,7 @@ auto DeviceGrpc::DeviceGrpcImpl::remove_interface(const std::string& interface_n
       R"(\"interface_name\":\s*\")" + escaped_interface_name + R"(\")";
   const std::regex pattern(pattern_string);
 
+  const std::lock_guard<std::mutex> lock(interfaces_mutex_);
   for (auto i = interfaces_bins_.begin(); i != interfaces_bins_.end(); ++i) {
     const std::string& interface_json = *i;
     std::smatch match;
@@ -156,7 +178,7 @@ auto DeviceGrpc::DeviceGrpcImpl::remove_interface(const std::string& interface_n
         grpc_interface_names.add_names(interface_name);
         ClientContext context;
         google::protobuf::Empty response;
-        const Status status = stub_->RemoveInterfaces(&context, grpc_interface_names, &response);
+        const Status status = stub()->RemoveInterfaces(&context, grpc_interface_names, &response);
         if (!status.ok()) {
           spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
           return astarte_tl::unexpected(GrpcLibError{
@@ -170,8 +192,21 @@ auto DeviceGrpc::DeviceGrpcImpl::remove_interface(const std::string& interface_n
   return {};
 }
 
+auto DeviceGrpc::DeviceGrpcImpl::set_thread_hook(ThreadHook hook)
+    -> astarte_tl::expected<void, Error> {
+  const std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  if (connection_thread_) {
+    spdlog::warn("Thread hook set while the connection process is running.");
+    return astarte_tl::unexpected(
+        OperationRefusedError{"Connection process is already in progress"});
+  }
+  thread_hook_ = std::move(hook);
+  return {};
+}
+
 auto DeviceGrpc::DeviceGrpcImpl::connect() -> astarte_tl::expected<void, Error> {
   spdlog::info("Connection requested.");
+  const std::lock_guard<std::mutex> lock(lifecycle_mutex_);
   if (connection_thread_) {
     spdlog::warn("Connection process is already running.");
     return astarte_tl::unexpected(
@@ -184,6 +219,7 @@ auto DeviceGrpc::DeviceGrpcImpl::connect() -> astarte_tl::expected<void, Error>
   // start the connection loop, passing it the token from our source.
   connection_thread_.emplace(
       [this](const std::stop_token& token) {
+        setup_thread(ThreadRole::kGrpcConnection, thread_hook_);
         auto res = this->connection_loop(token);
         // TODO(sorru94): Evaluate the use of futures to communicate errors with the user
         if (!res) {
@@ -199,6 +235,7 @@ auto DeviceGrpc::DeviceGrpcImpl::is_connected() const -> bool { return connected
 
 auto DeviceGrpc::DeviceGrpcImpl::disconnect() -> astarte_tl::expected<void, Error> {
   spdlog::info("Disconnection requested.");
+  const std::lock_guard<std::mutex> lock(lifecycle_mutex_);
   astarte_tl::expected<void, Error> res = {};
 
   // request a stop to signal connection_loop and handle_events
@@ -207,7 +244,7 @@ auto DeviceGrpc::DeviceGrpcImpl::disconnect() -> astarte_tl::expected<void, Erro
   if (connected_.load() || grpc_stream_error_.load()) {
     ClientContext context;
     google::protobuf::Empty response;
-    const Status status = stub_->Detach(&context, google::protobuf::Empty(), &response);
+    const Status status = stub()->Detach(&context, google::protobuf::Empty(), &response);
     if (!status.ok()) {
       spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
       res = astarte_tl::unexpected(
@@ -215,6 +252,7 @@ auto DeviceGrpc::DeviceGrpcImpl::disconnect() -> astarte_tl::expected<void, Erro
     }
     grpc_stream_error_.store(false);
   }
+  flight_recorder::record(flight_recorder::EventKind::kDisconnected);
 
   // clear the thread object by invoking the destructor on the internal thread.
   // jthread's destructor will join
@@ -225,6 +263,7 @@ auto DeviceGrpc::DeviceGrpcImpl::disconnect() -> astarte_tl::expected<void, Erro
 auto DeviceGrpc::DeviceGrpcImpl::send_individual(
     std::string_view interface_name, std::string_view path, const Data& data,
     const std::chrono::system_clock::time_point* timestamp) -> astarte_tl::expected<void, Error> {
+  ASTARTE_TRACE_SPAN("grpc", "send_individual");
   spdlog::debug("Sending individual: {} {}", interface_name, path);
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
@@ -235,15 +274,20 @@ auto DeviceGrpc::DeviceGrpcImpl::send_individual(
   message.set_interface_name(interface_name);
   message.set_path(path);
 
+  tracing::ScopedSpan convert_span("grpc", "convert");
   GrpcConverterTo converter;
   std::unique_ptr<gRPCAstarteDatastreamIndividual> grpc_datastream_individual =
       converter(data, timestamp);
   message.set_allocated_datastream_individual(grpc_datastream_individual.release());
+  convert_span.end();
 
   ClientContext context;
   google::protobuf::Empty response;
   spdlog::trace("Sending data: {} {}", interface_name, path);
-  const Status status = stub_->Send(&context, message, &response);
+  tracing::ScopedSpan rpc_span("grpc", "rpc_send");
+  const Status status = stub()->Send(&context, message, &response);
+  rpc_span.end();
+  record_send_outcome(status);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
@@ -256,6 +300,7 @@ auto DeviceGrpc::DeviceGrpcImpl::send_object(std::string_view interface_name, st
                                              const DatastreamObject& object,
                                              const std::chrono::system_clock::time_point* timestamp)
     -> astarte_tl::expected<void, Error> {
+  ASTARTE_TRACE_SPAN("grpc", "send_object");
   spdlog::debug("Sending object: {} {}", interface_name, path);
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
@@ -266,15 +311,20 @@ auto DeviceGrpc::DeviceGrpcImpl::send_object(std::string_view interface_name, st
   message.set_interface_name(interface_name);
   message.set_path(path);
 
+  tracing::ScopedSpan convert_span("grpc", "convert");
   GrpcConverterTo converter;
   std::unique_ptr<gRPCAstarteDatastreamObject> grpc_datastream_object =
       converter(object, timestamp);
   message.set_allocated_datastream_object(grpc_datastream_object.release());
+  convert_span.end();
 
   ClientContext context;
   google::protobuf::Empty response;
   spdlog::trace("Sending data: {} {}", interface_name, path);
-  const Status status = stub_->Send(&context, message, &response);
+  tracing::ScopedSpan rpc_span("grpc", "rpc_send");
+  const Status status = stub()->Send(&context, message, &response);
+  rpc_span.end();
+  record_send_outcome(status);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
@@ -286,6 +336,7 @@ auto DeviceGrpc::DeviceGrpcImpl::send_object(std::string_view interface_name, st
 auto DeviceGrpc::DeviceGrpcImpl::set_property(std::string_view interface_name,
                                               std::string_view path, const Data& data)
     -> astarte_tl::expected<void, Error> {
+  ASTARTE_TRACE_SPAN("grpc", "set_property");
   spdlog::debug("Setting property: {} {}", interface_name, path);
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
@@ -297,14 +348,19 @@ auto DeviceGrpc::DeviceGrpcImpl::set_property(std::string_view interface_name,
   message.set_path(path);
 
   const std::optional<Data>& opt_data = data;
+  tracing::ScopedSpan convert_span("grpc", "convert");
   GrpcConverterTo converter;
   std::unique_ptr<gRPCAstartePropertyIndividual> grpc_property_individual = converter(opt_data);
   message.set_allocated_property_individual(grpc_property_individual.release());
+  convert_span.end();
 
   ClientContext context;
   google::protobuf::Empty response;
   spdlog::trace("Sending data: {} {}", interface_name, path);
-  const Status status = stub_->Send(&context, message, &response);
+  tracing::ScopedSpan rpc_span("grpc", "rpc_send");
+  const Status status = stub()->Send(&context, message, &response);
+  rpc_span.end();
+  record_send_outcome(status);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
@@ -316,6 +372,7 @@ auto DeviceGrpc::DeviceGrpcImpl::set_property(std::string_view interface_name,
 auto DeviceGrpc::DeviceGrpcImpl::unset_property(std::string_view interface_name,
                                                 std::string_view path)
     -> astarte_tl::expected<void, Error> {
+  ASTARTE_TRACE_SPAN("grpc", "unset_property");
   spdlog::debug("Unsetting property: {} {}", interface_name, path);
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
@@ -327,13 +384,18 @@ auto DeviceGrpc::DeviceGrpcImpl::unset_property(std::string_view interface_name,
   message.set_path(path);
 
   const std::optional<Data> opt_data = std::nullopt;
+  tracing::ScopedSpan convert_span("grpc", "convert");
   GrpcConverterTo converter;
   std::unique_ptr<gRPCAstartePropertyIndividual> grpc_property_individual = converter(opt_data);
   message.set_allocated_property_individual(grpc_property_individual.release());
+  convert_span.end();
 
   ClientContext context;
   google::protobuf::Empty response;
-  const Status status = stub_->Send(&context, message, &response);
+  tracing::ScopedSpan rpc_span("grpc", "rpc_send");
+  const Status status = stub()->Send(&context, message, &response);
+  rpc_span.end();
+  record_send_outcome(status);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
@@ -344,32 +406,78 @@ auto DeviceGrpc::DeviceGrpcImpl::unset_property(std::string_view interface_name,
 
 auto DeviceGrpc::DeviceGrpcImpl::poll_incoming(const std::chrono::milliseconds& timeout)
     -> std::optional<Message> {
+  auto message = rcv_queue_.pop(timeout);
+  if (!message) {
+    return std::nullopt;
+  }
+  return std::move(message.value()).into_message();
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::poll_incoming_shared(const std::chrono::milliseconds& timeout)
+    -> std::optional<SharedMessage> {
   return rcv_queue_.pop(timeout);
 }
 
 auto DeviceGrpc::DeviceGrpcImpl::get_all_properties(const std::optional<Ownership>& ownership)
     -> astarte_tl::expected<std::list<StoredProperty>, Error> {
-  if (ownership.has_value()) {
-    spdlog::debug("Getting all stored properties {} owned.", ownership.value());
-  } else {
-    spdlog::debug("Getting all stored properties for all owners.");
-  }
+  return fetch_all_properties(ownership).and_then(
+      [](const gRPCStoredProperties& response) { return GrpcConverterFrom{}(response); });
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::get_properties(std::string_view interface_name)
+    -> astarte_tl::expected<std::list<StoredProperty>, Error> {
+  return fetch_properties(interface_name).and_then([](const gRPCStoredProperties& response) {
+    return GrpcConverterFrom{}(response);
+  });
+}
 
+auto DeviceGrpc::DeviceGrpcImpl::get_all_properties_vector(
+    const std::optional<Ownership>& ownership)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  return fetch_all_properties(ownership).and_then(
+      [](const gRPCStoredProperties& response) { return GrpcConverterFrom{}.to_vector(response); });
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::get_properties_vector(std::string_view interface_name)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  return fetch_properties(interface_name).and_then([](const gRPCStoredProperties& response) {
+    return GrpcConverterFrom{}.to_vector(response);
+  });
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::visit_all_properties(const std::optional<Ownership>& ownership,
+                                                      const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  return fetch_all_properties(ownership).and_then([&](const gRPCStoredProperties& response) {
+    return GrpcConverterFrom{}.visit(response, visitor);
+  });
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::visit_properties(std::string_view interface_name,
+                                                  const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  return fetch_properties(interface_name).and_then([&](const gRPCStoredProperties& response) {
+    return GrpcConverterFrom{}.visit(response, visitor);
+  });
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::get_property(std::string_view interface_name,
+                                              std::string_view path)
+    -> astarte_tl::expected<PropertyIndividual, Error> {
+  spdlog::debug("Getting stored property for interface '{}' and path '{}'", interface_name, path);
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
     spdlog::warn(msg);
     return astarte_tl::unexpected(OperationRefusedError{msg});
   }
 
-  gRPCPropertyFilter filter;
-  if (ownership.has_value()) {
-    filter.set_ownership((ownership == Ownership::kDevice) ? gRPCOwnership::DEVICE
-                                                           : gRPCOwnership::SERVER);
-  }
+  gRPCPropertyIdentifier identifier;
+  identifier.set_interface_name(interface_name);
+  identifier.set_path(path);
 
   ClientContext context;
-  gRPCStoredProperties response;
-  const Status status = stub_->GetAllProperties(&context, filter, &response);
+  gRPCAstartePropertyIndividual response;
+  const Status status = stub()->GetProperty(&context, identifier, &response);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
@@ -379,73 +487,90 @@ auto DeviceGrpc::DeviceGrpcImpl::get_all_properties(const std::optional<Ownershi
   return GrpcConverterFrom{}(response);
 }
 
-auto DeviceGrpc::DeviceGrpcImpl::get_properties(std::string_view interface_name)
-    -> astarte_tl::expected<std::list<StoredProperty>, Error> {
-  spdlog::debug("Getting stored properties for interface: {}", interface_name);
+// Private helper to set up the gRPC channel and stub
+void DeviceGrpc::DeviceGrpcImpl::setup_grpc_channel() {
+  const ChannelArguments args;
+  std::vector<std::unique_ptr<ClientInterceptorFactoryInterface>> interceptor_creators;
+  interceptor_creators.push_back(std::make_unique<NodeIdInterceptorFactory>(node_uuid_));
+
+  const std::shared_ptr<Channel> channel = CreateCustomChannelWithInterceptors(
+      server_addr_, InsecureChannelCredentials(), args, std::move(interceptor_creators));
+
+  std::shared_ptr<gRPCMessageHub::Stub> stub = gRPCMessageHub::NewStub(channel);
+  const std::lock_guard<std::mutex> lock(stub_mutex_);
+  stub_.swap(stub);
+}
+
+// Private helper returning a snapshot of the current stub, safe to use while it is replaced
+auto DeviceGrpc::DeviceGrpcImpl::stub() const -> std::shared_ptr<gRPCMessageHub::Stub> {
+  const std::lock_guard<std::mutex> lock(stub_mutex_);
+  return stub_;
+}
+
+auto DeviceGrpc::DeviceGrpcImpl::fetch_all_properties(const std::optional<Ownership>& ownership)
+    -> astarte_tl::expected<gRPCStoredProperties, Error> {
+  if (ownership.has_value()) {
+    spdlog::debug("Getting all stored properties {} owned.", ownership.value());
+  } else {
+    spdlog::debug("Getting all stored properties for all owners.");
+  }
+
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
     spdlog::warn(msg);
     return astarte_tl::unexpected(OperationRefusedError{msg});
   }
 
-  gRPCInterfaceName grpc_interface_name;
-  grpc_interface_name.set_name(interface_name);
+  gRPCPropertyFilter filter;
+  if (ownership.has_value()) {
+    filter.set_ownership((ownership == Ownership::kDevice) ? gRPCOwnership::DEVICE
+                                                           : gRPCOwnership::SERVER);
+  }
 
   ClientContext context;
   gRPCStoredProperties response;
-  const Status status = stub_->GetProperties(&context, grpc_interface_name, &response);
+  const Status status = stub()->GetAllProperties(&context, filter, &response);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
         GrpcLibError(static_cast<std::uint64_t>(status.error_code()), status.error_message()));
   }
 
-  return GrpcConverterFrom{}(response);
+  return response;
 }
 
-auto DeviceGrpc::DeviceGrpcImpl::get_property(std::string_view interface_name,
-                                              std::string_view path)
-    -> astarte_tl::expected<PropertyIndividual, Error> {
-  spdlog::debug("Getting stored property for interface '{}' and path '{}'", interface_name, path);
+auto DeviceGrpc::DeviceGrpcImpl::fetch_properties(std::string_view interface_name)
+    -> astarte_tl::expected<gRPCStoredProperties, Error> {
+  spdlog::debug("Getting stored properties for interface: {}", interface_name);
   if (!connected_.load()) {
     const std::string_view msg("Device disconnected, operation aborted.");
     spdlog::warn(msg);
     return astarte_tl::unexpected(OperationRefusedError{msg});
   }
 
-  gRPCPropertyIdentifier identifier;
-  identifier.set_interface_name(interface_name);
-  identifier.set_path(path);
+  gRPCInterfaceName grpc_interface_name;
+  grpc_interface_name.set_name(interface_name);
 
   ClientContext context;
-  gRPCAstartePropertyIndividual response;
-  const Status status = stub_->GetProperty(&context, identifier, &response);
+  gRPCStoredProperties response;
+  const Status status = stub()->GetProperties(&context, grpc_interface_name, &response);
   if (!status.ok()) {
     spdlog::error("{}: {}", static_cast<int>(status.error_code()), status.error_message());
     return astarte_tl::unexpected(
         GrpcLibError(static_cast<std::uint64_t>(status.error_code()), status.error_message()));
   }
 
-  return GrpcConverterFrom{}(response);
-}
-
-// Private helper to set up the gRPC channel and stub
-void DeviceGrpc::DeviceGrpcImpl::setup_grpc_channel() {
-  const ChannelArguments args;
-  std::vector<std::unique_ptr<ClientInterceptorFactoryInterface>> interceptor_creators;
-  interceptor_creators.push_back(std::make_unique<NodeIdInterceptorFactory>(node_uuid_));
-
-  const std::shared_ptr<Channel> channel = CreateCustomChannelWithInterceptors(
-      server_addr_, InsecureChannelCredentials(), args, std::move(interceptor_creators));
-
-  stub_ = gRPCMessageHub::NewStub(channel);
+  return response;
 }
 
 auto DeviceGrpc::DeviceGrpcImpl::perform_attach() -> astarte_tl::expected<AttachResult, Error> {
   // Create the node message for the attach RPC.
   gRPCNode node;
-  for (const std::string& interface_json : interfaces_bins_) {
-    node.add_interfaces_json(interface_json);
+  {
+    const std::lock_guard<std::mutex> lock(interfaces_mutex_);
+    for (const std::string& interface_json : interfaces_bins_) {
+      node.add_interfaces_json(interface_json);
+    }
   }
 
   // Generate a new client context for the Attach method.
@@ -454,7 +579,7 @@ auto DeviceGrpc::DeviceGrpcImpl::perform_attach() -> astarte_tl::expected<Attach
   // least for that long.
   // See: https://grpc.github.io/grpc/cpp/classgrpc_1_1_client_context.html
   std::unique_ptr<ClientContext> context = std::make_unique<ClientContext>();
-  std::unique_ptr<ClientReader<gRPCMessageHubEvent>> reader = stub_->Attach(context.get(), node);
+  std::unique_ptr<ClientReader<gRPCMessageHubEvent>> reader = stub()->Attach(context.get(), node);
 
   reader->WaitForInitialMetadata();
   auto server_metadata = context->GetServerInitialMetadata();
@@ -477,6 +602,7 @@ auto DeviceGrpc::DeviceGrpcImpl::connection_attempt(const std::stop_token& token
     return astarte_tl::unexpected(OperationRefusedError{"The device is already connected"});
   }
   spdlog::debug("Attempting to connect to the message hub at {}", server_addr_);
+  flight_recorder::record(flight_recorder::EventKind::kConnectAttempt);
 
   // Create a new channel and initialize the gRPC stub
   setup_grpc_channel();
@@ -484,10 +610,12 @@ auto DeviceGrpc::DeviceGrpcImpl::connection_attempt(const std::stop_token& token
   return perform_attach()
       .transform_error([](Error error) {
         spdlog::error("Failed to attach to the message hub");
+        flight_recorder::record(flight_recorder::EventKind::kConnectFailed);
         return error;
       })
       .and_then([&](auto&& attach_res) {
         connected_.store(true);
+        flight_recorder::record(flight_recorder::EventKind::kConnected);
         spdlog::info("Node connected");
         return handle_events(token, std::move(attach_res.context), std::move(attach_res.reader));
       })
@@ -507,11 +635,14 @@ auto DeviceGrpc::DeviceGrpcImpl::handle_events(
   gRPCMessageHubEvent msghub_event;
   while (!token.stop_requested() && reader->Read(&msghub_event)) {
     spdlog::debug("Event from the message hub received.");
+    ASTARTE_TRACE_SPAN("grpc", "receive_event");
     auto parsed_message = DeviceGrpcImpl::parse_message_hub_event(msghub_event);
     if (!parsed_message) {
       return astarte_tl::unexpected(parsed_message.error());
     }
-    this->rcv_queue_.push(parsed_message.value());
+    this->rcv_queue_.push(SharedMessage(std::move(parsed_message.value())));
+    flight_recorder::record(flight_recorder::EventKind::kReceiveQueueDepth,
+                            static_cast<int64_t>(this->rcv_queue_.size()));
   }
   spdlog::info("Message hub stream has been interrupted.");
 
@@ -519,6 +650,8 @@ auto DeviceGrpc::DeviceGrpcImpl::handle_events(
   const Status status = reader->Finish();
   if (!status.ok() && !token.stop_requested()) {
     grpc_stream_error_.store(true);
+    flight_recorder::record(flight_recorder::EventKind::kStreamError,
+                            static_cast<int64_t>(status.error_code()));
     const std::string msg =
         astarte_fmt::format("gRPC stream closed with error '{}' '{}'",
                             static_cast<int>(status.error_code()), status.error_message());
@@ -568,6 +701,9 @@ auto DeviceGrpc::DeviceGrpcImpl::connection_loop(const std::stop_token& token)
           }
 
           auto delay = exp_backoff.getNextDelay();
+          flight_recorder::record(
+              flight_recorder::EventKind::kBackoffDelay,
+              std::chrono::duration_cast<std::chrono::milliseconds>(delay).count());
           spdlog::info("Will attempt to reconnect in {} seconds.",
                        std::chrono::duration_cast<std::chrono::seconds>(delay).count());
           std::this_thread::sleep_for(delay);
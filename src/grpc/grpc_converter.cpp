@@ -16,6 +16,9 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -94,8 +97,7 @@ auto GrpcConverterTo::operator()(const std::vector<uint8_t>& value)
     -> std::unique_ptr<gRPCAstarteData> {
   spdlog::trace("Converting binary blob to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
-  std::string str_vector(value.begin(), value.end());
-  grpc_data->set_binary_blob(str_vector);
+  grpc_data->set_binary_blob(std::string(value.begin(), value.end()));
   spdlog::trace("Resulting gRPC message: \n{}", *grpc_data);
   return grpc_data;
 }
@@ -118,6 +120,7 @@ auto GrpcConverterTo::operator()(const std::vector<int32_t>& values)
   spdlog::trace("Converting integer array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteIntegerArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const int32_t& value : values) {
     grpc_array->add_values(value);
   }
@@ -130,6 +133,7 @@ auto GrpcConverterTo::operator()(const std::vector<int64_t>& values)
   spdlog::trace("Converting long integer array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteLongIntegerArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const int64_t& value : values) {
     grpc_array->add_values(value);
   }
@@ -142,6 +146,7 @@ auto GrpcConverterTo::operator()(const std::vector<double>& values)
   spdlog::trace("Converting double array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteDoubleArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const double& value : values) {
     grpc_array->add_values(value);
   }
@@ -154,6 +159,7 @@ auto GrpcConverterTo::operator()(const std::vector<bool>& values)
   spdlog::trace("Converting boolean array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteBooleanArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const bool& value : values) {
     grpc_array->add_values(value);
   }
@@ -166,6 +172,7 @@ auto GrpcConverterTo::operator()(const std::vector<std::string>& values)
   spdlog::trace("Converting string array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteStringArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const std::string& value : values) {
     grpc_array->add_values(value);
   }
@@ -178,9 +185,9 @@ auto GrpcConverterTo::operator()(const std::vector<std::vector<uint8_t>>& values
   spdlog::trace("Converting binary blob array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteBinaryBlobArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const std::vector<uint8_t>& value : values) {
-    const std::string str_value(value.begin(), value.end());
-    grpc_array->add_values(str_value);
+    grpc_array->add_values()->assign(value.begin(), value.end());
   }
   grpc_data->set_allocated_binary_blob_array(grpc_array.release());
   spdlog::trace("Resulting gRPC message: \n{}", *grpc_data);
@@ -191,6 +198,7 @@ auto GrpcConverterTo::operator()(const std::vector<std::chrono::system_clock::ti
   spdlog::trace("Converting date-time array to gRPC Astarte data.");
   auto grpc_data = std::make_unique<gRPCAstarteData>();
   auto grpc_array = std::make_unique<gRPCAstarteDateTimeArray>();
+  grpc_array->mutable_values()->Reserve(static_cast<int>(values.size()));
   for (const std::chrono::system_clock::time_point& value : values) {
     const std::chrono::system_clock::duration t_duration = value.time_since_epoch();
     const std::chrono::seconds sec = std::chrono::duration_cast<std::chrono::seconds>(t_duration);
@@ -371,14 +379,14 @@ auto GrpcConverterFrom::operator()(const gRPCAstarteDatastreamIndividual& value)
 auto GrpcConverterFrom::operator()(const gRPCAstarteDatastreamObject& value)
     -> astarte_tl::expected<DatastreamObject, Error> {
   spdlog::trace("Converting Astarte datastream object from gRPC, message: \n{}", value);
-  DatastreamObject object;
   const google::protobuf::Map<std::string, gRPCAstarteData>& grpc_data = value.data();
+  DatastreamObject object(grpc_data.size());
   for (const auto& [key, data] : grpc_data) {
     auto converted_data = (*this)(data);
     if (!converted_data) {
       return astarte_tl::unexpected(converted_data.error());
     }
-    object.insert(key, converted_data.value());
+    object.try_emplace(key, std::move(converted_data.value()));
   }
   return object;
 }
@@ -421,20 +429,84 @@ auto GrpcConverterFrom::operator()(const gRPCOwnership& value) -> Ownership {
   return (value == gRPCOwnership::DEVICE) ? Ownership::kDevice : Ownership::kServer;
 }
 
+namespace {
+
+// Shares a single string among the stored properties of the same interface.
+class InternedNames {
+ public:
+  auto get(const std::string& name) -> std::shared_ptr<const std::string> {
+    // Properties are usually grouped by interface, check the last name first
+    if (last_ && *last_ == name) {
+      return last_;
+    }
+    auto found = names_.find(name);
+    if (found == names_.end()) {
+      auto interned = std::make_shared<const std::string>(name);
+      found = names_.emplace(*interned, std::move(interned)).first;
+    }
+    last_ = found->second;
+    return last_;
+  }
+
+ private:
+  std::shared_ptr<const std::string> last_;
+  // Keys reference the strings owned by the mapped values
+  std::unordered_map<std::string_view, std::shared_ptr<const std::string>> names_;
+};
+
+}  // namespace
+
 auto GrpcConverterFrom::operator()(const gRPCStoredProperties& value)
     -> astarte_tl::expected<std::list<StoredProperty>, Error> {
   spdlog::trace("Converting Astarte stored property from gRPC.");
+  InternedNames interface_names;
   std::list<StoredProperty> stored_properties;
   for (const gRPCProperty& stored_property : value.properties()) {
     auto converted_data = (*this)(stored_property.data());
     if (!converted_data) {
       return astarte_tl::unexpected(converted_data.error());
     }
-    stored_properties.emplace_back(stored_property.interface_name(), stored_property.path(),
-                                   stored_property.version_major(),
-                                   (*this)(stored_property.ownership()), converted_data.value());
+    stored_properties.emplace_back(interface_names.get(stored_property.interface_name()),
+                                   stored_property.path(), stored_property.version_major(),
+                                   (*this)(stored_property.ownership()),
+                                   std::move(converted_data).value());
   }
   return stored_properties;
 }
 
+auto GrpcConverterFrom::to_vector(const gRPCStoredProperties& value)
+    -> astarte_tl::expected<std::vector<StoredProperty>, Error> {
+  spdlog::trace("Converting Astarte stored property from gRPC.");
+  InternedNames interface_names;
+  std::vector<StoredProperty> stored_properties;
+  stored_properties.reserve(static_cast<size_t>(value.properties_size()));
+  for (const gRPCProperty& stored_property : value.properties()) {
+    auto converted_data = (*this)(stored_property.data());
+    if (!converted_data) {
+      return astarte_tl::unexpected(converted_data.error());
+    }
+    stored_properties.emplace_back(interface_names.get(stored_property.interface_name()),
+                                   stored_property.path(), stored_property.version_major(),
+                                   (*this)(stored_property.ownership()),
+                                   std::move(converted_data).value());
+  }
+  return stored_properties;
+}
+
+auto GrpcConverterFrom::visit(const gRPCStoredProperties& value,
+                              const StoredPropertyVisitor& visitor)
+    -> astarte_tl::expected<void, Error> {
+  spdlog::trace("Visiting Astarte stored property from gRPC.");
+  for (const gRPCProperty& stored_property : value.properties()) {
+    auto converted_data = (*this)(stored_property.data());
+    if (!converted_data) {
+      return astarte_tl::unexpected(converted_data.error());
+    }
+    visitor(StoredPropertyView(stored_property.interface_name(), stored_property.path(),
+                               stored_property.version_major(),
+                               (*this)(stored_property.ownership()), converted_data.value()));
+  }
+  return {};
+}
+
 }  // namespace astarte::device::grpc
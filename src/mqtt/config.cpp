@@ -27,7 +27,13 @@ Config::Config(std::string_view realm, std::string_view device_id,
       store_dir_(store_dir),
       keepalive_(DEFAULT_KEEP_ALIVE),
       conn_timeout_(DEFAULT_CONNECTION_TIMEOUT),
-      disconn_timeout_(DEFAULT_DISCONNECTION_TIMEOUT) {}
+      disconn_timeout_(DEFAULT_DISCONNECTION_TIMEOUT),
+      max_inflight_(DEFAULT_MAX_INFLIGHT),
+      max_buffered_(DEFAULT_MAX_BUFFERED_MESSAGES),
+      topic_alias_max_(DEFAULT_TOPIC_ALIAS_MAXIMUM),
+      dedup_capacity_(DEFAULT_DEDUPLICATION_CAPACITY),
+      send_queue_capacity_(DEFAULT_SEND_QUEUE_CAPACITY),
+      send_batch_bytes_(DEFAULT_SEND_BATCH_BYTES) {}
 
 auto Config::with_credential_secret(std::string_view realm, std::string_view device_id,
                                     std::string_view credential, std::string_view pairing_url,
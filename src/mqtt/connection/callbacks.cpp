@@ -4,49 +4,88 @@
 
 #include "mqtt/connection/callbacks.hpp"
 
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "astarte_device_sdk/flight_recorder.hpp"
+#include "astarte_device_sdk/individual.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "flight_recorder_event.hpp"
+#include "mqtt/deserialize.hpp"
+#include "mqtt/interface.hpp"
+#include "thread_setup.hpp"
+
 namespace astarte::device::mqtt::connection {
 
 Callback::Callback(
     paho_mqtt::iasync_client* client, std::string realm, std::string device_id,
     std::shared_ptr<Introspection> introspection,
     const std::shared_ptr<std::atomic<bool>>& connected,
-    const std::shared_ptr<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>& session_setup_tokens)
+    const std::shared_ptr<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>& session_setup_tokens,
+    std::shared_ptr<std::atomic<bool>> session_present,
+    std::shared_ptr<SharedQueue<SharedMessage>> received,
+    std::shared_ptr<ServerProperties> server_properties, ThreadHook thread_hook,
+    std::optional<DuplicateFilter> duplicate_filter)
     : client_(client),
       realm_(std::move(realm)),
       device_id_(std::move(device_id)),
       introspection_(std::move(introspection)),
+      router_(realm_, device_id_),
       session_setup_tokens_(session_setup_tokens),
       connected_(connected),
+      session_present_(std::move(session_present)),
       session_setup_listener_(
           std::make_shared<SessionSetupListener>(session_setup_tokens, connected)),
-      disconnection_listener_(std::make_shared<DisconnectionListener>(connected)) {}
+      disconnection_listener_(std::make_shared<DisconnectionListener>(connected)),
+      received_(std::move(received)),
+      server_properties_(std::move(server_properties)),
+      thread_hook_(std::move(thread_hook)),
+      duplicate_filter_(std::move(duplicate_filter)) {}
 
-// TODO(rgallor): Perform additional checks. The "handshake" with astarte should have been completed
-// in a previous connection and the device introspection should not have changed since the last
-// connection.
 auto Callback::perform_session_setup(bool session_present) -> astarte_tl::expected<void, Error> {
-  if (!session_present) {
-    auto res = setup_subscriptions();
-    if (!res) {
-      return astarte_tl::unexpected(res.error());
-    }
-    spdlog::debug("Subscription to Astarte topics transmitted.");
+  auto introspection = introspection_string();
+  // The broker kept the subscriptions and queued the messages sent while the device was offline,
+  // the handshake with Astarte is only needed if the properties or the introspection changed
+  if (session_present && server_properties_ && server_properties_->is_consistent(introspection)) {
+    spdlog::debug("Session present and server properties cached: skipping the session setup.");
+    connected_->store(true);
+    return {};
+  }
 
-    res = send_introspection();
-    if (!res) {
-      return astarte_tl::unexpected(res.error());
-    }
-    spdlog::debug("Introspection sent to Astarte.");
+  auto res = setup_subscriptions();
+  if (!res) {
+    return astarte_tl::unexpected(res.error());
+  }
+  spdlog::debug("Subscription to Astarte topics transmitted.");
+
+  res = send_introspection(introspection);
+  if (!res) {
+    return astarte_tl::unexpected(res.error());
+  }
+  spdlog::debug("Introspection sent to Astarte.");
 
-    res = send_emptycache();
-    if (!res) {
-      return astarte_tl::unexpected(res.error());
+  if (server_properties_) {
+    // A failure only prevents skipping the next setup, the cache keeps working in memory
+    auto sync = server_properties_->begin_sync(introspection);
+    if (!sync) {
+      spdlog::warn("Failed to start the server properties synchronization: {}", sync.error());
     }
-    spdlog::debug("EmptyCache sent to Astarte.");
-  } else {
-    spdlog::debug("Session present: skipping subscription and introspection setup.");
   }
 
+  res = send_emptycache();
+  if (!res) {
+    return astarte_tl::unexpected(res.error());
+  }
+  spdlog::debug("EmptyCache sent to Astarte.");
+
   return {};
 }
 
@@ -86,7 +125,7 @@ auto Callback::setup_subscriptions() -> astarte_tl::expected<void, Error> {
   return {};
 }
 
-auto Callback::send_introspection() -> astarte_tl::expected<void, Error> {
+auto Callback::introspection_string() const -> std::string {
   // Create the stringified representation of the introspection to send to Astarte
   auto introspection_str = std::string();
   for (const auto& interface : introspection_->values()) {
@@ -98,11 +137,15 @@ auto Callback::send_introspection() -> astarte_tl::expected<void, Error> {
   if (!introspection_str.empty()) {
     introspection_str.pop_back();
   }
+  return introspection_str;
+}
 
+auto Callback::send_introspection(const std::string& introspection)
+    -> astarte_tl::expected<void, Error> {
   auto base_topic = astarte_fmt::format("{}/{}", realm_, device_id_);
   try {
     const paho_mqtt::const_message_ptr message =
-        paho_mqtt::message::create(base_topic, introspection_str, 2, false);
+        paho_mqtt::message::create(base_topic, introspection, 2, false);
     const paho_mqtt::token_ptr pub_token =
         client_->publish(message, nullptr, *session_setup_listener_);
     session_setup_tokens_->put(pub_token);
@@ -128,28 +171,156 @@ auto Callback::send_emptycache() -> astarte_tl::expected<void, Error> {
   }
 }
 
+void Callback::setup_callback_thread() const {
+  // Paho threads are shared by all the clients of the process, set them up only once
+  thread_local bool thread_set_up = false;
+  if (!thread_set_up) {
+    thread_set_up = true;
+    setup_thread(ThreadRole::kMqttCallback, thread_hook_);
+  }
+}
+
 void Callback::connected(const std::string& /* cause */) {
+  setup_callback_thread();
   spdlog::info("Device connected to Astarte.");
-  auto res = perform_session_setup(false);
+  flight_recorder::record(flight_recorder::EventKind::kConnected);
+  auto res = perform_session_setup(session_present_->load());
   if (!res) {
     spdlog::warn("Session setup failed.");
+    flight_recorder::record(flight_recorder::EventKind::kSessionSetupFailed);
     session_setup_tokens_->clear();
     client_->disconnect(nullptr, *disconnection_listener_);
   }
 }
 
 void Callback::connection_lost(const std::string& cause) {
+  setup_callback_thread();
   spdlog::warn("Connection lost: {}, waiting for auto-reconnect...", cause);
+  flight_recorder::record(flight_recorder::EventKind::kConnectionLost,
+                          static_cast<int64_t>(client_->get_pending_delivery_tokens().size()));
   session_setup_tokens_->clear();
   connected_->store(false);
 }
 
 void Callback::message_arrived(paho_mqtt::const_message_ptr msg) {
-  // TODO(rgallor): handle message reception
-  spdlog::debug("Message received at {}: {}", msg->get_topic(), msg->get_payload_str());
+  setup_callback_thread();
+  const std::string_view topic = msg->get_topic();
+  const std::string_view payload = msg->get_payload();
+  const auto route = router_.route(topic, *introspection_);
+  switch (route.kind) {
+    case Route::Kind::kInvalid:
+      spdlog::warn("Discarding message with an invalid topic: {}", topic);
+      return;
+    case Route::Kind::kUnknownInterface:
+      spdlog::warn("Discarding message for interface {} missing from the introspection",
+                   route.interface_name);
+      return;
+    case Route::Kind::kUnknownMapping:
+      spdlog::warn("Discarding message for interface {}, no mapping for path {}",
+                   route.interface_name, route.path);
+      return;
+    case Route::Kind::kControl:
+    case Route::Kind::kInterface:
+      break;
+  }
+
+  if (route.kind == Route::Kind::kInterface && route.interface->ownership() != Ownership::kServer) {
+    spdlog::warn("Discarding message for the device-owned interface {}", route.interface_name);
+    return;
+  }
+
+  // only the server datastreams are deduplicated, the properties and the control messages carry
+  // state that a repeated message may legitimately restore
+  if (duplicate_filter_ && route.kind == Route::Kind::kInterface &&
+      route.interface->interface_type() == InterfaceType::Value::kDatastream &&
+      duplicate_filter_->check(topic, payload)) {
+    spdlog::debug("Discarding message redelivered at {}", topic);
+    flight_recorder::record(flight_recorder::EventKind::kDuplicateDiscarded, msg->get_qos());
+    return;
+  }
+
+  if (server_properties_) {
+    cache_server_property(route, payload);
+  }
+  if (route.kind == Route::Kind::kControl) {
+    return;
+  }
+
+  auto message = decode_message(route, payload);
+  if (!message) {
+    spdlog::warn("Discarding message received at {}: {}", topic, message.error());
+    return;
+  }
+  spdlog::debug("Message received at {}, {} bytes", topic, payload.size());
+  received_->push(SharedMessage(std::move(message.value())));
+  flight_recorder::record(flight_recorder::EventKind::kReceiveQueueDepth,
+                          static_cast<int64_t>(received_->size()));
+}
+
+auto Callback::decode_message(const Route& route, std::string_view payload)
+    -> astarte_tl::expected<Message, Error> {
+  const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(payload.data()),
+                                       payload.size());
+  const Interface& interface = *route.interface;
+
+  if (interface.interface_type() == InterfaceType::Value::kProperty) {
+    // an empty payload unsets the property
+    if (payload.empty()) {
+      return Message(route.interface_name, route.path, PropertyIndividual(std::nullopt));
+    }
+    return bson::deserialize_astarte_individual(bytes, route.mapping->type())
+        .transform([&route](bson::DeserializedIndividual&& individual) {
+          return Message(route.interface_name, route.path,
+                         PropertyIndividual(std::optional<Data>(std::move(individual.data))));
+        });
+  }
+
+  if (!interface.aggregation() || interface.aggregation()->is_individual()) {
+    return bson::deserialize_astarte_individual(bytes, route.mapping->type())
+        .transform([&route](bson::DeserializedIndividual&& individual) {
+          return Message(route.interface_name, route.path,
+                         DatastreamIndividual(std::move(individual.data)));
+        });
+  }
+
+  // the keys of an object are the last segment of the mappings sharing its path
+  const auto type_of = [&route, &interface](std::string_view key) -> std::optional<Type> {
+    for (const auto& mapping : interface.mappings()) {
+      const std::string_view endpoint = mapping.endpoint();
+      if (endpoint.substr(endpoint.rfind('/') + 1) == key &&
+          mapping.match_object_path(route.path)) {
+        return mapping.type();
+      }
+    }
+    return std::nullopt;
+  };
+  return bson::deserialize_astarte_object(bytes, type_of, interface.mappings().size())
+      .transform([&route](bson::DeserializedObject&& object) {
+        return Message(route.interface_name, route.path, std::move(object.object));
+      });
+}
+
+void Callback::cache_server_property(const Route& route, std::string_view payload) {
+  astarte_tl::expected<void, Error> res;
+  if (route.kind == Route::Kind::kControl) {
+    if (route.path != "/consumer/properties") {
+      return;
+    }
+    res = server_properties_->purge(payload);
+  } else {
+    if (route.interface->ownership() != Ownership::kServer ||
+        route.interface->interface_type() != InterfaceType::Value::kProperty) {
+      return;
+    }
+    res = server_properties_->store(route.interface_name, route.path, payload);
+  }
+  if (!res) {
+    spdlog::warn("Failed to update the server properties cache: {}", res.error());
+  }
 }
 
 void Callback::delivery_complete(paho_mqtt::delivery_token_ptr token) {
+  setup_callback_thread();
   auto message = token->get_message();
   auto payload = message->get_payload_str();
   auto topic = message->get_topic();
@@ -6,50 +6,56 @@
 
 #include <mqtt/async_client.h>
 #include <mqtt/connect_options.h>
+#include <mqtt/create_options.h>
 #include <mqtt/delivery_token.h>
 #include <mqtt/exception.h>
 #include <mqtt/iasync_client.h>
 #include <mqtt/message.h>
+#include <mqtt/properties.h>
 #include <mqtt/token.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <format>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "astarte_device_sdk/flight_recorder.hpp"
 #include "astarte_device_sdk/mqtt/config.hpp"
 #include "astarte_device_sdk/mqtt/errors.hpp"
 #include "astarte_device_sdk/mqtt/pairing.hpp"
 #include "astarte_device_sdk/ownership.hpp"
+#include "flight_recorder_event.hpp"
+#include "mqtt/connection/duplicate_filter.hpp"
+#include "mqtt/connection/options.hpp"
 #include "mqtt/credentials.hpp"
+#include "mqtt/interface.hpp"
 #include "mqtt/introspection.hpp"
+#include "mqtt/mapping.hpp"
 #include "mqtt/persistence.hpp"
+#include "mqtt/property_cache.hpp"
+#include "mqtt/server_properties.hpp"
+#include "tracing_span.hpp"
 
 namespace astarte::device::mqtt::connection {
 
 namespace {
 
 auto build_mqtt_options(Config& cfg) -> astarte_tl::expected<paho_mqtt::connect_options, Error> {
-  auto conn_opts = paho_mqtt::connect_options_builder::v3();
-  auto conn_timeout = cfg.connection_timeout();
-  auto keepalive = cfg.keepalive();
-
-  if (keepalive <= conn_timeout) {
-    return astarte_tl::unexpected(PairingConfigError(
-        astarte_fmt::format("Keep alive ({}s) should be greater than the connection timeout ({}s)",
-                            keepalive, conn_timeout)));
+  auto conn_opts = build_connect_options(cfg);
+  if (!conn_opts) {
+    return astarte_tl::unexpected(conn_opts.error());
   }
 
-  conn_opts.keep_alive_interval(std::chrono::seconds(keepalive))
-      .connect_timeout(std::chrono::seconds(conn_timeout))
-      .automatic_reconnect(std::chrono::seconds(2), std::chrono::minutes(1))
-      .clean_session(true);
-
   auto ssl_opts =
       paho_mqtt::ssl_options_builder()
           .ssl_version(3)
@@ -61,10 +67,10 @@ auto build_mqtt_options(Config& cfg) -> astarte_tl::expected<paho_mqtt::connect_
           .error_handler([](const std::string& msg) { spdlog::error("TLS error: {}", msg); })
           .finalize();
 
-  // Add the SSL options to the connection builder
-  conn_opts.ssl(std::move(ssl_opts));
+  // Add the SSL options to the connection options
+  conn_opts->set_ssl(std::move(ssl_opts));
 
-  return conn_opts.finalize();
+  return conn_opts;
 }
 
 }  // namespace
@@ -118,7 +124,8 @@ auto Connection::create(Config& cfg) -> astarte_tl::expected<Connection, Error>
   }
 
   auto client_id = astarte_fmt::format("{}/{}", realm, device_id);
-  auto client = std::make_unique<paho_mqtt::async_client>(broker_url.value(), client_id);
+  auto client = std::make_unique<paho_mqtt::async_client>(broker_url.value(), client_id,
+                                                         build_create_options(cfg));
 
   return Connection(std::move(cfg), std::move(options.value()), std::move(client), std::move(api));
 }
@@ -130,7 +137,18 @@ Connection::Connection(Config cfg, paho_mqtt::connect_options options,
       client_(std::move(client)),
       connected_(std::make_shared<std::atomic<bool>>(false)),
       session_setup_tokens_(std::make_shared<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>()),
-      pairing_api_(std::move(pairing_api)) {}
+      session_present_(std::make_shared<std::atomic<bool>>(false)),
+      received_(std::make_shared<SharedQueue<SharedMessage>>()),
+      topic_aliases_(std::make_shared<TopicAliasCache>()),
+      connection_listener_(std::make_shared<ConnectionListener>(
+          session_present_, topic_aliases_, cfg_.mqtt_v5() ? cfg_.topic_alias_maximum() : 0)),
+      pairing_api_(std::move(pairing_api)) {
+  // The properties are loaded before connecting, a resumed session does not resend them
+  if (cfg_.persist_server_properties()) {
+    server_properties_ = std::make_shared<ServerProperties>(
+        PropertyCache::load(std::filesystem::path(cfg_.store_dir()) / "server_properties.bson"));
+  }
+}
 
 auto Connection::connect(std::shared_ptr<Introspection> introspection)
     -> astarte_tl::expected<void, Error> {
@@ -168,13 +186,20 @@ auto Connection::connect(std::shared_ptr<Introspection> introspection)
 
     // TODO(sorru94): this could be moved in the constructor if the Introspection is also passed
     // during object instantiation
-    callback_ = std::make_unique<Callback>(client_.get(), std::string(cfg_.realm()),
-                                           std::string(cfg_.device_id()), std::move(introspection),
-                                           connected_, session_setup_tokens_);
+    std::optional<DuplicateFilter> duplicate_filter;
+    if (cfg_.deduplication_window() > std::chrono::milliseconds::zero()) {
+      duplicate_filter.emplace(cfg_.deduplication_capacity(), cfg_.deduplication_window());
+    }
+    callback_ = std::make_unique<Callback>(
+        client_.get(), std::string(cfg_.realm()), std::string(cfg_.device_id()),
+        std::move(introspection), connected_, session_setup_tokens_, session_present_, received_,
+        server_properties_, cfg_.thread_hook(), std::move(duplicate_filter));
     client_->set_callback(*callback_);
 
     spdlog::debug("Connecting device to the Astarte MQTT broker...");
-    client_->connect(connect_options_)->wait();
+    flight_recorder::record(flight_recorder::EventKind::kConnectAttempt);
+    auto conn_token = client_->connect(connect_options_, nullptr, *connection_listener_);
+    conn_token->wait();
 
     Credential::delete_client_certificate_and_key(cfg_.store_dir());
 
@@ -182,6 +207,7 @@ auto Connection::connect(std::shared_ptr<Introspection> introspection)
 
   } catch (const paho_mqtt::exception& e) {
     spdlog::error("Error while trying to connect to Astarte: {}", e.what());
+    flight_recorder::record(flight_recorder::EventKind::kConnectFailed, e.get_reason_code());
     return astarte_tl::unexpected(MqttConnectionError(
         astarte_fmt::format("Mqtt connection error (ID {}): {}", e.get_reason_code(), e.what())));
   }
@@ -191,8 +217,29 @@ auto Connection::connect(std::shared_ptr<Introspection> introspection)
 
 auto Connection::is_connected() const -> bool { return connected_->load(); }
 
-auto Connection::send(std::string_view interface_name, std::string_view path, uint8_t qos,
-                      const std::span<uint8_t> data) -> astarte_tl::expected<void, Error> {
+auto Connection::server_properties() const -> const std::shared_ptr<ServerProperties>& {
+  return server_properties_;
+}
+
+auto Connection::poll_incoming(const std::chrono::milliseconds& timeout)
+    -> std::optional<SharedMessage> {
+  return received_->pop(timeout);
+}
+
+auto Connection::send(std::string_view interface_name, std::string_view path,
+                      const SendDescriptor& descriptor, const std::span<uint8_t> data)
+    -> astarte_tl::expected<void, Error> {
+  auto pending = start_send(interface_name, path, descriptor, data);
+  if (!pending) {
+    return astarte_tl::unexpected(pending.error());
+  }
+  return pending.value().wait();
+}
+
+auto Connection::start_send(std::string_view interface_name, std::string_view path,
+                            const SendDescriptor& descriptor, const std::span<uint8_t> data)
+    -> astarte_tl::expected<PendingSend, Error> {
+  const uint8_t qos = descriptor.qos;
   if (!path.starts_with('/')) {
     return astarte_tl::unexpected(MqttError(
         astarte_fmt::format("couldn't publish since path doesn't starts with /: {}", path)));
@@ -208,21 +255,97 @@ auto Connection::send(std::string_view interface_name, std::string_view path, ui
   spdlog::debug("publishing on topic {}", topic);
 
   try {
-    auto token = client_->publish(topic, data.data(), data.size(), qos, false);
-    auto message = token->get_message();
+    tracing::ScopedSpan publish_span("mqtt", "publish");
+    auto token = publish(topic, descriptor, data);
+    publish_span.end();
+    return PendingSend(std::move(token), qos);
+  } catch (...) {
+    spdlog::error("failed to publish astarte individual");
+    flight_recorder::record(flight_recorder::EventKind::kPublishFailed);
+    return astarte_tl::unexpected(MqttError("failed to publish astarte individual"));
+  }
+}
+
+PendingSend::PendingSend(paho_mqtt::delivery_token_ptr token, uint8_t qos)
+    : token_(std::move(token)), qos_(qos) {}
+
+auto PendingSend::wait() -> astarte_tl::expected<void, Error> {
+  try {
+    auto message = token_->get_message();
     spdlog::trace("Publishing... Topic: {}, Qos: {},", message->get_topic(), message->get_qos());
-    token->wait();
+    ASTARTE_TRACE_SPAN("mqtt", "publish_wait");
+    token_->wait();
+    flight_recorder::record(flight_recorder::EventKind::kPublishSucceeded, qos_);
   } catch (...) {
     // TODO(rgallor): catch the correct paho error and report it inside the log.
     // TODO(rgallor): determine whether the exception is due to a connection error, if it caused the
     // device disconection (eventually reconnect) connected_->store(false);
     spdlog::error("failed to publish astarte individual");
+    flight_recorder::record(flight_recorder::EventKind::kPublishFailed);
     return astarte_tl::unexpected(MqttError("failed to publish astarte individual"));
   }
 
   return {};
 }
 
+auto PendingSend::wait(const std::atomic<bool>& abandon) -> astarte_tl::expected<void, Error> {
+  // interval at which an abandoned wait is noticed
+  constexpr auto abandon_poll = std::chrono::milliseconds(20);
+  try {
+    ASTARTE_TRACE_SPAN("mqtt", "publish_wait");
+    while (!token_->wait_for(abandon_poll)) {
+      if (abandon.load()) {
+        spdlog::warn("Stopped waiting for the delivery of {}", token_->get_message()->get_topic());
+        flight_recorder::record(flight_recorder::EventKind::kPublishFailed);
+        return astarte_tl::unexpected(MqttError("the wait for the delivery was abandoned"));
+      }
+    }
+    flight_recorder::record(flight_recorder::EventKind::kPublishSucceeded, qos_);
+  } catch (...) {
+    spdlog::error("failed to publish astarte individual");
+    flight_recorder::record(flight_recorder::EventKind::kPublishFailed);
+    return astarte_tl::unexpected(MqttError("failed to publish astarte individual"));
+  }
+
+  return {};
+}
+
+auto Connection::publish(const std::string& topic, const SendDescriptor& descriptor,
+                         std::span<uint8_t> data) -> paho_mqtt::delivery_token_ptr {
+  const uint8_t qos = descriptor.qos;
+  if (!cfg_.mqtt_v5()) {
+    return client_->publish(topic, data.data(), data.size(), qos, false);
+  }
+
+  paho_mqtt::properties props;
+  // Retained data expiring on the device also expires while waiting in the broker.
+  if (descriptor.retention != Retention::kDiscard && descriptor.expiry > 0) {
+    auto expiry = std::min<int64_t>(descriptor.expiry, std::numeric_limits<int32_t>::max());
+    props.add(paho_mqtt::property(paho_mqtt::property::MESSAGE_EXPIRY_INTERVAL,
+                                  static_cast<int32_t>(expiry)));
+  }
+
+  // The lock is held until the message is queued in the client, so that the publish binding an
+  // alias is always transmitted before the ones using it.
+  auto lock = topic_aliases_->lock();
+  // Messages buffered while disconnected would be transmitted on a connection that does not know
+  // the alias, the QoS 1 and 2 ones are never aliased as they may be retransmitted on a later
+  // connection.
+  auto alias = connected_->load() ? topic_aliases_->lookup(topic, qos) : std::nullopt;
+  if (!alias) {
+    if (props.empty()) {
+      return client_->publish(topic, data.data(), data.size(), qos, false);
+    }
+    return client_->publish(
+        paho_mqtt::message::create(topic, data.data(), data.size(), qos, false, props));
+  }
+
+  props.add(paho_mqtt::property(paho_mqtt::property::TOPIC_ALIAS, static_cast<int>(alias->value)));
+  auto message = paho_mqtt::message::create(alias->established ? std::string() : topic,
+                                            data.data(), data.size(), qos, false, props);
+  return client_->publish(message);
+}
+
 auto Connection::disconnect() -> astarte_tl::expected<void, Error> {
   try {
     auto toks = client_->get_pending_delivery_tokens();
@@ -234,6 +357,7 @@ auto Connection::disconnect() -> astarte_tl::expected<void, Error> {
     session_setup_tokens_->clear();
     client_->disconnect(static_cast<int>(cfg_.disconnection_timeout().count()))->wait();
     connected_->store(false);
+    flight_recorder::record(flight_recorder::EventKind::kDisconnected);
     spdlog::info("Device disconnected from Astarte requested.");
   } catch (const paho_mqtt::exception& e) {
     return astarte_tl::unexpected(MqttConnectionError(astarte_fmt::format(
@@ -0,0 +1,114 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/connection/duplicate_filter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace astarte::device::mqtt::connection {
+
+namespace {
+
+constexpr uint64_t k_fnv_offset = 0xcbf29ce484222325ULL;
+constexpr uint64_t k_fnv_prime = 0x100000001b3ULL;
+
+auto fnv1a(uint64_t hash, std::string_view bytes) -> uint64_t {
+  for (const char byte : bytes) {
+    hash ^= static_cast<uint8_t>(byte);
+    hash *= k_fnv_prime;
+  }
+  return hash;
+}
+
+}  // namespace
+
+DuplicateFilter::DuplicateFilter(size_t capacity, std::chrono::milliseconds window)
+    : entries_(std::max<size_t>(capacity, 1)),
+      // Keep the load factor of the table at most one half, for short probe sequences
+      slots_(std::bit_ceil(2 * entries_.size()), k_empty),
+      window_(window) {}
+
+auto DuplicateFilter::fingerprint(std::string_view topic, std::string_view payload) -> uint64_t {
+  auto hash = fnv1a(k_fnv_offset, topic);
+  // Separate the topic from the payload, so that moving bytes between the two changes the hash
+  hash = fnv1a(hash, std::string_view("\0", 1));
+  return fnv1a(hash, payload);
+}
+
+auto DuplicateFilter::check(std::string_view topic, std::string_view payload,
+                            Clock::time_point now) -> bool {
+  while (size_ > 0 && now - entries_[head_].received >= window_) {
+    evict_oldest();
+  }
+
+  const auto hash = fingerprint(topic, payload);
+  auto slot = find(hash);
+  if (slots_[slot] != k_empty) {
+    return true;
+  }
+
+  if (size_ == entries_.size()) {
+    evict_oldest();
+    // The eviction may have shifted the slots of the probe sequence
+    slot = find(hash);
+  }
+  const auto index = (head_ + size_) % entries_.size();
+  entries_[index] = Entry{.fingerprint = hash, .received = now};
+  slots_[slot] = static_cast<uint32_t>(index);
+  size_++;
+  return false;
+}
+
+void DuplicateFilter::clear() {
+  std::fill(slots_.begin(), slots_.end(), k_empty);
+  head_ = 0;
+  size_ = 0;
+}
+
+auto DuplicateFilter::home(uint64_t fingerprint) const -> size_t {
+  // FNV-1a mixes the low bits poorly, fold the high ones in before masking
+  fingerprint ^= fingerprint >> 32;
+  fingerprint *= 0x9e3779b97f4a7c15ULL;
+  return static_cast<size_t>(fingerprint >> 32) & (slots_.size() - 1);
+}
+
+auto DuplicateFilter::find(uint64_t fingerprint) const -> size_t {
+  const auto mask = slots_.size() - 1;
+  auto slot = home(fingerprint);
+  while (slots_[slot] != k_empty && entries_[slots_[slot]].fingerprint != fingerprint) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void DuplicateFilter::evict_oldest() {
+  const auto mask = slots_.size() - 1;
+  auto hole = find(entries_[head_].fingerprint);
+
+  // Backward shift deletion: move into the hole every following entry of the cluster whose
+  // preferred slot does not lie between the hole and its current slot
+  auto next = hole;
+  while (true) {
+    next = (next + 1) & mask;
+    if (slots_[next] == k_empty) {
+      break;
+    }
+    const auto preferred = home(entries_[slots_[next]].fingerprint);
+    if (((next - preferred) & mask) >= ((next - hole) & mask)) {
+      slots_[hole] = slots_[next];
+      hole = next;
+    }
+  }
+  slots_[hole] = k_empty;
+
+  head_ = (head_ + 1) % entries_.size();
+  size_--;
+}
+
+}  // namespace astarte::device::mqtt::connection
@@ -4,6 +4,10 @@
 
 #include "mqtt/connection/listener.hpp"
 
+#include <mqtt/properties.h>
+
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 
 namespace astarte::device::mqtt::connection {
@@ -26,6 +30,37 @@ void SessionSetupListener::on_success(const paho_mqtt::token& tok) {
   }
 }
 
+ConnectionListener::ConnectionListener(std::shared_ptr<std::atomic<bool>> session_present,
+                                       std::shared_ptr<TopicAliasCache> topic_aliases,
+                                       uint16_t topic_alias_maximum)
+    : session_present_(std::move(session_present)),
+      topic_aliases_(std::move(topic_aliases)),
+      topic_alias_maximum_(topic_alias_maximum) {}
+
+void ConnectionListener::on_failure(const paho_mqtt::token& /*tok*/) {
+  spdlog::debug("MQTT connection attempt failed.");
+  session_present_->store(false);
+}
+
+void ConnectionListener::on_success(const paho_mqtt::token& tok) {
+  const bool session_present = tok.get_connect_response().is_session_present();
+  spdlog::debug("MQTT connection success, session present: {}", session_present);
+  session_present_->store(session_present);
+
+  // The broker advertises how many aliases it accepts on every connection, no aliases are allowed
+  // when absent. Aliases are scoped to a single network connection.
+  uint16_t broker_max = 0;
+  if (topic_alias_maximum_ > 0) {
+    const auto& props = tok.get_connect_response().get_properties();
+    if (props.contains(paho_mqtt::property::TOPIC_ALIAS_MAXIMUM)) {
+      broker_max = paho_mqtt::get<uint16_t>(props, paho_mqtt::property::TOPIC_ALIAS_MAXIMUM);
+    }
+  }
+  auto lock = topic_aliases_->lock();
+  topic_aliases_->reset(std::min(broker_max, topic_alias_maximum_));
+  spdlog::debug("Using up to {} topic aliases", topic_aliases_->maximum());
+}
+
 DisconnectionListener::DisconnectionListener(std::shared_ptr<std::atomic<bool>> connected)
     : connected_(std::move(connected)) {}
 
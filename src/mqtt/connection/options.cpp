@@ -0,0 +1,84 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/connection/options.hpp"
+
+#include <mqtt/connect_options.h>
+#include <mqtt/create_options.h>
+#include <mqtt/properties.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/mqtt/config.hpp"
+#include "astarte_device_sdk/mqtt/errors.hpp"
+
+namespace astarte::device::mqtt::connection {
+
+namespace {
+
+constexpr auto k_int_max = static_cast<uint32_t>(std::numeric_limits<int>::max());
+// Time the broker keeps the session of a disconnected device, when MQTT 5 is used
+constexpr int32_t k_session_expiry_s = 7 * 24 * 60 * 60;
+
+}  // namespace
+
+auto build_create_options(const Config& cfg) -> paho_mqtt::create_options {
+  auto max_buffered = std::min(cfg.max_buffered_messages(), k_int_max);
+  // Buffering is only enabled after the first connection, the device must complete the pairing
+  // and session setup before any data can be sent to Astarte.
+  auto create_opts = paho_mqtt::create_options_builder();
+  create_opts.send_while_disconnected(cfg.send_while_disconnected(), false)
+      .max_buffered_messages(static_cast<int>(max_buffered))
+      .delete_oldest_messages(cfg.delete_oldest_messages());
+  if (cfg.mqtt_v5()) {
+    create_opts.mqtt_version(MQTTVERSION_5);
+  }
+  return create_opts.finalize();
+}
+
+auto build_connect_options(const Config& cfg)
+    -> astarte_tl::expected<paho_mqtt::connect_options, Error> {
+  auto conn_timeout = cfg.connection_timeout();
+  auto keepalive = cfg.keepalive();
+
+  if (keepalive <= conn_timeout) {
+    return astarte_tl::unexpected(PairingConfigError(
+        astarte_fmt::format("Keep alive ({}s) should be greater than the connection timeout ({}s)",
+                            keepalive, conn_timeout)));
+  }
+
+  auto max_inflight = cfg.max_inflight();
+  if (max_inflight == 0 || max_inflight > k_int_max) {
+    return astarte_tl::unexpected(PairingConfigError(
+        astarte_fmt::format("Max in-flight messages should be in [1, {}], got {}", k_int_max,
+                            max_inflight)));
+  }
+
+  auto conn_opts = cfg.mqtt_v5() ? paho_mqtt::connect_options_builder::v5()
+                                  : paho_mqtt::connect_options_builder::v3();
+  conn_opts.keep_alive_interval(std::chrono::seconds(keepalive))
+      .connect_timeout(std::chrono::seconds(conn_timeout))
+      .automatic_reconnect(std::chrono::seconds(2), std::chrono::minutes(1))
+      .max_inflight(static_cast<int>(max_inflight));
+  // The session is kept only when the server-owned properties are persisted, since resuming it
+  // is only useful if the device can also skip the resynchronization of the properties
+  const bool clean = !cfg.persist_server_properties();
+  if (cfg.mqtt_v5()) {
+    conn_opts.clean_start(clean);
+    if (!clean) {
+      conn_opts.properties(
+          {paho_mqtt::property(paho_mqtt::property::SESSION_EXPIRY_INTERVAL, k_session_expiry_s)});
+    }
+  } else {
+    conn_opts.clean_session(clean);
+  }
+
+  return conn_opts.finalize();
+}
+
+}  // namespace astarte::device::mqtt::connection
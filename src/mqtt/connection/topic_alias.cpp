@@ -0,0 +1,53 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/connection/topic_alias.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace astarte::device::mqtt::connection {
+
+void TopicAliasCache::reset(uint16_t maximum) {
+  maximum_ = maximum;
+  clear();
+}
+
+void TopicAliasCache::clear() {
+  index_.clear();
+  lru_.clear();
+}
+
+auto TopicAliasCache::lookup(std::string_view topic, uint8_t qos) -> std::optional<Alias> {
+  if (maximum_ == 0 || qos != 0 || topic.empty()) {
+    return std::nullopt;
+  }
+
+  auto found = index_.find(topic);
+  if (found != index_.end()) {
+    lru_.splice(lru_.begin(), lru_, found->second);
+    return Alias{.value = found->second->alias, .established = true};
+  }
+
+  uint16_t alias = 0;
+  if (lru_.size() < maximum_) {
+    alias = static_cast<uint16_t>(1 + lru_.size());
+    lru_.emplace_front(Entry{.topic = std::string(topic), .alias = alias});
+  } else {
+    // Re-bind the least recently used alias, reusing its list node
+    auto& evicted = lru_.back();
+    index_.erase(evicted.topic);
+    alias = evicted.alias;
+    evicted.topic = std::string(topic);
+    lru_.splice(lru_.begin(), lru_, std::prev(lru_.end()));
+  }
+  index_.emplace(lru_.front().topic, lru_.begin());
+
+  return Alias{.value = alias, .established = false};
+}
+
+}  // namespace astarte::device::mqtt::connection
@@ -0,0 +1,69 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/connection/topic_router.hpp"
+
+#include <string>
+#include <string_view>
+
+#include "mqtt/introspection.hpp"
+
+namespace astarte::device::mqtt::connection {
+
+namespace {
+
+constexpr std::string_view k_control = "control";
+
+}  // namespace
+
+TopicRouter::TopicRouter(std::string_view realm, std::string_view device_id) {
+  prefix_.reserve(realm.size() + device_id.size() + 2);
+  prefix_.append(realm).append("/").append(device_id).append("/");
+}
+
+auto TopicRouter::split(std::string_view topic) const -> Route {
+  Route route;
+  if (!topic.starts_with(prefix_)) {
+    return route;
+  }
+  topic.remove_prefix(prefix_.size());
+
+  // The interface name is followed by a path of at least one segment
+  const auto separator = topic.find('/');
+  if (separator == 0 || separator == std::string_view::npos || separator + 1 == topic.size()) {
+    return route;
+  }
+
+  const auto interface_name = topic.substr(0, separator);
+  route.path = topic.substr(separator);
+  if (interface_name == k_control) {
+    route.kind = Route::Kind::kControl;
+  } else {
+    route.kind = Route::Kind::kInterface;
+    route.interface_name = interface_name;
+  }
+  return route;
+}
+
+auto TopicRouter::route(std::string_view topic, const Introspection& introspection) const
+    -> Route {
+  auto route = split(topic);
+  if (route.kind != Route::Kind::kInterface) {
+    return route;
+  }
+
+  route.interface = introspection.find(route.interface_name);
+  if (!route.interface) {
+    route.kind = Route::Kind::kUnknownInterface;
+    return route;
+  }
+
+  route.mapping = route.interface->find_mapping(route.path);
+  if (route.mapping == nullptr) {
+    route.kind = Route::Kind::kUnknownMapping;
+  }
+  return route;
+}
+
+}  // namespace astarte::device::mqtt::connection
@@ -0,0 +1,512 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/deserialize.hpp"
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/type.hpp"
+
+namespace astarte::device::mqtt::bson {
+
+namespace {
+
+// BSON element types used by Astarte
+constexpr uint8_t BSON_TYPE_DOUBLE = 0x01;
+constexpr uint8_t BSON_TYPE_STRING = 0x02;
+constexpr uint8_t BSON_TYPE_DOCUMENT = 0x03;
+constexpr uint8_t BSON_TYPE_ARRAY = 0x04;
+constexpr uint8_t BSON_TYPE_BINARY = 0x05;
+constexpr uint8_t BSON_TYPE_BOOLEAN = 0x08;
+constexpr uint8_t BSON_TYPE_DATETIME = 0x09;
+constexpr uint8_t BSON_TYPE_NULL = 0x0A;
+constexpr uint8_t BSON_TYPE_INT32 = 0x10;
+constexpr uint8_t BSON_TYPE_INT64 = 0x12;
+
+// Smallest document: the size and the terminator
+constexpr size_t k_min_document_size = 5;
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+auto malformed(std::string_view reason) -> astarte_tl::unexpected<Error> {
+  return astarte_tl::unexpected<Error>(
+      DataSerializationError(astarte_fmt::format("malformed BSON payload: {}", reason)));
+}
+
+auto load_i32(std::span<const uint8_t> bytes) -> int32_t {
+  uint32_t value = 0;
+  for (size_t i = 0; i < sizeof(value); i++) {
+    value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+  }
+  return static_cast<int32_t>(value);
+}
+
+auto load_i64(std::span<const uint8_t> bytes) -> int64_t {
+  uint64_t value = 0;
+  for (size_t i = 0; i < sizeof(value); i++) {
+    value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return static_cast<int64_t>(value);
+}
+
+// Checks that a byte sequence is well formed UTF-8, rejecting overlong forms and surrogates
+auto is_valid_utf8(std::span<const uint8_t> bytes) -> bool {
+  size_t pos = 0;
+  while (pos < bytes.size()) {
+    const uint8_t lead = bytes[pos];
+    if (lead < 0x80) {
+      pos++;
+      continue;
+    }
+    size_t len = 0;
+    uint32_t min = 0;
+    uint32_t code = 0;
+    if ((lead & 0xE0) == 0xC0) {
+      len = 2;
+      min = 0x80;
+      code = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+      len = 3;
+      min = 0x800;
+      code = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+      len = 4;
+      min = 0x10000;
+      code = lead & 0x07;
+    } else {
+      return false;
+    }
+    if (bytes.size() - pos < len) {
+      return false;
+    }
+    for (size_t i = 1; i < len; i++) {
+      const uint8_t cont = bytes[pos + i];
+      if ((cont & 0xC0) != 0x80) {
+        return false;
+      }
+      code = (code << 6) | (cont & 0x3F);
+    }
+    if (code < min || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+      return false;
+    }
+    pos += len;
+  }
+  return true;
+}
+
+// An element of a BSON document, the value spans exactly the bytes of the element value
+struct Element {
+  uint8_t type;
+  std::string_view name;
+  std::span<const uint8_t> value;
+};
+
+// Iterates the elements of a BSON document, validating their framing
+class DocumentReader {
+ public:
+  // Validates the document header and terminator, the document must span the whole buffer
+  static auto open(std::span<const uint8_t> doc) -> astarte_tl::expected<DocumentReader, Error> {
+    if (doc.size() < k_min_document_size) {
+      return malformed("document too short");
+    }
+    const int32_t size = load_i32(doc);
+    if (size < 0 || static_cast<size_t>(size) != doc.size()) {
+      return malformed("document size mismatch");
+    }
+    if (doc.back() != 0) {
+      return malformed("document not terminated");
+    }
+    // Skip the size and exclude the terminator
+    return DocumentReader(doc.subspan(sizeof(int32_t), doc.size() - k_min_document_size));
+  }
+
+  // Reads the next element, returns std::nullopt at the end of the document
+  auto next() -> astarte_tl::expected<std::optional<Element>, Error> {
+    if (pos_ == body_.size()) {
+      return std::nullopt;
+    }
+    const uint8_t type = body_[pos_++];
+
+    const auto rest = body_.subspan(pos_);
+    size_t name_len = 0;
+    while (name_len < rest.size() && rest[name_len] != 0) {
+      name_len++;
+    }
+    if (name_len == rest.size()) {
+      return malformed("element name not terminated");
+    }
+    const std::string_view name(reinterpret_cast<const char*>(rest.data()), name_len);
+    pos_ += name_len + 1;
+
+    auto value_len = value_length(type, body_.subspan(pos_));
+    if (!value_len) {
+      return astarte_tl::unexpected(value_len.error());
+    }
+    Element element{.type = type, .name = name, .value = body_.subspan(pos_, value_len.value())};
+    pos_ += value_len.value();
+    return element;
+  }
+
+ private:
+  explicit DocumentReader(std::span<const uint8_t> body) : body_(body) {}
+
+  // Gets the length of the value of an element from its type and leading bytes
+  static auto value_length(uint8_t type, std::span<const uint8_t> rest)
+      -> astarte_tl::expected<size_t, Error> {
+    size_t len = 0;
+    switch (type) {
+      case BSON_TYPE_DOUBLE:
+      case BSON_TYPE_DATETIME:
+      case BSON_TYPE_INT64:
+        len = sizeof(int64_t);
+        break;
+      case BSON_TYPE_INT32:
+        len = sizeof(int32_t);
+        break;
+      case BSON_TYPE_BOOLEAN:
+        len = 1;
+        break;
+      case BSON_TYPE_NULL:
+        len = 0;
+        break;
+      case BSON_TYPE_STRING:
+      case BSON_TYPE_BINARY:
+      case BSON_TYPE_DOCUMENT:
+      case BSON_TYPE_ARRAY: {
+        if (rest.size() < sizeof(int32_t)) {
+          return malformed("truncated element");
+        }
+        const int32_t prefix = load_i32(rest);
+        if (prefix < 0) {
+          return malformed("negative length");
+        }
+        len = static_cast<size_t>(prefix);
+        if (type == BSON_TYPE_STRING) {
+          len += sizeof(int32_t);
+        } else if (type == BSON_TYPE_BINARY) {
+          // Length prefix and subtype
+          len += sizeof(int32_t) + 1;
+        }
+        break;
+      }
+      default:
+        return malformed(astarte_fmt::format("unsupported element type {:#04x}", type));
+    }
+    if (len > rest.size()) {
+      return malformed("truncated element");
+    }
+    return len;
+  }
+
+  std::span<const uint8_t> body_;
+  size_t pos_{0};
+};
+
+auto wrong_type(const Element& element, Type expected) -> astarte_tl::unexpected<Error> {
+  return malformed(astarte_fmt::format("element '{}' of type {:#04x} is not a {}", element.name,
+                                       element.type, expected));
+}
+
+auto decode_int32(const Element& element) -> astarte_tl::expected<int32_t, Error> {
+  if (element.type == BSON_TYPE_INT32) {
+    return load_i32(element.value);
+  }
+  if (element.type == BSON_TYPE_INT64) {
+    const int64_t value = load_i64(element.value);
+    if (value >= std::numeric_limits<int32_t>::min() &&
+        value <= std::numeric_limits<int32_t>::max()) {
+      return static_cast<int32_t>(value);
+    }
+  }
+  return wrong_type(element, kInteger);
+}
+
+auto decode_int64(const Element& element) -> astarte_tl::expected<int64_t, Error> {
+  if (element.type == BSON_TYPE_INT64) {
+    return load_i64(element.value);
+  }
+  if (element.type == BSON_TYPE_INT32) {
+    return load_i32(element.value);
+  }
+  return wrong_type(element, kLongInteger);
+}
+
+auto decode_double(const Element& element) -> astarte_tl::expected<double, Error> {
+  switch (element.type) {
+    case BSON_TYPE_DOUBLE:
+      return std::bit_cast<double>(load_i64(element.value));
+    case BSON_TYPE_INT32:
+      return static_cast<double>(load_i32(element.value));
+    case BSON_TYPE_INT64:
+      return static_cast<double>(load_i64(element.value));
+    default:
+      return wrong_type(element, kDouble);
+  }
+}
+
+auto decode_bool(const Element& element) -> astarte_tl::expected<bool, Error> {
+  if (element.type != BSON_TYPE_BOOLEAN) {
+    return wrong_type(element, kBoolean);
+  }
+  if (element.value[0] > 1) {
+    return malformed("invalid boolean value");
+  }
+  return element.value[0] == 1;
+}
+
+auto decode_string(const Element& element) -> astarte_tl::expected<std::string, Error> {
+  if (element.type != BSON_TYPE_STRING) {
+    return wrong_type(element, kString);
+  }
+  // The length includes the terminator
+  const auto content = element.value.subspan(sizeof(int32_t));
+  if (content.empty() || content.back() != 0) {
+    return malformed("string not terminated");
+  }
+  const auto text = content.first(content.size() - 1);
+  if (!is_valid_utf8(text)) {
+    return malformed("string is not valid UTF-8");
+  }
+  return std::string(reinterpret_cast<const char*>(text.data()), text.size());
+}
+
+auto decode_binary(const Element& element) -> astarte_tl::expected<std::vector<uint8_t>, Error> {
+  if (element.type != BSON_TYPE_BINARY) {
+    return wrong_type(element, kBinaryBlob);
+  }
+  // Skip the length and the subtype
+  const auto content = element.value.subspan(sizeof(int32_t) + 1);
+  return std::vector<uint8_t>(content.begin(), content.end());
+}
+
+auto decode_datetime(const Element& element) -> astarte_tl::expected<TimePoint, Error> {
+  int64_t millis = 0;
+  switch (element.type) {
+    case BSON_TYPE_DATETIME:
+    case BSON_TYPE_INT64:
+      millis = load_i64(element.value);
+      break;
+    case BSON_TYPE_INT32:
+      millis = load_i32(element.value);
+      break;
+    default:
+      return wrong_type(element, kDatetime);
+  }
+  // Reject instants not representable by the system clock
+  constexpr auto k_max_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    TimePoint::duration::max())
+                                    .count();
+  if (millis > k_max_millis || millis < -k_max_millis) {
+    return malformed("date-time out of range");
+  }
+  return TimePoint(std::chrono::duration_cast<TimePoint::duration>(
+      std::chrono::milliseconds(millis)));
+}
+
+// Checks that the key of an array element is its decimal index
+auto is_index_key(std::string_view key, size_t index) -> bool {
+  if (key.empty() || (key.size() > 1 && key.front() == '0')) {
+    return false;
+  }
+  // Compare the digits from the least significant one
+  for (auto digit = key.rbegin(); digit != key.rend(); ++digit) {
+    if (*digit != static_cast<char>('0' + (index % 10))) {
+      return false;
+    }
+    index /= 10;
+  }
+  return index == 0;
+}
+
+template <typename T, typename Decode>
+auto decode_array(const Element& element, Type type, Decode decode)
+    -> astarte_tl::expected<std::vector<T>, Error> {
+  if (element.type != BSON_TYPE_ARRAY) {
+    return wrong_type(element, type);
+  }
+  auto reader = DocumentReader::open(element.value);
+  if (!reader) {
+    return astarte_tl::unexpected(reader.error());
+  }
+  std::vector<T> values;
+  for (size_t index = 0;; index++) {
+    auto item = reader->next();
+    if (!item) {
+      return astarte_tl::unexpected(item.error());
+    }
+    if (!item.value()) {
+      break;
+    }
+    if (!is_index_key(item.value()->name, index)) {
+      return malformed("array keys are not sequential indexes");
+    }
+    auto value = decode(*item.value());
+    if (!value) {
+      return astarte_tl::unexpected(value.error());
+    }
+    values.push_back(std::move(value.value()));
+  }
+  return values;
+}
+
+template <typename T>
+auto to_data(astarte_tl::expected<T, Error>&& value) -> astarte_tl::expected<Data, Error> {
+  if (!value) {
+    return astarte_tl::unexpected(value.error());
+  }
+  return Data(value.value());
+}
+
+auto decode_value(const Element& element, Type type) -> astarte_tl::expected<Data, Error> {
+  switch (type) {
+    case kInteger:
+      return to_data(decode_int32(element));
+    case kLongInteger:
+      return to_data(decode_int64(element));
+    case kDouble:
+      return to_data(decode_double(element));
+    case kBoolean:
+      return to_data(decode_bool(element));
+    case kString:
+      return to_data(decode_string(element));
+    case kBinaryBlob:
+      return to_data(decode_binary(element));
+    case kDatetime:
+      return to_data(decode_datetime(element));
+    case kIntegerArray:
+      return to_data(decode_array<int32_t>(element, type, decode_int32));
+    case kLongIntegerArray:
+      return to_data(decode_array<int64_t>(element, type, decode_int64));
+    case kDoubleArray:
+      return to_data(decode_array<double>(element, type, decode_double));
+    case kBooleanArray:
+      return to_data(decode_array<bool>(element, type, decode_bool));
+    case kStringArray:
+      return to_data(decode_array<std::string>(element, type, decode_string));
+    case kBinaryBlobArray:
+      return to_data(decode_array<std::vector<uint8_t>>(element, type, decode_binary));
+    case kDatetimeArray:
+      return to_data(decode_array<TimePoint>(element, type, decode_datetime));
+  }
+  return malformed("unknown mapping type");
+}
+
+// Elements of the top level document of an Astarte payload
+struct Envelope {
+  std::optional<Element> value;
+  std::optional<TimePoint> timestamp;
+};
+
+auto read_envelope(std::span<const uint8_t> payload) -> astarte_tl::expected<Envelope, Error> {
+  auto reader = DocumentReader::open(payload);
+  if (!reader) {
+    return astarte_tl::unexpected(reader.error());
+  }
+  Envelope envelope;
+  while (true) {
+    auto element = reader->next();
+    if (!element) {
+      return astarte_tl::unexpected(element.error());
+    }
+    if (!element.value()) {
+      break;
+    }
+    const auto& elem = *element.value();
+    if (elem.name == "v") {
+      if (envelope.value) {
+        return malformed("duplicated value");
+      }
+      envelope.value = elem;
+    } else if (elem.name == "t") {
+      if (envelope.timestamp) {
+        return malformed("duplicated timestamp");
+      }
+      auto timestamp = decode_datetime(elem);
+      if (!timestamp) {
+        return astarte_tl::unexpected(timestamp.error());
+      }
+      envelope.timestamp = timestamp.value();
+    }
+    // Other elements are reserved for future use and ignored
+  }
+  if (!envelope.value) {
+    return malformed("missing value");
+  }
+  return envelope;
+}
+
+}  // namespace
+
+auto deserialize_astarte_individual(std::span<const uint8_t> payload, Type type)
+    -> astarte_tl::expected<DeserializedIndividual, Error> {
+  auto envelope = read_envelope(payload);
+  if (!envelope) {
+    return astarte_tl::unexpected(envelope.error());
+  }
+  auto data = decode_value(envelope->value.value(), type);
+  if (!data) {
+    return astarte_tl::unexpected(data.error());
+  }
+  return DeserializedIndividual{.data = std::move(data.value()),
+                                .timestamp = envelope->timestamp};
+}
+
+auto deserialize_astarte_object(std::span<const uint8_t> payload, const ObjectTypeLookup& type_of,
+                                size_t expected_keys)
+    -> astarte_tl::expected<DeserializedObject, Error> {
+  auto envelope = read_envelope(payload);
+  if (!envelope) {
+    return astarte_tl::unexpected(envelope.error());
+  }
+  const auto& value = envelope->value.value();
+  if (value.type != BSON_TYPE_DOCUMENT) {
+    return malformed("object value is not a document");
+  }
+  auto reader = DocumentReader::open(value.value);
+  if (!reader) {
+    return astarte_tl::unexpected(reader.error());
+  }
+
+  DeserializedObject result{.object = DatastreamObject(expected_keys),
+                            .timestamp = envelope->timestamp};
+  while (true) {
+    auto element = reader->next();
+    if (!element) {
+      return astarte_tl::unexpected(element.error());
+    }
+    if (!element.value()) {
+      break;
+    }
+    const auto& elem = *element.value();
+    const auto type = type_of(elem.name);
+    if (!type) {
+      return malformed(astarte_fmt::format("unknown object key '{}'", elem.name));
+    }
+    if (result.object.contains(elem.name)) {
+      return malformed(astarte_fmt::format("duplicated object key '{}'", elem.name));
+    }
+    auto data = decode_value(elem, type.value());
+    if (!data) {
+      return astarte_tl::unexpected(data.error());
+    }
+    result.object.try_emplace(elem.name, std::move(data.value()));
+  }
+  return result;
+}
+
+}  // namespace astarte::device::mqtt::bson
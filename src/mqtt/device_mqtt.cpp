@@ -4,6 +4,7 @@
 
 #include "astarte_device_sdk/mqtt/device_mqtt.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <list>
@@ -12,7 +13,10 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "astarte_device_sdk/admission.hpp"
+#include "astarte_device_sdk/capture.hpp"
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/mqtt/config.hpp"
 #include "astarte_device_sdk/mqtt/errors.hpp"
@@ -21,6 +25,7 @@
 #include "astarte_device_sdk/ownership.hpp"
 #include "astarte_device_sdk/property.hpp"
 #include "astarte_device_sdk/stored_property.hpp"
+#include "capture_send.hpp"
 #include "mqtt/device_mqtt_impl.hpp"
 
 namespace astarte::device::mqtt {
@@ -70,30 +75,131 @@ auto DeviceMqtt::send_individual(std::string_view interface_name, std::string_vi
                                  const Data& data,
                                  const std::chrono::system_clock::time_point* timestamp)
     -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->send_individual(interface_name, path, data, timestamp);
+  const capture::SendCall call{.kind = capture::SendKind::kIndividual,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = &data,
+                               .object = nullptr,
+                               .timestamp = timestamp};
+  return capture::captured(call, [&]() {
+    return astarte_device_impl_->send_individual(interface_name, path, data, timestamp);
+  });
 }
 
 auto DeviceMqtt::send_object(std::string_view interface_name, std::string_view path,
                              const DatastreamObject& object,
                              const std::chrono::system_clock::time_point* timestamp)
     -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->send_object(interface_name, path, object, timestamp);
+  const capture::SendCall call{.kind = capture::SendKind::kObject,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = nullptr,
+                               .object = &object,
+                               .timestamp = timestamp};
+  return capture::captured(call, [&]() {
+    return astarte_device_impl_->send_object(interface_name, path, object, timestamp);
+  });
+}
+
+auto DeviceMqtt::send_individual(std::string_view interface_name, std::string_view path,
+                                 Data&& data,
+                                 const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  // a running capture reads the data after the send, which must not move it
+  if (capture::active_flag.load(std::memory_order_relaxed)) {
+    return send_individual(interface_name, path, static_cast<const Data&>(data), timestamp);
+  }
+  return astarte_device_impl_->send_individual(interface_name, path, std::move(data), timestamp);
+}
+
+template <DataAllowedType T>
+auto DeviceMqtt::send_individual(std::string_view interface_name, std::string_view path,
+                                 const T& value,
+                                 const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  // a running capture records the sends as Data
+  if (capture::active_flag.load(std::memory_order_relaxed)) {
+    return send_individual(interface_name, path, Data(value), timestamp);
+  }
+  return astarte_device_impl_->send_individual(interface_name, path, value, timestamp);
+}
+
+// the implementation is private, the typed sends are instantiated for each allowed type
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(T)                                                \
+  template auto DeviceMqtt::send_individual<T>(                                               \
+      std::string_view interface_name, std::string_view path, const T& value,                 \
+      const std::chrono::system_clock::time_point* timestamp) -> astarte_tl::expected<void, Error>;
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(int32_t)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(int64_t)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(double)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(bool)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::string)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::string_view)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<uint8_t>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::chrono::system_clock::time_point)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<int32_t>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<int64_t>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<double>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<bool>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<std::string>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<std::vector<uint8_t>>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<std::chrono::system_clock::time_point>)
+#undef ASTARTE_INSTANTIATE_SEND_INDIVIDUAL
+
+auto DeviceMqtt::send_object(std::string_view interface_name, std::string_view path,
+                             DatastreamObject&& object,
+                             const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  // a running capture reads the object after the send, which must not move it
+  if (capture::active_flag.load(std::memory_order_relaxed)) {
+    return send_object(interface_name, path, static_cast<const DatastreamObject&>(object),
+                       timestamp);
+  }
+  return astarte_device_impl_->send_object(interface_name, path, std::move(object), timestamp);
+}
+
+auto DeviceMqtt::admission_counters() const -> AdmissionCounters {
+  return astarte_device_impl_->admission_counters();
+}
+
+auto DeviceMqtt::admission_counters(std::string_view interface_name) const -> AdmissionCounters {
+  return astarte_device_impl_->admission_counters(interface_name);
 }
 
 auto DeviceMqtt::set_property(std::string_view interface_name, std::string_view path,
                               const Data& data) -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->set_property(interface_name, path, data);
+  const capture::SendCall call{.kind = capture::SendKind::kSetProperty,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = &data,
+                               .object = nullptr,
+                               .timestamp = nullptr};
+  return capture::captured(
+      call, [&]() { return astarte_device_impl_->set_property(interface_name, path, data); });
 }
 
 auto DeviceMqtt::unset_property(std::string_view interface_name, std::string_view path)
     -> astarte_tl::expected<void, Error> {
-  return astarte_device_impl_->unset_property(interface_name, path);
+  const capture::SendCall call{.kind = capture::SendKind::kUnsetProperty,
+                               .interface_name = interface_name,
+                               .path = path,
+                               .data = nullptr,
+                               .object = nullptr,
+                               .timestamp = nullptr};
+  return capture::captured(
+      call, [&]() { return astarte_device_impl_->unset_property(interface_name, path); });
 }
 
 auto DeviceMqtt::poll_incoming(const std::chrono::milliseconds& timeout) -> std::optional<Message> {
   return astarte_device_impl_->poll_incoming(timeout);
 }
 
+auto DeviceMqtt::poll_incoming_shared(const std::chrono::milliseconds& timeout)
+    -> std::optional<SharedMessage> {
+  return astarte_device_impl_->poll_incoming_shared(timeout);
+}
+
 auto DeviceMqtt::get_all_properties(const std::optional<Ownership>& ownership)
     -> astarte_tl::expected<std::list<StoredProperty>, Error> {
   return astarte_device_impl_->get_all_properties(ownership);
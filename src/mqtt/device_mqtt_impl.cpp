@@ -13,20 +13,27 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <iterator>
 #include <list>
 #include <memory>
-#include <nlohmann/json.hpp>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
 
+#include "admission_controller.hpp"
+#include "astarte_device_sdk/admission.hpp"
 #include "astarte_device_sdk/data.hpp"
 #include "astarte_device_sdk/formatter.hpp"
 #include "astarte_device_sdk/mqtt/config.hpp"
@@ -38,14 +45,54 @@
 #include "astarte_device_sdk/property.hpp"
 #include "astarte_device_sdk/stored_property.hpp"
 #include "mqtt/connection/connection.hpp"
+#include "mqtt/interface.hpp"
 #include "mqtt/introspection.hpp"
+#include "mqtt/send_pipeline.hpp"
 #include "mqtt/serialize.hpp"
+#include "mqtt/server_properties.hpp"
+#include "tracing_span.hpp"
 
 namespace astarte::device::mqtt {
 
 using namespace std::chrono_literals;
 
-using json = nlohmann::json;
+namespace {
+
+// Estimates the size of the serialized payload of a value, accounted by the admission control
+template <DataAllowedType T>
+auto payload_size(const T& value) -> size_t {
+  if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                std::is_same_v<T, std::vector<uint8_t>>) {
+    return value.size();
+  } else if constexpr (std::is_same_v<T, std::vector<std::string>> ||
+                       std::is_same_v<T, std::vector<std::vector<uint8_t>>>) {
+    size_t size = 0;
+    for (const auto& item : value) {
+      size += item.size();
+    }
+    return size;
+  } else if constexpr (requires { value.size(); }) {
+    return value.size() * sizeof(int64_t);
+  } else {
+    return sizeof(int64_t);
+  }
+}
+
+// Estimates the size of the serialized payload of a Data, accounted by the admission control
+auto payload_size(const Data& data) -> size_t {
+  return std::visit([](const auto& value) { return payload_size(value); }, data.get_raw_data());
+}
+
+// Estimates the size of the serialized payload of an object, accounted by the admission control
+auto payload_size(const DatastreamObject& object) -> size_t {
+  size_t size = 0;
+  for (const auto& [key, value] : object) {
+    size += key.size() + payload_size(value);
+  }
+  return size;
+}
+
+}  // namespace
 
 auto DeviceMqtt::DeviceMqttImpl::create(Config& cfg)
     -> astarte_tl::expected<std::shared_ptr<DeviceMqttImpl>, Error> {
@@ -60,9 +107,22 @@ auto DeviceMqtt::DeviceMqttImpl::create(Config& cfg)
 }
 
 DeviceMqtt::DeviceMqttImpl::DeviceMqttImpl(Config cfg, connection::Connection connection)
-    : cfg_(std::move(cfg)), connection_(std::move(connection)) {}
+    : cfg_(std::move(cfg)),
+      connection_(std::move(connection)),
+      pipeline_(cfg_.send_workers() > 0
+                    ? std::make_unique<SendPipeline>(
+                          cfg_.send_workers(), cfg_.send_queue_capacity(), cfg_.thread_hook(),
+                          cfg_.send_linger(), cfg_.send_batch_bytes())
+                    : nullptr) {
+  if (cfg_.admission()) {
+    admission_ = std::make_unique<AdmissionController>(cfg_.admission().value());
+  }
+}
 
-DeviceMqtt::DeviceMqttImpl::~DeviceMqttImpl() = default;
+DeviceMqtt::DeviceMqttImpl::~DeviceMqttImpl() {
+  // the workers run the queued sends before stopping, without waiting for their delivery
+  abandon_deliveries_.store(true);
+}
 
 auto DeviceMqtt::DeviceMqttImpl::add_interface_from_file(const std::filesystem::path& json_file)
     -> astarte_tl::expected<void, Error> {
@@ -93,16 +153,7 @@ auto DeviceMqtt::DeviceMqttImpl::add_interface_from_str(std::string_view interfa
     // TODO(rgallor): If the device is connected, communicate the new introspection to Astarte
   }
 
-  json interface_json;
-  try {
-    interface_json = json::parse(interface_str);
-  } catch (json::parse_error& e) {
-    spdlog::error("failed to parse JSON Astarte interface: {}", e.what());
-    return astarte_tl::unexpected(
-        JsonParsingError(astarte_fmt::format("failed to parse interface from json: {}", e.what())));
-  }
-
-  auto interface = Interface::try_from_json(interface_json);
+  auto interface = Interface::try_from_str(interface_str);
   if (!interface) {
     return astarte_tl::unexpected(interface.error());
   }
@@ -125,6 +176,14 @@ auto DeviceMqtt::DeviceMqttImpl::connect() -> astarte_tl::expected<void, Error>
 }
 
 auto DeviceMqtt::DeviceMqttImpl::disconnect() -> astarte_tl::expected<void, Error> {
+  // the queued sends are published before the connection is closed, waiting for their delivery
+  // at most for the disconnection timeout, as the broker may be unreachable
+  if (pipeline_ && !pipeline_->flush_for(cfg_.disconnection_timeout())) {
+    spdlog::warn("Disconnecting with sends still waiting for their delivery");
+    abandon_deliveries_.store(true);
+    pipeline_->flush();
+    abandon_deliveries_.store(false);
+  }
   if (!is_connected()) {
     spdlog::debug("device already disconnected");
     return {};
@@ -135,112 +194,207 @@ auto DeviceMqtt::DeviceMqttImpl::disconnect() -> astarte_tl::expected<void, Erro
 auto DeviceMqtt::DeviceMqttImpl::send_individual(
     std::string_view interface_name, std::string_view path, const Data& data,
     const std::chrono::system_clock::time_point* timestamp) -> astarte_tl::expected<void, Error> {
-  if (!connection_.is_connected()) {
-    spdlog::error("couldn't send data since the device is not connected");
-    return astarte_tl::unexpected(
-        MqttError("couldn't send data since the device is not connected"));
+  if (pipeline_) {
+    // the pipelined send outlives the call and must own its data
+    return send_individual(interface_name, path, Data(data), timestamp);
   }
 
-  // check if the interface exists in the device introspection
-  auto interface_res = introspection_->get(std::string(interface_name));
-  if (!interface_res) {
-    auto msg = astarte_fmt::format(
-        "couldn't send data since the interface {} not found in introspection", interface_name);
-    spdlog::error(msg);
-    return astarte_tl::unexpected(MqttError(msg));
+  ASTARTE_TRACE_SPAN("mqtt", "send_individual");
+  auto resolved = resolve_individual(interface_name, path, data, timestamp);
+  if (!resolved) {
+    return astarte_tl::unexpected(resolved.error());
   }
+  // the ticket accounts the send in the load until the publication completes
+  auto admission = admit(interface_name, payload_size(data));
+  if (!admission) {
+    return astarte_tl::unexpected(admission.error());
+  }
+  if (!admission.value().admitted) {
+    return {};
+  }
+  auto bson_bytes = bson::individual_to_bytes(data, timestamp);
+  if (!bson_bytes) {
+    return astarte_tl::unexpected(bson_bytes.error());
+  }
+  return connection_.send(interface_name, path, resolved.value().descriptor, bson_bytes.value());
+}
 
-  auto interface = interface_res.value();
-
-  // validate data
-  auto res = interface->validate_individual(path, data, timestamp);
-  if (!res) {
-    return astarte_tl::unexpected(res.error());
+auto DeviceMqtt::DeviceMqttImpl::send_individual(
+    std::string_view interface_name, std::string_view path, Data&& data,
+    const std::chrono::system_clock::time_point* timestamp) -> astarte_tl::expected<void, Error> {
+  if (!pipeline_) {
+    return send_individual(interface_name, path, static_cast<const Data&>(data), timestamp);
   }
 
-  // get qos
-  auto qos_res = interface->get_qos(path);
-  if (!qos_res) {
-    return astarte_tl::unexpected(qos_res.error());
+  ASTARTE_TRACE_SPAN("mqtt", "send_individual");
+  auto resolved = resolve_individual(interface_name, path, data, timestamp);
+  if (!resolved) {
+    return astarte_tl::unexpected(resolved.error());
+  }
+  // the ticket travels with the queued send, a refused submission releases it
+  auto admission = admit(interface_name, payload_size(data));
+  if (!admission) {
+    return astarte_tl::unexpected(admission.error());
+  }
+  if (!admission.value().admitted) {
+    return {};
   }
-  auto qos = qos_res.value();
 
-  // serialize data to bson ({"v": <data>})
-  // if timestamp is set add it ({"v": <data>, "t": <timestamp>})
-  json bson;
-  bson::serialize_astarte_individual(bson, "v", data, timestamp);
+  tracing::ScopedSpan submit_span("mqtt", "pipeline_submit");
+  return pipeline_->submit(
+      interface_name,
+      [this, interface_name = std::string(interface_name), path = std::string(path),
+       resolved = std::move(resolved.value()), data = std::move(data),
+       timestamp = timestamp != nullptr ? std::optional(*timestamp) : std::nullopt,
+       ticket = std::move(admission.value().ticket)]() {
+        auto bson_bytes = bson::individual_to_bytes(data, timestamp ? &timestamp.value() : nullptr);
+        if (!bson_bytes) {
+          spdlog::error("Failed to serialize the individual on {}{}: {}", interface_name, path,
+                        bson_bytes.error());
+          return SendPipeline::InFlight{};
+        }
+        return start_publish(interface_name, path, resolved.descriptor, bson_bytes.value(),
+                             ticket);
+      });
+}
 
-  // check that the generated bson is not 0 size
-  if (bson.empty()) {
-    return astarte_tl::unexpected(
-        DataSerializationError("Failed to serialize individual data to BSON"));
+template <DataAllowedType T>
+auto DeviceMqtt::DeviceMqttImpl::send_individual(
+    std::string_view interface_name, std::string_view path, const T& value,
+    const std::chrono::system_clock::time_point* timestamp) -> astarte_tl::expected<void, Error> {
+  if (pipeline_) {
+    // the pipelined send outlives the call and must own its data
+    return send_individual(interface_name, path, Data(value), timestamp);
   }
 
-  spdlog::trace("dump individual: {}", bson.dump());
-
-  // convert BSON to bytes
-  std::vector<uint8_t> bson_bytes = json::to_bson(bson);
+  ASTARTE_TRACE_SPAN("mqtt", "send_individual");
+  auto interface_res = lookup_interface(interface_name);
+  if (!interface_res) {
+    return astarte_tl::unexpected(interface_res.error());
+  }
 
-  return connection_.send(interface_name, path, qos, bson_bytes);
+  // the type of the value is known, the mapping is checked without visiting a Data
+  tracing::ScopedSpan validate_span("mqtt", "validate_individual");
+  auto descriptor_res = interface_res.value()->resolve_individual(path, value, timestamp);
+  validate_span.end();
+  if (!descriptor_res) {
+    return astarte_tl::unexpected(descriptor_res.error());
+  }
+  // the ticket accounts the send in the load until the publication completes
+  auto admission = admit(interface_name, payload_size(value));
+  if (!admission) {
+    return astarte_tl::unexpected(admission.error());
+  }
+  if (!admission.value().admitted) {
+    return {};
+  }
+  auto bson_bytes = bson::individual_to_bytes(value, timestamp);
+  if (!bson_bytes) {
+    return astarte_tl::unexpected(bson_bytes.error());
+  }
+  return connection_.send(interface_name, path, descriptor_res.value(), bson_bytes.value());
 }
 
+// the typed sends are only reachable through DeviceMqtt, instantiated for each allowed type
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(T)                                                \
+  template auto DeviceMqtt::DeviceMqttImpl::send_individual<T>(                               \
+      std::string_view interface_name, std::string_view path, const T& value,                 \
+      const std::chrono::system_clock::time_point* timestamp) -> astarte_tl::expected<void, Error>;
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(int32_t)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(int64_t)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(double)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(bool)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::string)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::string_view)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<uint8_t>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::chrono::system_clock::time_point)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<int32_t>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<int64_t>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<double>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<bool>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<std::string>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<std::vector<uint8_t>>)
+ASTARTE_INSTANTIATE_SEND_INDIVIDUAL(std::vector<std::chrono::system_clock::time_point>)
+#undef ASTARTE_INSTANTIATE_SEND_INDIVIDUAL
+
 auto DeviceMqtt::DeviceMqttImpl::send_object(std::string_view interface_name, std::string_view path,
                                              const DatastreamObject& object,
                                              const std::chrono::system_clock::time_point* timestamp)
     -> astarte_tl::expected<void, Error> {
-  if (!connection_.is_connected()) {
-    spdlog::error("couldn't send data since the device is not connected");
-    return astarte_tl::unexpected(
-        MqttError("couldn't send data since the device is not connected"));
+  if (pipeline_) {
+    // the pipelined send outlives the call and must own its object
+    return send_object(interface_name, path, DatastreamObject(object), timestamp);
   }
 
-  // check if the interface exists in the device introspection
-  auto interface_res = introspection_->get(std::string(interface_name));
-  if (!interface_res) {
-    auto msg = astarte_fmt::format(
-        "couldn't send data since the interface {} not found in introspection", interface_name);
-    spdlog::error(msg);
-    return astarte_tl::unexpected(MqttError(msg));
+  ASTARTE_TRACE_SPAN("mqtt", "send_object");
+  auto resolved = resolve_object(interface_name, path, object, timestamp);
+  if (!resolved) {
+    return astarte_tl::unexpected(resolved.error());
   }
-  auto interface = interface_res.value();
-
-  if (interface->mappings().size() != object.size()) {
-    spdlog::error("incomplete aggregated datastream");
-    return astarte_tl::unexpected(InterfaceValidationError(astarte_fmt::format(
-        "incomplete aggregated datastream: the interface contains {} mappings, provided {}",
-        interface->mappings().size(), object.size())));
+  // the ticket accounts the send in the load until the publication completes
+  auto admission = admit(interface_name, payload_size(object));
+  if (!admission) {
+    return astarte_tl::unexpected(admission.error());
   }
-
-  // validate data
-  auto validate_res = interface->validate_object(path, object, timestamp);
-  if (!validate_res) {
-    return validate_res;
+  if (!admission.value().admitted) {
+    return {};
   }
-
-  // get qos
-  auto qos_res = interface->get_qos(path);
-  if (!qos_res) {
-    return astarte_tl::unexpected(qos_res.error());
+  auto bson_bytes = bson::object_to_bytes(object, timestamp);
+  if (!bson_bytes) {
+    return astarte_tl::unexpected(bson_bytes.error());
   }
-  auto qos = qos_res.value();
+  return connection_.send(interface_name, path, resolved.value().descriptor, bson_bytes.value());
+}
 
-  // serialize data to bson ({"v": {<path1>: <data1>, <path2>: <data2>, ...}})
-  // if timestamp is set add it ({"v": {<path1>: <data1>, <path2>: <data2>, ...}, "t": <timestamp>})
-  json bson;
-  bson::serialize_astarte_object(bson, object, timestamp);
+auto DeviceMqtt::DeviceMqttImpl::send_object(std::string_view interface_name, std::string_view path,
+                                             DatastreamObject&& object,
+                                             const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<void, Error> {
+  if (!pipeline_) {
+    return send_object(interface_name, path, static_cast<const DatastreamObject&>(object),
+                       timestamp);
+  }
 
-  // check that the generated bson is not 0 size
-  if (bson.empty()) {
-    return astarte_tl::unexpected(
-        DataSerializationError("Failed to serialize object data to BSON"));
+  ASTARTE_TRACE_SPAN("mqtt", "send_object");
+  auto resolved = resolve_object(interface_name, path, object, timestamp);
+  if (!resolved) {
+    return astarte_tl::unexpected(resolved.error());
+  }
+  // the ticket travels with the queued send, a refused submission releases it
+  auto admission = admit(interface_name, payload_size(object));
+  if (!admission) {
+    return astarte_tl::unexpected(admission.error());
+  }
+  if (!admission.value().admitted) {
+    return {};
   }
 
-  spdlog::trace("dump object: {}", bson.dump());
+  tracing::ScopedSpan submit_span("mqtt", "pipeline_submit");
+  return pipeline_->submit(
+      interface_name,
+      [this, interface_name = std::string(interface_name), path = std::string(path),
+       resolved = std::move(resolved.value()), object = std::move(object),
+       timestamp = timestamp != nullptr ? std::optional(*timestamp) : std::nullopt,
+       ticket = std::move(admission.value().ticket)]() {
+        auto bson_bytes = bson::object_to_bytes(object, timestamp ? &timestamp.value() : nullptr);
+        if (!bson_bytes) {
+          spdlog::error("Failed to serialize the object on {}{}: {}", interface_name, path,
+                        bson_bytes.error());
+          return SendPipeline::InFlight{};
+        }
+        return start_publish(interface_name, path, resolved.descriptor, bson_bytes.value(),
+                             ticket);
+      });
+}
 
-  // convert BSON to bytes
-  std::vector<uint8_t> bson_bytes = json::to_bson(bson);
+auto DeviceMqtt::DeviceMqttImpl::admission_counters() const -> AdmissionCounters {
+  return admission_ ? admission_->counters() : AdmissionCounters{};
+}
 
-  return connection_.send(interface_name, path, qos, bson_bytes);
+auto DeviceMqtt::DeviceMqttImpl::admission_counters(std::string_view interface_name) const
+    -> AdmissionCounters {
+  return admission_ ? admission_->counters(interface_name) : AdmissionCounters{};
 }
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
@@ -255,28 +409,180 @@ auto DeviceMqtt::DeviceMqttImpl::unset_property(std::string_view /* interface_na
     -> astarte_tl::expected<void, Error> {
   TODO("not yet implemented");
 }
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-auto DeviceMqtt::DeviceMqttImpl::poll_incoming(const std::chrono::milliseconds& /* timeout */)
+auto DeviceMqtt::DeviceMqttImpl::poll_incoming(const std::chrono::milliseconds& timeout)
     -> std::optional<Message> {
-  // TODO(rgallor): change which correct implementation. the actual one is used only to make e2e
-  // tests work.
-  return std::nullopt;
+  auto message = connection_.poll_incoming(timeout);
+  if (!message) {
+    return std::nullopt;
+  }
+  return std::move(message.value()).into_message();
 }
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-auto DeviceMqtt::DeviceMqttImpl::get_all_properties(const std::optional<Ownership>& /* ownership */)
+
+auto DeviceMqtt::DeviceMqttImpl::poll_incoming_shared(const std::chrono::milliseconds& timeout)
+    -> std::optional<SharedMessage> {
+  return connection_.poll_incoming(timeout);
+}
+auto DeviceMqtt::DeviceMqttImpl::get_all_properties(const std::optional<Ownership>& ownership)
     -> astarte_tl::expected<std::list<StoredProperty>, Error> {
-  TODO("not yet implemented");
+  // the device-owned properties are not stored
+  if (ownership == Ownership::kDevice) {
+    return std::list<StoredProperty>();
+  }
+  auto properties = stored_server_properties();
+  if (!properties) {
+    return astarte_tl::unexpected(properties.error());
+  }
+  return properties.value()->list(*introspection_, std::nullopt);
 }
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-auto DeviceMqtt::DeviceMqttImpl::get_properties(std::string_view /* interface_name */)
+
+auto DeviceMqtt::DeviceMqttImpl::get_properties(std::string_view interface_name)
     -> astarte_tl::expected<std::list<StoredProperty>, Error> {
-  TODO("not yet implemented");
+  auto interface = introspection_->get(interface_name);
+  if (!interface) {
+    return astarte_tl::unexpected(interface.error());
+  }
+  if (interface.value()->ownership() == Ownership::kDevice) {
+    return std::list<StoredProperty>();
+  }
+  auto properties = stored_server_properties();
+  if (!properties) {
+    return astarte_tl::unexpected(properties.error());
+  }
+  return properties.value()->list(*introspection_, interface_name);
 }
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-auto DeviceMqtt::DeviceMqttImpl::get_property(std::string_view /* interface_name */,
-                                              std::string_view /* path */)
+
+auto DeviceMqtt::DeviceMqttImpl::get_property(std::string_view interface_name,
+                                              std::string_view path)
     -> astarte_tl::expected<PropertyIndividual, Error> {
-  TODO("not yet implemented");
+  auto interface = introspection_->get(interface_name);
+  if (!interface) {
+    return astarte_tl::unexpected(interface.error());
+  }
+  if (interface.value()->ownership() == Ownership::kDevice) {
+    return PropertyIndividual(std::nullopt);
+  }
+  auto properties = stored_server_properties();
+  if (!properties) {
+    return astarte_tl::unexpected(properties.error());
+  }
+  return properties.value()->get(*introspection_, interface_name, path);
+}
+
+auto DeviceMqtt::DeviceMqttImpl::stored_server_properties() const
+    -> astarte_tl::expected<std::shared_ptr<ServerProperties>, Error> {
+  const auto& properties = connection_.server_properties();
+  if (!properties) {
+    constexpr std::string_view msg =
+        "the server-owned properties are only stored when persist_server_properties is enabled";
+    spdlog::error(msg);
+    return astarte_tl::unexpected(MqttError(msg));
+  }
+  return properties;
+}
+
+auto DeviceMqtt::DeviceMqttImpl::lookup_interface(std::string_view interface_name) const
+    -> astarte_tl::expected<std::shared_ptr<const Interface>, Error> {
+  if (!connection_.is_connected()) {
+    spdlog::error("couldn't send data since the device is not connected");
+    return astarte_tl::unexpected(
+        MqttError("couldn't send data since the device is not connected"));
+  }
+
+  // check if the interface exists in the device introspection
+  tracing::ScopedSpan lookup_span("mqtt", "introspection_get");
+  auto interface_res = introspection_->get(interface_name);
+  lookup_span.end();
+  if (!interface_res) {
+    auto msg = astarte_fmt::format(
+        "couldn't send data since the interface {} not found in introspection", interface_name);
+    spdlog::error(msg);
+    return astarte_tl::unexpected(MqttError(msg));
+  }
+  return interface_res;
+}
+
+auto DeviceMqtt::DeviceMqttImpl::resolve_individual(
+    std::string_view interface_name, std::string_view path, const Data& data,
+    const std::chrono::system_clock::time_point* timestamp) const
+    -> astarte_tl::expected<ResolvedSend, Error> {
+  auto interface_res = lookup_interface(interface_name);
+  if (!interface_res) {
+    return astarte_tl::unexpected(interface_res.error());
+  }
+  auto interface = std::move(interface_res.value());
+
+  // validate data and resolve the mapping metadata needed to publish it
+  tracing::ScopedSpan validate_span("mqtt", "validate_individual");
+  auto descriptor_res = interface->resolve_individual(path, data, timestamp);
+  validate_span.end();
+  if (!descriptor_res) {
+    return astarte_tl::unexpected(descriptor_res.error());
+  }
+  return ResolvedSend{.interface = std::move(interface), .descriptor = descriptor_res.value()};
+}
+
+auto DeviceMqtt::DeviceMqttImpl::resolve_object(
+    std::string_view interface_name, std::string_view path, const DatastreamObject& object,
+    const std::chrono::system_clock::time_point* timestamp) const
+    -> astarte_tl::expected<ResolvedSend, Error> {
+  auto interface_res = lookup_interface(interface_name);
+  if (!interface_res) {
+    return astarte_tl::unexpected(interface_res.error());
+  }
+  auto interface = std::move(interface_res.value());
+
+  if (interface->mappings().size() != object.size()) {
+    spdlog::error("incomplete aggregated datastream");
+    return astarte_tl::unexpected(InterfaceValidationError(astarte_fmt::format(
+        "incomplete aggregated datastream: the interface contains {} mappings, provided {}",
+        interface->mappings().size(), object.size())));
+  }
+
+  // validate data and resolve the mapping metadata in a single pass over the object
+  tracing::ScopedSpan validate_span("mqtt", "validate_object");
+  auto descriptor_res = interface->resolve_object(path, object, timestamp);
+  validate_span.end();
+  if (!descriptor_res) {
+    return astarte_tl::unexpected(descriptor_res.error());
+  }
+  return ResolvedSend{.interface = std::move(interface), .descriptor = descriptor_res.value()};
+}
+
+auto DeviceMqtt::DeviceMqttImpl::admit(std::string_view interface_name, size_t bytes)
+    -> astarte_tl::expected<Admission, Error> {
+  if (!admission_) {
+    return Admission{};
+  }
+  auto ticket = admission_->admit(interface_name, bytes);
+  if (!ticket) {
+    spdlog::warn("Refusing a send on {}: {}", interface_name, ticket.error());
+    return astarte_tl::unexpected(ticket.error());
+  }
+  if (!ticket.value()) {
+    spdlog::trace("Dropping a send on {}, the outbound path is saturated", interface_name);
+    return Admission{.admitted = false};
+  }
+  return Admission{.ticket = std::make_shared<AdmissionController::Ticket>(
+                       std::move(ticket.value().value()))};
+}
+
+auto DeviceMqtt::DeviceMqttImpl::start_publish(
+    std::string_view interface_name, std::string_view path, const SendDescriptor& descriptor,
+    std::vector<uint8_t>& bson_bytes, std::shared_ptr<AdmissionController::Ticket> ticket)
+    -> SendPipeline::InFlight {
+  auto pending = connection_.start_send(interface_name, path, descriptor, bson_bytes);
+  if (!pending) {
+    spdlog::error("Failed to publish on {}{}: {}", interface_name, path, pending.error());
+    return {};
+  }
+  // the delivery failures are logged and recorded by the pending send itself, the ticket is
+  // released once the delivery completes
+  return SendPipeline::InFlight{.bytes = bson_bytes.size(),
+                                .wait = [this, pending = std::move(pending.value()),
+                                         ticket = std::move(ticket)]() mutable {
+                                  std::ignore = pending.wait(abandon_deliveries_);
+                                  ticket.reset();
+                                }};
 }
 
 }  // namespace astarte::device::mqtt
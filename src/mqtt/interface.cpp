@@ -6,6 +6,13 @@
 
 #include <spdlog/spdlog.h>
 
+#if defined(ASTARTE_USE_SIMDJSON)
+#include <simdjson.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <limits>
@@ -13,7 +20,9 @@
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "astarte_device_sdk/data.hpp"
@@ -128,6 +137,244 @@ auto mappings_from_interface_json(const json& interface)
   return mappings;
 }
 
+#if defined(ASTARTE_USE_SIMDJSON)
+namespace ondemand = simdjson::ondemand;
+
+/**
+ * @brief A field read from a JSON object.
+ *
+ * @details The outer optional is empty if the field is missing, the inner one if the field is
+ * present with the wrong type.
+ */
+template <typename T>
+using Field = std::optional<std::optional<T>>;
+
+auto ondemand_error(simdjson::error_code err) -> astarte_tl::unexpected<Error> {
+  return astarte_tl::unexpected<Error>(JsonParsingError(astarte_fmt::format(
+      "failed to parse interface from json: {}", simdjson::error_message(err))));
+}
+
+/**
+ * @brief Reads a JSON value with the expected type.
+ *
+ * @param value The JSON value.
+ * @return The value, std::nullopt if it has a different type, an error if the JSON is malformed.
+ */
+template <typename T>
+auto read_value(ondemand::value value) -> astarte_tl::expected<std::optional<T>, Error> {
+  using Raw = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+  Raw raw{};
+  auto err = value.get(raw);
+  if (err == simdjson::INCORRECT_TYPE || err == simdjson::NUMBER_OUT_OF_RANGE) {
+    return std::nullopt;
+  }
+  if (err) {
+    return ondemand_error(err);
+  }
+  return T(raw);
+}
+
+/**
+ * @brief Gets the value of a required field, with the same errors as json_helper::get_field.
+ *
+ * @param field The field read from the JSON object.
+ * @param key The name of the field.
+ * @return The value of the field, an error if it was missing or of the wrong type.
+ */
+template <typename T>
+auto required_value(Field<T>& field, std::string_view key) -> astarte_tl::expected<T, Error> {
+  if (!field) {
+    return astarte_tl::unexpected(
+        InterfaceValidationError(astarte_fmt::format("Missing required field: {}", key)));
+  }
+  if (!field.value()) {
+    return astarte_tl::unexpected(
+        InterfaceValidationError(astarte_fmt::format("Field {} has invalid type", key)));
+  }
+  return std::move(field.value().value());
+}
+
+/**
+ * @brief Converts an optional string to a mapping enumeration.
+ *
+ * @details Invalid strings fall back to the default value, as with the nlohmann deserializers.
+ *
+ * @param str The optional string.
+ * @return The enumeration value, std::nullopt if the string is missing.
+ */
+template <typename T>
+auto enum_or_default(const std::optional<std::string>& str) -> std::optional<T> {
+  if (!str) {
+    return std::nullopt;
+  }
+  return T::try_from_str(str.value()).value_or(T());
+}
+
+/**
+ * @brief Parses a mapping from a JSON value, mirroring Mapping::try_from_json.
+ *
+ * @param value The JSON value of an element of the "mappings" array.
+ * @return The parsed Mapping, an error otherwise.
+ */
+auto mapping_from_ondemand(ondemand::value value) -> astarte_tl::expected<Mapping, Error> {
+  ondemand::object object;
+  auto err = value.get_object().get(object);
+  if (err == simdjson::INCORRECT_TYPE) {
+    return astarte_tl::unexpected(
+        InterfaceValidationError("Each element in 'mappings' must be an object"));
+  }
+  if (err) {
+    return ondemand_error(err);
+  }
+
+  Field<std::string> endpoint;
+  Field<std::string> type;
+  std::optional<bool> explicit_timestamp;
+  std::optional<std::string> reliability;
+  std::optional<std::string> retention;
+  std::optional<int64_t> expiry;
+  std::optional<std::string> database_retention_policy;
+  std::optional<int64_t> database_retention_ttl;
+  std::optional<bool> allow_unset;
+  std::optional<std::string> description;
+  std::optional<std::string> doc;
+
+  // read all the fields in a single pass, later duplicates override earlier ones
+  for (auto field_res : object) {
+    ondemand::field field;
+    std::string_view key;
+    err = std::move(field_res).get(field);
+    if (!err) {
+      err = field.unescaped_key().get(key);
+    }
+    if (err) {
+      return ondemand_error(err);
+    }
+
+    auto read = [&]<typename T>(std::optional<T>& out) -> astarte_tl::expected<void, Error> {
+      auto res = read_value<T>(field.value());
+      if (!res) {
+        return astarte_tl::unexpected(res.error());
+      }
+      out = std::move(res.value());
+      return {};
+    };
+    auto read_required = [&]<typename T>(Field<T>& out) -> astarte_tl::expected<void, Error> {
+      out.emplace();
+      return read(out.value());
+    };
+
+    astarte_tl::expected<void, Error> res;
+    if (key == "endpoint") {
+      res = read_required(endpoint);
+    } else if (key == "type") {
+      res = read_required(type);
+    } else if (key == "explicit_timestamp") {
+      res = read(explicit_timestamp);
+    } else if (key == "reliability") {
+      res = read(reliability);
+    } else if (key == "retention") {
+      res = read(retention);
+    } else if (key == "expiry") {
+      res = read(expiry);
+    } else if (key == "database_retention_policy") {
+      res = read(database_retention_policy);
+    } else if (key == "database_retention_ttl") {
+      res = read(database_retention_ttl);
+    } else if (key == "allow_unset") {
+      res = read(allow_unset);
+    } else if (key == "description") {
+      res = read(description);
+    } else if (key == "doc") {
+      res = read(doc);
+    }
+    if (!res) {
+      return astarte_tl::unexpected(res.error());
+    }
+  }
+
+  auto endpoint_res = required_value(endpoint, "endpoint");
+  if (!endpoint_res) {
+    return astarte_tl::unexpected(endpoint_res.error());
+  }
+  auto type_str = required_value(type, "type");
+  if (!type_str) {
+    return astarte_tl::unexpected(type_str.error());
+  }
+  auto type_res = astarte_type_from_str(type_str.value());
+  if (!type_res) {
+    return astarte_tl::unexpected(type_res.error());
+  }
+
+  return Mapping(std::move(endpoint_res.value()), type_res.value(), explicit_timestamp,
+                 enum_or_default<Reliability>(reliability).value_or(Reliability()),
+                 enum_or_default<Retention>(retention), expiry,
+                 enum_or_default<DatabaseRetentionPolicy>(database_retention_policy),
+                 database_retention_ttl, allow_unset, std::move(description), std::move(doc));
+}
+
+/// @brief Mappings of an interface, or the error raised validating them.
+using MappingsResult = astarte_tl::expected<std::vector<Mapping>, Error>;
+
+/**
+ * @brief Parses the "mappings" array of an interface.
+ *
+ * @param value The JSON value of the "mappings" field.
+ * @return The mappings or their validation error, std::nullopt if the field is not an array, an
+ * error if the JSON is malformed.
+ */
+auto mappings_from_ondemand(ondemand::value value)
+    -> astarte_tl::expected<std::optional<MappingsResult>, Error> {
+  ondemand::array array;
+  auto err = value.get_array().get(array);
+  if (err == simdjson::INCORRECT_TYPE) {
+    return std::nullopt;
+  }
+  if (err) {
+    return ondemand_error(err);
+  }
+
+  std::vector<Mapping> mappings;
+  for (auto element : array) {
+    ondemand::value element_value;
+    err = element.get(element_value);
+    if (err) {
+      return ondemand_error(err);
+    }
+    auto mapping = mapping_from_ondemand(element_value);
+    if (!mapping && std::holds_alternative<JsonParsingError>(mapping.error())) {
+      return astarte_tl::unexpected(mapping.error());
+    }
+    if (!mapping) {
+      // the rest of the array is skipped by the parser
+      return std::optional<MappingsResult>(astarte_tl::unexpected(mapping.error()));
+    }
+    mappings.emplace_back(std::move(mapping.value()));
+  }
+  return std::optional<MappingsResult>(std::move(mappings));
+}
+#endif
+
+/**
+ * @brief Checks the timestamp of a data point against the explicit_timestamp of its mapping.
+ *
+ * @param mapping The mapping of the data point.
+ * @param timestamp A pointer to the timestamp, if provided.
+ * @return The description of the mismatch, nullopt if the timestamp is consistent.
+ */
+auto check_explicit_timestamp(const Mapping& mapping,
+                              const std::chrono::system_clock::time_point* timestamp)
+    -> std::optional<std::string_view> {
+  const auto requirement = mapping.metadata().timestamp();
+  if (requirement == MappingMetadata::Timestamp::kRequired && timestamp == nullptr) {
+    return "Explicit timestamp required";
+  }
+  if (requirement == MappingMetadata::Timestamp::kForbidden && timestamp != nullptr) {
+    return "Explicit timestamp not supported";
+  }
+  return std::nullopt;
+}
+
 }  // namespace
 
 auto Interface::try_from_json(const json& interface) -> astarte_tl::expected<Interface, Error> {
@@ -179,6 +426,175 @@ auto Interface::try_from_json(const json& interface) -> astarte_tl::expected<Int
                    own_res.value(), agg_res.value(), description, doc, mappings);
 }
 
+#if defined(ASTARTE_USE_SIMDJSON)
+
+auto Interface::try_from_str(std::string_view interface)
+    -> astarte_tl::expected<Interface, Error> {
+  // reuse the internal buffers of the parser across interfaces
+  thread_local ondemand::parser parser;
+  const simdjson::padded_string padded(interface);
+
+  ondemand::document document;
+  ondemand::object object;
+  auto err = parser.iterate(padded).get(document);
+  if (!err) {
+    err = document.get_object().get(object);
+  }
+  if (err == simdjson::INCORRECT_TYPE) {
+    return astarte_tl::unexpected(
+        InterfaceValidationError("Missing required field: interface_name"));
+  }
+  if (err) {
+    return ondemand_error(err);
+  }
+
+  Field<std::string> interface_name;
+  Field<int64_t> version_major;
+  Field<int64_t> version_minor;
+  Field<std::string> interface_type;
+  Field<std::string> ownership;
+  Field<std::string> aggregation;
+  std::optional<std::string> description;
+  std::optional<std::string> doc;
+  Field<MappingsResult> mappings;
+
+  // read all the fields in a single pass, later duplicates override earlier ones
+  for (auto field_res : object) {
+    ondemand::field field;
+    std::string_view key;
+    err = std::move(field_res).get(field);
+    if (!err) {
+      err = field.unescaped_key().get(key);
+    }
+    if (err) {
+      return ondemand_error(err);
+    }
+
+    auto read = [&]<typename T>(std::optional<T>& out) -> astarte_tl::expected<void, Error> {
+      auto res = read_value<T>(field.value());
+      if (!res) {
+        return astarte_tl::unexpected(res.error());
+      }
+      out = std::move(res.value());
+      return {};
+    };
+    auto read_required = [&]<typename T>(Field<T>& out) -> astarte_tl::expected<void, Error> {
+      out.emplace();
+      return read(out.value());
+    };
+
+    astarte_tl::expected<void, Error> res;
+    if (key == "interface_name") {
+      res = read_required(interface_name);
+    } else if (key == "version_major") {
+      res = read_required(version_major);
+    } else if (key == "version_minor") {
+      res = read_required(version_minor);
+    } else if (key == "type") {
+      res = read_required(interface_type);
+    } else if (key == "ownership") {
+      res = read_required(ownership);
+    } else if (key == "aggregation") {
+      res = read_required(aggregation);
+    } else if (key == "description") {
+      res = read(description);
+    } else if (key == "doc") {
+      res = read(doc);
+    } else if (key == "mappings") {
+      auto mappings_res = mappings_from_ondemand(field.value());
+      if (!mappings_res) {
+        return astarte_tl::unexpected(mappings_res.error());
+      }
+      mappings.emplace(std::move(mappings_res.value()));
+    }
+    if (!res) {
+      return astarte_tl::unexpected(res.error());
+    }
+  }
+  if (!document.at_end()) {
+    return ondemand_error(simdjson::TRAILING_CONTENT);
+  }
+
+  // validate the fields in the same order as try_from_json
+  auto name_res = required_value(interface_name, "interface_name");
+  if (!name_res) {
+    return astarte_tl::unexpected(name_res.error());
+  }
+
+  auto maj_res = required_value(version_major, "version_major").and_then([](int64_t version) {
+    return convert_version("major", version);
+  });
+  if (!maj_res) {
+    return astarte_tl::unexpected(maj_res.error());
+  }
+
+  auto min_res = required_value(version_minor, "version_minor").and_then([](int64_t version) {
+    return convert_version("minor", version);
+  });
+  if (!min_res) {
+    return astarte_tl::unexpected(min_res.error());
+  }
+
+  auto type_res = required_value(interface_type, "type").and_then([](const std::string& type) {
+    return InterfaceType::try_from_str(type);
+  });
+  if (!type_res) {
+    return astarte_tl::unexpected(type_res.error());
+  }
+
+  auto own_res = required_value(ownership, "ownership").and_then([](const std::string& own) {
+    return ownership_from_str(own);
+  });
+  if (!own_res) {
+    return astarte_tl::unexpected(own_res.error());
+  }
+
+  std::optional<InterfaceAggregation> agg;
+  if (aggregation) {
+    if (!aggregation.value()) {
+      return astarte_tl::unexpected(InterfaceValidationError("aggregation must be a string"));
+    }
+    auto agg_res = InterfaceAggregation::try_from_str(aggregation.value().value());
+    if (!agg_res) {
+      return astarte_tl::unexpected(agg_res.error());
+    }
+    agg = agg_res.value();
+  }
+
+  auto mappings_res = required_value(mappings, "mappings");
+  if (!mappings_res) {
+    return astarte_tl::unexpected(mappings_res.error());
+  }
+  if (!mappings_res.value()) {
+    return astarte_tl::unexpected(mappings_res.value().error());
+  }
+  if (mappings_res.value()->empty()) {
+    return astarte_tl::unexpected(InterfaceValidationError("There must be at least one mapping"));
+  }
+
+  return Interface(std::move(name_res.value()), maj_res.value(), min_res.value(), type_res.value(),
+                   own_res.value(), agg, std::move(description), std::move(doc),
+                   std::move(mappings_res.value().value()));
+}
+
+#else
+
+auto Interface::try_from_str(std::string_view interface)
+    -> astarte_tl::expected<Interface, Error> {
+  json interface_json;
+  try {
+    interface_json = json::parse(interface);
+  } catch (json::parse_error& e) {
+    spdlog::error("failed to parse JSON Astarte interface: {}", e.what());
+    return astarte_tl::unexpected(
+        JsonParsingError(astarte_fmt::format("failed to parse interface from json: {}", e.what())));
+  }
+
+  return try_from_json(interface_json);
+}
+
+#endif
+
 auto Interface::get_mapping(std::string_view path) const
     -> astarte_tl::expected<const Mapping*, Error> {
   for (const auto& mapping : mappings_) {
@@ -191,9 +607,39 @@ auto Interface::get_mapping(std::string_view path) const
       InterfaceValidationError(astarte_fmt::format("couldn't find mapping with path {}", path)));
 }
 
+auto Interface::find_mapping(std::string_view path) const -> const Mapping* {
+  const bool individual = !aggregation_.has_value() || aggregation_.value().is_individual();
+  for (const auto& mapping : mappings_) {
+    if (individual ? mapping.match_path(path) : mapping.match_object_path(path)) {
+      return &mapping;
+    }
+  }
+  return nullptr;
+}
+
 auto Interface::validate_individual(std::string_view path, const Data& data,
                                     const std::chrono::system_clock::time_point* timestamp) const
     -> astarte_tl::expected<void, Error> {
+  auto res = resolve_individual(path, data, timestamp);
+  if (!res) {
+    return astarte_tl::unexpected(res.error());
+  }
+  return {};
+}
+
+auto Interface::validate_object(std::string_view common_path, const DatastreamObject& object,
+                                const std::chrono::system_clock::time_point* timestamp) const
+    -> astarte_tl::expected<void, Error> {
+  auto res = resolve_object(common_path, object, timestamp);
+  if (!res) {
+    return astarte_tl::unexpected(res.error());
+  }
+  return {};
+}
+
+auto Interface::resolve_individual(std::string_view path, const Data& data,
+                                   const std::chrono::system_clock::time_point* timestamp) const
+    -> astarte_tl::expected<SendDescriptor, Error> {
   auto mapping_res = get_mapping(path);
   if (!mapping_res) {
     return astarte_tl::unexpected(mapping_res.error());
@@ -205,35 +651,134 @@ auto Interface::validate_individual(std::string_view path, const Data& data,
     return astarte_tl::unexpected(res.error());
   }
 
-  auto explicit_ts = mapping->explicit_timestamp();
-  if ((explicit_ts.has_value() && explicit_ts.value()) && timestamp == nullptr) {
-    spdlog::error("Explicit timestamp required for interface {}, path {}", interface_name_, path);
-    return astarte_tl::unexpected(InterfaceValidationError(astarte_fmt::format(
-        "Explicit timestamp required for interface {}, path {}", interface_name_, path)));
+  return describe_individual(*mapping, path, timestamp);
+}
+
+auto Interface::resolve_object(std::string_view common_path, const DatastreamObject& object,
+                               const std::chrono::system_clock::time_point* timestamp) const
+    -> astarte_tl::expected<SendDescriptor, Error> {
+  if (mappings_.empty()) {
+    return astarte_tl::unexpected(MqttError("Interface has no mappings"));
   }
 
-  if ((explicit_ts.has_value() && !explicit_ts.value()) && timestamp != nullptr) {
-    spdlog::error("Explicit timestamp not supported for interface {}, path {}", interface_name_,
-                  path);
-    return astarte_tl::unexpected(InterfaceValidationError(astarte_fmt::format(
-        "Explicit timestamp not supported for interface {}, path {}", interface_name_, path)));
+  if (object_fields_.empty()) {
+    for (const auto& [endpoint_path, data] : object) {
+      auto path = astarte_fmt::format("{}/{}", common_path, endpoint_path);
+      auto res = this->validate_individual(path, data, timestamp);
+      if (!res) {
+        return astarte_tl::unexpected(res.error());
+      }
+    }
+    return describe_send(mappings_.front(), timestamp);
   }
 
-  return {};
-}
+  // all the indexed mappings share the same common path, matching the first one is enough
+  const Mapping& first = mappings_.front();
+  if (!first.match_object_path(common_path)) {
+    return astarte_tl::unexpected(InterfaceValidationError(
+        astarte_fmt::format("couldn't find mapping with path {}", common_path)));
+  }
 
-auto Interface::validate_object(std::string_view common_path, const DatastreamObject& object,
-                                const std::chrono::system_clock::time_point* timestamp) const
-    -> astarte_tl::expected<void, Error> {
   for (const auto& [endpoint_path, data] : object) {
-    auto path = astarte_fmt::format("{}/{}", common_path, endpoint_path);
-    auto res = this->validate_individual(path, data, timestamp);
+    const Mapping* mapping = find_object_field(endpoint_path);
+    if (mapping == nullptr) {
+      return astarte_tl::unexpected(InterfaceValidationError(astarte_fmt::format(
+          "couldn't find mapping with path {}/{}", common_path, endpoint_path)));
+    }
+
+    auto res = mapping->check_data_type(data);
     if (!res) {
       return astarte_tl::unexpected(res.error());
     }
+
+    if (auto mismatch = check_explicit_timestamp(*mapping, timestamp)) {
+      spdlog::error("{} for interface {}, path {}/{}", mismatch.value(), interface_name_,
+                    common_path, endpoint_path);
+      return astarte_tl::unexpected(
+          InterfaceValidationError(astarte_fmt::format("{} for interface {}, path {}/{}",
+                                                       mismatch.value(), interface_name_,
+                                                       common_path, endpoint_path)));
+    }
   }
 
-  return {};
+  return describe_send(first, timestamp);
+}
+
+auto Interface::describe_send(const Mapping& mapping,
+                              const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<SendDescriptor, Error> {
+  const MappingMetadata metadata = mapping.metadata();
+  return SendDescriptor{
+      .mapping = &mapping,
+      .qos = metadata.qos(),
+      .retention = metadata.retention(),
+      .expiry = metadata.expiry(),
+      .explicit_timestamp = timestamp != nullptr,
+  };
+}
+
+auto Interface::describe_individual(const Mapping& mapping, std::string_view path,
+                                    const std::chrono::system_clock::time_point* timestamp) const
+    -> astarte_tl::expected<SendDescriptor, Error> {
+  if (auto mismatch = check_explicit_timestamp(mapping, timestamp)) {
+    spdlog::error("{} for interface {}, path {}", mismatch.value(), interface_name_, path);
+    return astarte_tl::unexpected(InterfaceValidationError(astarte_fmt::format(
+        "{} for interface {}, path {}", mismatch.value(), interface_name_, path)));
+  }
+
+  return describe_send(mapping, timestamp);
+}
+
+void Interface::index_object_fields() {
+  if (!aggregation_.has_value() || aggregation_.value().is_individual()) {
+    return;
+  }
+
+  std::vector<ObjectField> fields;
+  fields.reserve(mappings_.size());
+  std::string_view common;
+  for (size_t i = 0; i < mappings_.size(); i++) {
+    const std::string_view endpoint = mappings_[i].endpoint();
+    const auto last_slash = endpoint.rfind('/');
+    if (last_slash == std::string_view::npos || last_slash == 0) {
+      return;
+    }
+    if (i == 0) {
+      common = endpoint.substr(0, last_slash);
+    } else if (endpoint.substr(0, last_slash) != common) {
+      return;
+    }
+    fields.push_back(ObjectField{.mapping = i, .name_offset = last_slash + 1});
+  }
+
+  auto by_name = [this](const ObjectField& lhs, const ObjectField& rhs) {
+    return object_field_name(lhs) < object_field_name(rhs);
+  };
+  std::sort(fields.begin(), fields.end(), by_name);
+  auto same_name = [this](const ObjectField& lhs, const ObjectField& rhs) {
+    return object_field_name(lhs) == object_field_name(rhs);
+  };
+  if (std::adjacent_find(fields.begin(), fields.end(), same_name) != fields.end()) {
+    return;
+  }
+
+  object_fields_ = std::move(fields);
+}
+
+auto Interface::object_field_name(const ObjectField& field) const -> std::string_view {
+  return std::string_view(mappings_[field.mapping].endpoint()).substr(field.name_offset);
+}
+
+auto Interface::find_object_field(std::string_view name) const -> const Mapping* {
+  auto found = std::lower_bound(
+      object_fields_.begin(), object_fields_.end(), name,
+      [this](const ObjectField& field, std::string_view key) {
+        return object_field_name(field) < key;
+      });
+  if (found == object_fields_.end() || object_field_name(*found) != name) {
+    return nullptr;
+  }
+  return &mappings_[found->mapping];
 }
 
 auto Interface::get_qos(std::string_view path) const -> astarte_tl::expected<uint8_t, Error> {
@@ -257,14 +802,7 @@ auto Interface::get_qos(std::string_view path) const -> astarte_tl::expected<uin
     return astarte_tl::unexpected(mapping_exp.error());
   }
 
-  const Mapping* map_ptr = mapping_exp.value();
-
-  auto reliability = map_ptr->reliability();
-  if (!reliability) {
-    return astarte_tl::unexpected(MqttError("the interface mapping doesn't contain the qos value"));
-  }
-
-  return reliability->get_qos();
+  return mapping_exp.value()->metadata().qos();
 }
 
 }  // namespace astarte::device::mqtt
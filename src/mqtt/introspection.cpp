@@ -77,12 +77,22 @@ auto Introspection::values() const -> std::vector<std::shared_ptr<const Interfac
 
 auto Introspection::get(std::string_view interface_name) const
     -> astarte_tl::expected<std::shared_ptr<const Interface>, Error> {
+  auto interface = find(interface_name);
+  if (!interface) {
+    return astarte_tl::unexpected(MqttError(
+        astarte_fmt::format("couldn't find interface {} in the introspection", interface_name)));
+  }
+
+  return interface;
+}
+
+auto Introspection::find(std::string_view interface_name) const
+    -> std::shared_ptr<const Interface> {
   const std::shared_lock lock(lock_);
 
   auto iter = interfaces_.find(interface_name);
   if (iter == interfaces_.end()) {
-    return astarte_tl::unexpected(MqttError(
-        astarte_fmt::format("couldn't find interface {} in the introspection", interface_name)));
+    return nullptr;
   }
 
   return iter->second;
@@ -0,0 +1,123 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/json_backend.hpp"
+
+#if defined(ASTARTE_USE_SIMDJSON)
+#include <simdjson.h>
+#else
+#include <nlohmann/json.hpp>
+#endif
+
+#include <string>
+#include <string_view>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+
+namespace astarte::device::mqtt::json_backend {
+
+namespace {
+
+template <typename T>
+struct json_type_traits;
+template <>
+struct json_type_traits<std::string> {
+#if defined(ASTARTE_USE_SIMDJSON)
+  using ondemand_type = std::string_view;
+#else
+  static auto check(const nlohmann::json& input) -> bool { return input.is_string(); }
+#endif
+  static auto name() -> const char* { return "string"; }
+};
+template <>
+struct json_type_traits<bool> {
+#if defined(ASTARTE_USE_SIMDJSON)
+  using ondemand_type = bool;
+#else
+  static auto check(const nlohmann::json& input) -> bool { return input.is_boolean(); }
+#endif
+  static auto name() -> const char* { return "boolean"; }
+};
+
+}  // namespace
+
+#if defined(ASTARTE_USE_SIMDJSON)
+
+auto name() -> std::string_view { return "simdjson"; }
+
+template <typename T>
+auto value_at(std::string_view text, std::string_view pointer) -> astarte_tl::expected<T, Error> {
+  // Reuse the internal buffers of the parser across documents
+  thread_local simdjson::ondemand::parser parser;
+  const simdjson::padded_string padded(text);
+
+  simdjson::ondemand::document doc;
+  auto err = parser.iterate(padded).get(doc);
+  if (err) {
+    return astarte_tl::unexpected(
+        JsonParsingError(astarte_fmt::format("Invalid JSON. Body: {}", text)));
+  }
+
+  simdjson::ondemand::value value;
+  err = doc.at_pointer(pointer).get(value);
+  if (err == simdjson::NO_SUCH_FIELD || err == simdjson::INDEX_OUT_OF_BOUNDS ||
+      err == simdjson::INVALID_JSON_POINTER) {
+    return astarte_tl::unexpected(
+        JsonParsingError{astarte_fmt::format("Path {} not found. Body: {}", pointer, text)});
+  }
+  if (err) {
+    return astarte_tl::unexpected(
+        JsonParsingError(astarte_fmt::format("Invalid JSON. Body: {}", text)));
+  }
+
+  typename json_type_traits<T>::ondemand_type result;
+  err = value.get(result);
+  if (err == simdjson::INCORRECT_TYPE) {
+    return astarte_tl::unexpected(JsonParsingError{astarte_fmt::format(
+        "Value at {} is not a {}. Body: {}", pointer, json_type_traits<T>::name(), text)});
+  }
+  if (err) {
+    return astarte_tl::unexpected(
+        JsonParsingError(astarte_fmt::format("Invalid JSON. Body: {}", text)));
+  }
+  return T(result);
+}
+
+#else
+
+auto name() -> std::string_view { return "nlohmann"; }
+
+template <typename T>
+auto value_at(std::string_view text, std::string_view pointer) -> astarte_tl::expected<T, Error> {
+  using json = nlohmann::json;
+  json text_json = json::parse(text, nullptr, false);
+  if (text_json.is_discarded()) {
+    return astarte_tl::unexpected(
+        JsonParsingError(astarte_fmt::format("Invalid JSON. Body: {}", text)));
+  }
+
+  const json::json_pointer path_json{std::string(pointer)};
+  if (!text_json.contains(path_json)) {
+    return astarte_tl::unexpected(JsonParsingError{
+        astarte_fmt::format("Path {} not found. Body: {}", path_json.to_string(), text)});
+  }
+
+  const auto& value = text_json[path_json];
+  if (!json_type_traits<T>::check(value)) {
+    return astarte_tl::unexpected(JsonParsingError{
+        astarte_fmt::format("Value at {} is not a {}. Body: {}", path_json.to_string(),
+                            json_type_traits<T>::name(), text)});
+  }
+  return value.get<T>();
+}
+
+#endif
+
+template auto value_at<std::string>(std::string_view text, std::string_view pointer)
+    -> astarte_tl::expected<std::string, Error>;
+template auto value_at<bool>(std::string_view text, std::string_view pointer)
+    -> astarte_tl::expected<bool, Error>;
+
+}  // namespace astarte::device::mqtt::json_backend
@@ -56,6 +56,35 @@ auto is_segment_match(std::string_view pattern, std::string_view path_seg) -> bo
   return pattern == path_seg;
 }
 
+// helper function to check that a path matches an endpoint pattern, segment by segment
+auto match_endpoint(std::string_view endpoint, std::string_view path) -> bool {
+  // check lengths and trailing slash
+  if (path.length() < 2 || path.back() == '/') {
+    return false;
+  }
+  // check leading slash consistency
+  if (endpoint.empty() || path.front() != endpoint.front()) {
+    return false;
+  }
+
+  // remove the leading slash to prepare for segment iteration
+  // (we know both start with same char, usually '/')
+  endpoint.remove_prefix(1);
+  path.remove_prefix(1);
+
+  while (!endpoint.empty() && !path.empty()) {
+    const std::string_view endpoint_seg = pop_next_segment(endpoint);
+    const std::string_view path_seg = pop_next_segment(path);
+
+    if (!is_segment_match(endpoint_seg, path_seg)) {
+      return false;
+    }
+  }
+
+  // both strings must be fully consumed. If one has leftovers there is a length mismatch.
+  return endpoint.empty() && path.empty();
+}
+
 }  // namespace
 
 namespace astarte::device::mqtt {
@@ -104,59 +133,21 @@ auto Mapping::try_from_json(const json& json) -> astarte_tl::expected<Mapping, E
 }
 
 auto Mapping::match_path(std::string_view path) const -> bool {
-  // copy the endpoint
-  std::string_view endpoint = endpoint_;
+  return match_endpoint(endpoint_, path);
+}
 
-  // check lengths and trailing slash
-  if (path.length() < 2 || path.back() == '/') {
+auto Mapping::match_object_path(std::string_view path) const -> bool {
+  // the common path of an object is the endpoint without its last segment
+  const std::string_view endpoint = endpoint_;
+  const auto last_slash = endpoint.rfind('/');
+  if (last_slash == std::string_view::npos || last_slash == 0) {
     return false;
   }
-  // check leading slash consistency
-  if (endpoint.empty() || path.front() != endpoint.front()) {
-    return false;
-  }
-
-  // remove the leading slash to prepare for segment iteration
-  // (we know both start with same char, usually '/')
-  endpoint.remove_prefix(1);
-  path.remove_prefix(1);
-
-  while (!endpoint.empty() && !path.empty()) {
-    const std::string_view endpoint_seg = pop_next_segment(endpoint);
-    const std::string_view path_seg = pop_next_segment(path);
-
-    if (!is_segment_match(endpoint_seg, path_seg)) {
-      return false;
-    }
-  }
-
-  // both strings must be fully consumed. If one has leftovers there is a length mismatch.
-  return endpoint.empty() && path.empty();
+  return match_endpoint(endpoint.substr(0, last_slash), path);
 }
 
 auto Mapping::check_data_type(const Data& data) const -> astarte_tl::expected<void, Error> {
-  if (type_ != data.get_type()) {
-    spdlog::error("Astarte data type and mapping type do not match");
-    return astarte_tl::unexpected(
-        InterfaceValidationError("Astarte data type and mapping type do not match"));
-  }
-
-  if ((type_ == Type::kDouble) && (!std::isfinite(data.into<double>()))) {
-    spdlog::error("Astarte data double is not a number");
-    return astarte_tl::unexpected(InterfaceValidationError("Astarte data double is not a number"));
-  }
-
-  if (type_ == Type::kDoubleArray) {
-    for (const double value : data.into<std::vector<double>>()) {
-      if (!std::isfinite(value)) {
-        spdlog::error("Astarte data double is not a number");
-        return astarte_tl::unexpected(
-            InterfaceValidationError("Astarte data double is not a number"));
-      }
-    }
-  }
-
-  return {};
+  return std::visit([this](const auto& value) { return check_value(value); }, data.get_raw_data());
 }
 
 }  // namespace astarte::device::mqtt
@@ -30,6 +30,7 @@
 #include "astarte_device_sdk/formatter.hpp"
 #include "astarte_device_sdk/mqtt/errors.hpp"
 #include "mqtt/crypto.hpp"
+#include "mqtt/json_backend.hpp"
 
 using json = nlohmann::json;
 
@@ -131,43 +132,6 @@ auto is_successful(std::int64_t status_code) -> bool {
          HttpStatusCategory::Success;
 }
 
-template <typename T>
-struct json_type_traits;
-template <>
-struct json_type_traits<std::string> {
-  static auto check(const json& input) -> bool { return input.is_string(); }
-  static auto name() -> const char* { return "string"; }
-};
-template <>
-struct json_type_traits<bool> {
-  static auto check(const json& input) -> bool { return input.is_boolean(); }
-  static auto name() -> const char* { return "boolean"; }
-};
-
-template <typename T>
-auto parse_json(const std::string& text, const std::string& path)
-    -> astarte_tl::expected<T, Error> {
-  json text_json = json::parse(text, nullptr, false);
-  if (text_json.is_discarded()) {
-    return astarte_tl::unexpected(
-        JsonParsingError(astarte_fmt::format("Invalid JSON. Body: {}", text)));
-  }
-
-  const json::json_pointer path_json(path);
-  if (!text_json.contains(path_json)) {
-    return astarte_tl::unexpected(JsonParsingError{
-        astarte_fmt::format("Path {} not found. Body: {}", path_json.to_string(), text)});
-  }
-
-  const auto& value = text_json[path_json];
-  if (!json_type_traits<T>::check(value)) {
-    return astarte_tl::unexpected(JsonParsingError{
-        astarte_fmt::format("Value at {} is not a {}. Body: {}", path_json.to_string(),
-                            json_type_traits<T>::name(), text)});
-  }
-  return value;
-}
-
 }  // namespace
 
 auto PairingApi::create(std::string_view realm, std::string_view device_id,
@@ -223,7 +187,7 @@ auto PairingApi::register_device(std::string_view pairing_token,
                                                                     res.status_code, res.text)))));
   }
 
-  return parse_json<std::string>(res.text, "/data/credentials_secret");
+  return json_backend::value_at<std::string>(res.text, "/data/credentials_secret");
 }
 
 auto PairingApi::get_broker_url(std::string_view credential_secret, int timeout_ms) const
@@ -250,7 +214,8 @@ auto PairingApi::get_broker_url(std::string_view credential_secret, int timeout_
         HttpError(astarte_fmt::format("Status code: {}, Reason: {}", res.status_code, res.text)))));
   }
 
-  return parse_json<std::string>(res.text, "/data/protocols/astarte_mqtt_v1/broker_url");
+  return json_backend::value_at<std::string>(res.text,
+                                             "/data/protocols/astarte_mqtt_v1/broker_url");
 }
 
 auto PairingApi::get_device_key_and_certificate(std::string_view credential_secret,
@@ -305,7 +270,7 @@ auto PairingApi::get_device_key_and_certificate(std::string_view credential_secr
         HttpError(astarte_fmt::format("Status code: {}, Reason: {}", res.status_code, res.text)))));
   }
 
-  return parse_json<std::string>(res.text, "/data/client_crt")
+  return json_backend::value_at<std::string>(res.text, "/data/client_crt")
       .transform_error([](const Error& err) -> Error {
         return MqttError(PairingApiError("Failed to retrieve Astarte device certificate.", err));
       })
@@ -343,9 +308,11 @@ auto PairingApi::device_cert_valid(std::string_view certificate, std::string_vie
         HttpError(astarte_fmt::format("Status code: {}, Reason: {}", res.status_code, res.text)))));
   }
 
-  return parse_json<bool>(res.text, "/data/valid").transform_error([](const Error& err) -> Error {
-    return MqttError(PairingApiError("Failed to check Astarte device certificate validity.", err));
-  });
+  return json_backend::value_at<bool>(res.text, "/data/valid")
+      .transform_error([](const Error& err) -> Error {
+        return MqttError(
+            PairingApiError("Failed to check Astarte device certificate validity.", err));
+      });
 }
 
 auto create_random_device_id() -> std::string {
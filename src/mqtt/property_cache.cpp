@@ -0,0 +1,424 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/property_cache.hpp"
+
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+
+namespace astarte::device::mqtt {
+
+namespace {
+
+using json = nlohmann::json;
+
+/// Version of the file format, files with a different version are discarded.
+constexpr int k_format_version = 2;
+/// Minimum number of journal records before the snapshot is rewritten.
+constexpr size_t k_min_journal_records = 64;
+/// Size of the length prefix of a BSON document.
+constexpr size_t k_bson_length_size = 4;
+/// Upper bound to the decompressed size of the list of set properties.
+constexpr uint32_t k_max_list_size = 64U * 1024U * 1024U;
+
+auto make_key(std::string_view interface_name, std::string_view path) -> std::string {
+  std::string key;
+  key.reserve(interface_name.size() + path.size());
+  key.append(interface_name).append(path);
+  return key;
+}
+
+// The list is a four bytes big endian length followed by the zlib compressed properties, separated
+// by semicolons.
+auto decompress_list(std::string_view payload) -> astarte_tl::expected<std::string, Error> {
+  if (payload.size() < 4) {
+    return astarte_tl::unexpected(
+        InvalidInputError("properties list shorter than its length prefix"));
+  }
+  uint32_t length = 0;
+  for (size_t i = 0; i < 4; i++) {
+    length = (length << 8U) | static_cast<uint8_t>(payload[i]);
+  }
+  if (length == 0) {
+    return std::string();
+  }
+  if (length > k_max_list_size) {
+    return astarte_tl::unexpected(InvalidInputError(
+        astarte_fmt::format("properties list of {} bytes exceeds {} bytes", length,
+                            k_max_list_size)));
+  }
+
+  std::string list(length, '\0');
+  auto list_size = static_cast<uLongf>(length);
+  const auto res = uncompress(reinterpret_cast<Bytef*>(list.data()), &list_size,
+                              reinterpret_cast<const Bytef*>(payload.data() + 4),
+                              static_cast<uLong>(payload.size() - 4));
+  if (res != Z_OK || list_size != length) {
+    return astarte_tl::unexpected(InvalidInputError(
+        astarte_fmt::format("failed to decompress the properties list, zlib error {}", res)));
+  }
+  return list;
+}
+
+// Writes bytes to a file, flushing them to the disk before closing it
+auto write_synced(const std::filesystem::path& path, const char* mode,
+                  const std::vector<uint8_t>& bytes) -> astarte_tl::expected<void, Error> {
+  std::FILE* file = std::fopen(path.string().c_str(), mode);
+  if (file == nullptr) {
+    return astarte_tl::unexpected(FileOpenError(path.string()));
+  }
+  bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+                 std::fflush(file) == 0;
+#if defined(_WIN32)
+  written = written && _commit(_fileno(file)) == 0;
+#else
+  written = written && fsync(fileno(file)) == 0;
+#endif
+  const int error = errno;
+  if (std::fclose(file) != 0 || !written) {
+    return astarte_tl::unexpected(InternalError(
+        astarte_fmt::format("failed to write {}, {}", path.string(),
+                            std::error_code(error, std::generic_category()).message())));
+  }
+  return {};
+}
+
+auto split_list(std::string_view list) -> std::set<std::string_view> {
+  std::set<std::string_view> entries;
+  while (!list.empty()) {
+    const auto end = list.find(';');
+    auto entry = list.substr(0, end);
+    if (!entry.empty()) {
+      entries.insert(entry);
+    }
+    if (end == std::string_view::npos) {
+      break;
+    }
+    list.remove_prefix(end + 1);
+  }
+  return entries;
+}
+
+}  // namespace
+
+PropertyCache::PropertyCache(std::filesystem::path file_path) : file_path_(std::move(file_path)) {}
+
+auto PropertyCache::load(std::filesystem::path file_path) -> PropertyCache {
+  PropertyCache cache(std::move(file_path));
+
+  std::ifstream file(cache.file_path_, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    spdlog::debug("No server properties cache at {}", cache.file_path_.string());
+    return cache;
+  }
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+
+  const json doc = json::from_bson(data, true, false);
+  if (doc.is_discarded() || !doc.is_object() || doc.value("version", 0) != k_format_version ||
+      !doc.contains("introspection") || !doc["introspection"].is_string() ||
+      !doc.contains("consistent") || !doc["consistent"].is_boolean() ||
+      !doc.contains("generation") || !doc["generation"].is_number_integer() ||
+      !doc.contains("properties") || !doc["properties"].is_object()) {
+    spdlog::warn("Discarding the invalid server properties cache at {}",
+                 cache.file_path_.string());
+    return cache;
+  }
+
+  for (const auto& [key, value] : doc["properties"].items()) {
+    if (!value.is_binary()) {
+      spdlog::warn("Discarding the invalid server properties cache at {}",
+                   cache.file_path_.string());
+      cache.properties_.clear();
+      return cache;
+    }
+    const auto& bytes = value.get_binary();
+    cache.properties_.emplace(key, std::string(bytes.begin(), bytes.end()));
+  }
+  cache.introspection_ = doc["introspection"].get<std::string>();
+  cache.consistent_ = doc["consistent"].get<bool>();
+  cache.generation_ = doc["generation"].get<int64_t>();
+  cache.replay_journal();
+  spdlog::debug("Loaded {} server properties from the cache", cache.properties_.size());
+  return cache;
+}
+
+auto PropertyCache::is_consistent(std::string_view introspection) const -> bool {
+  return consistent_ && introspection_ == introspection;
+}
+
+auto PropertyCache::begin_sync(std::string_view introspection)
+    -> astarte_tl::expected<void, Error> {
+  introspection_ = introspection;
+  consistent_ = false;
+  syncing_ = true;
+  awaiting_list_ = true;
+  received_.clear();
+  pending_.clear();
+  // Persist the interrupted synchronization, the values on disk must not be trusted until it ends
+  return persist();
+}
+
+auto PropertyCache::store(std::string_view interface_name, std::string_view path,
+                          std::string_view payload) -> astarte_tl::expected<void, Error> {
+  auto key = make_key(interface_name, path);
+  if (payload.empty()) {
+    auto found = properties_.find(key);
+    if (found != properties_.end()) {
+      properties_.erase(found);
+    }
+  } else {
+    properties_.insert_or_assign(key, std::string(payload));
+  }
+
+  if (consistent_) {
+    return persist_update(key, payload);
+  }
+  if (syncing_) {
+    if (awaiting_list_) {
+      received_.insert(std::move(key));
+      return {};
+    }
+    pending_.erase(key);
+    return complete_sync();
+  }
+  return {};
+}
+
+auto PropertyCache::purge(std::string_view payload) -> astarte_tl::expected<void, Error> {
+  auto list = decompress_list(payload);
+  if (!list) {
+    return astarte_tl::unexpected(list.error());
+  }
+  const auto listed = split_list(list.value());
+
+  for (auto it = properties_.begin(); it != properties_.end();) {
+    if (listed.contains(it->first)) {
+      ++it;
+    } else {
+      it = properties_.erase(it);
+    }
+  }
+
+  if (syncing_ && awaiting_list_) {
+    awaiting_list_ = false;
+    for (const auto& entry : listed) {
+      if (!received_.contains(entry)) {
+        pending_.emplace(entry);
+      }
+    }
+    received_.clear();
+    return complete_sync();
+  }
+  if (consistent_) {
+    return persist();
+  }
+  return {};
+}
+
+auto PropertyCache::get(std::string_view interface_name, std::string_view path) const
+    -> std::optional<std::string> {
+  auto found = properties_.find(make_key(interface_name, path));
+  if (found == properties_.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+void PropertyCache::for_each(
+    std::optional<std::string_view> interface_name,
+    const std::function<void(std::string_view, std::string_view, std::string_view)>& visitor)
+    const {
+  // the paths start with a slash, that never appears in an interface name
+  std::string prefix;
+  if (interface_name) {
+    prefix = make_key(interface_name.value(), "/");
+  }
+  for (auto it = properties_.lower_bound(prefix);
+       it != properties_.end() && it->first.starts_with(prefix); ++it) {
+    const std::string_view key = it->first;
+    const auto separator = key.find('/');
+    if (separator == std::string_view::npos) {
+      continue;
+    }
+    visitor(key.substr(0, separator), key.substr(separator), it->second);
+  }
+}
+
+auto PropertyCache::complete_sync() -> astarte_tl::expected<void, Error> {
+  if (!pending_.empty()) {
+    return {};
+  }
+  syncing_ = false;
+  consistent_ = true;
+  spdlog::debug("Server properties cache synchronized, {} properties", properties_.size());
+  return persist();
+}
+
+auto PropertyCache::persist() -> astarte_tl::expected<void, Error> {
+  auto res = save();
+  if (!res) {
+    // The file could claim a consistency the cache no longer has, never leave it behind
+    consistent_ = false;
+    std::error_code err;
+    std::filesystem::remove(file_path_, err);
+    std::filesystem::remove(journal_path(), err);
+    spdlog::warn("Failed to persist the server properties cache: {}", res.error());
+  }
+  return res;
+}
+
+auto PropertyCache::persist_update(std::string_view key, std::string_view payload)
+    -> astarte_tl::expected<void, Error> {
+  // rewriting the snapshot costs as much as the journal records written since the last one
+  if (journal_records_ >= std::max(properties_.size(), k_min_journal_records)) {
+    return persist();
+  }
+
+  json record = {{"k", key}};
+  if (!payload.empty()) {
+    record["v"] = json::binary(std::vector<uint8_t>(payload.begin(), payload.end()));
+  }
+  std::vector<uint8_t> bytes;
+  if (journal_records_ == 0) {
+    // a new journal starts with the generation of the snapshot it extends
+    bytes = json::to_bson(json{{"generation", generation_}});
+  }
+  const auto record_bytes = json::to_bson(record);
+  bytes.insert(bytes.end(), record_bytes.begin(), record_bytes.end());
+
+  auto res = write_synced(journal_path(), journal_records_ == 0 ? "wb" : "ab", bytes);
+  if (!res) {
+    consistent_ = false;
+    std::error_code err;
+    std::filesystem::remove(file_path_, err);
+    std::filesystem::remove(journal_path(), err);
+    spdlog::warn("Failed to persist the server properties cache: {}", res.error());
+    return res;
+  }
+  journal_records_++;
+  return {};
+}
+
+auto PropertyCache::save() -> astarte_tl::expected<void, Error> {
+  json properties = json::object();
+  for (const auto& [key, payload] : properties_) {
+    properties[key] = json::binary(std::vector<uint8_t>(payload.begin(), payload.end()));
+  }
+  const json doc = {{"version", k_format_version},
+                    {"introspection", introspection_},
+                    {"consistent", consistent_},
+                    {"generation", generation_ + 1},
+                    {"properties", std::move(properties)}};
+
+  // Write a temporary file and rename it, so that a crash never leaves a truncated cache
+  auto tmp_path = file_path_;
+  tmp_path += ".tmp";
+  auto res = write_synced(tmp_path, "wb", json::to_bson(doc));
+  if (!res) {
+    return res;
+  }
+  std::error_code err;
+  std::filesystem::rename(tmp_path, file_path_, err);
+  if (err) {
+    return astarte_tl::unexpected(InternalError(astarte_fmt::format(
+        "failed to replace {}, {}", file_path_.string(), err.message())));
+  }
+
+  // the journal of the previous generation no longer applies, even if its removal fails
+  generation_++;
+  journal_records_ = 0;
+  std::filesystem::remove(journal_path(), err);
+  return {};
+}
+
+void PropertyCache::replay_journal() {
+  std::ifstream file(journal_path(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return;
+  }
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+
+  size_t offset = 0;
+  size_t records = 0;
+  while (data.size() - offset >= k_bson_length_size) {
+    uint32_t length = 0;
+    for (size_t i = k_bson_length_size; i > 0; i--) {
+      length = (length << 8U) | data[offset + i - 1];
+    }
+    if (length <= k_bson_length_size || length > data.size() - offset) {
+      break;
+    }
+    const auto begin = data.begin() + static_cast<std::ptrdiff_t>(offset);
+    const json record = json::from_bson(begin, begin + length, true, false);
+    if (record.is_discarded() || !record.is_object()) {
+      break;
+    }
+    if (records == 0) {
+      // a journal of another generation extends a snapshot that has been replaced
+      if (!record.contains("generation") || record["generation"] != generation_) {
+        spdlog::debug("Ignoring a stale server properties journal");
+        return;
+      }
+    } else {
+      if (!record.contains("k") || !record["k"].is_string()) {
+        break;
+      }
+      auto key = record["k"].get<std::string>();
+      if (record.contains("v") && record["v"].is_binary()) {
+        const auto& bytes = record["v"].get_binary();
+        properties_.insert_or_assign(std::move(key), std::string(bytes.begin(), bytes.end()));
+      } else {
+        properties_.erase(key);
+      }
+    }
+    offset += length;
+    records++;
+  }
+  journal_records_ = records > 0 ? records - 1 : 0;
+
+  if (offset != data.size()) {
+    // an interrupted append leaves a partial record, rewrite the snapshot to drop it
+    spdlog::warn("Dropping the truncated server properties journal at {}",
+                 journal_path().string());
+    std::ignore = persist();
+  }
+}
+
+auto PropertyCache::journal_path() const -> std::filesystem::path {
+  auto path = file_path_;
+  path += ".journal";
+  return path;
+}
+
+}  // namespace astarte::device::mqtt
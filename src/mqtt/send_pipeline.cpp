@@ -0,0 +1,190 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/send_pipeline.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+#include "thread_setup.hpp"
+#include "tracing_span.hpp"
+
+namespace astarte::device::mqtt {
+
+SendPipeline::SendPipeline(uint32_t workers, size_t capacity, ThreadHook hook,
+                           std::chrono::microseconds max_linger, size_t batch_bytes)
+    : capacity_(std::max<size_t>(capacity, 1)),
+      hook_(std::move(hook)),
+      max_linger_(std::max(max_linger, std::chrono::microseconds(0))),
+      batch_bytes_(std::max<size_t>(batch_bytes, 1)) {
+  workers_.reserve(std::max<uint32_t>(workers, 1));
+  for (uint32_t i = 0; i < std::max<uint32_t>(workers, 1); ++i) {
+    auto worker = std::make_unique<Worker>();
+    Worker& ref = *worker;
+    worker->thread = std::jthread([this, &ref](const std::stop_token& token) { run(ref, token); });
+    workers_.push_back(std::move(worker));
+  }
+}
+
+SendPipeline::~SendPipeline() {
+  // stop all the workers before joining them, so that they drain their jobs concurrently
+  for (const auto& worker : workers_) {
+    worker->thread.request_stop();
+  }
+  workers_.clear();
+}
+
+auto SendPipeline::submit(std::string_view key, Job job) -> astarte_tl::expected<void, Error> {
+  if (pending_.fetch_add(1) >= capacity_) {
+    pending_.fetch_sub(1);
+    return astarte_tl::unexpected(OperationRefusedError(astarte_fmt::format(
+        "the send pipeline is full, {} sends are waiting to be published", capacity_)));
+  }
+
+  Worker& worker = *workers_[std::hash<std::string_view>{}(key) % workers_.size()];
+  {
+    const std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.jobs.push_back(std::move(job));
+  }
+  // the flushing threads wait on the same condition variable
+  worker.cv.notify_all();
+  return {};
+}
+
+void SendPipeline::flush() {
+  for (const auto& worker : workers_) {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    worker->cv.wait(lock, [&worker]() { return worker->jobs.empty() && !worker->busy; });
+  }
+}
+
+auto SendPipeline::flush_for(std::chrono::milliseconds timeout) -> bool {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (const auto& worker : workers_) {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    if (!worker->cv.wait_until(lock, deadline,
+                               [&worker]() { return worker->jobs.empty() && !worker->busy; })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto SendPipeline::pending() const -> size_t { return pending_.load(); }
+
+auto SendPipeline::linger() const -> std::chrono::microseconds {
+  int64_t longest = 0;
+  for (const auto& worker : workers_) {
+    longest = std::max(longest, worker->linger.load(std::memory_order_relaxed));
+  }
+  return std::chrono::microseconds(longest);
+}
+
+void SendPipeline::run(Worker& worker, const std::stop_token& token) {
+  setup_thread(ThreadRole::kMqttSendWorker, hook_);
+  // wake up the worker as soon as a stop is requested
+  const std::stop_callback wake_up(token, [&worker]() {
+    const std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.cv.notify_all();
+  });
+
+  std::unique_lock<std::mutex> lock(worker.mutex);
+  while (true) {
+    worker.cv.wait(lock, [&]() { return !worker.jobs.empty() || token.stop_requested(); });
+    // the jobs still queued when the stop is requested are run before exiting
+    if (worker.jobs.empty()) {
+      break;
+    }
+    worker.busy = true;
+    const size_t jobs = run_batch(worker, lock, token);
+    worker.busy = false;
+    pending_.fetch_sub(jobs);
+    worker.cv.notify_all();
+    adapt_linger(worker, jobs);
+  }
+}
+
+auto SendPipeline::run_batch(Worker& worker, std::unique_lock<std::mutex>& lock,
+                             const std::stop_token& token) -> size_t {
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(worker.linger.load(std::memory_order_relaxed));
+  std::vector<std::function<void()>> waits;
+  size_t bytes = 0;
+  size_t jobs = 0;
+  while (true) {
+    while (!worker.jobs.empty() && bytes < batch_bytes_) {
+      Job job = std::move(worker.jobs.front());
+      worker.jobs.pop_front();
+      jobs++;
+      lock.unlock();
+      try {
+        InFlight started = job();
+        bytes += started.bytes;
+        if (started.wait) {
+          waits.push_back(std::move(started.wait));
+        }
+      } catch (const std::exception& e) {
+        spdlog::error("A pipelined send failed: {}", e.what());
+      }
+      lock.lock();
+    }
+    if (bytes >= batch_bytes_ || token.stop_requested()) {
+      break;
+    }
+    // linger for further jobs until the deadline, the stop ends the linger early
+    const bool woken = worker.cv.wait_until(
+        lock, deadline, [&]() { return !worker.jobs.empty() || token.stop_requested(); });
+    if (!woken || worker.jobs.empty()) {
+      break;
+    }
+  }
+
+  lock.unlock();
+  {
+    ASTARTE_TRACE_SPAN("mqtt", "batch_wait");
+    for (auto& wait : waits) {
+      try {
+        wait();
+      } catch (const std::exception& e) {
+        spdlog::error("A pipelined send failed: {}", e.what());
+      }
+    }
+  }
+  lock.lock();
+  return jobs;
+}
+
+void SendPipeline::adapt_linger(Worker& worker, size_t jobs) const {
+  if (max_linger_.count() == 0) {
+    return;
+  }
+  // the smallest non zero linger time, reached in a few doublings and dropped when halved
+  const int64_t step = std::max<int64_t>(max_linger_.count() / 8, 1);
+  const int64_t current = worker.linger.load(std::memory_order_relaxed);
+  int64_t next = 0;
+  if (jobs > 1) {
+    // sends are arriving faster than they are delivered, wait longer to batch more of them
+    next = std::min(max_linger_.count(), std::max(current * 2, step));
+  } else if (current / 2 >= step) {
+    next = current / 2;
+  }
+  worker.linger.store(next, std::memory_order_relaxed);
+}
+
+}  // namespace astarte::device::mqtt
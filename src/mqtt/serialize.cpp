@@ -4,67 +4,28 @@
 
 #include "mqtt/serialize.hpp"
 
-#include <algorithm>
+#include <spdlog/spdlog.h>
+
 #include <chrono>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/errors.hpp"
 #include "astarte_device_sdk/formatter.hpp"
 #include "astarte_device_sdk/object.hpp"
+#include "tracing_span.hpp"
 
 namespace astarte::device::mqtt::bson {
 
 using json = nlohmann::json;
 
-constexpr uint8_t BSON_TYPE_EOO = 0x00;
-
-void serialize_astarte_individual(json& bson, const std::string& key, const Data& data,
-                                  const std::chrono::system_clock::time_point* timestamp) {
-  std::visit(
-      [&](auto&& arg) {
-        using T = std::decay_t<decltype(arg)>;
-
-        // handle Binary Blob
-        if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
-          bson.emplace(key, json::binary(arg, BSON_TYPE_EOO));
-        }
-        // handle DateTime (std::chrono::system_clock::time_point)
-        else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
-          // Convert to milliseconds
-          auto millis =
-              std::chrono::duration_cast<std::chrono::milliseconds>(arg.time_since_epoch()).count();
-
-          bson.emplace(key, millis);
-        }
-        // handle Array of Binaries
-        else if constexpr (std::is_same_v<T, std::vector<std::vector<uint8_t>>>) {
-          std::vector<json> binary_array;
-          binary_array.reserve(arg.size());
-          std::transform(arg.begin(), arg.end(), std::back_inserter(binary_array),
-                         [](const auto& bin) { return json::binary(bin, BSON_TYPE_EOO); });
-
-          bson.emplace(key, binary_array);
-        }
-        // handle Array of DateTimes
-        else if constexpr (std::is_same_v<T, std::vector<std::chrono::system_clock::time_point>>) {
-          std::vector<int64_t> dates;
-          dates.reserve(arg.size());
-          std::transform(arg.begin(), arg.end(), std::back_inserter(dates), [](const auto& time) {
-            return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch())
-                .count();
-          });
-
-          bson.emplace(key, dates);
-        }
-        // default handler (int, double, string, bool, and the respective vectors)
-        else {
-          bson.emplace(key, arg);
-        }
-      },
-      data.get_raw_data());
-
+void serialize_timestamp(json& bson, const std::chrono::system_clock::time_point* timestamp) {
   if (timestamp != nullptr) {
     bson.emplace(
         "t", std::chrono::duration_cast<std::chrono::milliseconds>(timestamp->time_since_epoch())
@@ -72,6 +33,13 @@ void serialize_astarte_individual(json& bson, const std::string& key, const Data
   }
 }
 
+void serialize_astarte_individual(json& bson, const std::string& key, const Data& data,
+                                  const std::chrono::system_clock::time_point* timestamp) {
+  std::visit([&](const auto& value) { serialize_astarte_value(bson, key, value); },
+             data.get_raw_data());
+  serialize_timestamp(bson, timestamp);
+}
+
 void serialize_astarte_object(json& bson, const DatastreamObject& object,
                               const std::chrono::system_clock::time_point* timestamp) {
   json inner_bson;
@@ -79,13 +47,33 @@ void serialize_astarte_object(json& bson, const DatastreamObject& object,
     // we insert the timestamp only in the outer bson
     serialize_astarte_individual(inner_bson, endpoint_path, data, nullptr);
   }
-  bson.emplace("v", inner_bson);
+  bson.emplace("v", std::move(inner_bson));
+  serialize_timestamp(bson, timestamp);
+}
 
-  if (timestamp != nullptr) {
-    bson.emplace(
-        "t", std::chrono::duration_cast<std::chrono::milliseconds>(timestamp->time_since_epoch())
-                 .count());
+void trace_payload(std::string_view kind, const json& bson) {
+  if (spdlog::should_log(spdlog::level::trace)) {
+    spdlog::trace("dump {}: {}", kind, bson.dump());
   }
 }
 
+auto object_to_bytes(const DatastreamObject& object,
+                     const std::chrono::system_clock::time_point* timestamp)
+    -> astarte_tl::expected<std::vector<uint8_t>, Error> {
+  tracing::ScopedSpan serialize_span("mqtt", "serialize_bson");
+  json bson;
+  serialize_astarte_object(bson, object, timestamp);
+  serialize_span.end();
+
+  // check that the generated bson is not 0 size
+  if (bson.empty()) {
+    return astarte_tl::unexpected(
+        DataSerializationError("Failed to serialize object data to BSON"));
+  }
+  trace_payload("object", bson);
+
+  ASTARTE_TRACE_SPAN("mqtt", "to_bson");
+  return json::to_bson(bson);
+}
+
 }  // namespace astarte::device::mqtt::bson
@@ -0,0 +1,124 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mqtt/server_properties.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+#include "mqtt/deserialize.hpp"
+#include "mqtt/interface.hpp"
+#include "mqtt/introspection.hpp"
+#include "mqtt/property_cache.hpp"
+
+namespace astarte::device::mqtt {
+
+namespace {
+
+auto decode(const Interface& interface, std::string_view path, std::string_view payload)
+    -> astarte_tl::expected<Data, Error> {
+  const auto* mapping = interface.find_mapping(path);
+  if (mapping == nullptr) {
+    return astarte_tl::unexpected(InvalidInputError(astarte_fmt::format(
+        "no mapping of the interface {} for path {}", interface.interface_name(), path)));
+  }
+  const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(payload.data()),
+                                       payload.size());
+  return bson::deserialize_astarte_individual(bytes, mapping->type())
+      .transform([](bson::DeserializedIndividual&& individual) {
+        return std::move(individual.data);
+      });
+}
+
+}  // namespace
+
+ServerProperties::ServerProperties(PropertyCache cache) : cache_(std::move(cache)) {}
+
+auto ServerProperties::is_consistent(std::string_view introspection) const -> bool {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.is_consistent(introspection);
+}
+
+auto ServerProperties::begin_sync(std::string_view introspection)
+    -> astarte_tl::expected<void, Error> {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.begin_sync(introspection);
+}
+
+auto ServerProperties::store(std::string_view interface_name, std::string_view path,
+                             std::string_view payload) -> astarte_tl::expected<void, Error> {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.store(interface_name, path, payload);
+}
+
+auto ServerProperties::purge(std::string_view payload) -> astarte_tl::expected<void, Error> {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.purge(payload);
+}
+
+auto ServerProperties::get(const Introspection& introspection, std::string_view interface_name,
+                           std::string_view path) const
+    -> astarte_tl::expected<PropertyIndividual, Error> {
+  auto interface = introspection.get(interface_name);
+  if (!interface) {
+    return astarte_tl::unexpected(interface.error());
+  }
+
+  std::optional<std::string> payload;
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    payload = cache_.get(interface_name, path);
+  }
+  if (!payload) {
+    return PropertyIndividual(std::nullopt);
+  }
+  return decode(*interface.value(), path, payload.value()).transform([](Data&& data) {
+    return PropertyIndividual(std::optional<Data>(std::move(data)));
+  });
+}
+
+auto ServerProperties::list(const Introspection& introspection,
+                            std::optional<std::string_view> interface_name) const
+    -> std::list<StoredProperty> {
+  std::list<StoredProperty> properties;
+  // the properties are ordered by interface, resolve each interface once
+  std::shared_ptr<const Interface> interface;
+  std::shared_ptr<const std::string> shared_name;
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  cache_.for_each(interface_name, [&](std::string_view name, std::string_view path,
+                                      std::string_view payload) {
+    if (!shared_name || *shared_name != name) {
+      interface = introspection.find(name);
+      shared_name = std::make_shared<const std::string>(name);
+    }
+    if (!interface || interface->ownership() != Ownership::kServer) {
+      return;
+    }
+    auto data = decode(*interface, path, payload);
+    if (!data) {
+      spdlog::warn("Skipping the stored property {}{}: {}", name, path, data.error());
+      return;
+    }
+    properties.emplace_back(shared_name, path, static_cast<int32_t>(interface->version_major()),
+                            Ownership::kServer, std::move(data.value()));
+  });
+  return properties;
+}
+
+}  // namespace astarte::device::mqtt
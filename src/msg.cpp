@@ -4,7 +4,10 @@
 
 #include "astarte_device_sdk/msg.hpp"
 
+#include <cassert>
+#include <memory>
 #include <string>
+#include <utility>
 #include <variant>
 
 #include "astarte_device_sdk/individual.hpp"
@@ -41,4 +44,50 @@ auto Message::operator!=(const Message& other) const -> bool {
          this->data_ != other.get_raw_data();
 }
 
+SharedMessage::SharedMessage(Message message)
+    : message_(std::make_shared<Message>(std::move(message))) {}
+
+auto SharedMessage::has_value() const -> bool { return message_ != nullptr; }
+
+SharedMessage::operator bool() const { return has_value(); }
+
+auto SharedMessage::get() const -> const Message& {
+  assert(message_ && "SharedMessage accessed after being moved from");
+  return *message_;
+}
+
+auto SharedMessage::operator*() const -> const Message& { return get(); }
+
+auto SharedMessage::operator->() const -> const Message* { return &get(); }
+
+auto SharedMessage::use_count() const -> long { return message_.use_count(); }
+
+auto SharedMessage::into_message() && -> Message {
+  assert(message_ && "SharedMessage converted after being moved from");
+  // no other handle exists, so no other thread can be reading the message
+  if (message_.use_count() == 1) {
+    Message message = std::move(*message_);
+    message_.reset();
+    return message;
+  }
+  Message message = *message_;
+  message_.reset();
+  return message;
+}
+
+auto SharedMessage::operator==(const SharedMessage& other) const -> bool {
+  if (message_ == other.message_) {
+    return true;
+  }
+  // an empty handle only equals another empty handle
+  if (!message_ || !other.message_) {
+    return false;
+  }
+  return *message_ == *other.message_;
+}
+
+auto SharedMessage::operator!=(const SharedMessage& other) const -> bool {
+  return !(*this == other);
+}
+
 }  // namespace astarte::device
@@ -5,7 +5,10 @@
 #include "astarte_device_sdk/object.hpp"
 
 #include <initializer_list>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include "astarte_device_sdk/data.hpp"
 
@@ -15,10 +18,24 @@ namespace astarte::device {
 DatastreamObject::DatastreamObject() = default;
 // Constructor with initializer list
 DatastreamObject::DatastreamObject(std::initializer_list<MapType::value_type> init) : data_(init) {}
-// Access element by key (modifiable)
-auto DatastreamObject::at(const std::string& key) -> Data& { return data_.at(key); }
+// Constructor reserving the room for a number of elements
+DatastreamObject::DatastreamObject(size_type capacity) { data_.reserve(capacity); }
+// Access element by key (modifiable), std::unordered_map::at has no transparent overload
+auto DatastreamObject::at(std::string_view key) -> Data& {
+  auto found = data_.find(key);
+  if (found == data_.end()) {
+    throw std::out_of_range("DatastreamObject::at");
+  }
+  return found->second;
+}
 // Access element by key (const)
-auto DatastreamObject::at(const std::string& key) const -> const Data& { return data_.at(key); }
+auto DatastreamObject::at(std::string_view key) const -> const Data& {
+  auto found = data_.find(key);
+  if (found == data_.end()) {
+    throw std::out_of_range("DatastreamObject::at");
+  }
+  return found->second;
+}
 // Begin iterator (modifiable)
 auto DatastreamObject::begin() -> iterator { return data_.begin(); }
 // Begin iterator (const)
@@ -31,20 +48,33 @@ auto DatastreamObject::end() const -> const_iterator { return data_.end(); }
 auto DatastreamObject::size() const -> size_type { return data_.size(); }
 // Check if map is empty
 auto DatastreamObject::empty() const -> bool { return data_.empty(); }
+// Reserve room for a number of elements
+void DatastreamObject::reserve(size_type count) { data_.reserve(count); }
 // Insert element into the map
-void DatastreamObject::insert(const std::string& key, const Data& data) {
-  data_.insert({key, data});
+void DatastreamObject::insert(std::string key, Data data) {
+  data_.try_emplace(std::move(key), std::move(data));
+}
+// Erase element by key, std::unordered_map::erase has no transparent overload
+auto DatastreamObject::erase(std::string_view key) -> size_type {
+  auto found = data_.find(key);
+  if (found == data_.end()) {
+    return 0;
+  }
+  data_.erase(found);
+  return 1;
 }
-// Erase element by key
-auto DatastreamObject::erase(const std::string& key) -> size_type { return data_.erase(key); }
 // Clear the map
 void DatastreamObject::clear() { data_.clear(); }
 // Find element by key (modifiable)
-auto DatastreamObject::find(const std::string& key) -> iterator { return data_.find(key); }
+auto DatastreamObject::find(std::string_view key) -> iterator { return data_.find(key); }
 // Find element by key (const)
-auto DatastreamObject::find(const std::string& key) const -> const_iterator {
+auto DatastreamObject::find(std::string_view key) const -> const_iterator {
   return data_.find(key);
 }
+// Check if the key is present
+auto DatastreamObject::contains(std::string_view key) const -> bool {
+  return data_.find(key) != data_.end();
+}
 
 auto DatastreamObject::get_raw_data() const -> const MapType& { return this->data_; }
 
@@ -5,6 +5,7 @@
 #include "astarte_device_sdk/stored_property.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -22,7 +23,18 @@ StoredProperty::StoredProperty(std::string_view interface_name, std::string_view
       ownership_(ownership),
       data_(std::move(data)) {}
 
-auto StoredProperty::get_interface_name() const -> const std::string& { return interface_name_; }
+StoredProperty::StoredProperty(std::shared_ptr<const std::string> interface_name,
+                               std::string_view path, int32_t version_major, Ownership ownership,
+                               Data data)
+    : shared_interface_name_(std::move(interface_name)),
+      path_(path),
+      version_major_(version_major),
+      ownership_(ownership),
+      data_(std::move(data)) {}
+
+auto StoredProperty::get_interface_name() const -> const std::string& {
+  return shared_interface_name_ ? *shared_interface_name_ : interface_name_;
+}
 
 auto StoredProperty::get_path() const -> const std::string& { return path_; }
 
@@ -33,7 +45,7 @@ auto StoredProperty::get_ownership() const -> const Ownership& { return ownershi
 auto StoredProperty::get_value() const -> const Data& { return data_; }
 
 auto StoredProperty::operator==(const StoredProperty& other) const -> bool {
-  return (interface_name_ == other.interface_name_) && (path_ == other.path_) &&
+  return (get_interface_name() == other.get_interface_name()) && (path_ == other.path_) &&
          (version_major_ == other.version_major_) && (ownership_ == other.ownership_) &&
          (data_ == other.data_);
 }
@@ -42,4 +54,27 @@ auto StoredProperty::operator!=(const StoredProperty& other) const -> bool {
   return !(*this == other);
 }
 
+StoredPropertyView::StoredPropertyView(std::string_view interface_name, std::string_view path,
+                                       int32_t version_major, Ownership ownership,
+                                       const Data& data)
+    : interface_name_(interface_name),
+      path_(path),
+      version_major_(version_major),
+      ownership_(ownership),
+      data_(&data) {}
+
+auto StoredPropertyView::get_interface_name() const -> std::string_view { return interface_name_; }
+
+auto StoredPropertyView::get_path() const -> std::string_view { return path_; }
+
+auto StoredPropertyView::get_version_major() const -> int32_t { return version_major_; }
+
+auto StoredPropertyView::get_ownership() const -> Ownership { return ownership_; }
+
+auto StoredPropertyView::get_value() const -> const Data& { return *data_; }
+
+auto StoredPropertyView::to_stored_property() const -> StoredProperty {
+  return StoredProperty(interface_name_, path_, version_major_, ownership_, *data_);
+}
+
 }  // namespace astarte::device
@@ -0,0 +1,170 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/thread_config.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "thread_setup.hpp"
+
+namespace astarte::device {
+
+namespace {
+
+#if defined(__linux__)
+// Linux thread names are limited to 16 bytes, including the terminator.
+constexpr size_t k_max_thread_name = 15;
+
+auto errno_error(std::string_view action, int err) -> Error {
+  auto msg = astarte_fmt::format("failed to {}: {}", action, std::strerror(err));
+  if (err == EPERM) {
+    return OperationRefusedError(msg);
+  }
+  if (err == EINVAL) {
+    return InvalidInputError(msg);
+  }
+  return InternalError(msg);
+}
+
+auto set_name(const std::string& name) -> astarte_tl::expected<void, Error> {
+  const std::string truncated = name.substr(0, k_max_thread_name);
+  const int err = pthread_setname_np(pthread_self(), truncated.c_str());
+  if (err != 0) {
+    return astarte_tl::unexpected(errno_error("set the thread name", err));
+  }
+  return {};
+}
+
+auto set_affinity(const std::vector<uint32_t>& cpus) -> astarte_tl::expected<void, Error> {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const uint32_t cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      return astarte_tl::unexpected(
+          InvalidInputError(astarte_fmt::format("CPU index out of range: {}", cpu)));
+    }
+    CPU_SET(cpu, &set);
+  }
+  const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (err != 0) {
+    return astarte_tl::unexpected(errno_error("set the thread CPU affinity", err));
+  }
+  return {};
+}
+
+auto to_native_policy(SchedulingPolicy policy) -> int {
+  switch (policy) {
+    case SchedulingPolicy::kBatch:
+      return SCHED_BATCH;
+    case SchedulingPolicy::kIdle:
+      return SCHED_IDLE;
+    case SchedulingPolicy::kFifo:
+      return SCHED_FIFO;
+    case SchedulingPolicy::kRoundRobin:
+      return SCHED_RR;
+    case SchedulingPolicy::kOther:
+    default:
+      return SCHED_OTHER;
+  }
+}
+
+auto set_scheduling(SchedulingPolicy policy, int32_t priority)
+    -> astarte_tl::expected<void, Error> {
+  sched_param param{};
+  param.sched_priority = priority;
+  const int err = pthread_setschedparam(pthread_self(), to_native_policy(policy), &param);
+  if (err != 0) {
+    return astarte_tl::unexpected(errno_error("set the thread scheduling policy", err));
+  }
+  return {};
+}
+
+auto set_nice(int32_t nice) -> astarte_tl::expected<void, Error> {
+  // On Linux the nice value is a per-thread attribute, addressed by the kernel thread ID
+  const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+  if (setpriority(PRIO_PROCESS, tid, nice) != 0) {
+    return astarte_tl::unexpected(errno_error("set the thread nice value", errno));
+  }
+  return {};
+}
+#endif
+
+}  // namespace
+
+auto thread_role_name(ThreadRole role) -> std::string_view {
+  switch (role) {
+    case ThreadRole::kGrpcConnection:
+      return "astarte-grpc";
+    case ThreadRole::kMqttCallback:
+      return "astarte-mqtt";
+    case ThreadRole::kFailoverMonitor:
+      return "astarte-failover";
+    case ThreadRole::kMqttSendWorker:
+      return "astarte-mqtt-tx";
+    default:
+      return "astarte";
+  }
+}
+
+auto ThreadConfig::apply() const -> astarte_tl::expected<void, Error> {
+#if defined(__linux__)
+  astarte_tl::expected<void, Error> res;
+  auto keep_first_error = [&res](astarte_tl::expected<void, Error> step) {
+    if (res && !step) {
+      res = std::move(step);
+    }
+  };
+  if (name_) {
+    keep_first_error(set_name(name_.value()));
+  }
+  if (!cpus_.empty()) {
+    keep_first_error(set_affinity(cpus_));
+  }
+  if (policy_) {
+    keep_first_error(set_scheduling(policy_.value(), priority_));
+  }
+  if (nice_) {
+    keep_first_error(set_nice(nice_.value()));
+  }
+  return res;
+#else
+  if (name_ || !cpus_.empty() || policy_ || nice_) {
+    return astarte_tl::unexpected(
+        OperationRefusedError("thread configuration is only supported on Linux"));
+  }
+  return {};
+#endif
+}
+
+void setup_thread(ThreadRole role, const ThreadHook& hook) {
+#if defined(__linux__)
+  auto res = ThreadConfig().name(std::string(thread_role_name(role))).apply();
+  if (!res) {
+    spdlog::debug("Failed to name the {} thread: {}", thread_role_name(role), res.error());
+  }
+#endif
+  if (hook) {
+    hook(role);
+  }
+}
+
+}  // namespace astarte::device
@@ -0,0 +1,197 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/tracing.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/formatter.hpp"
+#include "tracing_span.hpp"
+
+namespace astarte::device::tracing {
+
+namespace {
+
+// Spans recorded by a single thread. The owning thread is the only writer, each slot is guarded
+// by a sequence number so that readers can detect slots being overwritten.
+struct Ring {
+  struct Slot {
+    // Odd while the slot is being written, 2 * (index + 1) once the span at index is complete
+    std::atomic<uint64_t> seq{0};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<int64_t> duration_ns{0};
+  };
+
+  // Number of spans ever written
+  std::atomic<uint64_t> head{0};
+  // Spans before this index are discarded
+  std::atomic<uint64_t> tail{0};
+  uint64_t tid{0};
+  std::string thread_name;
+  std::array<Slot, k_ring_capacity> slots;
+};
+
+// Rings of all the threads that recorded at least a span, kept after the threads exit.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Ring>> rings;
+  uint64_t next_tid{1};
+};
+
+auto registry() -> Registry& {
+  static Registry instance;
+  return instance;
+}
+
+auto current_thread_name() -> std::string {
+#if defined(__linux__)
+  std::array<char, 16> name{};
+  if (pthread_getname_np(pthread_self(), name.data(), name.size()) == 0) {
+    return {name.data()};
+  }
+#endif
+  return {};
+}
+
+auto thread_ring() -> Ring& {
+  thread_local std::shared_ptr<Ring> ring = [] {
+    auto new_ring = std::make_shared<Ring>();
+    new_ring->thread_name = current_thread_name();
+    auto& reg = registry();
+    const std::lock_guard<std::mutex> lock(reg.mutex);
+    new_ring->tid = reg.next_tid++;
+    reg.rings.push_back(new_ring);
+    return new_ring;
+  }();
+  return *ring;
+}
+
+void write_json_string(std::ostream& out, std::string_view str) {
+  out << '"';
+  for (const char chr : str) {
+    if (chr == '"' || chr == '\\') {
+      out << '\\' << chr;
+    } else if (static_cast<unsigned char>(chr) < 0x20) {
+      out << astarte_fmt::format("\\u{:04x}", static_cast<int>(chr));
+    } else {
+      out << chr;
+    }
+  }
+  out << '"';
+}
+
+void write_ring(std::ostream& out, const Ring& ring, bool& first) {
+  auto separator = [&out, &first]() {
+    if (!first) {
+      out << ",\n";
+    }
+    first = false;
+  };
+
+  if (!ring.thread_name.empty()) {
+    separator();
+    out << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << ring.tid << R"(,"args":{"name":)";
+    write_json_string(out, ring.thread_name);
+    out << "}}";
+  }
+
+  const uint64_t head = ring.head.load(std::memory_order_acquire);
+  const uint64_t oldest = head > k_ring_capacity ? head - k_ring_capacity : 0;
+  for (uint64_t index = std::max(oldest, ring.tail.load(std::memory_order_acquire)); index < head;
+       index++) {
+    const auto& slot = ring.slots.at(index % k_ring_capacity);
+    const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    const char* category = slot.category.load(std::memory_order_relaxed);
+    const char* name = slot.name.load(std::memory_order_relaxed);
+    const int64_t start_ns = slot.start_ns.load(std::memory_order_relaxed);
+    const int64_t duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Skip the slots overwritten while being read
+    if (seq != 2 * (index + 1) || slot.seq.load(std::memory_order_relaxed) != seq) {
+      continue;
+    }
+
+    separator();
+    out << R"({"ph":"X","pid":1,"tid":)" << ring.tid << R"(,"cat":)";
+    write_json_string(out, category);
+    out << R"(,"name":)";
+    write_json_string(out, name);
+    out << astarte_fmt::format(R"(,"ts":{:.3f},"dur":{:.3f}}})",
+                               static_cast<double>(start_ns) / 1000.0,
+                               static_cast<double>(duration_ns) / 1000.0);
+  }
+}
+
+}  // namespace
+
+void record(const char* category, const char* name, int64_t start_ns, int64_t duration_ns) {
+  Ring& ring = thread_ring();
+  const uint64_t index = ring.head.load(std::memory_order_relaxed);
+  auto& slot = ring.slots.at(index % k_ring_capacity);
+  slot.seq.store((2 * index) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.category.store(category, std::memory_order_relaxed);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+  slot.seq.store(2 * (index + 1), std::memory_order_release);
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+void enable() { enabled_flag.store(true, std::memory_order_relaxed); }
+
+void disable() { enabled_flag.store(false, std::memory_order_relaxed); }
+
+auto is_enabled() -> bool { return enabled_flag.load(std::memory_order_relaxed); }
+
+void clear() {
+  auto& reg = registry();
+  const std::lock_guard<std::mutex> lock(reg.mutex);
+  for (const auto& ring : reg.rings) {
+    ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+  // Rings only referenced by the registry belong to threads that have exited
+  std::erase_if(reg.rings, [](const std::shared_ptr<Ring>& ring) { return ring.use_count() == 1; });
+}
+
+void write_chrome_trace(std::ostream& out) {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    auto& reg = registry();
+    const std::lock_guard<std::mutex> lock(reg.mutex);
+    rings = reg.rings;
+  }
+
+  out << R"({"displayTimeUnit":"ns","traceEvents":[)" << "\n";
+  bool first = true;
+  for (const auto& ring : rings) {
+    write_ring(out, *ring, first);
+  }
+  out << "\n]}\n";
+}
+
+auto chrome_trace() -> std::string {
+  std::ostringstream out;
+  write_chrome_trace(out);
+  return out.str();
+}
+
+}  // namespace astarte::device::tracing
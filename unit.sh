@@ -8,6 +8,7 @@
 fresh_mode=false
 transport=grpc
 system_transport=false
+simdjson=false
 jobs=$(nproc --all)
 build_dir="unit/build"
 
@@ -20,8 +21,9 @@ Build and run unit tests.
 
 Options:
   --fresh               Build from scratch (removes $build_dir).
-  --transport <TR>      Specify the transport to use (mqtt or grpc). Default: $transport.
+  --transport <TR>      Specify the transport to use (mqtt, grpc or both). Default: $transport.
   --system_transport    Use the system trasnport (gRPC or MQTT) instead of building it from scratch.
+  --simdjson            Parse interfaces and pairing responses with simdjson (mqtt only).
   -j, --jobs <N>        Specify the number of parallel jobs for make. Default: $jobs.
   -h, --help            Display this help message.
 EOF
@@ -37,12 +39,13 @@ while [[ "$#" -gt 0 ]]; do
         --fresh) fresh_mode=true; shift ;;
         --transport)
             transport="$2"
-            if [[ ! "$transport" =~ ^('mqtt'|'grpc')$ ]]; then
-                error_exit "Invalid transport '$transport'. Use mqtt or grpc."
+            if [[ ! "$transport" =~ ^('mqtt'|'grpc'|'both')$ ]]; then
+                error_exit "Invalid transport '$transport'. Use mqtt, grpc or both."
             fi
             shift 2
             ;;
         --system_transport) system_transport=true; shift ;;
+        --simdjson) simdjson=true; shift ;;
         -j|--jobs)
             jobs="$2"
             if ! [[ "$jobs" =~ ^[0-9]+$ && "$jobs" -gt 0 ]]; then
@@ -63,6 +66,7 @@ echo "  Build Directory: $build_dir"
 echo "  Fresh Mode: $fresh_mode"
 echo "  Transport: $transport"
 echo "  Use System transport: $system_transport"
+echo "  Use simdjson: $simdjson"
 echo ""
 
 # Clean build if --fresh is set
@@ -99,16 +103,25 @@ cmake_options_array+=("-DCMAKE_POSITION_INDEPENDENT_CODE=ON")
 
 if [[ "$transport" == "grpc" ]]; then
     cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=ON")
+    cmake_options_array+=("-DASTARTE_TRANSPORT_MQTT=OFF")
+elif [[ "$transport" == "both" ]]; then
+    cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=ON")
+    cmake_options_array+=("-DASTARTE_TRANSPORT_MQTT=ON")
 else
     cmake_options_array+=("-DASTARTE_TRANSPORT_GRPC=OFF")
 fi
 
-if [ "$system_transport" = true ] && [[ "$transport" == "grpc" ]]; then
+if [ "$system_transport" = true ] && [[ "$transport" != "mqtt" ]]; then
     cmake_options_array+=("-DASTARTE_USE_SYSTEM_GRPC=ON")
-elif [ "$system_transport" = true ] && [[ "$transport" == "mqtt" ]]; then
+fi
+if [ "$system_transport" = true ] && [[ "$transport" != "grpc" ]]; then
     cmake_options_array+=("-DASTARTE_USE_SYSTEM_MQTT=ON")
 fi
 
+if [ "$simdjson" = true ]; then
+    cmake_options_array+=("-DASTARTE_USE_SIMDJSON=ON")
+fi
+
 echo "CMake options: ${cmake_options_array[*]}"
 if ! cmake "${cmake_options_array[@]}" ..; then
     error_exit "CMake configuration failed."
@@ -0,0 +1,147 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "admission_controller.hpp"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "astarte_device_sdk/admission.hpp"
+#include "astarte_device_sdk/errors.hpp"
+
+using astarte::device::AdmissionController;
+using astarte::device::AdmissionOptions;
+using astarte::device::InterfaceAdmission;
+using astarte::device::OverloadError;
+using astarte::device::OverloadPolicy;
+
+namespace {
+
+// Admits sends until one is not admitted, keeping the tickets of the admitted ones
+void fill(AdmissionController& controller, const char* interface_name,
+          std::vector<AdmissionController::Ticket>& tickets) {
+  while (true) {
+    auto res = controller.admit(interface_name, 10);
+    if (!res || !res.value()) {
+      return;
+    }
+    tickets.push_back(std::move(res.value().value()));
+  }
+}
+
+}  // namespace
+
+TEST(AstarteTestAdmissionController, RejectsBeyondTheLimits) {
+  AdmissionController controller(AdmissionOptions{.max_pending_sends = 3});
+  std::vector<AdmissionController::Ticket> tickets;
+  fill(controller, "org.Sensors", tickets);
+
+  EXPECT_EQ(tickets.size(), 3U);
+  EXPECT_EQ(controller.pending_sends(), 3U);
+  EXPECT_EQ(controller.pending_bytes(), 30U);
+  auto refused = controller.admit("org.Sensors", 10);
+  ASSERT_FALSE(refused);
+  EXPECT_TRUE(std::holds_alternative<OverloadError>(refused.error()));
+
+  // the released tickets leave room for new sends
+  tickets.clear();
+  EXPECT_EQ(controller.pending_sends(), 0U);
+  EXPECT_EQ(controller.pending_bytes(), 0U);
+  EXPECT_TRUE(controller.admit("org.Sensors", 10));
+
+  const auto counters = controller.counters();
+  EXPECT_EQ(counters.admitted, 4U);
+  EXPECT_EQ(counters.rejected, 2U);
+  EXPECT_EQ(counters.dropped, 0U);
+}
+
+TEST(AstarteTestAdmissionController, LimitsThePendingBytes) {
+  AdmissionController controller(AdmissionOptions{.max_pending_bytes = 100});
+  auto first = controller.admit("org.Sensors", 60);
+  ASSERT_TRUE(first && first.value());
+  EXPECT_FALSE(controller.admit("org.Sensors", 60));
+  auto second = controller.admit("org.Sensors", 40);
+  EXPECT_TRUE(second && second.value());
+}
+
+TEST(AstarteTestAdmissionController, AdmitsLargeSendsOnAnIdlePath) {
+  AdmissionController controller(AdmissionOptions{.max_pending_bytes = 100});
+  auto large = controller.admit("org.Sensors", 1000);
+  ASSERT_TRUE(large && large.value());
+  EXPECT_FALSE(controller.admit("org.Sensors", 1));
+}
+
+TEST(AstarteTestAdmissionController, DropsTheLowestPriorityFirst) {
+  const InterfaceAdmission low{.policy = OverloadPolicy::kDropLowestPriority, .priority = 0};
+  const InterfaceAdmission high{.policy = OverloadPolicy::kDropLowestPriority, .priority = 1};
+  AdmissionController controller(AdmissionOptions{
+      .max_pending_sends = 10, .interfaces = {{"org.Low", low}, {"org.High", high}}});
+  std::vector<AdmissionController::Ticket> tickets;
+
+  // the low priority sends are dropped past half of the limit
+  fill(controller, "org.Low", tickets);
+  EXPECT_EQ(tickets.size(), 5U);
+  auto dropped = controller.admit("org.Low", 10);
+  ASSERT_TRUE(dropped);
+  EXPECT_FALSE(dropped.value());
+
+  // the high priority sends are dropped at the limit
+  fill(controller, "org.High", tickets);
+  EXPECT_EQ(tickets.size(), 10U);
+
+  EXPECT_EQ(controller.counters("org.Low").admitted, 5U);
+  EXPECT_EQ(controller.counters("org.Low").dropped, 2U);
+  EXPECT_EQ(controller.counters("org.High").admitted, 5U);
+  EXPECT_EQ(controller.counters("org.High").dropped, 1U);
+  EXPECT_EQ(controller.counters().dropped, 3U);
+  EXPECT_EQ(controller.counters().rejected, 0U);
+}
+
+TEST(AstarteTestAdmissionController, SamplesAboveTheSamplingLoad) {
+  const InterfaceAdmission sampled{.policy = OverloadPolicy::kSample, .sample_every = 4};
+  AdmissionController controller(AdmissionOptions{.max_pending_sends = 100,
+                                                  .sampling_load = 0.1,
+                                                  .interfaces = {{"org.Gps", sampled}}});
+  std::vector<AdmissionController::Ticket> tickets;
+  for (int i = 0; i < 10; i++) {
+    auto res = controller.admit("org.Gps", 10);
+    ASSERT_TRUE(res && res.value());
+    tickets.push_back(std::move(res.value().value()));
+  }
+
+  // beyond the sampling load one send every four is admitted
+  int admitted = 0;
+  for (int i = 0; i < 40; i++) {
+    auto res = controller.admit("org.Gps", 10);
+    ASSERT_TRUE(res);
+    if (res.value()) {
+      admitted++;
+      tickets.push_back(std::move(res.value().value()));
+    }
+  }
+  EXPECT_EQ(admitted, 10);
+  EXPECT_EQ(controller.counters("org.Gps").sampled_out, 30U);
+  EXPECT_EQ(controller.counters("org.Gps").admitted, 20U);
+}
+
+TEST(AstarteTestAdmissionController, AppliesTheDefaultToUnlistedInterfaces) {
+  AdmissionController controller(AdmissionOptions{
+      .max_pending_sends = 1,
+      .default_interface = {.policy = OverloadPolicy::kDropLowestPriority},
+      .interfaces = {{"org.Critical", {}}}});
+  auto first = controller.admit("org.Sensors", 10);
+  ASSERT_TRUE(first && first.value());
+
+  auto dropped = controller.admit("org.Sensors", 10);
+  ASSERT_TRUE(dropped);
+  EXPECT_FALSE(dropped.value());
+  EXPECT_FALSE(controller.admit("org.Critical", 10));
+  EXPECT_EQ(controller.counters("org.Sensors").dropped, 1U);
+  EXPECT_EQ(controller.counters("org.Critical").rejected, 1U);
+  EXPECT_EQ(controller.counters("org.Unknown").admitted, 0U);
+}
@@ -0,0 +1,291 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Budgets of the heap allocations performed on the send and receive paths, for each Data type.
+// A budget is the maximum number of allocations of a single call on the calling thread. When an
+// optimization lowers a count, lower the budget accordingly so that regressions are caught.
+//
+// The budgets cover the functions the devices call for each message. The full sends of DeviceMqtt
+// and DeviceGrpc, including the publication and the gRPC conversions, need a broker or a message
+// hub and are budgeted by benchmark/device_allocation_budget.cpp against the in-process stand-ins,
+// with the gRPC budgets keyed on the protobuf release the SDK is built against.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <map>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "mqtt/connection/topic_router.hpp"
+#include "mqtt/deserialize.hpp"
+#include "mqtt/interface.hpp"
+#include "mqtt/introspection.hpp"
+#include "mqtt/serialize.hpp"
+#endif
+
+using astarte::device::Data;
+using astarte::device::unit::AllocationScope;
+
+namespace {
+
+const auto k_timestamp =
+    std::chrono::system_clock::time_point(std::chrono::milliseconds(1700000000123));
+
+// A value of each Data type, with the endpoint it is sent on and the budgets of its conversions.
+struct TypeBudget {
+  Data data;
+  // Path of the mapping of the MQTT budget interface.
+  const char* path;
+  // Wrapping the value into a Data and extracting it back.
+  uint64_t conversion;
+  // Lookup, validation and BSON serialization performed by the MQTT send_individual of a Data.
+  uint64_t mqtt_send;
+  // The same steps for the typed MQTT send_individual.
+  uint64_t mqtt_send_typed;
+  // BSON decoding of a received individual.
+  uint64_t mqtt_receive;
+};
+
+auto budgets() -> std::vector<TypeBudget> {
+  return {
+      {Data(int32_t{-42}), "/sensor_1/integer", 0, 9, 9, 0},
+      {Data(int64_t{5000000000}), "/sensor_1/longinteger", 0, 9, 9, 0},
+      {Data(3.25), "/sensor_1/double", 0, 9, 9, 0},
+      {Data(true), "/sensor_1/boolean", 0, 9, 9, 0},
+      {Data(std::string(32, 'x')), "/sensor_1/string", 2, 13, 13, 2},
+      {Data(std::vector<uint8_t>(32, 0xAB)), "/sensor_1/binaryblob", 2, 13, 13, 2},
+      {Data(k_timestamp), "/sensor_1/datetime", 0, 9, 9, 0},
+      {Data(std::vector<int32_t>(8, -42)), "/sensor_1/integerarray", 2, 16, 16, 5},
+      {Data(std::vector<int64_t>(8, 5000000000)), "/sensor_1/longintegerarray", 2, 17, 17, 5},
+      {Data(std::vector<double>(8, 3.25)), "/sensor_1/doublearray", 2, 17, 17, 5},
+      {Data(std::vector<bool>(8, true)), "/sensor_1/booleanarray", 2, 15, 15, 2},
+      {Data(std::vector<std::string>(4, std::string(32, 'x'))), "/sensor_1/stringarray", 10, 24,
+       24, 12},
+      {Data(std::vector<std::vector<uint8_t>>(4, std::vector<uint8_t>(32, 0xAB))),
+       "/sensor_1/binaryblobarray", 10, 33, 33, 12},
+      {Data(std::vector<std::chrono::system_clock::time_point>(4, k_timestamp)),
+       "/sensor_1/datetimearray", 2, 16, 16, 4},
+  };
+}
+
+}  // namespace
+
+TEST(AstarteTestAllocationBudget, DataConversion) {
+  for (const auto& budget : budgets()) {
+    const AllocationScope scope;
+    std::visit(
+        [](const auto& value) {
+          const Data data(value);
+          auto extracted = data.try_into<std::decay_t<decltype(value)>>();
+          ASSERT_TRUE(extracted);
+        },
+        budget.data.get_raw_data());
+    EXPECT_LE(scope.count(), budget.conversion) << astarte_fmt::format("{}", budget.data);
+  }
+}
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+using astarte::device::Error;
+using astarte::device::Type;
+using astarte::device::astarte_tl::expected;
+using astarte::device::mqtt::Interface;
+using astarte::device::mqtt::Introspection;
+using astarte::device::mqtt::bson::deserialize_astarte_individual;
+using astarte::device::mqtt::bson::deserialize_astarte_object;
+using astarte::device::mqtt::bson::individual_to_bytes;
+using astarte::device::mqtt::bson::object_to_bytes;
+using astarte::device::mqtt::connection::Route;
+using astarte::device::mqtt::connection::TopicRouter;
+
+namespace {
+
+const astarte::device::DatastreamObject k_object{{"temperature", Data(21.5)},
+                                                 {"humidity", Data(0.45)},
+                                                 {"status", Data(std::string(32, 'x'))}};
+
+// Budgets of the MQTT send_object, of the routing of a received message and of the decoding of a
+// received object of three entries.
+constexpr uint64_t k_mqtt_send_object_budget = 20;
+constexpr uint64_t k_mqtt_route_budget = 0;
+constexpr uint64_t k_mqtt_receive_object_budget = 6;
+
+constexpr std::string_view k_individual_interface_name =
+    "org.astarte-platform.test.AllocationBudget";
+constexpr std::string_view k_object_interface_name =
+    "org.astarte-platform.test.AllocationBudgetObject";
+
+constexpr std::string_view k_individual_interface = R"({
+  "interface_name": "org.astarte-platform.test.AllocationBudget",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "device",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/integer", "type": "integer", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/longinteger", "type": "longinteger", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/double", "type": "double", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/boolean", "type": "boolean", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/string", "type": "string", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/binaryblob", "type": "binaryblob", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/datetime", "type": "datetime", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/integerarray", "type": "integerarray",
+     "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/longintegerarray", "type": "longintegerarray",
+     "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/doublearray", "type": "doublearray", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/booleanarray", "type": "booleanarray",
+     "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/stringarray", "type": "stringarray", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/binaryblobarray", "type": "binaryblobarray",
+     "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/datetimearray", "type": "datetimearray",
+     "explicit_timestamp": true}
+  ]
+})";
+
+constexpr std::string_view k_object_interface = R"({
+  "interface_name": "org.astarte-platform.test.AllocationBudgetObject",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "device",
+  "aggregation": "object",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/temperature", "type": "double", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/humidity", "type": "double", "explicit_timestamp": true},
+    {"endpoint": "/%{sensor_id}/status", "type": "string", "explicit_timestamp": true}
+  ]
+})";
+
+class AstarteTestAllocationBudgetMqtt : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (const auto interface : {k_individual_interface, k_object_interface}) {
+      auto res = Interface::try_from_str(interface);
+      ASSERT_TRUE(res);
+      ASSERT_TRUE(introspection_.checked_insert(std::move(res.value())));
+    }
+  }
+
+  // The MQTT send_individual up to the publication, for a Data or a typed value: the lookup of the
+  // interface, the validation of the value and the serialization of the payload.
+  template <typename Value>
+  auto send_individual(std::string_view path, const Value& value)
+      -> expected<std::vector<uint8_t>, Error> {
+    return introspection_.get(k_individual_interface_name)
+        .and_then([&](const auto& interface) {
+          return interface->resolve_individual(path, value, &k_timestamp);
+        })
+        .and_then([&](const auto& /* descriptor */) {
+          return individual_to_bytes(value, &k_timestamp);
+        });
+  }
+
+  // The MQTT send_object up to the publication.
+  auto send_object(std::string_view path, const astarte::device::DatastreamObject& object)
+      -> expected<std::vector<uint8_t>, Error> {
+    return introspection_.get(k_object_interface_name)
+        .and_then([&](const auto& interface) {
+          return interface->resolve_object(path, object, &k_timestamp);
+        })
+        .and_then(
+            [&](const auto& /* descriptor */) { return object_to_bytes(object, &k_timestamp); });
+  }
+
+  Introspection introspection_;
+};
+
+}  // namespace
+
+TEST_F(AstarteTestAllocationBudgetMqtt, SendIndividual) {
+  for (const auto& budget : budgets()) {
+    // The first call initializes the lazily constructed state, such as the logger
+    ASSERT_TRUE(send_individual(budget.path, budget.data)) << budget.path;
+
+    const AllocationScope scope;
+    const auto bytes = send_individual(budget.path, budget.data);
+    EXPECT_LE(scope.count(), budget.mqtt_send) << budget.path;
+  }
+}
+
+TEST_F(AstarteTestAllocationBudgetMqtt, SendTypedIndividual) {
+  for (const auto& budget : budgets()) {
+    std::visit(
+        [&](const auto& value) {
+          ASSERT_TRUE(send_individual(budget.path, value)) << budget.path;
+
+          const AllocationScope scope;
+          const auto bytes = send_individual(budget.path, value);
+          EXPECT_LE(scope.count(), budget.mqtt_send_typed) << budget.path;
+        },
+        budget.data.get_raw_data());
+  }
+}
+
+TEST_F(AstarteTestAllocationBudgetMqtt, ReceiveIndividual) {
+  const TopicRouter router("realm", "device");
+  const auto topic = std::string("realm/device/") + std::string(k_individual_interface_name) +
+                     "/sensor_1/double";
+  {
+    const AllocationScope scope;
+    const auto route = router.route(topic, introspection_);
+    EXPECT_EQ(route.kind, Route::Kind::kInterface);
+    EXPECT_LE(scope.count(), k_mqtt_route_budget);
+  }
+
+  for (const auto& budget : budgets()) {
+    const auto bytes = individual_to_bytes(budget.data, &k_timestamp);
+    ASSERT_TRUE(bytes) << budget.path;
+
+    const AllocationScope scope;
+    auto decoded = deserialize_astarte_individual(bytes.value(), budget.data.get_type());
+    ASSERT_TRUE(decoded) << budget.path;
+    EXPECT_LE(scope.count(), budget.mqtt_receive) << budget.path;
+  }
+}
+
+TEST_F(AstarteTestAllocationBudgetMqtt, Object) {
+  ASSERT_TRUE(send_object("/sensor_1", k_object));
+
+  std::vector<uint8_t> bytes;
+  {
+    const AllocationScope scope;
+    auto sent = send_object("/sensor_1", k_object);
+    EXPECT_LE(scope.count(), k_mqtt_send_object_budget);
+    ASSERT_TRUE(sent);
+    bytes = std::move(sent.value());
+  }
+
+  const std::map<std::string, Type, std::less<>> types{
+      {"temperature", Type::kDouble}, {"humidity", Type::kDouble}, {"status", Type::kString}};
+  const auto type_of = [&types](std::string_view key) -> std::optional<Type> {
+    auto found = types.find(key);
+    return found != types.end() ? std::optional(found->second) : std::nullopt;
+  };
+  const astarte::device::mqtt::bson::ObjectTypeLookup lookup(type_of);
+
+  const AllocationScope scope;
+  auto decoded = deserialize_astarte_object(bytes, lookup, types.size());
+  ASSERT_TRUE(decoded);
+  EXPECT_LE(scope.count(), k_mqtt_receive_object_budget);
+}
+#endif
+
@@ -0,0 +1,74 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local uint64_t thread_allocations = 0;
+std::atomic<uint64_t> allocations{0};
+
+void count_allocation() {
+  thread_allocations++;
+  allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto counted_alloc(std::size_t size) -> void* {
+  count_allocation();
+  // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+auto counted_aligned_alloc(std::size_t size, std::align_val_t align) -> void* {
+  count_allocation();
+  auto alignment = static_cast<std::size_t>(align);
+  // aligned_alloc requires the size to be a multiple of the alignment
+  auto rounded = (size + alignment - 1) / alignment * alignment;
+  if (void* ptr = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+namespace astarte::device::unit {
+
+auto thread_allocation_count() -> uint64_t { return thread_allocations; }
+
+auto allocation_count() -> uint64_t { return allocations.load(std::memory_order_relaxed); }
+
+}  // namespace astarte::device::unit
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc)
+auto operator new(std::size_t size) -> void* { return counted_alloc(size); }
+auto operator new[](std::size_t size) -> void* { return counted_alloc(size); }
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+  return counted_aligned_alloc(size, align);
+}
+auto operator new[](std::size_t size, std::align_val_t align) -> void* {
+  return counted_aligned_alloc(size, align);
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /* size */) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t /* size */) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t /* align */) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t /* align */) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /* size */, std::align_val_t /* align */) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t /* size */, std::align_val_t /* align */) noexcept {
+  std::free(ptr);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc)
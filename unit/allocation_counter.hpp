@@ -0,0 +1,56 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ASTARTE_UNIT_ALLOCATION_COUNTER_H
+#define ASTARTE_UNIT_ALLOCATION_COUNTER_H
+
+/**
+ * @file unit/allocation_counter.hpp
+ * @brief Count of the heap allocations, shared by the unit tests and the benchmarks.
+ *
+ * @details Linking allocation_counter.cpp replaces the global `operator new` overloads with
+ * counting ones. The unit tests account the calling thread only, so that the threads of the test
+ * framework and of the SDK do not perturb the counts. The benchmarks account every thread, so that
+ * the work offloaded by the device to the transport threads is accounted to the operation that
+ * caused it.
+ */
+
+#include <cstdint>
+
+namespace astarte::device::unit {
+
+/**
+ * @brief Gets the number of heap allocations performed by the calling thread so far.
+ * @return The number of allocations since the thread started.
+ */
+auto thread_allocation_count() -> uint64_t;
+
+/**
+ * @brief Gets the number of heap allocations performed by every thread so far.
+ * @return The number of allocations since the program started.
+ */
+auto allocation_count() -> uint64_t;
+
+/**
+ * @brief Counts the allocations performed by the calling thread during its lifetime.
+ */
+class AllocationScope {
+ public:
+  /// @brief Starts counting.
+  AllocationScope() : start_(thread_allocation_count()) {}
+
+  /**
+   * @brief Gets the number of allocations performed since the scope was created.
+   * @return The number of allocations.
+   */
+  [[nodiscard]] auto count() const -> uint64_t { return thread_allocation_count() - start_; }
+
+ private:
+  /// @brief Allocations performed by the thread when the scope was created.
+  uint64_t start_;
+};
+
+}  // namespace astarte::device::unit
+
+#endif  // ASTARTE_UNIT_ALLOCATION_COUNTER_H
@@ -0,0 +1,170 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "mqtt/deserialize.hpp"
+#include "mqtt/serialize.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Type;
+using astarte::device::mqtt::bson::deserialize_astarte_individual;
+using astarte::device::mqtt::bson::deserialize_astarte_object;
+using astarte::device::mqtt::bson::serialize_astarte_individual;
+using astarte::device::mqtt::bson::serialize_astarte_object;
+
+using nlohmann::json;
+
+namespace {
+
+const auto k_timestamp =
+    std::chrono::system_clock::time_point(std::chrono::milliseconds(1700000000123));
+
+auto encode_individual(const Data& data,
+                       const std::chrono::system_clock::time_point* timestamp = nullptr)
+    -> std::vector<uint8_t> {
+  json doc;
+  serialize_astarte_individual(doc, "v", data, timestamp);
+  return json::to_bson(doc);
+}
+
+auto all_types() -> std::vector<Data> {
+  return {
+      Data(int32_t{-42}),
+      Data(int64_t{5000000000}),
+      Data(3.25),
+      Data(true),
+      Data(std::string("hello \xC3\xA8")),
+      Data(std::vector<uint8_t>{0x00, 0x01, 0xFF}),
+      Data(k_timestamp),
+      Data(std::vector<int32_t>{1, -2, 3}),
+      Data(std::vector<int64_t>{1, 5000000000}),
+      Data(std::vector<double>{0.5, -1.5}),
+      Data(std::vector<bool>{true, false, true}),
+      Data(std::vector<std::string>{"a", "", "c"}),
+      Data(std::vector<std::vector<uint8_t>>{{0x01}, {}, {0x02, 0x03}}),
+      Data(std::vector<std::chrono::system_clock::time_point>{k_timestamp, k_timestamp}),
+  };
+}
+
+}  // namespace
+
+TEST(AstarteTestBsonDeserialize, IndividualRoundTrip) {
+  for (const auto& data : all_types()) {
+    auto decoded = deserialize_astarte_individual(encode_individual(data), data.get_type());
+    ASSERT_TRUE(decoded) << astarte_fmt::format("{}", data);
+    EXPECT_EQ(decoded->data, data);
+    EXPECT_FALSE(decoded->timestamp);
+  }
+
+  auto decoded = deserialize_astarte_individual(encode_individual(Data(1.0), &k_timestamp),
+                                                Type::kDouble);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(decoded->timestamp, k_timestamp);
+}
+
+TEST(AstarteTestBsonDeserialize, ObjectRoundTrip) {
+  const DatastreamObject object{{"temperature", Data(21.5)},
+                                {"count", Data(int32_t{7})},
+                                {"labels", Data(std::vector<std::string>{"x", "y"})}};
+  const std::map<std::string, Type, std::less<>> types{
+      {"temperature", Type::kDouble}, {"count", Type::kInteger}, {"labels", Type::kStringArray}};
+  auto type_of = [&](std::string_view key) -> std::optional<Type> {
+    auto found = types.find(key);
+    return found != types.end() ? std::optional(found->second) : std::nullopt;
+  };
+
+  json doc;
+  serialize_astarte_object(doc, object, &k_timestamp);
+  auto decoded = deserialize_astarte_object(json::to_bson(doc), type_of);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(decoded->object, object);
+  EXPECT_EQ(decoded->timestamp, k_timestamp);
+
+  const DatastreamObject unknown{{"pressure", Data(1.0)}};
+  json unknown_doc;
+  serialize_astarte_object(unknown_doc, unknown, nullptr);
+  EXPECT_FALSE(deserialize_astarte_object(json::to_bson(unknown_doc), type_of));
+
+  EXPECT_FALSE(deserialize_astarte_object(encode_individual(Data(1.0)), type_of));
+}
+
+TEST(AstarteTestBsonDeserialize, LenientNumericTypes) {
+  // Integral values are accepted where a wider type is expected
+  auto as_double = deserialize_astarte_individual(json::to_bson({{"v", 3}}), Type::kDouble);
+  ASSERT_TRUE(as_double);
+  EXPECT_EQ(as_double->data, Data(3.0));
+
+  auto as_long = deserialize_astarte_individual(json::to_bson({{"v", 3}}), Type::kLongInteger);
+  ASSERT_TRUE(as_long);
+  EXPECT_EQ(as_long->data, Data(int64_t{3}));
+
+  // Values not representable by the mapping type are rejected
+  EXPECT_FALSE(deserialize_astarte_individual(json::to_bson({{"v", int64_t{5000000000}}}),
+                                              Type::kInteger));
+  EXPECT_FALSE(deserialize_astarte_individual(json::to_bson({{"v", 1.5}}), Type::kInteger));
+  EXPECT_FALSE(deserialize_astarte_individual(json::to_bson({{"v", "1"}}), Type::kDouble));
+  EXPECT_FALSE(deserialize_astarte_individual(json::to_bson({{"v", json::array({1, "a"})}}),
+                                              Type::kIntegerArray));
+}
+
+TEST(AstarteTestBsonDeserialize, RejectsMalformedPayloads) {
+  const auto valid = encode_individual(Data(std::vector<std::string>{"a", "b"}), &k_timestamp);
+  ASSERT_TRUE(deserialize_astarte_individual(valid, Type::kStringArray));
+
+  // Every truncation of a valid payload is rejected
+  for (size_t len = 0; len < valid.size(); len++) {
+    EXPECT_FALSE(deserialize_astarte_individual({valid.data(), len}, Type::kStringArray)) << len;
+  }
+
+  // Missing and duplicated values
+  EXPECT_FALSE(deserialize_astarte_individual(json::to_bson({{"t", 1}}), Type::kInteger));
+  const std::vector<uint8_t> duplicated{0x13, 0x00, 0x00, 0x00, 0x10, 'v',  0x00,
+                                        0x01, 0x00, 0x00, 0x00, 0x10, 'v',  0x00,
+                                        0x02, 0x00, 0x00, 0x00, 0x00};
+  EXPECT_FALSE(deserialize_astarte_individual(duplicated, Type::kInteger));
+
+  // Wrong size, missing terminator and unsupported element types
+  auto corrupted = encode_individual(Data(int32_t{1}));
+  corrupted[0]++;
+  EXPECT_FALSE(deserialize_astarte_individual(corrupted, Type::kInteger));
+  corrupted = encode_individual(Data(int32_t{1}));
+  corrupted.back() = 0x01;
+  EXPECT_FALSE(deserialize_astarte_individual(corrupted, Type::kInteger));
+  corrupted = encode_individual(Data(int32_t{1}));
+  corrupted[4] = 0x07;
+  EXPECT_FALSE(deserialize_astarte_individual(corrupted, Type::kInteger));
+
+  // Invalid booleans and strings
+  corrupted = encode_individual(Data(true));
+  corrupted[7] = 0x02;
+  EXPECT_FALSE(deserialize_astarte_individual(corrupted, Type::kBoolean));
+  corrupted = encode_individual(Data(std::string("ab")));
+  corrupted[11] = 0xC0;
+  EXPECT_FALSE(deserialize_astarte_individual(corrupted, Type::kString));
+
+  // Array keys must be the element indexes
+  json array_doc;
+  array_doc["v"] = json::object({{"1", 1}});
+  auto array_bson = json::to_bson(array_doc);
+  array_bson[4] = 0x04;
+  EXPECT_FALSE(deserialize_astarte_individual(array_bson, Type::kIntegerArray));
+}
+
+#endif
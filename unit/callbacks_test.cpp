@@ -0,0 +1,318 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/individual.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+#include "mqtt/connection/callbacks.hpp"
+#include "mqtt/connection/duplicate_filter.hpp"
+#include "mqtt/interface.hpp"
+#include "mqtt/introspection.hpp"
+#include "mqtt/message.h"
+#include "mqtt/property_cache.hpp"
+#include "mqtt/serialize.hpp"
+#include "mqtt/server_properties.hpp"
+#include "shared_queue.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamIndividual;
+using astarte::device::DatastreamObject;
+using astarte::device::Message;
+using astarte::device::Ownership;
+using astarte::device::PropertyIndividual;
+using astarte::device::SharedMessage;
+using astarte::device::SharedQueue;
+using astarte::device::StoredProperty;
+using astarte::device::mqtt::Interface;
+using astarte::device::mqtt::Introspection;
+using astarte::device::mqtt::PropertyCache;
+using astarte::device::mqtt::ServerProperties;
+using astarte::device::mqtt::bson::individual_to_bytes;
+using astarte::device::mqtt::bson::object_to_bytes;
+using astarte::device::mqtt::connection::Callback;
+using astarte::device::mqtt::connection::DuplicateFilter;
+using namespace std::chrono_literals;
+
+namespace paho_mqtt = ::mqtt;
+
+namespace {
+
+constexpr std::string_view k_datastream_name = "org.astarte-platform.test.ServerDatastream";
+constexpr std::string_view k_object_name = "org.astarte-platform.test.ServerObject";
+constexpr std::string_view k_property_name = "org.astarte-platform.test.ServerProperty";
+constexpr std::string_view k_device_name = "org.astarte-platform.test.DeviceDatastream";
+
+constexpr std::string_view k_datastream = R"({
+  "interface_name": "org.astarte-platform.test.ServerDatastream",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "server",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/value", "type": "double"}
+  ]
+})";
+
+constexpr std::string_view k_object = R"({
+  "interface_name": "org.astarte-platform.test.ServerObject",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "server",
+  "aggregation": "object",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/temperature", "type": "double"},
+    {"endpoint": "/%{sensor_id}/status", "type": "string"}
+  ]
+})";
+
+constexpr std::string_view k_property = R"({
+  "interface_name": "org.astarte-platform.test.ServerProperty",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "properties",
+  "ownership": "server",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/enabled", "type": "boolean", "allow_unset": true}
+  ]
+})";
+
+constexpr std::string_view k_device = R"({
+  "interface_name": "org.astarte-platform.test.DeviceDatastream",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "device",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/value", "type": "double"}
+  ]
+})";
+
+class AstarteTestCallback : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (const auto interface : {k_datastream, k_object, k_property, k_device}) {
+      auto res = Interface::try_from_str(interface);
+      ASSERT_TRUE(res);
+      ASSERT_TRUE(introspection_->checked_insert(std::move(res.value())));
+    }
+  }
+
+  // The callback of a connection, without a client as receiving does not use it
+  auto make_callback(std::optional<DuplicateFilter> duplicate_filter = std::nullopt)
+      -> std::unique_ptr<Callback> {
+    return std::make_unique<Callback>(
+        nullptr, "realm", "device", introspection_, std::make_shared<std::atomic<bool>>(true),
+        std::make_shared<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>(),
+        std::make_shared<std::atomic<bool>>(false), received_, nullptr, nullptr,
+        std::move(duplicate_filter));
+  }
+
+  // The callback of a connection persisting the server properties. Without a client the session
+  // setup can only succeed by being skipped.
+  auto make_callback(std::shared_ptr<ServerProperties> server_properties, bool session_present,
+                     std::shared_ptr<std::atomic<bool>> connected) -> std::unique_ptr<Callback> {
+    return std::make_unique<Callback>(
+        nullptr, "realm", "device", introspection_, std::move(connected),
+        std::make_shared<paho_mqtt::thread_queue<paho_mqtt::token_ptr>>(),
+        std::make_shared<std::atomic<bool>>(session_present), received_,
+        std::move(server_properties), nullptr);
+  }
+
+  // The introspection as sent to Astarte by the session setup
+  [[nodiscard]] auto introspection_string() const -> std::string {
+    std::string introspection;
+    for (const auto& interface : introspection_->values()) {
+      if (!introspection.empty()) {
+        introspection += ';';
+      }
+      introspection += interface->interface_name() + ":" +
+                       std::to_string(interface->version_major()) + ":" +
+                       std::to_string(interface->version_minor());
+    }
+    return introspection;
+  }
+
+  // Delivers a message as the Paho callback thread would. The callback names the thread it runs
+  // on, so the test thread is left alone.
+  static void deliver(Callback& callback, std::string_view interface_name, std::string_view path,
+                      const std::vector<uint8_t>& payload, int qos = 1) {
+    auto topic = std::string("realm/device/").append(interface_name).append(path);
+    auto msg = paho_mqtt::message::create(topic, payload.data(), payload.size(), qos, false);
+    std::thread([&callback, &msg] {
+      static_cast<paho_mqtt::callback&>(callback).message_arrived(msg);
+    }).join();
+  }
+
+  auto poll() -> std::optional<Message> {
+    auto message = received_->pop(0ms);
+    if (!message) {
+      return std::nullopt;
+    }
+    return std::move(message.value()).into_message();
+  }
+
+  std::shared_ptr<Introspection> introspection_ = std::make_shared<Introspection>();
+  std::shared_ptr<SharedQueue<SharedMessage>> received_ =
+      std::make_shared<SharedQueue<SharedMessage>>();
+};
+
+}  // namespace
+
+TEST_F(AstarteTestCallback, ReceivesIndividualDatastreams) {
+  auto callback = make_callback();
+  auto payload = individual_to_bytes(Data(21.5), nullptr);
+  ASSERT_TRUE(payload);
+  deliver(*callback, k_datastream_name, "/sensor_1/value", payload.value());
+
+  auto message = poll();
+  ASSERT_TRUE(message);
+  EXPECT_EQ(message.value(),
+            Message(k_datastream_name, "/sensor_1/value", DatastreamIndividual(Data(21.5))));
+  EXPECT_FALSE(poll());
+}
+
+TEST_F(AstarteTestCallback, ReceivesObjects) {
+  auto callback = make_callback();
+  const DatastreamObject object{{"temperature", Data(20.5)}, {"status", Data(std::string("ok"))}};
+  auto payload = object_to_bytes(object, nullptr);
+  ASSERT_TRUE(payload);
+  deliver(*callback, k_object_name, "/sensor_1", payload.value());
+
+  auto message = poll();
+  ASSERT_TRUE(message);
+  EXPECT_EQ(message.value(), Message(k_object_name, "/sensor_1", object));
+}
+
+TEST_F(AstarteTestCallback, ReceivesPropertiesAndUnsets) {
+  auto callback = make_callback();
+  auto payload = individual_to_bytes(Data(true), nullptr);
+  ASSERT_TRUE(payload);
+  deliver(*callback, k_property_name, "/sensor_1/enabled", payload.value());
+  deliver(*callback, k_property_name, "/sensor_1/enabled", {});
+
+  auto set = poll();
+  ASSERT_TRUE(set);
+  EXPECT_EQ(set.value(),
+            Message(k_property_name, "/sensor_1/enabled", PropertyIndividual(Data(true))));
+  auto unset = poll();
+  ASSERT_TRUE(unset);
+  EXPECT_EQ(unset.value(),
+            Message(k_property_name, "/sensor_1/enabled", PropertyIndividual(std::nullopt)));
+}
+
+TEST_F(AstarteTestCallback, RedeliveredDatastreamsAreReturnedOnce) {
+  auto callback = make_callback(DuplicateFilter(16, 10s));
+  auto payload = individual_to_bytes(Data(21.5), nullptr);
+  ASSERT_TRUE(payload);
+  // the broker redelivers a QoS 1 message whose acknowledgment was lost
+  deliver(*callback, k_datastream_name, "/sensor_1/value", payload.value());
+  deliver(*callback, k_datastream_name, "/sensor_1/value", payload.value());
+
+  auto message = poll();
+  ASSERT_TRUE(message);
+  EXPECT_EQ(message.value(),
+            Message(k_datastream_name, "/sensor_1/value", DatastreamIndividual(Data(21.5))));
+  EXPECT_FALSE(poll());
+
+  // the properties are never deduplicated
+  auto property = individual_to_bytes(Data(true), nullptr);
+  ASSERT_TRUE(property);
+  deliver(*callback, k_property_name, "/sensor_1/enabled", property.value());
+  deliver(*callback, k_property_name, "/sensor_1/enabled", property.value());
+  EXPECT_TRUE(poll());
+  EXPECT_TRUE(poll());
+}
+
+TEST_F(AstarteTestCallback, RedeliveriesAreReturnedWithoutFilter) {
+  auto callback = make_callback();
+  auto payload = individual_to_bytes(Data(21.5), nullptr);
+  ASSERT_TRUE(payload);
+  deliver(*callback, k_datastream_name, "/sensor_1/value", payload.value());
+  deliver(*callback, k_datastream_name, "/sensor_1/value", payload.value());
+  EXPECT_TRUE(poll());
+  EXPECT_TRUE(poll());
+}
+
+TEST_F(AstarteTestCallback, DiscardsUndeliverableMessages) {
+  auto callback = make_callback();
+  auto wrong_type = individual_to_bytes(Data(std::string("text")), nullptr);
+  ASSERT_TRUE(wrong_type);
+  deliver(*callback, k_datastream_name, "/sensor_1/value", wrong_type.value());
+  deliver(*callback, k_datastream_name, "/sensor_1/value", {0x01, 0x02});
+
+  auto value = individual_to_bytes(Data(1.0), nullptr);
+  ASSERT_TRUE(value);
+  deliver(*callback, k_device_name, "/sensor_1/value", value.value());
+  deliver(*callback, k_datastream_name, "/sensor_1/missing/value", value.value());
+  deliver(*callback, "org.astarte-platform.test.Unknown", "/sensor_1/value", value.value());
+
+  EXPECT_FALSE(poll());
+}
+TEST_F(AstarteTestCallback, PersistedPropertiesAreReadAfterARestart) {
+  const auto path = std::filesystem::temp_directory_path() / "astarte_callbacks_server_properties";
+  std::filesystem::remove(path);
+  {
+    // a first run synchronizes the properties with Astarte, which lists no set property
+    auto server_properties = std::make_shared<ServerProperties>(PropertyCache::load(path));
+    ASSERT_TRUE(server_properties->begin_sync(introspection_string()));
+    auto callback = make_callback(server_properties, false, std::make_shared<std::atomic<bool>>());
+    deliver(*callback, "control", "/consumer/properties", std::vector<uint8_t>(4, 0));
+    ASSERT_TRUE(server_properties->is_consistent(introspection_string()));
+
+    auto payload = individual_to_bytes(Data(true), nullptr);
+    ASSERT_TRUE(payload);
+    deliver(*callback, k_property_name, "/sensor_1/enabled", payload.value());
+    EXPECT_TRUE(poll());
+  }
+
+  // the process restarts and the broker resumes the session, Astarte resends nothing
+  auto server_properties = std::make_shared<ServerProperties>(PropertyCache::load(path));
+  auto connected = std::make_shared<std::atomic<bool>>(false);
+  auto callback = make_callback(server_properties, true, connected);
+  std::thread([&callback] {
+    static_cast<paho_mqtt::callback&>(*callback).connected("");
+  }).join();
+  EXPECT_TRUE(connected->load());
+  EXPECT_FALSE(poll());
+
+  auto property =
+      server_properties->get(*introspection_, k_property_name, "/sensor_1/enabled");
+  ASSERT_TRUE(property);
+  EXPECT_EQ(property.value(), PropertyIndividual(Data(true)));
+  auto unset = server_properties->get(*introspection_, k_property_name, "/sensor_2/enabled");
+  ASSERT_TRUE(unset);
+  EXPECT_EQ(unset.value(), PropertyIndividual(std::nullopt));
+
+  const auto properties = server_properties->list(*introspection_, std::nullopt);
+  ASSERT_EQ(properties.size(), 1);
+  EXPECT_EQ(properties.front(),
+            StoredProperty(k_property_name, "/sensor_1/enabled", 1,
+                           Ownership::kServer, Data(true)));
+
+  std::filesystem::remove(path);
+  auto journal = path;
+  journal += ".journal";
+  std::filesystem::remove(journal);
+}
+#endif
@@ -0,0 +1,271 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/capture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+#include "capture_send.hpp"
+
+namespace astarte_tl = astarte::device::astarte_tl;
+namespace capture = astarte::device::capture;
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Device;
+using astarte::device::Error;
+using astarte::device::Message;
+using astarte::device::OperationRefusedError;
+using astarte::device::Ownership;
+using astarte::device::PropertyIndividual;
+using astarte::device::StoredProperty;
+using capture::SendKind;
+
+namespace {
+
+// Device recording the send calls it receives, all the other methods are refused.
+class RecordingDevice : public Device {
+ public:
+  auto add_interface_from_file(const std::filesystem::path& /*json_file*/)
+      -> astarte_tl::expected<void, Error> override {
+    return refused();
+  }
+  auto add_interface_from_str(std::string_view /*json*/)
+      -> astarte_tl::expected<void, Error> override {
+    return refused();
+  }
+  auto remove_interface(const std::string& /*interface_name*/)
+      -> astarte_tl::expected<void, Error> override {
+    return refused();
+  }
+  auto connect() -> astarte_tl::expected<void, Error> override { return refused(); }
+  [[nodiscard]] auto is_connected() const -> bool override { return true; }
+  auto disconnect() -> astarte_tl::expected<void, Error> override { return refused(); }
+
+  auto send_individual(std::string_view interface_name, std::string_view path, const Data& data,
+                       const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error> override {
+    return captured_send({.kind = SendKind::kIndividual,
+                          .interface_name = interface_name,
+                          .path = path,
+                          .data = &data,
+                          .object = nullptr,
+                          .timestamp = timestamp});
+  }
+  auto send_object(std::string_view interface_name, std::string_view path,
+                   const DatastreamObject& object,
+                   const std::chrono::system_clock::time_point* timestamp)
+      -> astarte_tl::expected<void, Error> override {
+    return captured_send({.kind = SendKind::kObject,
+                          .interface_name = interface_name,
+                          .path = path,
+                          .data = nullptr,
+                          .object = &object,
+                          .timestamp = timestamp});
+  }
+  auto set_property(std::string_view interface_name, std::string_view path, const Data& data)
+      -> astarte_tl::expected<void, Error> override {
+    return captured_send({.kind = SendKind::kSetProperty,
+                          .interface_name = interface_name,
+                          .path = path,
+                          .data = &data,
+                          .object = nullptr,
+                          .timestamp = nullptr});
+  }
+  auto unset_property(std::string_view interface_name, std::string_view path)
+      -> astarte_tl::expected<void, Error> override {
+    return captured_send({.kind = SendKind::kUnsetProperty,
+                          .interface_name = interface_name,
+                          .path = path,
+                          .data = nullptr,
+                          .object = nullptr,
+                          .timestamp = nullptr});
+  }
+
+  auto poll_incoming(const std::chrono::milliseconds& /*timeout*/)
+      -> std::optional<Message> override {
+    return std::nullopt;
+  }
+  auto get_all_properties(const std::optional<Ownership>& /*ownership*/)
+      -> astarte_tl::expected<std::list<StoredProperty>, Error> override {
+    return refused();
+  }
+  auto get_properties(std::string_view /*interface_name*/)
+      -> astarte_tl::expected<std::list<StoredProperty>, Error> override {
+    return refused();
+  }
+  auto get_property(std::string_view /*interface_name*/, std::string_view /*path*/)
+      -> astarte_tl::expected<PropertyIndividual, Error> override {
+    return refused();
+  }
+
+  std::vector<SendKind> kinds;
+  std::vector<std::string> paths;
+  std::vector<std::optional<std::chrono::system_clock::time_point>> timestamps;
+
+ private:
+  static auto refused() -> astarte_tl::unexpected<Error> {
+    return astarte_tl::unexpected<Error>(OperationRefusedError("not supported by the test device"));
+  }
+
+  auto captured_send(const capture::SendCall& call) -> astarte_tl::expected<void, Error> {
+    return capture::captured(call, [&]() -> astarte_tl::expected<void, Error> {
+      kinds.push_back(call.kind);
+      paths.emplace_back(call.path);
+      timestamps.push_back(call.timestamp != nullptr ? std::optional(*call.timestamp)
+                                                     : std::nullopt);
+      if (call.path == "/fail") {
+        return refused();
+      }
+      return {};
+    });
+  }
+};
+
+class AstarteTestCapture : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_ = std::filesystem::temp_directory_path() / "astarte_capture_test.bin";
+  }
+  void TearDown() override {
+    if (capture::is_active()) {
+      (void)capture::stop();
+    }
+    std::filesystem::remove(file_);
+  }
+
+  std::filesystem::path file_;
+};
+
+}  // namespace
+
+TEST_F(AstarteTestCapture, InactiveByDefault) {
+  EXPECT_FALSE(capture::is_active());
+  EXPECT_FALSE(capture::stop());
+
+  RecordingDevice device;
+  EXPECT_TRUE(device.send_individual("org.astarte.Test", "/value", Data(1.0), nullptr));
+}
+
+TEST_F(AstarteTestCapture, RoundTrip) {
+  RecordingDevice device;
+  const auto timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+  const DatastreamObject object{{"temperature", Data(21.5)},
+                                {"samples", Data(std::vector<int64_t>{1, 2, 3})},
+                                {"labels", Data(std::vector<std::string>{"a", "b"})}};
+
+  ASSERT_TRUE(capture::start(file_));
+  EXPECT_TRUE(capture::is_active());
+  EXPECT_FALSE(capture::start(file_));
+  (void)device.send_individual("org.astarte.Test", "/integer", Data(int32_t{-7}), &timestamp);
+  (void)device.send_individual("org.astarte.Test", "/blob",
+                               Data(std::vector<uint8_t>{0x00, 0xFF}), nullptr);
+  (void)device.send_individual("org.astarte.Test", "/bools", Data(std::vector<bool>{true, false}),
+                               nullptr);
+  (void)device.send_individual("org.astarte.Test", "/datetime", Data(timestamp), nullptr);
+  (void)device.send_object("org.astarte.Object", "/sensor", object, &timestamp);
+  (void)device.set_property("org.astarte.Property", "/name", Data(std::string("device")));
+  (void)device.unset_property("org.astarte.Property", "/fail");
+  ASSERT_TRUE(capture::stop());
+  EXPECT_FALSE(capture::is_active());
+
+  auto read = capture::read_file(file_);
+  ASSERT_TRUE(read);
+  const auto& sends = read->sends;
+  ASSERT_EQ(sends.size(), 7);
+
+  EXPECT_EQ(sends[0].kind, SendKind::kIndividual);
+  EXPECT_EQ(sends[0].interface_name, "org.astarte.Test");
+  EXPECT_EQ(sends[0].path, "/integer");
+  EXPECT_EQ(sends[0].data, Data(int32_t{-7}));
+  EXPECT_EQ(sends[0].timestamp, timestamp);
+  EXPECT_TRUE(sends[0].succeeded);
+  EXPECT_EQ(sends[1].data, Data(std::vector<uint8_t>{0x00, 0xFF}));
+  EXPECT_FALSE(sends[1].timestamp);
+  EXPECT_EQ(sends[2].data, Data(std::vector<bool>{true, false}));
+  EXPECT_EQ(sends[3].data, Data(timestamp));
+  EXPECT_EQ(sends[4].kind, SendKind::kObject);
+  EXPECT_EQ(sends[4].object, object);
+  EXPECT_EQ(sends[5].kind, SendKind::kSetProperty);
+  EXPECT_EQ(sends[5].data, Data(std::string("device")));
+  EXPECT_EQ(sends[6].kind, SendKind::kUnsetProperty);
+  EXPECT_FALSE(sends[6].succeeded);
+
+  for (size_t i = 1; i < sends.size(); i++) {
+    EXPECT_GE(sends[i].offset, sends[i - 1].offset);
+  }
+}
+
+TEST_F(AstarteTestCapture, RejectsMalformedFiles) {
+  EXPECT_FALSE(capture::read_file(file_));
+
+  {
+    std::ofstream out(file_, std::ios::binary);
+    out << "not a capture file";
+  }
+  EXPECT_FALSE(capture::read_file(file_));
+
+  RecordingDevice device;
+  ASSERT_TRUE(capture::start(file_));
+  (void)device.send_individual("org.astarte.Test", "/value", Data(1.0), nullptr);
+  ASSERT_TRUE(capture::stop());
+  std::filesystem::resize_file(file_, std::filesystem::file_size(file_) - 1);
+  EXPECT_FALSE(capture::read_file(file_));
+}
+
+TEST_F(AstarteTestCapture, Replay) {
+  const auto captured_at = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+  capture::Capture recorded{.started = captured_at, .sends = {}};
+  for (int i = 0; i < 4; i++) {
+    recorded.sends.push_back(capture::CapturedSend{
+        .kind = SendKind::kIndividual,
+        .interface_name = "org.astarte.Test",
+        .path = i == 3 ? "/fail" : "/value",
+        .data = Data(static_cast<double>(i)),
+        .object = std::nullopt,
+        .timestamp = captured_at + std::chrono::seconds(i),
+        .offset = std::chrono::milliseconds(5 * i),
+        .duration = std::chrono::microseconds(10),
+        .succeeded = true});
+  }
+
+  RecordingDevice device;
+  auto report = capture::replay(device, recorded);
+  EXPECT_EQ(report.sends, 4);
+  EXPECT_EQ(report.failures, 1);
+  EXPECT_GE(report.elapsed, std::chrono::milliseconds(15));
+  EXPECT_LE(report.latency_p50, report.latency_max);
+  EXPECT_GT(report.throughput(), 0.0);
+  ASSERT_EQ(device.timestamps.size(), 4);
+  // Timestamps are shifted to the replay time, keeping their spacing
+  EXPECT_GT(device.timestamps[0].value(), captured_at + std::chrono::hours(1));
+  EXPECT_EQ(device.timestamps[1].value() - device.timestamps[0].value(), std::chrono::seconds(1));
+
+  RecordingDevice unshifted;
+  report = capture::replay(unshifted, recorded, {.speed = 0, .shift_timestamps = false});
+  EXPECT_EQ(report.sends, 4);
+  EXPECT_EQ(unshifted.timestamps[0].value(), captured_at);
+
+  std::ostringstream out;
+  capture::write_report(out, report);
+  EXPECT_NE(out.str().find("throughput"), std::string::npos);
+}
@@ -0,0 +1,78 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include "astarte_device_sdk/mqtt/config.hpp"
+#include "mqtt/connection/options.hpp"
+
+using astarte::device::mqtt::Config;
+using astarte::device::mqtt::DEFAULT_MAX_BUFFERED_MESSAGES;
+using astarte::device::mqtt::DEFAULT_MAX_INFLIGHT;
+using astarte::device::mqtt::connection::build_connect_options;
+using astarte::device::mqtt::connection::build_create_options;
+
+namespace {
+
+auto make_config() -> Config {
+  return Config::with_credential_secret("realm", "device_id", "secret", "http://localhost:4003",
+                                        "/tmp");
+}
+
+}  // namespace
+
+TEST(AstarteTestConnectionOptions, Defaults) {
+  auto cfg = make_config();
+
+  auto conn_opts = build_connect_options(cfg);
+  ASSERT_TRUE(conn_opts);
+  EXPECT_EQ(conn_opts->get_max_inflight(), static_cast<int>(DEFAULT_MAX_INFLIGHT));
+
+  auto create_opts = build_create_options(cfg);
+  EXPECT_EQ(create_opts.get_max_buffered_messages(),
+            static_cast<int>(DEFAULT_MAX_BUFFERED_MESSAGES));
+  EXPECT_FALSE(create_opts.get_delete_oldest_messages());
+  EXPECT_FALSE(create_opts.get_send_while_disconnected());
+}
+
+TEST(AstarteTestConnectionOptions, Custom) {
+  auto cfg = make_config();
+  cfg.max_inflight(1000)
+      .max_buffered_messages(50)
+      .delete_oldest_messages(true)
+      .send_while_disconnected(true);
+
+  auto conn_opts = build_connect_options(cfg);
+  ASSERT_TRUE(conn_opts);
+  EXPECT_EQ(conn_opts->get_max_inflight(), 1000);
+
+  auto create_opts = build_create_options(cfg);
+  EXPECT_EQ(create_opts.get_max_buffered_messages(), 50);
+  EXPECT_TRUE(create_opts.get_delete_oldest_messages());
+  EXPECT_TRUE(create_opts.get_send_while_disconnected());
+}
+
+TEST(AstarteTestConnectionOptions, PersistentSession) {
+  auto cfg = make_config();
+
+  auto conn_opts = build_connect_options(cfg);
+  ASSERT_TRUE(conn_opts);
+  EXPECT_TRUE(conn_opts->is_clean_session());
+
+  cfg.persist_server_properties(true);
+  conn_opts = build_connect_options(cfg);
+  ASSERT_TRUE(conn_opts);
+  EXPECT_FALSE(conn_opts->is_clean_session());
+}
+
+TEST(AstarteTestConnectionOptions, InvalidValues) {
+  auto cfg = make_config();
+  cfg.max_inflight(0);
+  EXPECT_FALSE(build_connect_options(cfg));
+
+  cfg.max_inflight(DEFAULT_MAX_INFLIGHT).keepalive(5).connection_timeout(5);
+  EXPECT_FALSE(build_connect_options(cfg));
+}
+#endif
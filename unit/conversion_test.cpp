@@ -8,12 +8,42 @@
 #include "astarte_device_sdk/data.hpp"
 
 #if defined(ASTARTE_TRANSPORT_GRPC)
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
 #include "grpc/grpc_converter.hpp"
 
 using astarte::device::Data;
+using astarte::device::Ownership;
+using astarte::device::StoredPropertyView;
 using astarte::device::grpc::gRPCAstarteData;
 using astarte::device::grpc::GrpcConverterFrom;
 using astarte::device::grpc::GrpcConverterTo;
+using astarte::device::grpc::gRPCOwnership;
+using astarte::device::grpc::gRPCStoredProperties;
+
+namespace {
+
+auto make_stored_properties() -> gRPCStoredProperties {
+  gRPCStoredProperties stored;
+  const std::array<std::string, 3> interfaces = {"org.astarte.First", "org.astarte.First",
+                                                 "org.astarte.Second"};
+  for (int32_t i = 0; i < 3; i++) {
+    auto* property = stored.add_properties();
+    property->set_interface_name(interfaces.at(i));
+    property->set_path("/sensor" + std::to_string(i));
+    property->set_version_major(1);
+    property->set_ownership(gRPCOwnership::DEVICE);
+    property->mutable_data()->set_integer(i);
+  }
+  return stored;
+}
+
+}  // namespace
 
 TEST(AstarteTestConversion, DataToGrpc) {
   int32_t value = 199;
@@ -26,4 +56,34 @@ TEST(AstarteTestConversion, DataToGrpc) {
   Data original = converter(*grpc_individual).value();
   EXPECT_EQ(original.into<int32_t>(), value);
 }
+
+TEST(AstarteTestConversion, StoredPropertiesToVector) {
+  auto stored = make_stored_properties();
+  auto properties = GrpcConverterFrom{}.to_vector(stored);
+  ASSERT_TRUE(properties);
+  ASSERT_EQ(properties->size(), 3);
+  EXPECT_EQ(properties->at(1).get_path(), "/sensor1");
+  EXPECT_EQ(properties->at(1).get_ownership(), Ownership::kDevice);
+  EXPECT_EQ(properties->at(1).get_value().into<int32_t>(), 1);
+  // Properties of the same interface share the interface name
+  EXPECT_EQ(&properties->at(0).get_interface_name(), &properties->at(1).get_interface_name());
+  EXPECT_EQ(properties->at(2).get_interface_name(), "org.astarte.Second");
+
+  auto list = GrpcConverterFrom{}(stored);
+  ASSERT_TRUE(list);
+  EXPECT_TRUE(std::equal(list->begin(), list->end(), properties->begin(), properties->end()));
+}
+
+TEST(AstarteTestConversion, StoredPropertiesVisit) {
+  auto stored = make_stored_properties();
+  int32_t visited = 0;
+  auto res = GrpcConverterFrom{}.visit(stored, [&](const StoredPropertyView& property) {
+    EXPECT_EQ(property.get_path(), "/sensor" + std::to_string(visited));
+    EXPECT_EQ(property.get_value().into<int32_t>(), visited);
+    EXPECT_EQ(property.to_stored_property().get_interface_name(), property.get_interface_name());
+    visited++;
+  });
+  EXPECT_TRUE(res);
+  EXPECT_EQ(visited, 3);
+}
 #endif
@@ -7,7 +7,7 @@
 
 #include "astarte_device_sdk/formatter.hpp"
 
-#if !defined(ASTARTE_TRANSPORT_GRPC)
+#if defined(ASTARTE_TRANSPORT_MQTT)
 #include "mqtt/crypto.hpp"
 
 using astarte::device::mqtt::Crypto;
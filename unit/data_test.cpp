@@ -8,6 +8,9 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "astarte_device_sdk/formatter.hpp"
@@ -337,3 +340,17 @@ TEST(AstarteTestData, TryIntoDatetimeArray) {
   auto original = data.try_into<std::vector<std::chrono::system_clock::time_point>>();
   EXPECT_THAT(original.value(), ContainerEq(value));
 }
+
+TEST(AstarteTestData, AstarteTypeAtCompileTime) {
+  static_assert(astarte::device::k_astarte_type<int32_t> == Type::kInteger);
+  static_assert(astarte::device::k_astarte_type<std::string_view> == Type::kString);
+  static_assert(astarte::device::k_astarte_type<std::vector<bool>> == Type::kBooleanArray);
+  static_assert(astarte::device::k_astarte_type<
+                    std::vector<std::chrono::system_clock::time_point>> == Type::kDatetimeArray);
+
+  EXPECT_EQ(Data(int64_t{3}).get_type(), astarte::device::k_astarte_type<int64_t>);
+  EXPECT_EQ(Data(std::string_view("text")).get_type(), Type::kString);
+  EXPECT_EQ(Data(std::vector<uint8_t>{0x01U}).get_type(), Type::kBinaryBlob);
+  EXPECT_EQ(Data(std::vector<std::vector<uint8_t>>{{0x01U}}).get_type(), Type::kBinaryBlobArray);
+  EXPECT_EQ(Data(std::chrono::system_clock::now()).get_type(), Type::kDatetime);
+}
@@ -5,7 +5,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#if !defined(ASTARTE_TRANSPORT_GRPC)
+#if defined(ASTARTE_TRANSPORT_MQTT)
 #include "astarte_device_sdk/mqtt/pairing.hpp"
 
 using astarte::device::mqtt::create_deterministic_device_id;
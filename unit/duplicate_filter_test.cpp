@@ -0,0 +1,77 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <chrono>
+#include <string>
+
+#include "mqtt/connection/duplicate_filter.hpp"
+
+using astarte::device::mqtt::connection::DuplicateFilter;
+using namespace std::chrono_literals;
+
+namespace {
+
+const DuplicateFilter::Clock::time_point start{};
+
+}  // namespace
+
+TEST(AstarteTestDuplicateFilter, DiscardsRedeliveries) {
+  DuplicateFilter filter(16, 10s);
+
+  EXPECT_FALSE(filter.check("realm/device/interface/path", "payload", start));
+  EXPECT_TRUE(filter.check("realm/device/interface/path", "payload", start + 1s));
+  EXPECT_FALSE(filter.check("realm/device/interface/path", "other payload", start + 1s));
+  EXPECT_FALSE(filter.check("realm/device/interface/other", "payload", start + 1s));
+  EXPECT_EQ(filter.size(), 3);
+}
+
+TEST(AstarteTestDuplicateFilter, TopicAndPayloadAreSeparated) {
+  EXPECT_NE(DuplicateFilter::fingerprint("realm/device/path", "ab"),
+            DuplicateFilter::fingerprint("realm/device/patha", "b"));
+}
+
+TEST(AstarteTestDuplicateFilter, ForgetsAfterWindow) {
+  DuplicateFilter filter(16, 10s);
+
+  EXPECT_FALSE(filter.check("realm/device/interface/path", "payload", start));
+  EXPECT_TRUE(filter.check("realm/device/interface/path", "payload", start + 9s));
+  // The window starts from the first reception, redeliveries do not extend it
+  EXPECT_FALSE(filter.check("realm/device/interface/path", "payload", start + 10s));
+  EXPECT_EQ(filter.size(), 1);
+}
+
+TEST(AstarteTestDuplicateFilter, ForgetsOldestWhenFull) {
+  DuplicateFilter filter(4, 10s);
+
+  for (int i = 0; i < 5; i++) {
+    EXPECT_FALSE(filter.check("realm/device/interface/path", std::to_string(i), start));
+  }
+  EXPECT_EQ(filter.size(), filter.capacity());
+  EXPECT_FALSE(filter.check("realm/device/interface/path", "0", start));
+  EXPECT_TRUE(filter.check("realm/device/interface/path", "4", start));
+}
+
+TEST(AstarteTestDuplicateFilter, SustainedTraffic) {
+  // Cycle many times through the ring and the hash table, exercising the backward shift deletion
+  DuplicateFilter filter(64, 1h);
+
+  for (int i = 0; i < 100000; i++) {
+    const auto payload = std::to_string(i);
+    ASSERT_FALSE(filter.check("realm/device/interface/path", payload, start)) << i;
+    ASSERT_TRUE(filter.check("realm/device/interface/path", payload, start)) << i;
+    if (i >= 63) {
+      ASSERT_TRUE(filter.check("realm/device/interface/path", std::to_string(i - 63), start))
+          << i;
+    }
+  }
+  EXPECT_EQ(filter.size(), filter.capacity());
+
+  filter.clear();
+  EXPECT_EQ(filter.size(), 0);
+  EXPECT_FALSE(filter.check("realm/device/interface/path", "99999", start));
+}
+#endif
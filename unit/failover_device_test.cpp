@@ -0,0 +1,557 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/failover_device.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/device.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/flight_recorder.hpp"
+#include "astarte_device_sdk/msg.hpp"
+#include "astarte_device_sdk/object.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+#include "astarte_device_sdk/property.hpp"
+#include "astarte_device_sdk/stored_property.hpp"
+
+namespace astarte_tl = astarte::device::astarte_tl;
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::Device;
+using astarte::device::Error;
+using astarte::device::FailoverDevice;
+using astarte::device::FailoverOptions;
+using astarte::device::FailoverRoute;
+using astarte::device::InvalidInputError;
+using astarte::device::Message;
+using astarte::device::OperationRefusedError;
+using astarte::device::Ownership;
+using astarte::device::PropertyIndividual;
+using astarte::device::StoredProperty;
+using astarte::device::StoredPropertyView;
+
+namespace {
+
+// Astarte device identity shared by several fake devices, recording whether two of them have been
+// connected at the same time.
+struct Identity {
+  std::atomic_int connected{0};
+  std::atomic_bool overlapped{false};
+};
+
+// Device with a connection controlled by the test, recording the paths of the sends it accepts.
+// Once connected the device reconnects on its own when it becomes reachable again, until it is
+// disconnected.
+class FakeDevice : public Device {
+ public:
+  auto add_interface_from_file(const std::filesystem::path& json_file)
+      -> astarte_tl::expected<void, Error> override {
+    return add_interface_from_str(json_file.string());
+  }
+  auto add_interface_from_str(std::string_view json)
+      -> astarte_tl::expected<void, Error> override {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    interfaces_.emplace_back(json);
+    return {};
+  }
+  auto remove_interface(const std::string& interface_name)
+      -> astarte_tl::expected<void, Error> override {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    std::erase(interfaces_, interface_name);
+    return {};
+  }
+  auto connect() -> astarte_tl::expected<void, Error> override {
+    const std::lock_guard<std::mutex> lock(state_mutex_);
+    connects_++;
+    started_ = true;
+    if (!reachable_) {
+      return astarte_tl::unexpected(OperationRefusedError("unreachable"));
+    }
+    set_connected(true);
+    return {};
+  }
+  [[nodiscard]] auto is_connected() const -> bool override { return connected_.load(); }
+  auto disconnect() -> astarte_tl::expected<void, Error> override {
+    const std::lock_guard<std::mutex> lock(state_mutex_);
+    started_ = false;
+    set_connected(false);
+    return {};
+  }
+
+  auto send_individual(std::string_view /*interface_name*/, std::string_view path,
+                       const Data& /*data*/,
+                       const std::chrono::system_clock::time_point* /*timestamp*/)
+      -> astarte_tl::expected<void, Error> override {
+    return accept(path);
+  }
+  auto send_object(std::string_view /*interface_name*/, std::string_view path,
+                   const DatastreamObject& /*object*/,
+                   const std::chrono::system_clock::time_point* /*timestamp*/)
+      -> astarte_tl::expected<void, Error> override {
+    return accept(path);
+  }
+  auto set_property(std::string_view /*interface_name*/, std::string_view path,
+                    const Data& /*data*/) -> astarte_tl::expected<void, Error> override {
+    return accept(path);
+  }
+  auto unset_property(std::string_view /*interface_name*/, std::string_view path)
+      -> astarte_tl::expected<void, Error> override {
+    return accept(path);
+  }
+
+  auto poll_incoming(const std::chrono::milliseconds& /*timeout*/)
+      -> std::optional<Message> override {
+    return std::nullopt;
+  }
+  // the vector and visitor variants are left to the Device defaults
+  auto get_all_properties(const std::optional<Ownership>& /*ownership*/)
+      -> astarte_tl::expected<std::list<StoredProperty>, Error> override {
+    return std::list<StoredProperty>{StoredProperty("org.astarte-platform.test.Failover", "/p", 1,
+                                                    Ownership::kDevice, Data(7))};
+  }
+  auto get_properties(std::string_view /*interface_name*/)
+      -> astarte_tl::expected<std::list<StoredProperty>, Error> override {
+    return get_all_properties(std::nullopt);
+  }
+  auto get_property(std::string_view /*interface_name*/, std::string_view /*path*/)
+      -> astarte_tl::expected<PropertyIndividual, Error> override {
+    return astarte_tl::unexpected(InvalidInputError("no property"));
+  }
+
+  // Drops the connection, as a broker or message hub outage would
+  void drop() {
+    const std::lock_guard<std::mutex> lock(state_mutex_);
+    set_connected(false);
+  }
+  void set_reachable(bool reachable) {
+    const std::lock_guard<std::mutex> lock(state_mutex_);
+    reachable_ = reachable;
+    if (reachable_ && started_) {
+      set_connected(true);
+    }
+  }
+  void share(std::shared_ptr<Identity> identity) {
+    const std::lock_guard<std::mutex> lock(state_mutex_);
+    identity_ = std::move(identity);
+  }
+  // Sends of this path block until released
+  void hold(std::string path) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    held_path_ = std::move(path);
+  }
+  void release() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      held_path_.clear();
+    }
+    held_cv_.notify_all();
+  }
+  [[nodiscard]] auto holding() const -> bool { return holding_.load(); }
+  // Paths starting with this prefix are refused while connected
+  void refuse(std::string prefix) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    refused_prefix_ = std::move(prefix);
+  }
+
+  auto sent() -> std::vector<std::string> {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return sent_;
+  }
+  auto interfaces() -> std::vector<std::string> {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return interfaces_;
+  }
+  [[nodiscard]] auto connects() const -> int { return connects_.load(); }
+
+ private:
+  auto accept(std::string_view path) -> astarte_tl::expected<void, Error> {
+    if (!connected_.load()) {
+      return astarte_tl::unexpected(OperationRefusedError("not connected"));
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    holding_.store(path == held_path_);
+    held_cv_.wait(lock, [&] { return path != held_path_; });
+    holding_.store(false);
+    if (!refused_prefix_.empty() && path.starts_with(refused_prefix_)) {
+      return astarte_tl::unexpected(InvalidInputError("refused"));
+    }
+    sent_.emplace_back(path);
+    return {};
+  }
+
+  // called with the state mutex held
+  void set_connected(bool connected) {
+    if (connected_.exchange(connected) == connected || !identity_) {
+      return;
+    }
+    if (!connected) {
+      identity_->connected--;
+    } else if (identity_->connected++ != 0) {
+      identity_->overlapped.store(true);
+    }
+  }
+
+  std::mutex state_mutex_;
+  bool reachable_{true};
+  bool started_{false};
+  std::shared_ptr<Identity> identity_;
+  std::atomic_bool connected_{false};
+  std::atomic_int connects_{0};
+  std::atomic_bool holding_{false};
+  std::mutex mutex_;
+  std::condition_variable held_cv_;
+  std::string held_path_;
+  std::vector<std::string> sent_;
+  std::vector<std::string> interfaces_;
+  std::string refused_prefix_;
+};
+
+auto fast_options() -> FailoverOptions {
+  FailoverOptions options;
+  options.failover_delay = std::chrono::milliseconds(20);
+  options.failback_delay = std::chrono::milliseconds(20);
+  options.check_interval = std::chrono::milliseconds(2);
+  return options;
+}
+
+// Waits until the condition holds, failing after a generous timeout
+auto eventually(const std::function<bool()>& condition) -> bool {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (condition()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return condition();
+}
+
+auto send(FailoverDevice& device, std::string_view path) -> astarte_tl::expected<void, Error> {
+  return device.send_individual("org.astarte-platform.test.Failover", path, Data(1), nullptr);
+}
+
+class AstarteTestFailoverDevice : public testing::Test {
+ protected:
+  std::shared_ptr<FakeDevice> primary = std::make_shared<FakeDevice>();
+  std::shared_ptr<FakeDevice> fallback = std::make_shared<FakeDevice>();
+};
+
+}  // namespace
+
+TEST_F(AstarteTestFailoverDevice, InterfacesAreInstalledOnBothDevices) {
+  FailoverDevice device(primary, fallback, fast_options());
+  ASSERT_TRUE(device.add_interface_from_str("first"));
+  ASSERT_TRUE(device.add_interface_from_str("second"));
+  ASSERT_TRUE(device.remove_interface("first"));
+
+  const std::vector<std::string> expected{"second"};
+  EXPECT_EQ(primary->interfaces(), expected);
+  EXPECT_EQ(fallback->interfaces(), expected);
+}
+
+TEST_F(AstarteTestFailoverDevice, SendsGoThroughThePrimaryDevice) {
+  FailoverDevice device(primary, fallback, fast_options());
+  ASSERT_TRUE(device.connect());
+  EXPECT_FALSE(device.connect());
+  EXPECT_TRUE(device.is_connected());
+  EXPECT_EQ(device.route(), FailoverRoute::kPrimary);
+
+  ASSERT_TRUE(send(device, "/a"));
+  ASSERT_TRUE(device.set_property("org.astarte-platform.test.Failover", "/b", Data(2)));
+  ASSERT_TRUE(device.unset_property("org.astarte-platform.test.Failover", "/c"));
+
+  const std::vector<std::string> expected{"/a", "/b", "/c"};
+  EXPECT_EQ(primary->sent(), expected);
+  EXPECT_TRUE(fallback->sent().empty());
+  EXPECT_EQ(fallback->connects(), 0);
+  ASSERT_TRUE(device.disconnect());
+  EXPECT_FALSE(primary->is_connected());
+}
+
+TEST_F(AstarteTestFailoverDevice, PropertiesComeFromTheDeviceInUse) {
+  FailoverDevice device(primary, fallback, fast_options());
+  ASSERT_TRUE(device.connect());
+
+  auto properties = device.get_all_properties_vector(std::nullopt);
+  ASSERT_TRUE(properties);
+  ASSERT_EQ(properties.value().size(), 1U);
+  EXPECT_EQ(properties.value().front().get_path(), "/p");
+
+  std::vector<std::string> visited;
+  ASSERT_TRUE(device.visit_properties(
+      "org.astarte-platform.test.Failover",
+      [&](const StoredPropertyView& view) { visited.emplace_back(view.get_path()); }));
+  const std::vector<std::string> expected{"/p"};
+  EXPECT_EQ(visited, expected);
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, RefusedSendsAreReturned) {
+  FailoverDevice device(primary, fallback, fast_options());
+  ASSERT_TRUE(device.connect());
+  primary->refuse("/bad");
+
+  EXPECT_FALSE(send(device, "/bad"));
+  EXPECT_EQ(device.buffered(), 0U);
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, SendsAreRefusedBeforeConnecting) {
+  FailoverDevice device(primary, fallback, fast_options());
+  EXPECT_FALSE(send(device, "/a"));
+  EXPECT_EQ(device.buffered(), 0U);
+}
+
+TEST_F(AstarteTestFailoverDevice, FailsOverAndBack) {
+  FailoverDevice device(primary, fallback, fast_options());
+  ASSERT_TRUE(device.connect());
+  ASSERT_TRUE(send(device, "/before"));
+
+  primary->set_reachable(false);
+  primary->drop();
+  ASSERT_TRUE(eventually([&] { return device.route() == FailoverRoute::kFallback; }));
+  EXPECT_FALSE(primary->is_connected());
+  ASSERT_TRUE(send(device, "/during"));
+  ASSERT_TRUE(eventually([&] { return fallback->sent().size() == 1; }));
+
+  primary->set_reachable(true);
+  ASSERT_TRUE(eventually([&] { return device.route() == FailoverRoute::kPrimary; }));
+  EXPECT_FALSE(fallback->is_connected());
+  ASSERT_TRUE(send(device, "/after"));
+
+  EXPECT_EQ(primary->sent(), (std::vector<std::string>{"/before", "/after"}));
+  EXPECT_EQ(fallback->sent(), (std::vector<std::string>{"/during"}));
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, DevicesAreNeverConnectedAtTheSameTime) {
+  auto identity = std::make_shared<Identity>();
+  primary->share(identity);
+  fallback->share(identity);
+  FailoverDevice device(primary, fallback, fast_options());
+  ASSERT_TRUE(device.connect());
+
+  for (int outage = 0; outage < 3; outage++) {
+    primary->set_reachable(false);
+    primary->drop();
+    ASSERT_TRUE(eventually([&] { return device.route() == FailoverRoute::kFallback; }));
+    // the primary device is tried again during the outage
+    const int connects = primary->connects();
+    ASSERT_TRUE(eventually([&] { return primary->connects() >= connects + 2; }));
+
+    // the primary device would reconnect on its own if it had not been stopped
+    primary->set_reachable(true);
+    ASSERT_TRUE(eventually([&] { return device.route() == FailoverRoute::kPrimary; }));
+  }
+  ASSERT_TRUE(device.disconnect());
+  EXPECT_FALSE(identity->overlapped.load());
+  EXPECT_EQ(identity->connected.load(), 0);
+}
+
+TEST_F(AstarteTestFailoverDevice, BufferedSendsAreFlushedInOrder) {
+  auto options = fast_options();
+  options.failover_delay = std::chrono::hours(1);
+  FailoverDevice device(primary, fallback, options);
+  ASSERT_TRUE(device.connect());
+
+  primary->drop();
+  EXPECT_EQ(device.route(), FailoverRoute::kBuffering);
+  EXPECT_FALSE(device.is_connected());
+  ASSERT_TRUE(send(device, "/first"));
+  ASSERT_TRUE(device.send_object("org.astarte-platform.test.Failover", "/second",
+                                 DatastreamObject{{"value", Data(2)}}, nullptr));
+  primary->refuse("/third");
+  ASSERT_TRUE(send(device, "/third"));
+  EXPECT_EQ(device.buffered(), 3U);
+
+  // the monitor flushes the buffer as soon as the primary device is connected again
+  ASSERT_TRUE(primary->connect());
+  ASSERT_TRUE(eventually([&] { return device.buffered() == 0; }));
+  ASSERT_TRUE(send(device, "/fourth"));
+
+  EXPECT_EQ(primary->sent(), (std::vector<std::string>{"/first", "/second", "/fourth"}));
+  EXPECT_TRUE(fallback->sent().empty());
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, SendsAreBufferedWhileTheBufferDrains) {
+  auto options = fast_options();
+  options.failover_delay = std::chrono::hours(1);
+  FailoverDevice device(primary, fallback, options);
+  ASSERT_TRUE(device.connect());
+
+  primary->drop();
+  ASSERT_TRUE(send(device, "/first"));
+  ASSERT_TRUE(send(device, "/second"));
+  primary->hold("/first");
+  ASSERT_TRUE(primary->connect());
+  ASSERT_TRUE(eventually([&] { return primary->holding(); }));
+
+  // the monitor is blocked sending the buffer, the new send waits behind it without blocking
+  ASSERT_TRUE(send(device, "/third"));
+  EXPECT_EQ(device.buffered(), 3U);
+  primary->release();
+  ASSERT_TRUE(eventually([&] { return device.buffered() == 0; }));
+
+  EXPECT_EQ(primary->sent(), (std::vector<std::string>{"/first", "/second", "/third"}));
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, ConcurrentConnectsStartASingleMonitor) {
+  FailoverDevice device(primary, fallback, fast_options());
+  std::atomic_int connected{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&] {
+      if (device.connect()) {
+        connected++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(connected.load(), 1);
+  EXPECT_EQ(primary->connects(), 1);
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, FullBufferRefusesSends) {
+  auto options = fast_options();
+  options.failover_delay = std::chrono::hours(1);
+  options.buffer_capacity = 2;
+  FailoverDevice device(primary, fallback, options);
+  primary->set_reachable(false);
+  ASSERT_TRUE(device.connect());
+
+  ASSERT_TRUE(send(device, "/a"));
+  ASSERT_TRUE(send(device, "/b"));
+  auto res = send(device, "/c");
+  ASSERT_FALSE(res);
+  EXPECT_TRUE(std::holds_alternative<OperationRefusedError>(res.error()));
+  EXPECT_EQ(device.buffered(), 2U);
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, UnreachableFallbackIsRetried) {
+  FailoverDevice device(primary, fallback, fast_options());
+  primary->set_reachable(false);
+  fallback->set_reachable(false);
+  ASSERT_TRUE(device.connect());
+
+  ASSERT_TRUE(eventually([&] { return fallback->connects() >= 2; }));
+  EXPECT_EQ(device.route(), FailoverRoute::kBuffering);
+  ASSERT_TRUE(send(device, "/a"));
+
+  fallback->set_reachable(true);
+  ASSERT_TRUE(eventually([&] { return device.route() == FailoverRoute::kFallback; }));
+  ASSERT_TRUE(eventually([&] { return device.buffered() == 0; }));
+  EXPECT_EQ(fallback->sent(), (std::vector<std::string>{"/a"}));
+  ASSERT_TRUE(device.disconnect());
+  EXPECT_FALSE(fallback->is_connected());
+}
+
+TEST_F(AstarteTestFailoverDevice, DisconnectFlushesTheBuffer) {
+  auto options = fast_options();
+  options.failover_delay = std::chrono::hours(1);
+  // the monitor checks the devices once, the buffer is left to the disconnection
+  options.check_interval = std::chrono::hours(1);
+  FailoverDevice device(primary, fallback, options);
+  ASSERT_TRUE(device.connect());
+
+  primary->drop();
+  ASSERT_TRUE(send(device, "/first"));
+  ASSERT_TRUE(send(device, "/second"));
+  ASSERT_TRUE(primary->connect());
+  EXPECT_EQ(device.buffered(), 2U);
+
+  ASSERT_TRUE(device.disconnect());
+  EXPECT_EQ(device.buffered(), 0U);
+  EXPECT_EQ(primary->sent(), (std::vector<std::string>{"/first", "/second"}));
+}
+
+TEST_F(AstarteTestFailoverDevice, DisconnectDropsUndeliverableSends) {
+  namespace flight_recorder = astarte::device::flight_recorder;
+  flight_recorder::clear();
+  auto options = fast_options();
+  options.failover_delay = std::chrono::hours(1);
+  FailoverDevice device(primary, fallback, options);
+  primary->set_reachable(false);
+  ASSERT_TRUE(device.connect());
+
+  ASSERT_TRUE(send(device, "/a"));
+  ASSERT_TRUE(send(device, "/b"));
+  ASSERT_TRUE(device.disconnect());
+  EXPECT_EQ(device.buffered(), 0U);
+
+  auto events = flight_recorder::snapshot();
+  auto dropped = std::find_if(events.begin(), events.end(), [](const auto& event) {
+    return event.kind == flight_recorder::EventKind::kFailoverBufferDropped;
+  });
+  ASSERT_NE(dropped, events.end());
+  EXPECT_EQ(dropped->value, 2);
+
+  // the dropped sends are not replayed on the next connection
+  primary->set_reachable(true);
+  ASSERT_TRUE(device.connect());
+  ASSERT_TRUE(send(device, "/c"));
+  EXPECT_EQ(primary->sent(), (std::vector<std::string>{"/c"}));
+  ASSERT_TRUE(device.disconnect());
+}
+
+TEST_F(AstarteTestFailoverDevice, SendsDoNotOvertakeTheBufferWhileDisconnecting) {
+  namespace flight_recorder = astarte::device::flight_recorder;
+  flight_recorder::clear();
+  auto options = fast_options();
+  options.failover_delay = std::chrono::hours(1);
+  options.check_interval = std::chrono::hours(1);
+  FailoverDevice device(primary, fallback, options);
+  primary->set_reachable(false);
+  ASSERT_TRUE(device.connect());
+  // the monitor records the buffering route on its only check, the buffer is then left to the
+  // disconnection
+  ASSERT_TRUE(eventually([] {
+    auto events = flight_recorder::snapshot();
+    return std::any_of(events.begin(), events.end(), [](const auto& event) {
+      return event.kind == flight_recorder::EventKind::kFailoverRoute;
+    });
+  }));
+
+  ASSERT_TRUE(send(device, "/first"));
+  ASSERT_TRUE(send(device, "/second"));
+  primary->set_reachable(true);
+  primary->hold("/first");
+  ASSERT_TRUE(primary->connect());
+
+  std::thread disconnecting([&] { EXPECT_TRUE(device.disconnect()); });
+  EXPECT_TRUE(eventually([&] { return primary->holding(); }));
+
+  // the disconnection is flushing the buffer, the send is refused rather than sent first
+  auto res = send(device, "/third");
+  primary->release();
+  disconnecting.join();
+  ASSERT_FALSE(res);
+  EXPECT_TRUE(std::holds_alternative<OperationRefusedError>(res.error()));
+
+  EXPECT_EQ(primary->sent(), (std::vector<std::string>{"/first", "/second"}));
+  EXPECT_EQ(device.buffered(), 0U);
+}
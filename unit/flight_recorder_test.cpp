@@ -0,0 +1,109 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/flight_recorder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flight_recorder_event.hpp"
+
+namespace flight_recorder = astarte::device::flight_recorder;
+using flight_recorder::EventKind;
+
+class AstarteTestFlightRecorder : public ::testing::Test {
+ protected:
+  void SetUp() override { flight_recorder::clear(); }
+  void TearDown() override { flight_recorder::clear(); }
+};
+
+TEST_F(AstarteTestFlightRecorder, RecordsInOrder) {
+  flight_recorder::record(EventKind::kConnectAttempt);
+  flight_recorder::record(EventKind::kBackoffDelay, 2000);
+  flight_recorder::record(EventKind::kConnected);
+
+  auto events = flight_recorder::snapshot();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].kind, EventKind::kConnectAttempt);
+  EXPECT_EQ(events[1].kind, EventKind::kBackoffDelay);
+  EXPECT_EQ(events[1].value, 2000);
+  EXPECT_EQ(events[2].kind, EventKind::kConnected);
+  EXPECT_LE(events[0].timestamp_ns, events[2].timestamp_ns);
+
+  flight_recorder::clear();
+  EXPECT_TRUE(flight_recorder::snapshot().empty());
+}
+
+TEST_F(AstarteTestFlightRecorder, KeepsMostRecentEvents) {
+  const auto total = static_cast<int64_t>(flight_recorder::k_capacity) + 100;
+  for (int64_t i = 0; i < total; i++) {
+    flight_recorder::record(EventKind::kReceiveQueueDepth, i);
+  }
+
+  auto events = flight_recorder::snapshot();
+  ASSERT_EQ(events.size(), flight_recorder::k_capacity);
+  EXPECT_EQ(events.front().value, 100);
+  EXPECT_EQ(events.back().value, total - 1);
+}
+
+TEST_F(AstarteTestFlightRecorder, ConcurrentRecording) {
+  constexpr int k_threads = 4;
+  constexpr int k_per_thread = 200;
+  std::vector<std::thread> threads;
+  threads.reserve(k_threads);
+  for (int t = 0; t < k_threads; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < k_per_thread; i++) {
+        flight_recorder::record(EventKind::kPublishSucceeded, 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(flight_recorder::snapshot().size(), k_threads * k_per_thread);
+}
+
+TEST_F(AstarteTestFlightRecorder, TextDump) {
+  flight_recorder::record(EventKind::kStreamError, 14);
+  std::ostringstream out;
+  flight_recorder::write_text(out);
+  EXPECT_NE(out.str().find("stream_error 14\n"), std::string::npos);
+}
+
+#if !defined(_WIN32)
+TEST_F(AstarteTestFlightRecorder, BinaryDumpRoundTrip) {
+  flight_recorder::record(EventKind::kConnectionLost, 3);
+  flight_recorder::record(EventKind::kPublishFailed, -1);
+
+  std::FILE* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  ASSERT_TRUE(flight_recorder::write_binary(fileno(file)));
+  std::rewind(file);
+  std::vector<uint8_t> dump;
+  for (int chr = std::fgetc(file); chr != EOF; chr = std::fgetc(file)) {
+    dump.push_back(static_cast<uint8_t>(chr));
+  }
+  (void)std::fclose(file);
+
+  auto events = flight_recorder::parse_binary(dump);
+  ASSERT_TRUE(events);
+  ASSERT_EQ(events->size(), 2);
+  EXPECT_EQ(events->at(0).kind, EventKind::kConnectionLost);
+  EXPECT_EQ(events->at(0).value, 3);
+  EXPECT_EQ(events->at(1).kind, EventKind::kPublishFailed);
+  EXPECT_EQ(events->at(1).value, -1);
+
+  dump.pop_back();
+  EXPECT_FALSE(flight_recorder::parse_binary(dump));
+  dump.at(0) = 'X';
+  EXPECT_FALSE(flight_recorder::parse_binary(dump));
+}
+#endif
@@ -6,13 +6,17 @@
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
 
-#if !defined(ASTARTE_TRANSPORT_GRPC)
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <nlohmann/json.hpp>
 #include <string_view>
+#include <utility>
 #include <variant>
+#include <vector>
 
+#include "astarte_device_sdk/formatter.hpp"
 #include "mqtt/introspection.hpp"
 
 using astarte::device::astarte_type_from_str;
@@ -243,6 +247,72 @@ TEST(AstarteTestInterface, ConvertFromJson) {
               IsUnexpected("Field mappings has invalid type"));
 }
 
+TEST(AstarteTestInterface, ConvertFromStrMatchesJson) {
+  json base = {{"interface_name", "test.Test"},
+               {"version_major", 1},
+               {"version_minor", 0},
+               {"type", "properties"},
+               {"ownership", "server"},
+               {"aggregation", "individual"},
+               {"description", "test"},
+               {"mappings", json::array({{{"endpoint", "/%{id}/value"},
+                                          {"type", "longinteger"},
+                                          {"reliability", "unique"},
+                                          {"retention", "volatile"},
+                                          {"expiry", 60},
+                                          {"database_retention_policy", "use_ttl"},
+                                          {"database_retention_ttl", 120},
+                                          {"allow_unset", true},
+                                          {"doc", "doc"}},
+                                         {{"endpoint", "/flag"},
+                                          {"type", "boolean"},
+                                          {"reliability", "wrong"},
+                                          {"explicit_timestamp", "wrong"}}})}};
+
+  std::vector<json> cases{base};
+  for (const auto* key : {"interface_name", "version_major", "version_minor", "type", "ownership",
+                          "aggregation", "description", "mappings"}) {
+    auto missing = base;
+    missing.erase(key);
+    cases.push_back(missing);
+    auto wrong_type = base;
+    wrong_type[key] = json::array({1});
+    cases.push_back(wrong_type);
+  }
+  auto negative_version = base;
+  negative_version["version_minor"] = -1;
+  cases.push_back(negative_version);
+  auto no_mappings = base;
+  no_mappings["mappings"] = json::array();
+  cases.push_back(no_mappings);
+  auto wrong_mapping = base;
+  wrong_mapping["mappings"].push_back("not an object");
+  cases.push_back(wrong_mapping);
+  auto missing_endpoint = base;
+  missing_endpoint["mappings"][1].erase("endpoint");
+  cases.push_back(missing_endpoint);
+
+  // both JSON backends must agree with the DOM based parser
+  for (const auto& interface_json : cases) {
+    auto from_json = Interface::try_from_json(interface_json);
+    auto from_str = Interface::try_from_str(interface_json.dump());
+    ASSERT_EQ(from_json.has_value(), from_str.has_value()) << interface_json.dump();
+    if (from_json) {
+      ASSERT_EQ(astarte_fmt::format("{}", from_json.value()),
+                astarte_fmt::format("{}", from_str.value()));
+    } else {
+      ASSERT_EQ(astarte_fmt::format("{}", from_json.error()),
+                astarte_fmt::format("{}", from_str.error()));
+    }
+  }
+
+  // malformed JSON
+  ASSERT_THAT(Interface::try_from_str(R"({"interface_name": )"),
+              IsUnexpected("failed to parse interface from json"));
+  ASSERT_THAT(Interface::try_from_str(base.dump() + "}"),
+              IsUnexpected("failed to parse interface from json"));
+}
+
 class AstarteTestInterfaceValidation : public testing::Test {
  protected:
   auto create_test_interface(std::string_view path, std::string_view type, bool explicit_ts)
@@ -436,6 +506,50 @@ TEST(AstarteTestInterfaceGetQoS, GetQosLevels) {
   EXPECT_THAT(obj_iface.get_qos("/random"), IsExpected(1));
 }
 
+TEST(AstarteTestInterfaceResolve, ResolveIndividual) {
+  json iface_json = {
+      {"interface_name", "test.Individual"},
+      {"version_major", 1},
+      {"version_minor", 0},
+      {"type", "datastream"},
+      {"ownership", "device"},
+      {"mappings", json::array({{{"endpoint", "/stored"},
+                                 {"type", "integer"},
+                                 {"explicit_timestamp", true},
+                                 {"reliability", "unique"},
+                                 {"retention", "stored"},
+                                 {"expiry", 60}},
+                                {{"endpoint", "/default"}, {"type", "integer"}}})}};
+
+  auto iface_res = Interface::try_from_json(iface_json);
+  ASSERT_THAT(iface_res, IsExpected());
+  const auto& iface = iface_res.value();
+  const auto timestamp = std::chrono::system_clock::now();
+
+  auto stored = iface.resolve_individual("/stored", Data(42), &timestamp);
+  ASSERT_THAT(stored, IsExpected());
+  EXPECT_EQ(stored->mapping, &iface.mappings()[0]);
+  EXPECT_EQ(stored->qos, 2);
+  EXPECT_EQ(stored->retention, Retention::Value::kStored);
+  EXPECT_EQ(stored->expiry, 60);
+  EXPECT_TRUE(stored->explicit_timestamp);
+
+  auto fallback = iface.resolve_individual("/default", Data(42), nullptr);
+  ASSERT_THAT(fallback, IsExpected());
+  EXPECT_EQ(fallback->mapping, &iface.mappings()[1]);
+  EXPECT_EQ(fallback->qos, 0);
+  EXPECT_EQ(fallback->retention, Retention::Value::kDiscard);
+  EXPECT_EQ(fallback->expiry, 0);
+  EXPECT_FALSE(fallback->explicit_timestamp);
+
+  EXPECT_THAT(iface.resolve_individual("/stored", Data(42), nullptr),
+              IsUnexpected("Explicit timestamp required"));
+  EXPECT_THAT(iface.resolve_individual("/stored", Data(1.5), &timestamp),
+              IsUnexpected("Astarte data type and mapping type do not match"));
+  EXPECT_THAT(iface.resolve_individual("/missing", Data(42), nullptr),
+              IsUnexpected("couldn't find mapping"));
+}
+
 constexpr std::string_view interface_str = R"({
   "interface_name": "test.Test",
     "version_major": 0,
@@ -573,4 +687,31 @@ TEST_F(AstarteTestIntrospection, ValidateObject) {
               IsUnexpected("couldn't find mapping with path"));
 }
 
+TEST_F(AstarteTestIntrospection, ResolveObject) {
+  json mappings = base_json_["mappings"];
+  for (auto& mapping : mappings) {
+    mapping["reliability"] = "unique";
+  }
+  auto iface = update({{"mappings", mappings}});
+  // the index built on construction must survive moving the interface
+  const auto moved = std::move(iface);
+
+  DatastreamObject obj_data = {{"double_endpoint", Data(1.5)}, {"integer_endpoint", Data(42)}};
+  auto descriptor = moved.resolve_object("/1", obj_data, nullptr);
+  ASSERT_THAT(descriptor, IsExpected());
+  EXPECT_EQ(descriptor->mapping, &moved.mappings().front());
+  EXPECT_EQ(descriptor->qos, 2);
+
+  EXPECT_THAT(moved.resolve_object("/1/2", obj_data, nullptr),
+              IsUnexpected("couldn't find mapping with path /1/2"));
+
+  DatastreamObject unknown_field = {{"double_endpoint", Data(1.5)}, {"unknown", Data(1.0)}};
+  EXPECT_THAT(moved.resolve_object("/1", unknown_field, nullptr),
+              IsUnexpected("couldn't find mapping with path /1/unknown"));
+
+  const auto timestamp = std::chrono::system_clock::now();
+  EXPECT_THAT(moved.resolve_object("/1", obj_data, &timestamp),
+              IsUnexpected("Explicit timestamp not supported for interface test.Test, path /1/"));
+}
+
 #endif
@@ -0,0 +1,63 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/mqtt/errors.hpp"
+#include "mqtt/json_backend.hpp"
+
+using astarte::device::mqtt::JsonParsingError;
+using astarte::device::mqtt::json_backend::value_at;
+
+namespace {
+
+constexpr std::string_view k_response = R"({
+  "data": {
+    "client_crt": "-----BEGIN CERTIFICATE-----\nMIIB\n-----END CERTIFICATE-----\n",
+    "valid": true,
+    "protocols": {"astarte_mqtt_v1": {"broker_url": "mqtts://broker.astarte.localhost:8883/"}}
+  }
+})";
+
+}  // namespace
+
+TEST(AstarteTestJsonBackend, ExtractsValues) {
+  auto cert = value_at<std::string>(k_response, "/data/client_crt");
+  ASSERT_TRUE(cert);
+  EXPECT_EQ(cert.value(), "-----BEGIN CERTIFICATE-----\nMIIB\n-----END CERTIFICATE-----\n");
+
+  auto url = value_at<std::string>(k_response, "/data/protocols/astarte_mqtt_v1/broker_url");
+  ASSERT_TRUE(url);
+  EXPECT_EQ(url.value(), "mqtts://broker.astarte.localhost:8883/");
+
+  auto valid = value_at<bool>(k_response, "/data/valid");
+  ASSERT_TRUE(valid);
+  EXPECT_TRUE(valid.value());
+}
+
+TEST(AstarteTestJsonBackend, RejectsInvalidDocuments) {
+  auto missing = value_at<std::string>(k_response, "/data/credentials_secret");
+  ASSERT_FALSE(missing);
+  ASSERT_TRUE(std::holds_alternative<JsonParsingError>(missing.error()));
+  EXPECT_NE(std::get<JsonParsingError>(missing.error()).message().find("not found"),
+            std::string::npos);
+
+  auto wrong_type = value_at<bool>(k_response, "/data/client_crt");
+  ASSERT_FALSE(wrong_type);
+  EXPECT_NE(std::get<JsonParsingError>(wrong_type.error()).message().find("is not a boolean"),
+            std::string::npos);
+
+  auto invalid = value_at<std::string>(R"({"data": )", "/data");
+  ASSERT_FALSE(invalid);
+  EXPECT_NE(std::get<JsonParsingError>(invalid.error()).message().find("Invalid JSON"),
+            std::string::npos);
+}
+
+#endif
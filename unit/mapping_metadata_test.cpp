@@ -0,0 +1,107 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/type.hpp"
+#include "mqtt/mapping.hpp"
+
+using astarte::device::Data;
+using astarte::device::InterfaceValidationError;
+using astarte::device::Type;
+using astarte::device::mqtt::Mapping;
+using astarte::device::mqtt::MappingMetadata;
+using astarte::device::mqtt::Reliability;
+using astarte::device::mqtt::Retention;
+
+TEST(AstarteTestMappingMetadata, PacksEveryField) {
+  constexpr MappingMetadata metadata(Type::kStringArray, true, Reliability(Reliability::kUnique),
+                                     Retention(Retention::kStored), 3600, true);
+  static_assert(metadata.type() == Type::kStringArray);
+
+  EXPECT_EQ(metadata.qos(), 2);
+  EXPECT_EQ(metadata.retention(), Retention::kStored);
+  EXPECT_EQ(metadata.timestamp(), MappingMetadata::Timestamp::kRequired);
+  EXPECT_TRUE(metadata.allow_unset());
+  EXPECT_EQ(metadata.expiry(), 3600);
+}
+
+TEST(AstarteTestMappingMetadata, DefaultsTheMissingFields) {
+  const MappingMetadata metadata(Type::kDouble, std::nullopt, std::nullopt, std::nullopt,
+                                 std::nullopt, std::nullopt);
+  EXPECT_EQ(metadata.type(), Type::kDouble);
+  EXPECT_EQ(metadata.qos(), 0);
+  EXPECT_EQ(metadata.retention(), Retention::kDiscard);
+  EXPECT_EQ(metadata.timestamp(), MappingMetadata::Timestamp::kAny);
+  EXPECT_FALSE(metadata.allow_unset());
+  EXPECT_EQ(metadata.expiry(), 0);
+
+  const MappingMetadata forbidden(Type::kDouble, false, std::nullopt, std::nullopt, std::nullopt,
+                                  std::nullopt);
+  EXPECT_EQ(forbidden.timestamp(), MappingMetadata::Timestamp::kForbidden);
+}
+
+TEST(AstarteTestMappingMetadata, ClampsTheExpiry) {
+  const MappingMetadata negative(Type::kInteger, std::nullopt, std::nullopt, std::nullopt, -5,
+                                 std::nullopt);
+  EXPECT_EQ(negative.expiry(), 0);
+
+  const MappingMetadata large(Type::kInteger, std::nullopt, std::nullopt, std::nullopt,
+                              std::numeric_limits<int64_t>::max(), std::nullopt);
+  EXPECT_EQ(large.expiry(), std::numeric_limits<uint32_t>::max());
+  EXPECT_EQ(large.type(), Type::kInteger);
+  EXPECT_EQ(large.qos(), 0);
+}
+
+TEST(AstarteTestMappingMetadata, IsDerivedWhenParsing) {
+  auto mapping = Mapping::try_from_json(nlohmann::json::parse(R"({
+    "endpoint": "/%{sensor_id}/value",
+    "type": "longinteger",
+    "reliability": "guaranteed",
+    "retention": "volatile",
+    "expiry": 60,
+    "explicit_timestamp": false
+  })"));
+  ASSERT_TRUE(mapping);
+
+  const MappingMetadata metadata = mapping.value().metadata();
+  EXPECT_EQ(metadata.type(), Type::kLongInteger);
+  EXPECT_EQ(metadata.qos(), 1);
+  EXPECT_EQ(metadata.retention(), Retention::kVolatile);
+  EXPECT_EQ(metadata.timestamp(), MappingMetadata::Timestamp::kForbidden);
+  EXPECT_EQ(metadata.expiry(), 60);
+  EXPECT_EQ(mapping.value().type(), Type::kLongInteger);
+}
+TEST(AstarteTestMappingMetadata, ChecksTypedValues) {
+  auto mapping = Mapping::try_from_json(nlohmann::json::parse(R"({
+    "endpoint": "/value",
+    "type": "doublearray"
+  })"));
+  ASSERT_TRUE(mapping);
+
+  EXPECT_TRUE(mapping.value().check_value(std::vector<double>{1.0, 2.5}));
+  auto nan = mapping.value().check_value(std::vector<double>{1.0, std::nan("")});
+  ASSERT_FALSE(nan);
+  EXPECT_TRUE(std::holds_alternative<InterfaceValidationError>(nan.error()));
+  auto mismatch = mapping.value().check_value(std::string_view("text"));
+  ASSERT_FALSE(mismatch);
+  EXPECT_TRUE(std::holds_alternative<InterfaceValidationError>(mismatch.error()));
+
+  // the Data checks agree with the typed ones
+  EXPECT_TRUE(mapping.value().check_data_type(Data(std::vector<double>{1.0})));
+  EXPECT_FALSE(mapping.value().check_data_type(Data(1.0)));
+}
+#endif
@@ -7,11 +7,17 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
 using astarte::device::Data;
 using astarte::device::DatastreamIndividual;
 using astarte::device::DatastreamObject;
 using astarte::device::Message;
 using astarte::device::PropertyIndividual;
+using astarte::device::SharedMessage;
 
 TEST(AstarteTestMessage, InstantiationDatastreamIndividual) {
   std::string interface("some.interface.Name");
@@ -62,3 +68,73 @@ TEST(AstarteTestMessage, InstantiationPropertyIndividual) {
   EXPECT_EQ(msg.try_into<DatastreamObject>(), std::nullopt);
   EXPECT_EQ(msg.try_into<PropertyIndividual>(), std::optional<PropertyIndividual>{data});
 }
+
+TEST(AstarteTestMessage, SharedMessageCopiesShareThePayload) {
+  std::vector<uint8_t> blob(1024, 0xAB);
+  auto shared = SharedMessage(
+      Message("some.interface.Name", "/some_endpoint", DatastreamIndividual(Data(blob))));
+  const SharedMessage copy = shared;
+
+  EXPECT_EQ(shared.use_count(), 2);
+  EXPECT_EQ(&shared.get(), &copy.get());
+  EXPECT_EQ(copy->get_path(), "/some_endpoint");
+  EXPECT_EQ((*copy).into<DatastreamIndividual>().get_value().into<std::vector<uint8_t>>(), blob);
+  EXPECT_EQ(copy, shared);
+  EXPECT_EQ(astarte_fmt::format("{}", copy), astarte_fmt::format("{}", shared.get()));
+}
+
+TEST(AstarteTestMessage, SharedMessageEquality) {
+  auto first = SharedMessage(Message("some.interface.Name", "/a", PropertyIndividual(Data(1))));
+  auto same = SharedMessage(Message("some.interface.Name", "/a", PropertyIndividual(Data(1))));
+  auto other = SharedMessage(Message("some.interface.Name", "/b", PropertyIndividual(Data(1))));
+
+  EXPECT_EQ(first, same);
+  EXPECT_NE(first, other);
+}
+
+TEST(AstarteTestMessage, SharedMessageIntoMessage) {
+  const Message expected("some.interface.Name", "/some_endpoint",
+                         DatastreamIndividual(Data(std::string(64, 'x'))));
+
+  // the only handle gives its message away
+  auto unique = SharedMessage(Message(expected));
+  const auto* address = &unique.get().into<DatastreamIndividual>().get_value();
+  const auto* payload = address->into<std::string>().data();
+  auto moved = std::move(unique).into_message();
+  EXPECT_EQ(moved, expected);
+  EXPECT_EQ(moved.into<DatastreamIndividual>().get_value().into<std::string>().data(), payload);
+
+  // a message still shared with other handles is copied
+  auto shared = SharedMessage(Message(expected));
+  const SharedMessage kept = shared;
+  auto copied = std::move(shared).into_message();
+  EXPECT_EQ(copied, expected);
+  EXPECT_EQ(kept.get(), expected);
+  EXPECT_EQ(kept.use_count(), 1);
+}
+
+TEST(AstarteTestMessage, SharedMessageMovedFromIsEmpty) {
+  auto shared = SharedMessage(Message("some.interface.Name", "/a", PropertyIndividual(Data(1))));
+  EXPECT_TRUE(shared.has_value());
+  EXPECT_TRUE(shared);
+
+  const SharedMessage moved = std::move(shared);
+  // NOLINTBEGIN(bugprone-use-after-move)
+  EXPECT_FALSE(shared.has_value());
+  EXPECT_FALSE(shared);
+  EXPECT_EQ(shared.use_count(), 0);
+  EXPECT_NE(shared, moved);
+  EXPECT_NE(moved, shared);
+  EXPECT_EQ(astarte_fmt::format("{}", shared), "{empty}");
+
+  auto converted = SharedMessage(Message(moved.get()));
+  (void)std::move(converted).into_message();
+  EXPECT_FALSE(converted);
+  EXPECT_EQ(converted, shared);
+
+  // an empty handle can be assigned a message again
+  shared = moved;
+  EXPECT_TRUE(shared);
+  EXPECT_EQ(shared, moved);
+  // NOLINTEND(bugprone-use-after-move)
+}
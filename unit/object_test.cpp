@@ -0,0 +1,92 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/object.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "allocation_counter.hpp"
+#include "astarte_device_sdk/data.hpp"
+
+using astarte::device::Data;
+using astarte::device::DatastreamObject;
+using astarte::device::unit::AllocationScope;
+
+TEST(AstarteTestObject, LookupWithoutString) {
+  DatastreamObject object{{"temperature", Data(21.5)}, {"status", Data(std::string(32, 'x'))}};
+  constexpr std::string_view key = "temperature";
+
+  const AllocationScope scope;
+  EXPECT_EQ(object.at(key), Data(21.5));
+  EXPECT_EQ(std::as_const(object).at("temperature"), Data(21.5));
+  EXPECT_NE(object.find(key), object.end());
+  EXPECT_EQ(std::as_const(object).find("humidity"), object.end());
+  EXPECT_TRUE(object.contains("status"));
+  EXPECT_FALSE(object.contains("humidity"));
+  EXPECT_EQ(scope.count(), 0U);
+
+  EXPECT_THROW((void)object.at("humidity"), std::out_of_range);
+  EXPECT_THROW((void)std::as_const(object).at("humidity"), std::out_of_range);
+}
+
+TEST(AstarteTestObject, TryEmplace) {
+  DatastreamObject object;
+  auto [inserted, added] = object.try_emplace("temperature", 21.5);
+  EXPECT_TRUE(added);
+  EXPECT_EQ(inserted->first, "temperature");
+  EXPECT_EQ(inserted->second, Data(21.5));
+
+  // the present key is neither copied nor overwritten
+  const AllocationScope scope;
+  auto [found, replaced] = object.try_emplace(std::string_view("temperature"), 30.0);
+  EXPECT_EQ(scope.count(), 0U);
+  EXPECT_FALSE(replaced);
+  EXPECT_EQ(found, inserted);
+  EXPECT_EQ(object.at("temperature"), Data(21.5));
+  EXPECT_EQ(object.size(), 1U);
+}
+
+TEST(AstarteTestObject, InsertMovesTemporaries) {
+  DatastreamObject object;
+  std::string key(64, 'k');
+  Data value(std::string(64, 'v'));
+  const auto* key_buffer = key.data();
+  const auto* value_buffer = value.into<std::string>().data();
+  object.insert(std::move(key), std::move(value));
+
+  const auto& [stored_key, stored_data] = *object.begin();
+  EXPECT_EQ(stored_key.data(), key_buffer);
+  EXPECT_EQ(stored_data.into<std::string>().data(), value_buffer);
+
+  // an insert does not overwrite the present key
+  object.insert(std::string(64, 'k'), Data(1));
+  EXPECT_EQ(object.size(), 1U);
+  EXPECT_EQ(object.at(std::string(64, 'k')), Data(std::string(64, 'v')));
+}
+
+TEST(AstarteTestObject, ReserveAndErase) {
+  DatastreamObject object(8);
+  EXPECT_TRUE(object.empty());
+  EXPECT_GE(object.get_raw_data().bucket_count() * object.get_raw_data().max_load_factor(), 8.0F);
+
+  const auto buckets = object.get_raw_data().bucket_count();
+  for (int32_t i = 0; i < 8; i++) {
+    object.try_emplace("key_" + std::to_string(i), i);
+  }
+  EXPECT_EQ(object.get_raw_data().bucket_count(), buckets);
+
+  object.reserve(64);
+  EXPECT_GE(object.get_raw_data().bucket_count() * object.get_raw_data().max_load_factor(), 64.0F);
+
+  EXPECT_EQ(object.erase("key_3"), 1U);
+  EXPECT_EQ(object.erase("key_3"), 0U);
+  EXPECT_FALSE(object.contains("key_3"));
+  EXPECT_EQ(object.size(), 7U);
+}
@@ -0,0 +1,233 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <zlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mqtt/property_cache.hpp"
+
+using astarte::device::mqtt::PropertyCache;
+
+namespace {
+
+constexpr std::string_view k_introspection = "org.astarte-platform.test.ServerProperties:1:0";
+constexpr std::string_view k_interface = "org.astarte-platform.test.ServerProperties";
+
+// Builds the payload Astarte publishes on control/consumer/properties.
+auto make_list(std::string_view list) -> std::string {
+  auto compressed_size = compressBound(static_cast<uLong>(list.size()));
+  std::string payload(4 + compressed_size, '\0');
+  compress(reinterpret_cast<Bytef*>(payload.data() + 4), &compressed_size,
+           reinterpret_cast<const Bytef*>(list.data()), static_cast<uLong>(list.size()));
+  payload.resize(4 + compressed_size);
+  const auto size = static_cast<uint32_t>(list.size());
+  payload[0] = static_cast<char>(size >> 24U);
+  payload[1] = static_cast<char>(size >> 16U);
+  payload[2] = static_cast<char>(size >> 8U);
+  payload[3] = static_cast<char>(size);
+  return payload;
+}
+
+class AstarteTestPropertyCache : public testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = std::filesystem::temp_directory_path() /
+            ("astarte_property_cache_" +
+             std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+    std::filesystem::remove(path_);
+    std::filesystem::remove(journal());
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(path_);
+    std::filesystem::remove(journal());
+  }
+
+  [[nodiscard]] auto journal() const -> std::filesystem::path {
+    auto path = path_;
+    path += ".journal";
+    return path;
+  }
+
+  // Brings a new cache to a consistent state with no property set
+  [[nodiscard]] auto synced() const -> PropertyCache {
+    auto cache = PropertyCache::load(path_);
+    EXPECT_TRUE(cache.begin_sync(k_introspection));
+    EXPECT_TRUE(cache.purge(make_list("")));
+    return cache;
+  }
+
+  std::filesystem::path path_;
+};
+
+}  // namespace
+
+TEST_F(AstarteTestPropertyCache, EmptyWithoutFile) {
+  auto cache = PropertyCache::load(path_);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_FALSE(cache.is_consistent(k_introspection));
+}
+
+TEST_F(AstarteTestPropertyCache, SyncCompletesWhenAllListedValuesArrive) {
+  auto cache = PropertyCache::load(path_);
+  ASSERT_TRUE(cache.begin_sync(k_introspection));
+
+  ASSERT_TRUE(cache.purge(make_list(std::string(k_interface) + "/a;" +
+                                    std::string(k_interface) + "/b")));
+  EXPECT_FALSE(cache.is_consistent(k_introspection));
+  ASSERT_TRUE(cache.store(k_interface, "/a", "value a"));
+  EXPECT_FALSE(cache.is_consistent(k_introspection));
+  ASSERT_TRUE(cache.store(k_interface, "/b", "value b"));
+  EXPECT_TRUE(cache.is_consistent(k_introspection));
+  EXPECT_FALSE(cache.is_consistent("org.astarte-platform.test.ServerProperties:2:0"));
+
+  auto reloaded = PropertyCache::load(path_);
+  EXPECT_TRUE(reloaded.is_consistent(k_introspection));
+  EXPECT_EQ(reloaded.get(k_interface, "/a"), "value a");
+  EXPECT_EQ(reloaded.get(k_interface, "/b"), "value b");
+}
+
+TEST_F(AstarteTestPropertyCache, ValuesBeforeListCount) {
+  auto cache = PropertyCache::load(path_);
+  ASSERT_TRUE(cache.begin_sync(k_introspection));
+
+  ASSERT_TRUE(cache.store(k_interface, "/a", "value a"));
+  ASSERT_TRUE(cache.purge(make_list(std::string(k_interface) + "/a")));
+  EXPECT_TRUE(cache.is_consistent(k_introspection));
+}
+
+TEST_F(AstarteTestPropertyCache, PurgeRemovesUnlisted) {
+  auto cache = PropertyCache::load(path_);
+  ASSERT_TRUE(cache.begin_sync(k_introspection));
+  ASSERT_TRUE(cache.store(k_interface, "/stale", "stale value"));
+  ASSERT_TRUE(cache.purge(make_list("")));
+  EXPECT_TRUE(cache.is_consistent(k_introspection));
+  EXPECT_EQ(cache.get(k_interface, "/stale"), std::nullopt);
+
+  // Once consistent, updates and unsets are persisted immediately
+  ASSERT_TRUE(cache.store(k_interface, "/a", "value a"));
+  ASSERT_TRUE(cache.store(k_interface, "/b", "value b"));
+  ASSERT_TRUE(cache.store(k_interface, "/a", ""));
+  auto reloaded = PropertyCache::load(path_);
+  EXPECT_EQ(reloaded.size(), 1);
+  EXPECT_EQ(reloaded.get(k_interface, "/b"), "value b");
+}
+
+TEST_F(AstarteTestPropertyCache, InterruptedSyncIsNotTrusted) {
+  {
+    auto cache = PropertyCache::load(path_);
+    ASSERT_TRUE(cache.begin_sync(k_introspection));
+    ASSERT_TRUE(cache.purge(make_list(std::string(k_interface) + "/a")));
+    ASSERT_TRUE(cache.store(k_interface, "/a", "value a"));
+    ASSERT_TRUE(cache.is_consistent(k_introspection));
+    ASSERT_TRUE(cache.begin_sync(k_introspection));
+  }
+  EXPECT_FALSE(PropertyCache::load(path_).is_consistent(k_introspection));
+}
+
+TEST_F(AstarteTestPropertyCache, RejectsInvalidInput) {
+  auto cache = PropertyCache::load(path_);
+  EXPECT_FALSE(cache.purge("ab"));
+  EXPECT_FALSE(cache.purge(std::string("\0\0\0\x10garbage", 11)));
+
+  std::ofstream(path_, std::ios::binary) << "not a bson document";
+  auto corrupted = PropertyCache::load(path_);
+  EXPECT_EQ(corrupted.size(), 0);
+  EXPECT_FALSE(corrupted.is_consistent(""));
+}
+TEST_F(AstarteTestPropertyCache, JournalsTheUpdates) {
+  auto cache = synced();
+  const auto snapshot_size = std::filesystem::file_size(path_);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(cache.store(k_interface, "/a", "value " + std::to_string(i)));
+  }
+  ASSERT_TRUE(cache.store(k_interface, "/b", "value b"));
+  ASSERT_TRUE(cache.store(k_interface, "/b", ""));
+
+  // the snapshot is left untouched, the updates are appended to the journal
+  EXPECT_EQ(std::filesystem::file_size(path_), snapshot_size);
+  EXPECT_TRUE(std::filesystem::exists(journal()));
+  auto reloaded = PropertyCache::load(path_);
+  EXPECT_TRUE(reloaded.is_consistent(k_introspection));
+  EXPECT_EQ(reloaded.size(), 1);
+  EXPECT_EQ(reloaded.get(k_interface, "/a"), "value 9");
+}
+
+TEST_F(AstarteTestPropertyCache, CompactsTheJournal) {
+  auto cache = synced();
+  for (int i = 0; i < 200; i++) {
+    ASSERT_TRUE(cache.store(k_interface, "/a", "value " + std::to_string(i)));
+  }
+  EXPECT_LT(std::filesystem::file_size(journal()), 64U * 64U);
+  EXPECT_EQ(PropertyCache::load(path_).get(k_interface, "/a"), "value 199");
+}
+
+TEST_F(AstarteTestPropertyCache, DropsATruncatedJournal) {
+  {
+    auto cache = synced();
+    ASSERT_TRUE(cache.store(k_interface, "/a", "value a"));
+    ASSERT_TRUE(cache.store(k_interface, "/b", "value b"));
+  }
+  // an append interrupted by a crash
+  std::filesystem::resize_file(journal(), std::filesystem::file_size(journal()) - 3);
+
+  auto reloaded = PropertyCache::load(path_);
+  EXPECT_TRUE(reloaded.is_consistent(k_introspection));
+  EXPECT_EQ(reloaded.get(k_interface, "/a"), "value a");
+  EXPECT_EQ(reloaded.get(k_interface, "/b"), std::nullopt);
+  ASSERT_TRUE(reloaded.store(k_interface, "/c", "value c"));
+  EXPECT_EQ(PropertyCache::load(path_).get(k_interface, "/c"), "value c");
+}
+
+TEST_F(AstarteTestPropertyCache, IgnoresAStaleJournal) {
+  {
+    auto cache = synced();
+    ASSERT_TRUE(cache.store(k_interface, "/a", "old value"));
+  }
+  const auto stale = journal().string() + ".stale";
+  std::filesystem::copy_file(journal(), stale);
+  {
+    // a new snapshot replaces the journal
+    auto cache = PropertyCache::load(path_);
+    ASSERT_TRUE(cache.begin_sync(k_introspection));
+    ASSERT_TRUE(cache.purge(make_list(std::string(k_interface) + "/a")));
+    ASSERT_TRUE(cache.store(k_interface, "/a", "new value"));
+  }
+  // a crash right after the rename of the snapshot leaves the previous journal behind
+  std::filesystem::rename(stale, journal());
+  EXPECT_EQ(PropertyCache::load(path_).get(k_interface, "/a"), "new value");
+}
+
+TEST_F(AstarteTestPropertyCache, VisitsThePropertiesOfAnInterface) {
+  auto cache = synced();
+  ASSERT_TRUE(cache.store(k_interface, "/b", "value b"));
+  ASSERT_TRUE(cache.store(k_interface, "/a", "value a"));
+  // an interface whose name extends the one of the other interface
+  ASSERT_TRUE(cache.store(std::string(k_interface) + "Extra", "/a", "extra a"));
+
+  std::vector<std::string> visited;
+  cache.for_each(k_interface, [&visited](std::string_view interface_name, std::string_view path,
+                                         std::string_view payload) {
+    EXPECT_EQ(interface_name, k_interface);
+    visited.emplace_back(std::string(path) + "=" + std::string(payload));
+  });
+  EXPECT_EQ(visited, (std::vector<std::string>{"/a=value a", "/b=value b"}));
+
+  size_t all = 0;
+  cache.for_each(std::nullopt, [&all](std::string_view, std::string_view, std::string_view) {
+    all++;
+  });
+  EXPECT_EQ(all, 3);
+}
+#endif
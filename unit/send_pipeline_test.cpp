@@ -0,0 +1,227 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "astarte_device_sdk/errors.hpp"
+#include "astarte_device_sdk/thread_config.hpp"
+#include "mqtt/send_pipeline.hpp"
+
+using astarte::device::OperationRefusedError;
+using astarte::device::ThreadRole;
+using astarte::device::mqtt::SendPipeline;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Job counting its runs
+auto count(std::atomic<int>& runs) -> SendPipeline::Job {
+  return [&runs]() {
+    runs++;
+    return SendPipeline::InFlight{};
+  };
+}
+
+// Job blocking its worker until released
+auto blocker(const std::shared_future<void>& released) -> SendPipeline::Job {
+  return [released]() {
+    released.wait();
+    return SendPipeline::InFlight{};
+  };
+}
+
+// Job recording when it is started and when its completion is awaited
+auto traced(std::mutex& mutex, std::vector<std::string>& events, int id, size_t bytes)
+    -> SendPipeline::Job {
+  return [&mutex, &events, id, bytes]() {
+    const std::lock_guard<std::mutex> lock(mutex);
+    events.push_back("start " + std::to_string(id));
+    return SendPipeline::InFlight{.bytes = bytes, .wait = [&mutex, &events, id]() {
+                                    const std::lock_guard<std::mutex> lock(mutex);
+                                    events.push_back("wait " + std::to_string(id));
+                                  }};
+  };
+}
+
+}  // namespace
+
+TEST(AstarteTestSendPipeline, RunsTheJobsOfAKeyInOrder) {
+  SendPipeline pipeline(4, 4096, {});
+  std::mutex mutex;
+  std::map<std::string, std::vector<int>> runs;
+
+  const std::vector<std::string> keys{"org.Sensors", "org.Gps", "org.Camera"};
+  for (int i = 0; i < 300; i++) {
+    const std::string& key = keys.at(i % keys.size());
+    auto res = pipeline.submit(key, [&mutex, &runs, key, i]() {
+      const std::lock_guard<std::mutex> lock(mutex);
+      runs[key].push_back(i);
+      return SendPipeline::InFlight{};
+    });
+    ASSERT_TRUE(res);
+  }
+  pipeline.flush();
+
+  EXPECT_EQ(pipeline.pending(), 0U);
+  ASSERT_EQ(runs.size(), keys.size());
+  for (const auto& [key, order] : runs) {
+    ASSERT_EQ(order.size(), 100U);
+    for (size_t i = 1; i < order.size(); i++) {
+      EXPECT_LT(order[i - 1], order[i]) << key;
+    }
+  }
+}
+
+TEST(AstarteTestSendPipeline, RefusesJobsWhenFull) {
+  SendPipeline pipeline(1, 2, {});
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic<int> runs{0};
+
+  ASSERT_TRUE(pipeline.submit("org.Sensors", [released, &runs]() {
+    released.wait();
+    runs++;
+    return SendPipeline::InFlight{};
+  }));
+  ASSERT_TRUE(pipeline.submit("org.Sensors", count(runs)));
+
+  auto refused = pipeline.submit("org.Sensors", count(runs));
+  ASSERT_FALSE(refused);
+  EXPECT_TRUE(std::holds_alternative<OperationRefusedError>(refused.error()));
+  EXPECT_EQ(pipeline.pending(), 2U);
+
+  release.set_value();
+  pipeline.flush();
+  EXPECT_EQ(runs.load(), 2);
+  EXPECT_TRUE(pipeline.submit("org.Sensors", count(runs)));
+  pipeline.flush();
+  EXPECT_EQ(runs.load(), 3);
+}
+
+TEST(AstarteTestSendPipeline, RunsTheQueuedJobsBeforeStopping) {
+  std::atomic<int> runs{0};
+  {
+    SendPipeline pipeline(2, 1024, {});
+    for (int i = 0; i < 500; i++) {
+      ASSERT_TRUE(pipeline.submit(std::to_string(i % 7), count(runs)));
+    }
+  }
+  EXPECT_EQ(runs.load(), 500);
+}
+
+TEST(AstarteTestSendPipeline, InvokesTheHookOnEachWorker) {
+  std::mutex mutex;
+  std::vector<ThreadRole> roles;
+  {
+    const SendPipeline pipeline(3, 16, [&mutex, &roles](ThreadRole role) {
+      const std::lock_guard<std::mutex> lock(mutex);
+      roles.push_back(role);
+    });
+    EXPECT_EQ(pipeline.workers(), 3U);
+  }
+  ASSERT_EQ(roles.size(), 3U);
+  for (const ThreadRole role : roles) {
+    EXPECT_EQ(role, ThreadRole::kMqttSendWorker);
+  }
+}
+
+TEST(AstarteTestSendPipeline, SurvivesThrowingJobs) {
+  SendPipeline pipeline(1, 16, {});
+  std::atomic<int> runs{0};
+
+  ASSERT_TRUE(pipeline.submit(
+      "org.Sensors", []() -> SendPipeline::InFlight { throw std::runtime_error("failure"); }));
+  ASSERT_TRUE(pipeline.submit("org.Sensors", count(runs)));
+  pipeline.flush();
+  EXPECT_EQ(runs.load(), 1);
+  EXPECT_EQ(pipeline.pending(), 0U);
+}
+
+TEST(AstarteTestSendPipeline, StartsTheWholeBatchBeforeWaiting) {
+  SendPipeline pipeline(1, 64, {}, 0us, 1024);
+  std::promise<void> release;
+  std::mutex mutex;
+  std::vector<std::string> events;
+
+  ASSERT_TRUE(pipeline.submit("org.Sensors", blocker(release.get_future().share())));
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(pipeline.submit("org.Sensors", traced(mutex, events, i, 10)));
+  }
+  release.set_value();
+  pipeline.flush();
+
+  const std::vector<std::string> expected{"start 0", "start 1", "start 2",
+                                          "wait 0",  "wait 1",  "wait 2"};
+  EXPECT_EQ(events, expected);
+}
+
+TEST(AstarteTestSendPipeline, BoundsTheFlush) {
+  SendPipeline pipeline(1, 64, {});
+  std::promise<void> release;
+  ASSERT_TRUE(pipeline.submit("org.Sensors", blocker(release.get_future().share())));
+
+  // a job that never completes does not hold the flush past its timeout
+  EXPECT_FALSE(pipeline.flush_for(20ms));
+  EXPECT_EQ(pipeline.pending(), 1U);
+  release.set_value();
+  EXPECT_TRUE(pipeline.flush_for(1s));
+  EXPECT_EQ(pipeline.pending(), 0U);
+}
+
+TEST(AstarteTestSendPipeline, ClosesTheBatchAtTheByteLimit) {
+  SendPipeline pipeline(1, 64, {}, 0us, 20);
+  std::promise<void> release;
+  std::mutex mutex;
+  std::vector<std::string> events;
+
+  ASSERT_TRUE(pipeline.submit("org.Sensors", blocker(release.get_future().share())));
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(pipeline.submit("org.Sensors", traced(mutex, events, i, 10)));
+  }
+  release.set_value();
+  pipeline.flush();
+
+  const std::vector<std::string> expected{"start 0", "start 1", "wait 0",  "wait 1",
+                                          "start 2", "start 3", "wait 2",  "wait 3"};
+  EXPECT_EQ(events, expected);
+}
+
+TEST(AstarteTestSendPipeline, AdaptsTheLingerToTheLoad) {
+  SendPipeline pipeline(1, 64, {}, 800us, 1 << 20);
+  std::atomic<int> runs{0};
+  EXPECT_EQ(pipeline.linger(), 0us);
+
+  // a backlog is batched and makes the worker linger
+  for (int burst = 0; burst < 4; burst++) {
+    std::promise<void> release;
+    ASSERT_TRUE(pipeline.submit("org.Sensors", blocker(release.get_future().share())));
+    for (int i = 0; i < 8; i++) {
+      ASSERT_TRUE(pipeline.submit("org.Sensors", count(runs)));
+    }
+    release.set_value();
+    pipeline.flush();
+  }
+  EXPECT_EQ(pipeline.linger(), 800us);
+
+  // isolated sends bring the linger back to zero
+  for (int i = 0; i < 8; i++) {
+    ASSERT_TRUE(pipeline.submit("org.Sensors", count(runs)));
+    pipeline.flush();
+  }
+  EXPECT_EQ(pipeline.linger(), 0us);
+  EXPECT_EQ(runs.load(), 40);
+}
+#endif
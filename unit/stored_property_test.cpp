@@ -0,0 +1,52 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/stored_property.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "allocation_counter.hpp"
+#include "astarte_device_sdk/data.hpp"
+#include "astarte_device_sdk/formatter.hpp"
+#include "astarte_device_sdk/ownership.hpp"
+
+using astarte::device::Data;
+using astarte::device::Ownership;
+using astarte::device::StoredProperty;
+using astarte::device::unit::AllocationScope;
+
+TEST(AstarteTestStoredProperty, SharesTheInterfaceName) {
+  auto name = std::make_shared<const std::string>("org.Sensors");
+  const StoredProperty first(name, "/first", 1, Ownership::kServer, Data(int32_t{1}));
+  const StoredProperty second(name, "/second", 1, Ownership::kServer, Data(int32_t{2}));
+
+  EXPECT_EQ(&first.get_interface_name(), &second.get_interface_name());
+  const StoredProperty copy("org.Sensors", "/first", 1, Ownership::kServer, Data(int32_t{1}));
+  EXPECT_EQ(first, copy);
+}
+
+TEST(AstarteTestStoredProperty, OwnedNameIsASingleAllocation) {
+  // a name too long for the small string buffer, along with a short path and a scalar value
+  const AllocationScope scope;
+  const StoredProperty property("org.astarte-platform.Sensors", "/value", 1, Ownership::kDevice,
+                                Data(true));
+  EXPECT_EQ(scope.count(), 1U);
+}
+
+TEST(AstarteTestStoredProperty, MovedFromHasAnEmptyName) {
+  StoredProperty property("org.Sensors", "/value", 1, Ownership::kDevice, Data(true));
+  const StoredProperty moved(std::move(property));
+  EXPECT_EQ(moved.get_interface_name(), "org.Sensors");
+
+  // NOLINTBEGIN(bugprone-use-after-move)
+  EXPECT_TRUE(property.get_interface_name().empty());
+  EXPECT_NE(property, moved);
+  EXPECT_FALSE(astarte_fmt::format("{}", property).empty());
+  // NOLINTEND(bugprone-use-after-move)
+}
@@ -0,0 +1,98 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/thread_config.hpp"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "thread_setup.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#endif
+
+using astarte::device::setup_thread;
+using astarte::device::ThreadConfig;
+using astarte::device::ThreadRole;
+
+TEST(AstarteTestThreadConfig, EmptyConfigIsNoop) {
+  EXPECT_TRUE(ThreadConfig().apply());
+}
+
+TEST(AstarteTestThreadConfig, HookRunsWithRole) {
+  std::optional<ThreadRole> seen;
+  std::thread([&seen] {
+    setup_thread(ThreadRole::kGrpcConnection, [&seen](ThreadRole role) { seen = role; });
+  }).join();
+  EXPECT_EQ(seen, ThreadRole::kGrpcConnection);
+
+  // An empty hook is allowed
+  std::thread([] { setup_thread(ThreadRole::kMqttCallback, nullptr); }).join();
+}
+
+#if defined(__linux__)
+namespace {
+
+auto current_thread_name() -> std::string {
+  std::array<char, 16> name{};
+  pthread_getname_np(pthread_self(), name.data(), name.size());
+  return {name.data()};
+}
+
+}  // namespace
+
+TEST(AstarteTestThreadConfig, NameIsTruncated) {
+  std::string name;
+  std::thread([&name] {
+    EXPECT_TRUE(ThreadConfig().name("astarte-very-long-thread-name").apply());
+    name = current_thread_name();
+  }).join();
+  EXPECT_EQ(name, "astarte-very-lo");
+}
+
+TEST(AstarteTestThreadConfig, DefaultNameBeforeHook) {
+  std::string name;
+  std::thread([&name] {
+    setup_thread(ThreadRole::kGrpcConnection,
+                 [&name](ThreadRole /*role*/) { name = current_thread_name(); });
+  }).join();
+  EXPECT_EQ(name, astarte::device::thread_role_name(ThreadRole::kGrpcConnection));
+}
+
+TEST(AstarteTestThreadConfig, CpuAffinity) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  uint32_t cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    cpu++;
+  }
+
+  std::thread([cpu] {
+    EXPECT_TRUE(ThreadConfig().cpu_affinity({cpu}).apply());
+    cpu_set_t set;
+    ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(set), &set), 0);
+    EXPECT_EQ(CPU_COUNT(&set), 1);
+    EXPECT_TRUE(CPU_ISSET(cpu, &set));
+  }).join();
+
+  std::thread([] {
+    EXPECT_FALSE(ThreadConfig().cpu_affinity({static_cast<uint32_t>(CPU_SETSIZE)}).apply());
+  }).join();
+}
+
+TEST(AstarteTestThreadConfig, InvalidSchedulingPriority) {
+  std::thread([] {
+    EXPECT_FALSE(ThreadConfig().scheduling(astarte::device::SchedulingPolicy::kOther, 10).apply());
+  }).join();
+}
+#endif
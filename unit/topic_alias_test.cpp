@@ -0,0 +1,99 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <cstdint>
+#include <set>
+#include <string>
+
+#include "mqtt/connection/topic_alias.hpp"
+
+using astarte::device::mqtt::connection::TopicAliasCache;
+
+TEST(AstarteTestTopicAlias, DisabledByDefault) {
+  TopicAliasCache cache;
+  EXPECT_EQ(cache.maximum(), 0);
+  EXPECT_FALSE(cache.lookup("realm/device/interface/path", 1));
+  EXPECT_FALSE(cache.lookup("realm/device/interface/path", 0));
+}
+
+TEST(AstarteTestTopicAlias, EstablishThenReuse) {
+  TopicAliasCache cache;
+  cache.reset(4);
+
+  auto first = cache.lookup("realm/device/interface/path", 0);
+  ASSERT_TRUE(first);
+  EXPECT_FALSE(first->established);
+  EXPECT_GT(first->value, 0);
+
+  auto second = cache.lookup("realm/device/interface/path", 0);
+  ASSERT_TRUE(second);
+  EXPECT_TRUE(second->established);
+  EXPECT_EQ(second->value, first->value);
+}
+
+TEST(AstarteTestTopicAlias, AcknowledgedMessagesAreNotAliased) {
+  TopicAliasCache cache;
+  cache.reset(4);
+  EXPECT_FALSE(cache.lookup("realm/device/interface/path", 1));
+  EXPECT_FALSE(cache.lookup("realm/device/interface/path", 2));
+}
+
+TEST(AstarteTestTopicAlias, AliasesStayWithinMaximum) {
+  TopicAliasCache cache;
+  cache.reset(4);
+
+  std::set<uint16_t> aliases;
+  for (int i = 0; i < 8; i++) {
+    aliases.insert(cache.lookup("realm/device/interface/" + std::to_string(i), 0)->value);
+  }
+
+  EXPECT_EQ(aliases.size(), 4);
+  for (auto alias : aliases) {
+    EXPECT_GE(alias, 1);
+    EXPECT_LE(alias, 4);
+  }
+
+  // A broker lowering the maximum on reconnection gets aliases within the new one
+  cache.reset(2);
+  for (int i = 0; i < 8; i++) {
+    auto alias = cache.lookup("realm/device/interface/" + std::to_string(i), 0)->value;
+    EXPECT_GE(alias, 1);
+    EXPECT_LE(alias, 2);
+  }
+}
+
+TEST(AstarteTestTopicAlias, LeastRecentlyUsedIsEvicted) {
+  TopicAliasCache cache;
+  cache.reset(2);
+
+  auto alias_a = cache.lookup("a", 0)->value;
+  auto alias_b = cache.lookup("b", 0)->value;
+  // Touch "a" so that "b" becomes the least recently used topic
+  EXPECT_TRUE(cache.lookup("a", 0)->established);
+
+  auto alias_c = cache.lookup("c", 0);
+  EXPECT_FALSE(alias_c->established);
+  EXPECT_EQ(alias_c->value, alias_b);
+
+  EXPECT_TRUE(cache.lookup("a", 0)->established);
+  EXPECT_EQ(cache.lookup("a", 0)->value, alias_a);
+
+  auto rebound_b = cache.lookup("b", 0);
+  EXPECT_FALSE(rebound_b->established);
+}
+
+TEST(AstarteTestTopicAlias, ClearForgetsAliases) {
+  TopicAliasCache cache;
+  cache.reset(4);
+  EXPECT_FALSE(cache.lookup("a", 0)->established);
+  EXPECT_TRUE(cache.lookup("a", 0)->established);
+
+  cache.clear();
+  EXPECT_EQ(cache.maximum(), 4);
+  EXPECT_FALSE(cache.lookup("a", 0)->established);
+}
+#endif
@@ -0,0 +1,126 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#if defined(ASTARTE_TRANSPORT_MQTT)
+#include <string_view>
+#include <utility>
+
+#include "mqtt/connection/topic_router.hpp"
+#include "mqtt/interface.hpp"
+#include "mqtt/introspection.hpp"
+
+using astarte::device::mqtt::Interface;
+using astarte::device::mqtt::Introspection;
+using astarte::device::mqtt::connection::Route;
+using astarte::device::mqtt::connection::TopicRouter;
+
+namespace {
+
+constexpr std::string_view k_individual = R"({
+  "interface_name": "org.astarte-platform.test.ServerDatastream",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "server",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/value", "type": "double"},
+    {"endpoint": "/enabled", "type": "boolean"}
+  ]
+})";
+
+constexpr std::string_view k_object = R"({
+  "interface_name": "org.astarte-platform.test.ServerObject",
+  "version_major": 1,
+  "version_minor": 0,
+  "type": "datastream",
+  "ownership": "server",
+  "aggregation": "object",
+  "mappings": [
+    {"endpoint": "/%{sensor_id}/temperature", "type": "double"},
+    {"endpoint": "/%{sensor_id}/humidity", "type": "double"}
+  ]
+})";
+
+class AstarteTestTopicRouter : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (const auto interface : {k_individual, k_object}) {
+      auto res = Interface::try_from_str(interface);
+      ASSERT_TRUE(res);
+      ASSERT_TRUE(introspection_.checked_insert(std::move(res.value())));
+    }
+  }
+
+  Introspection introspection_;
+  TopicRouter router_{"realm", "device"};
+};
+
+}  // namespace
+
+TEST_F(AstarteTestTopicRouter, SplitsTopics) {
+  auto route = router_.split("realm/device/org.astarte-platform.test.Interface/some/path");
+  EXPECT_EQ(route.kind, Route::Kind::kInterface);
+  EXPECT_EQ(route.interface_name, "org.astarte-platform.test.Interface");
+  EXPECT_EQ(route.path, "/some/path");
+
+  route = router_.split("realm/device/control/consumer/properties");
+  EXPECT_EQ(route.kind, Route::Kind::kControl);
+  EXPECT_TRUE(route.interface_name.empty());
+  EXPECT_EQ(route.path, "/consumer/properties");
+}
+
+TEST_F(AstarteTestTopicRouter, RejectsForeignAndMalformedTopics) {
+  for (const auto topic :
+       {"realm/other/org.astarte-platform.test.Interface/path",
+        "realm2/device/org.astarte-platform.test.Interface/path",
+        "realm/device2/org.astarte-platform.test.Interface/path", "realm/device",
+        "realm/device/org.astarte-platform.test.Interface",
+        "realm/device/org.astarte-platform.test.Interface/", "realm/device//path"}) {
+    EXPECT_EQ(router_.split(topic).kind, Route::Kind::kInvalid) << topic;
+  }
+}
+
+TEST_F(AstarteTestTopicRouter, ResolvesIndividualMappings) {
+  auto route =
+      router_.route("realm/device/org.astarte-platform.test.ServerDatastream/sensor_1/value",
+                    introspection_);
+  ASSERT_EQ(route.kind, Route::Kind::kInterface);
+  ASSERT_NE(route.interface, nullptr);
+  EXPECT_EQ(route.interface->interface_name(), "org.astarte-platform.test.ServerDatastream");
+  ASSERT_NE(route.mapping, nullptr);
+  EXPECT_EQ(route.mapping->endpoint(), "/%{sensor_id}/value");
+
+  route = router_.route("realm/device/org.astarte-platform.test.ServerDatastream/enabled",
+                        introspection_);
+  ASSERT_EQ(route.kind, Route::Kind::kInterface);
+  EXPECT_EQ(route.mapping->endpoint(), "/enabled");
+}
+
+TEST_F(AstarteTestTopicRouter, ResolvesObjectMappings) {
+  auto route = router_.route("realm/device/org.astarte-platform.test.ServerObject/sensor_1",
+                             introspection_);
+  ASSERT_EQ(route.kind, Route::Kind::kInterface);
+  ASSERT_NE(route.mapping, nullptr);
+  EXPECT_EQ(route.mapping->endpoint(), "/%{sensor_id}/temperature");
+
+  route = router_.route(
+      "realm/device/org.astarte-platform.test.ServerObject/sensor_1/temperature", introspection_);
+  EXPECT_EQ(route.kind, Route::Kind::kUnknownMapping);
+}
+
+TEST_F(AstarteTestTopicRouter, ReportsUnknownDestinations) {
+  auto route =
+      router_.route("realm/device/org.astarte-platform.test.Missing/path", introspection_);
+  EXPECT_EQ(route.kind, Route::Kind::kUnknownInterface);
+  EXPECT_EQ(route.interface_name, "org.astarte-platform.test.Missing");
+
+  route = router_.route("realm/device/org.astarte-platform.test.ServerDatastream/sensor_1/other",
+                        introspection_);
+  EXPECT_EQ(route.kind, Route::Kind::kUnknownMapping);
+  EXPECT_NE(route.interface, nullptr);
+  EXPECT_EQ(route.mapping, nullptr);
+}
+#endif
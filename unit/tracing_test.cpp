@@ -0,0 +1,86 @@
+// (C) Copyright 2025 - 2026, SECO Mind Srl
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "astarte_device_sdk/tracing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+
+#include "tracing_span.hpp"
+
+namespace tracing = astarte::device::tracing;
+using json = nlohmann::json;
+
+namespace {
+
+// Counts the complete events of a trace with the given name.
+auto spans_named(const json& trace, const std::string& name) -> size_t {
+  size_t count = 0;
+  for (const auto& event : trace.at("traceEvents")) {
+    if (event.at("ph") == "X" && event.at("name") == name) {
+      count++;
+    }
+  }
+  return count;
+}
+
+class AstarteTestTracing : public ::testing::Test {
+ protected:
+  void SetUp() override { tracing::clear(); }
+  void TearDown() override {
+    tracing::disable();
+    tracing::clear();
+  }
+};
+
+}  // namespace
+
+TEST_F(AstarteTestTracing, DisabledRecordsNothing) {
+  ASSERT_FALSE(tracing::is_enabled());
+  { ASTARTE_TRACE_SPAN("test", "disabled"); }
+  auto trace = json::parse(tracing::chrome_trace());
+  EXPECT_EQ(spans_named(trace, "disabled"), 0);
+}
+
+TEST_F(AstarteTestTracing, SpansFromMultipleThreads) {
+  tracing::enable();
+  { ASTARTE_TRACE_SPAN("test", "main"); }
+  std::thread([] {
+    tracing::ScopedSpan span("test", "worker");
+    span.end();
+    // Ending twice records a single span
+    span.end();
+  }).join();
+
+  auto trace = json::parse(tracing::chrome_trace());
+  EXPECT_EQ(spans_named(trace, "main"), 1);
+  EXPECT_EQ(spans_named(trace, "worker"), 1);
+  for (const auto& event : trace.at("traceEvents")) {
+    if (event.at("ph") == "X") {
+      EXPECT_EQ(event.at("cat"), "test");
+      EXPECT_GE(event.at("dur").get<double>(), 0.0);
+    }
+  }
+}
+
+TEST_F(AstarteTestTracing, RingKeepsMostRecentSpans) {
+  tracing::enable();
+  for (size_t i = 0; i < tracing::k_ring_capacity + 10; i++) {
+    ASTARTE_TRACE_SPAN("test", "wrapped");
+  }
+  auto trace = json::parse(tracing::chrome_trace());
+  EXPECT_EQ(spans_named(trace, "wrapped"), tracing::k_ring_capacity);
+}
+
+TEST_F(AstarteTestTracing, ClearDiscardsSpans) {
+  tracing::enable();
+  { ASTARTE_TRACE_SPAN("test", "cleared"); }
+  tracing::clear();
+  auto trace = json::parse(tracing::chrome_trace());
+  EXPECT_EQ(spans_named(trace, "cleared"), 0);
+}